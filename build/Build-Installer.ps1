@@ -266,6 +266,7 @@ function Build-Portable([string]$BinSuffix, [string]$InstallerSuffix, [string]$V
         Copy-Item (Join-Path $BinDir "ts*.dll") -Destination $TempBin
         Copy-Item (Join-Multipath @($SrcDir, "libtsduck", "dtv", "tsduck*.xml")) -Destination $TempBin
         Copy-Item (Join-Multipath @($SrcDir, "libtsduck", "dtv", "tsduck*.names")) -Destination $TempBin
+        Copy-Item (Join-Path $BinDir "tsduck*.names.bin") -Destination $TempBin
 
         $TempDoc = (New-Directory @($TempRoot, "doc"))
         Copy-Item (Join-Multipath @($RootDir, "doc", "tsduck.pdf")) -Destination $TempDoc
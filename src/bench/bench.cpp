@@ -0,0 +1,127 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSDuck benchmarks driver program.
+//
+//  The benchmarks are not part of the unitary tests. They measure the
+//  performance of critical parts of the library and should be run on
+//  an idle system, preferably several times.
+//
+//----------------------------------------------------------------------------
+
+#include "bench.h"
+#include "tsMain.h"
+TSDUCK_SOURCE;
+TS_MAIN(MainCode);
+
+
+//----------------------------------------------------------------------------
+// Repository of benchmarks, sorted by name.
+//----------------------------------------------------------------------------
+
+namespace {
+    typedef std::map<ts::UString, bench::Function> Repository;
+
+    // The repository is built by static initializers, it must be created on first use.
+    Repository& GetRepository()
+    {
+        static Repository repo;
+        return repo;
+    }
+}
+
+bench::Register::Register(const ts::UString& name, Function func)
+{
+    GetRepository().insert(std::make_pair(name, func));
+}
+
+
+//----------------------------------------------------------------------------
+// Command line options
+//----------------------------------------------------------------------------
+
+bench::Options::~Options() {}
+
+bench::Options::Options(int argc, char *argv[]) :
+    Args(u"Run TSDuck performance benchmarks", u"[options] [name ...]"),
+    names(),
+    input(),
+    list(false)
+{
+    option(u"", 0, STRING, 0, UNLIMITED_COUNT);
+    help(u"", u"Names of the benchmarks to run. By default, run all benchmarks.");
+
+    option(u"input", 'i', STRING);
+    help(u"input", u"filename",
+         u"Reference capture file (TS) for the benchmarks which process packets. "
+         u"By default, these benchmarks use synthetic streams.");
+
+    option(u"list", 'l');
+    help(u"list", u"List the names of all benchmarks and exit.");
+
+    analyze(argc, argv);
+
+    getValues(names);
+    getValue(input, u"input");
+    list = present(u"list");
+
+    for (auto name = names.begin(); name != names.end(); ++name) {
+        bool found = false;
+        for (auto it = GetRepository().begin(); !found && it != GetRepository().end(); ++it) {
+            found = it->first.similar(*name);
+        }
+        if (!found) {
+            error(u"unknown benchmark %s, use --list", {*name});
+        }
+    }
+
+    exitOnError();
+}
+
+
+//----------------------------------------------------------------------------
+//  Program entry point
+//----------------------------------------------------------------------------
+
+int MainCode(int argc, char *argv[])
+{
+    bench::Options opt(argc, argv);
+    bool success = true;
+
+    for (auto it = GetRepository().begin(); it != GetRepository().end(); ++it) {
+        if (opt.list) {
+            std::cout << it->first << std::endl;
+        }
+        else if (opt.names.empty() || it->first.containSimilar(opt.names)) {
+            std::cout << "==== " << it->first << std::endl;
+            success = it->second(opt) && success;
+        }
+    }
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
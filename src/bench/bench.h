@@ -0,0 +1,84 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSDuck benchmarks: common declarations.
+//
+//  Maintenance note:
+//    Each benchmark is a function in a source file of this directory,
+//    registered using the macro BENCH_REGISTER. The function displays its
+//    results on the standard output. It returns false when the results
+//    are not consistent, so that the benchmarks also check what they measure.
+//
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsArgs.h"
+#include "tsMonotonic.h"
+
+namespace bench {
+
+    // Command line options. Benchmarks report their errors here.
+    class Options: public ts::Args
+    {
+        TS_NOBUILD_NOCOPY(Options);
+    public:
+        Options(int argc, char *argv[]);
+        virtual ~Options();
+
+        ts::UStringVector names;  // Benchmarks to run, all if empty.
+        ts::UString       input;  // Reference capture file, synthetic streams if empty.
+        bool              list;   // List the benchmarks, do not run them.
+    };
+
+    // Profile of a benchmark function.
+    typedef bool (*Function)(Options& opt);
+
+    // Register a benchmark function. Use the macro BENCH_REGISTER instead.
+    class Register
+    {
+        TS_NOBUILD_NOCOPY(Register);
+    public:
+        Register(const ts::UString& name, Function func);
+    };
+
+    // Current monotonic time in nanoseconds.
+    inline ts::NanoSecond Now()
+    {
+        return ts::Monotonic::CurrentNanoSeconds();
+    }
+
+    // Duration since a start time, never zero so that it can be used as divisor.
+    inline ts::NanoSecond Since(ts::NanoSecond start)
+    {
+        return std::max<ts::NanoSecond>(1, Now() - start);
+    }
+}
+
+// Register a benchmark function under a name, in a source file.
+#define BENCH_REGISTER(name, func) static bench::Register TS_UNIQUE_NAME(_Registrar)(name, func)
@@ -0,0 +1,97 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Benchmark of the CRC32 implementations.
+//
+//----------------------------------------------------------------------------
+
+#include "bench.h"
+#include "tsCRC32.h"
+#include "tsByteBlock.h"
+TSDUCK_SOURCE;
+
+namespace {
+    // Implementations to compare.
+    struct Implementation {
+        ts::CRC32::Implementation impl;
+        const ts::UChar* name;
+    };
+    const Implementation implementations[] = {
+        {ts::CRC32::BYTEWISE, u"byte-wise"},
+        {ts::CRC32::SLICING8, u"slicing-by-8"},
+        {ts::CRC32::CLMUL,    u"clmul"},
+        {ts::CRC32::FASTEST,  u"fastest"},
+    };
+
+    // Compare all implementations on typical section sizes.
+    bool BenchCRC32(bench::Options& opt)
+    {
+        static const size_t sizes[] = {16, 188, 1024, 4096};
+        static const size_t total = 64 * 1024 * 1024;
+
+        std::cout << "carry-less multiplication: " << ts::UString::YesNo(ts::CRC32::IsSupported(ts::CRC32::CLMUL)) << std::endl;
+
+        ts::ByteBlock data(4096);
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = uint8_t(i * 13);
+        }
+
+        bool success = true;
+        for (size_t is = 0; is < sizeof(sizes) / sizeof(sizes[0]); ++is) {
+            const size_t size = sizes[is];
+            const size_t count = total / size;
+            uint32_t first = 0;
+            for (size_t i = 0; i < sizeof(implementations) / sizeof(implementations[0]); ++i) {
+                // Keep the CRC values to check the results and prevent optimizing out the loop.
+                uint32_t acc = 0;
+                const ts::NanoSecond start = bench::Now();
+                for (size_t n = 0; n < count; ++n) {
+                    ts::CRC32 crc;
+                    crc.add(data.data(), size, implementations[i].impl);
+                    acc ^= crc.value() + uint32_t(n);
+                }
+                const ts::NanoSecond duration = bench::Since(start);
+                if (i == 0) {
+                    first = acc;
+                }
+                else if (acc != first) {
+                    opt.error(u"%s: different CRC32 values on %d bytes", {implementations[i].name, size});
+                    success = false;
+                }
+                std::cout << ts::UString::Format(u"%4d bytes, %-12s: %8'd ns/section, %6'd MB/s",
+                                                 {size, implementations[i].name, duration / ts::NanoSecond(count),
+                                                  (ts::NanoSecond(count * size) * 1000) / duration})
+                          << std::endl;
+            }
+        }
+        return success;
+    }
+}
+
+BENCH_REGISTER(u"crc32", BenchCRC32);
@@ -0,0 +1,160 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Benchmark of the section demux.
+//
+//----------------------------------------------------------------------------
+
+#include "bench.h"
+#include "tsSectionDemux.h"
+#include "tsBinaryTable.h"
+#include "tsOneShotPacketizer.h"
+#include "tsTSPacketReader.h"
+#include "tsPMT.h"
+#include "tsSDT.h"
+TSDUCK_SOURCE;
+
+namespace {
+    // Count tables and sections.
+    class DemuxCounter: public ts::TableHandlerInterface, public ts::SectionHandlerInterface
+    {
+    public:
+        DemuxCounter() : tables(0), sections(0) {}
+        size_t tables;
+        size_t sections;
+        virtual void handleTable(ts::SectionDemux&, const ts::BinaryTable&) override { tables++; }
+        virtual void handleSection(ts::SectionDemux&, const ts::Section&) override { sections++; }
+    };
+
+    // Build a multiplex of many PID's, each of them carrying a PMT or an SDT, repeated several times.
+    void BuildMultiplex(ts::TSPacketVector& mux)
+    {
+        static const size_t pid_count = 400;
+        static const size_t repeat = 100;
+
+        ts::DuckContext duck;
+        std::vector<ts::TSPacketVector> streams(pid_count);
+        for (size_t pi = 0; pi < pid_count; ++pi) {
+            const ts::PID pid = ts::PID(0x0100 + pi);
+            const uint16_t id = uint16_t(pi);
+            ts::OneShotPacketizer pzer(pid);
+            if (pi % 2 == 0) {
+                ts::PMT pmt(0, true, id, ts::PID(pid + 0x1000));
+                pmt.streams[ts::PID(pid + 0x1000)].stream_type = ts::ST_MPEG2_VIDEO;
+                pmt.streams[ts::PID(pid + 0x1001)].stream_type = ts::ST_MPEG1_AUDIO;
+                pmt.streams[ts::PID(pid + 0x1002)].stream_type = ts::ST_PES_PRIV;
+                pzer.addTable(duck, pmt);
+            }
+            else {
+                ts::SDT sdt(true, 0, true, id, 1);
+                for (uint16_t srv = 0; srv < 20; ++srv) {
+                    sdt.services[srv].setName(duck, ts::UString::Format(u"Service %d on TS %d", {srv, id}));
+                }
+                pzer.addTable(duck, sdt);
+            }
+            ts::TSPacketVector packets;
+            pzer.getPackets(packets);
+            for (size_t i = 0; i < repeat * packets.size(); ++i) {
+                streams[pi].push_back(packets[i % packets.size()]);
+                streams[pi].back().setCC(uint8_t(i & ts::CC_MASK));
+            }
+        }
+
+        // Interleave all streams.
+        mux.clear();
+        for (size_t i = 0; ; ++i) {
+            const size_t prev = mux.size();
+            for (size_t pi = 0; pi < streams.size(); ++pi) {
+                if (i < streams[pi].size()) {
+                    mux.push_back(streams[pi][i]);
+                }
+            }
+            if (mux.size() == prev) {
+                break;
+            }
+        }
+    }
+
+    // Load a capture file in memory.
+    bool LoadCapture(ts::TSPacketVector& mux, const ts::UString& filename, ts::Report& report)
+    {
+        ts::TSPacketReader reader;
+        ts::TSPacket pkt;
+        mux.clear();
+        if (!reader.open(filename, report)) {
+            return false;
+        }
+        while (reader.read(pkt, report)) {
+            mux.push_back(pkt);
+        }
+        return reader.close(report);
+    }
+
+    // Demux all packets, with or without section handler.
+    void Demux(const ts::TSPacketVector& mux, bool sections, const ts::UString& title)
+    {
+        ts::DuckContext duck;
+        DemuxCounter counter;
+        ts::SectionDemux demux(duck, &counter, sections ? &counter : nullptr, ts::AllPIDs);
+        const ts::NanoSecond start = bench::Now();
+        for (size_t i = 0; i < mux.size(); ++i) {
+            demux.feedPacket(mux[i]);
+        }
+        const ts::NanoSecond duration = bench::Since(start);
+        std::cout << ts::UString::Format(u"%-14s: %'d packets, %'d tables, %'d sections, %'d ns/packet, %'d packets/s",
+                                         {title, mux.size(), counter.tables, counter.sections,
+                                          duration / ts::NanoSecond(mux.size()),
+                                          (ts::NanoSecond(mux.size()) * ts::NanoSecPerSec) / duration})
+                  << std::endl;
+    }
+
+    // Demux all PSI/SI on all PID's of a synthetic multiplex or a reference capture.
+    bool BenchDemux(bench::Options& opt)
+    {
+        ts::TSPacketVector mux;
+        if (opt.input.empty()) {
+            BuildMultiplex(mux);
+        }
+        else if (!LoadCapture(mux, opt.input, opt)) {
+            return false;
+        }
+        if (mux.empty()) {
+            opt.error(u"no packet to demux");
+            return false;
+        }
+        std::cout << "input: " << (opt.input.empty() ? u"synthetic multiplex" : opt.input) << std::endl;
+
+        // Without section handler, repeated sections are only checked, not rebuilt.
+        Demux(mux, false, u"tables only");
+        Demux(mux, true, u"all sections");
+        return true;
+    }
+}
+
+BENCH_REGISTER(u"demux", BenchDemux);
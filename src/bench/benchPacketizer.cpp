@@ -0,0 +1,91 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Benchmark of the cycling packetizer.
+//
+//----------------------------------------------------------------------------
+
+#include "bench.h"
+#include "tsCyclingPacketizer.h"
+TSDUCK_SOURCE;
+
+namespace {
+    // Build an EIT-like section of 100 bytes of payload.
+    ts::SectionPtr MakeSection(ts::TID tid, uint16_t tid_ext, uint8_t section_number)
+    {
+        const ts::ByteBlock payload(100, uint8_t(tid_ext));
+        return ts::SectionPtr(new ts::Section(tid, true, tid_ext, 1, true, section_number, section_number, payload.data(), payload.size()));
+    }
+
+    // Cycle 50,000 scheduled sections at 30 Mb/s, typically an EIT schedule.
+    bool BenchPacketizer(bench::Options& opt)
+    {
+        static const size_t section_count = 50000;
+        static const size_t packet_count = 1000000;
+
+        ts::CyclingPacketizer pzer(0x0012, ts::CyclingPacketizer::AT_END, 30000000);
+
+        ts::NanoSecond start = bench::Now();
+        for (size_t i = 0; i < section_count; ++i) {
+            pzer.addSection(MakeSection(ts::TID(0x50 + i % 16), uint16_t(i / 256), uint8_t(i % 256)), 5000 + ts::MilliSecond(i % 5) * 1000);
+        }
+        const ts::NanoSecond add_duration = bench::Since(start);
+
+        start = bench::Now();
+        ts::TSPacket pkt;
+        size_t sections = 0;
+        for (size_t i = 0; i < packet_count; ++i) {
+            pzer.getNextPacket(pkt);
+            if (pkt.getPUSI()) {
+                sections++;
+            }
+        }
+        const ts::NanoSecond cycle_duration = bench::Since(start);
+
+        start = bench::Now();
+        for (ts::TID tid = 0x50; tid < 0x58; ++tid) {
+            pzer.removeSections(tid);
+        }
+        const ts::NanoSecond remove_duration = bench::Since(start);
+
+        std::cout << ts::UString::Format(u"add: %'d sections, %'d ns/section", {section_count, add_duration / ts::NanoSecond(section_count)}) << std::endl
+                  << ts::UString::Format(u"cycle: %'d packets, %'d sections, %'d ns/packet, %'d packets/s",
+                                         {packet_count, sections, cycle_duration / ts::NanoSecond(packet_count),
+                                          (ts::NanoSecond(packet_count) * ts::NanoSecPerSec) / cycle_duration}) << std::endl
+                  << ts::UString::Format(u"remove half: %'d us", {remove_duration / ts::NanoSecPerMicroSec}) << std::endl;
+
+        if (sections < section_count || pzer.storedSectionCount() != section_count / 2) {
+            opt.error(u"packetizer: %'d sections sent, %'d sections left", {sections, pzer.storedSectionCount()});
+            return false;
+        }
+        return true;
+    }
+}
+
+BENCH_REGISTER(u"packetizer", BenchPacketizer);
@@ -0,0 +1,143 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Benchmark of the TS packet readers.
+//
+//----------------------------------------------------------------------------
+
+#include "bench.h"
+#include "tsTSPacketReader.h"
+#include "tsNullReport.h"
+#include "tsSysUtils.h"
+TSDUCK_SOURCE;
+
+namespace {
+    // Read a file packet by packet on a binary stream, the previous method in the tools.
+    size_t ReadStream(const ts::UString& filename)
+    {
+        std::ifstream strm(filename.toUTF8().c_str(), std::ios::binary);
+        ts::TSPacket pkt;
+        size_t count = 0;
+        while (pkt.read(strm, true, NULLREP)) {
+            count++;
+        }
+        return count;
+    }
+
+    // Read a file packet by packet with a TSPacketReader.
+    size_t ReadPackets(const ts::UString& filename, ts::Report& report)
+    {
+        ts::TSPacketReader reader;
+        size_t count = 0;
+        if (reader.open(filename, report)) {
+            while (reader.read(report) != nullptr) {
+                count++;
+            }
+            reader.close(report);
+        }
+        return count;
+    }
+
+    // Read a file by blocks of packets with a TSPacketReader.
+    size_t ReadBlocks(const ts::UString& filename, ts::Report& report)
+    {
+        ts::TSPacketReader reader;
+        const ts::TSPacket* packets = nullptr;
+        size_t count = 0;
+        if (reader.open(filename, report)) {
+            for (size_t n; (n = reader.read(packets, ts::TSPacketReader::DEFAULT_BUFFER_SIZE, report)) > 0; ) {
+                count += n;
+            }
+            reader.close(report);
+        }
+        return count;
+    }
+
+    // Display the result of one reading method.
+    void Display(const ts::UString& title, size_t count, ts::NanoSecond duration)
+    {
+        std::cout << ts::UString::Format(u"%-18s: %'d packets, %'d us, %'d packets/s",
+                                         {title, count, duration / ts::NanoSecPerMicroSec,
+                                          (ts::NanoSecond(count) * ts::NanoSecPerSec) / duration})
+                  << std::endl;
+    }
+
+    // Compare the old and new ways of reading packets from a file.
+    bool BenchReader(bench::Options& opt)
+    {
+        static const size_t packet_count = 200000;
+
+        // Use the reference capture or create a file in the system cache.
+        ts::UString filename(opt.input);
+        if (filename.empty()) {
+            filename = ts::TempFile(u".ts");
+            ts::TSPacketVector packets(packet_count, ts::NullPacket);
+            std::ofstream file(filename.toUTF8().c_str(), std::ios::binary);
+            file.write(reinterpret_cast<const char*>(packets.data()), std::streamsize(packets.size() * ts::PKT_SIZE));
+            file.close();
+            if (!file) {
+                opt.error(u"error creating %s", {filename});
+                ts::DeleteFile(filename);
+                return false;
+            }
+        }
+        else {
+            // Load the reference capture in the system cache.
+            ReadBlocks(filename, opt);
+        }
+
+        ts::NanoSecond start = bench::Now();
+        const size_t stream_count = ReadStream(filename);
+        const ts::NanoSecond stream_time = bench::Since(start);
+
+        start = bench::Now();
+        const size_t packets_count = ReadPackets(filename, opt);
+        const ts::NanoSecond packets_time = bench::Since(start);
+
+        start = bench::Now();
+        const size_t blocks_count = ReadBlocks(filename, opt);
+        const ts::NanoSecond blocks_time = bench::Since(start);
+
+        if (opt.input.empty()) {
+            ts::DeleteFile(filename);
+        }
+
+        Display(u"istream", stream_count, stream_time);
+        Display(u"reader, packets", packets_count, packets_time);
+        Display(u"reader, blocks", blocks_count, blocks_time);
+
+        if (stream_count == 0 || packets_count != stream_count || blocks_count != stream_count) {
+            opt.error(u"reader: different packet counts");
+            return false;
+        }
+        return true;
+    }
+}
+
+BENCH_REGISTER(u"reader", BenchReader);
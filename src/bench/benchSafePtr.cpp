@@ -0,0 +1,125 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Benchmark of the reference counting of safe pointers.
+//
+//----------------------------------------------------------------------------
+
+#include "bench.h"
+#include "tsSafePtr.h"
+#include "tsMutex.h"
+#include "tsSectionDemux.h"
+#include "tsBinaryTable.h"
+#include "tsOneShotPacketizer.h"
+#include "tsPAT.h"
+TSDUCK_SOURCE;
+
+namespace {
+    // Time to create and delete two copies of a pointer, repeated.
+    template <class PTR>
+    ts::NanoSecond CopyTime(const PTR& ptr, size_t count)
+    {
+        const ts::NanoSecond start = bench::Now();
+        for (size_t i = 0; i < count; ++i) {
+            PTR p1(ptr);
+            PTR p2(p1);
+        }
+        return bench::Since(start);
+    }
+
+    // A table handler which keeps references to all sections, as applications usually do.
+    class PipelineHandler: public ts::TableHandlerInterface
+    {
+    public:
+        PipelineHandler() : sections(), tables(0) {}
+        std::vector<ts::SectionPtr> sections;
+        size_t tables;
+        virtual void handleTable(ts::SectionDemux&, const ts::BinaryTable& table) override
+        {
+            tables++;
+            for (size_t i = 0; i < table.sectionCount(); ++i) {
+                sections.push_back(table.sectionAt(i));
+            }
+        }
+    };
+
+    // Cost of pointer copies, alone and in a section demux pipeline.
+    bool BenchSafePtr(bench::Options& opt)
+    {
+        static const size_t copy_count = 10000000;
+        static const size_t packet_count = 1000000;
+
+        const ts::SafePtr<int, ts::NullMutex> pn(new int(1));
+        const ts::SafePtr<int, ts::Mutex> pm(new int(2));
+        const ts::NanoSecond null_time = CopyTime(pn, copy_count);
+        const ts::NanoSecond mutex_time = CopyTime(pm, copy_count);
+
+        // Section demux pipeline: all sections of all tables are referenced by the handler.
+        // Build PAT packets with all versions so that each packet is a new table.
+        ts::DuckContext duck;
+        ts::TSPacketVector packets;
+        for (uint8_t version = 0; version <= ts::SVERSION_MASK; ++version) {
+            ts::PAT pat(version, true, 1);
+            pat.pmts[100] = 1000;
+            pat.pmts[200] = 2000;
+            ts::OneShotPacketizer pzer(ts::PID_PAT);
+            ts::TSPacketVector pkts;
+            pzer.addTable(duck, pat);
+            pzer.getPackets(pkts);
+            packets.insert(packets.end(), pkts.begin(), pkts.end());
+        }
+
+        PipelineHandler handler;
+        ts::SectionDemux demux(duck, &handler);
+        demux.addPID(ts::PID_PAT);
+        const ts::NanoSecond start = bench::Now();
+        for (size_t i = 0; i < packet_count; ++i) {
+            ts::TSPacket& pkt(packets[i % packets.size()]);
+            pkt.setCC(uint8_t(i & ts::CC_MASK));
+            demux.feedPacket(pkt);
+            if (handler.sections.size() >= 64) {
+                handler.sections.clear();
+            }
+        }
+        const ts::NanoSecond pipeline_time = bench::Since(start);
+
+        std::cout << ts::UString::Format(u"copy with NullMutex: %'d ns", {null_time / ts::NanoSecond(copy_count)}) << std::endl
+                  << ts::UString::Format(u"copy with Mutex: %'d ns", {mutex_time / ts::NanoSecond(copy_count)}) << std::endl
+                  << ts::UString::Format(u"section pipeline: %'d packets, %'d tables, %'d ns/packet",
+                                         {packet_count, handler.tables, pipeline_time / ts::NanoSecond(packet_count)}) << std::endl;
+
+        if (pn.count() != 1 || pm.count() != 1 || handler.tables != packet_count) {
+            opt.error(u"safeptr: invalid reference counts or %'d tables", {handler.tables});
+            return false;
+        }
+        return true;
+    }
+}
+
+BENCH_REGISTER(u"safeptr", BenchSafePtr);
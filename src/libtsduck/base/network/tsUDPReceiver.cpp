@@ -307,6 +307,12 @@ bool ts::UDPReceiver::open(ts::Report& report)
         (_recv_timeout < 0 || setReceiveTimeout(_recv_timeout, report)) &&
         bind(local_addr, report);
 
+    // Kernel reception time stamps are optional, a failure is only a warning.
+    if (ok) {
+        // coverity[CHECKED_RETURN]
+        setReceiveTimestamps(true, report);
+    }
+
     // Optional SSM source address.
     IPAddress ssm_source;
     if (_use_ssm) {
@@ -344,85 +350,134 @@ bool ts::UDPReceiver::receive(void* data,
                               ts::SocketAddress& sender,
                               ts::SocketAddress& destination,
                               const ts::AbortInterface* abort,
-                              ts::Report& report)
+                              ts::Report& report,
+                              ts::NanoSecond* timestamp)
 {
     // Loop on packet reception until one matching filtering criteria is found.
     for (;;) {
 
         // Wait for a UDP message from the superclass.
-        if (!UDPSocket::receive(data, max_size, ret_size, sender, destination, abort, report)) {
+        if (!UDPSocket::receive(data, max_size, ret_size, sender, destination, abort, report, timestamp)) {
             return false;
         }
 
-        // Debug (level 2) message for each message.
-        if (report.maxSeverity() >= 2) {
-            // Prior report level checking to avoid evaluating parameters when not necessary.
-            report.log(2, u"received UDP packet, source: %s, destination: %s", {sender, destination});
+        // Return the message if it matches all criteria.
+        if (acceptMessage(sender, destination, report)) {
+            return true;
         }
+    }
+}
 
-        // Check the destination address to exclude packets from other streams.
-        // When several multicast streams use the same destination port and several
-        // applications on the same system listen to these distinct streams,
-        // the multicast MAC address management is such that any socket which
-        // is bound to the common port will receive the traffic for all streams.
-        // This is why we need to check the destination address and exclude
-        // packets which are not from the intended stream.
-        //
-        // We accept a packet in any of:
-        // 1) Actual packet destination is unknown. Probably, the system cannot
-        //    report the destination address.
-        // 2) We listen to a multicast address and the actual destination is the same.
-        // 3) If we listen to unicast traffic and the actual destination is unicast.
-        //    In that case, unicast is by definition sent to us.
-
-        if (destination.hasAddress() && ((_dest_addr.hasAddress() && destination != _dest_addr) || (!_dest_addr.hasAddress() && destination.isMulticast()))) {
-            // This is a spurious packet.
-            if (report.maxSeverity() >= Severity::Debug) {
-                // Prior report level checking to avoid evaluating parameters when not necessary.
-                report.debug(u"rejecting packet, destination: %s, expecting: %s", {destination, _dest_addr});
-            }
-            continue;
+
+//----------------------------------------------------------------------------
+// Receive several messages, return those matching the filtering criteria.
+//----------------------------------------------------------------------------
+
+bool ts::UDPReceiver::receive(Message* messages,
+                              size_t max_count,
+                              size_t& ret_count,
+                              const AbortInterface* abort,
+                              Report& report)
+{
+    // Loop on batch reception until at least one message matches the filtering criteria.
+    for (;;) {
+
+        // Wait for UDP messages from the superclass.
+        if (!UDPSocket::receive(messages, max_count, ret_count, abort, report)) {
+            return false;
         }
 
-        // Keep track of the first sender address.
-        if (!_first_source.hasAddress()) {
-            // First packet, keep address of the sender.
-            _first_source = sender;
-            _sources.insert(sender);
-
-            // With option --first-source, use this one to filter packets.
-            if (_use_first_source) {
-                assert(!_use_source.hasAddress());
-                _use_source = sender;
-                report.verbose(u"now filtering on source address %s", {sender});
+        // Empty the messages which do not match the filtering criteria.
+        bool found = false;
+        for (size_t i = 0; i < ret_count; ++i) {
+            if ((messages[i].size > 0 || messages[i].sender.hasAddress()) && acceptMessage(messages[i].sender, messages[i].destination, report)) {
+                found = true;
+            }
+            else {
+                messages[i].size = 0;
             }
         }
+        if (found) {
+            return true;
+        }
+    }
+}
 
-        // Keep track of senders (sources) to detect or filter multiple sources.
-        if (_sources.count(sender) == 0) {
-            // Detected an additional source, warn the user that distinct streams are potentially mixed.
-            // If no source filtering is applied, this is a warning since this may affect the resulting stream.
-            // With source filtering, this is just an informational verbose-level message.
-            const int level = _use_source.hasAddress() ? Severity::Verbose : Severity::Warning;
-            if (_sources.size() == 1) {
-                report.log(level, u"detected multiple sources for the same destination %s with potentially distinct streams", {destination});
-                report.log(level, u"detected source: %s", {_first_source});
-            }
-            report.log(level, u"detected source: %s", {sender});
-            _sources.insert(sender);
+
+//----------------------------------------------------------------------------
+// Check if a received message matches the filtering criteria.
+//----------------------------------------------------------------------------
+
+bool ts::UDPReceiver::acceptMessage(const SocketAddress& sender, const SocketAddress& destination, Report& report)
+{
+    // Debug (level 2) message for each message.
+    if (report.maxSeverity() >= 2) {
+        // Prior report level checking to avoid evaluating parameters when not necessary.
+        report.log(2, u"received UDP packet, source: %s, destination: %s", {sender, destination});
+    }
+
+    // Check the destination address to exclude packets from other streams.
+    // When several multicast streams use the same destination port and several
+    // applications on the same system listen to these distinct streams,
+    // the multicast MAC address management is such that any socket which
+    // is bound to the common port will receive the traffic for all streams.
+    // This is why we need to check the destination address and exclude
+    // packets which are not from the intended stream.
+    //
+    // We accept a packet in any of:
+    // 1) Actual packet destination is unknown. Probably, the system cannot
+    //    report the destination address.
+    // 2) We listen to a multicast address and the actual destination is the same.
+    // 3) If we listen to unicast traffic and the actual destination is unicast.
+    //    In that case, unicast is by definition sent to us.
+
+    if (destination.hasAddress() && ((_dest_addr.hasAddress() && destination != _dest_addr) || (!_dest_addr.hasAddress() && destination.isMulticast()))) {
+        // This is a spurious packet.
+        if (report.maxSeverity() >= Severity::Debug) {
+            // Prior report level checking to avoid evaluating parameters when not necessary.
+            report.debug(u"rejecting packet, destination: %s, expecting: %s", {destination, _dest_addr});
         }
+        return false;
+    }
 
-        // Filter packets based on source address if requested.
-        if (!sender.match(_use_source)) {
-            // Not the expected source, this is a spurious packet.
-            if (report.maxSeverity() >= Severity::Debug) {
-                // Prior report level checking to avoid evaluating parameters when not necessary.
-                report.debug(u"rejecting packet, source: %s, expecting: %s", {sender, _use_source});
-            }
-            continue;
+    // Keep track of the first sender address.
+    if (!_first_source.hasAddress()) {
+        // First packet, keep address of the sender.
+        _first_source = sender;
+        _sources.insert(sender);
+
+        // With option --first-source, use this one to filter packets.
+        if (_use_first_source) {
+            assert(!_use_source.hasAddress());
+            _use_source = sender;
+            report.verbose(u"now filtering on source address %s", {sender});
         }
+    }
 
-        // Now found a packet matching all criteria.
-        return true;
+    // Keep track of senders (sources) to detect or filter multiple sources.
+    if (_sources.count(sender) == 0) {
+        // Detected an additional source, warn the user that distinct streams are potentially mixed.
+        // If no source filtering is applied, this is a warning since this may affect the resulting stream.
+        // With source filtering, this is just an informational verbose-level message.
+        const int level = _use_source.hasAddress() ? Severity::Verbose : Severity::Warning;
+        if (_sources.size() == 1) {
+            report.log(level, u"detected multiple sources for the same destination %s with potentially distinct streams", {destination});
+            report.log(level, u"detected source: %s", {_first_source});
+        }
+        report.log(level, u"detected source: %s", {sender});
+        _sources.insert(sender);
+    }
+
+    // Filter packets based on source address if requested.
+    if (!sender.match(_use_source)) {
+        // Not the expected source, this is a spurious packet.
+        if (report.maxSeverity() >= Severity::Debug) {
+            // Prior report level checking to avoid evaluating parameters when not necessary.
+            report.debug(u"rejecting packet, source: %s, expecting: %s", {sender, _use_source});
+        }
+        return false;
     }
+
+    // Now found a packet matching all criteria.
+    return true;
 }
@@ -89,6 +89,12 @@ namespace ts {
                              SocketAddress& sender,
                              SocketAddress& destination,
                              const AbortInterface* abort = nullptr,
+                             Report& report = CERR,
+                             NanoSecond* timestamp = nullptr) override;
+        virtual bool receive(Message* messages,
+                             size_t max_count,
+                             size_t& ret_count,
+                             const AbortInterface* abort = nullptr,
                              Report& report = CERR) override;
 
     private:
@@ -106,5 +112,8 @@ namespace ts {
         SocketAddress           _use_source;         // Filter on this socket address of sender (can be a simple filter of an SSM source).
         SocketAddress           _first_source;       // Socket address of first received packet.
         std::set<SocketAddress> _sources;            // Set of all detected packet sources.
+
+        // Check if a received message matches the filtering criteria.
+        bool acceptMessage(const SocketAddress& sender, const SocketAddress& destination, Report& report);
     };
 }
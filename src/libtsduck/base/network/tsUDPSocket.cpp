@@ -33,13 +33,36 @@
 
 #include "tsUDPSocket.h"
 #include "tsNullReport.h"
+#include "tsMonotonic.h"
+#include "tsTime.h"
 TSDUCK_SOURCE;
 
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr size_t ts::UDPSocket::MAX_BATCH_MESSAGES;
+#endif
+
+// Size of the ancillary data buffer per message in batch receive operations.
+#define BATCH_ANCIL_SIZE 128
+
 // Furiously idiotic Windows feature, see comment in receiveOne()
 #if defined(TS_WINDOWS)
 volatile ::LPFN_WSARECVMSG ts::UDPSocket::_wsaRevcMsg = 0;
 #endif
 
+// Convert a kernel time stamp (CLOCK_REALTIME) into the reference of Monotonic::CurrentNanoSeconds().
+#if defined(TS_LINUX)
+namespace {
+    ts::NanoSecond KernelTimeStamp(const ::timespec& t, ts::NanoSecond offset)
+    {
+        return ts::NanoSecond(t.tv_sec) * ts::NanoSecPerSec + ts::NanoSecond(t.tv_nsec) + offset;
+    }
+    ts::NanoSecond KernelTimeOffset()
+    {
+        return ts::Monotonic::CurrentNanoSeconds() - ts::Time::UnixClockNanoSeconds(CLOCK_REALTIME);
+    }
+}
+#endif
+
 
 //----------------------------------------------------------------------------
 // Constructor
@@ -238,6 +261,27 @@ bool ts::UDPSocket::setBroadcast(bool on, Report& report)
 }
 
 
+//----------------------------------------------------------------------------
+// Enable or disable the reception time stamps of the datagrams.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::setReceiveTimestamps(bool on, Report& report)
+{
+#if defined(TS_LINUX)
+    // The kernel reception time of each UDP packet is returned in ancillary data.
+    // Actual socket option is an int.
+    int enable = int(on);
+    if (::setsockopt(getSocket(), SOL_SOCKET, SO_TIMESTAMPNS, TS_SOCKOPT_T(&enable), sizeof(enable)) != 0) {
+        report.warning(u"error setting socket SO_TIMESTAMPNS option: %s", {SocketErrorCodeMessage()});
+        return false;
+    }
+    return true;
+#else
+    return !on;
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Enable or disable the broadcast option, based on an IP address.
 //----------------------------------------------------------------------------
@@ -403,6 +447,59 @@ bool ts::UDPSocket::send(const void* data, size_t size, const SocketAddress& des
 }
 
 
+//----------------------------------------------------------------------------
+// Send several messages to the default destination address and port.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::send(const Message* messages, size_t count, Report& report)
+{
+#if defined(TS_LINUX)
+
+    ::sockaddr addr;
+    _default_destination.copy(addr);
+
+    ::mmsghdr hdr[MAX_BATCH_MESSAGES];
+    ::iovec vec[MAX_BATCH_MESSAGES];
+
+    while (count > 0) {
+
+        // Build the message headers for at most MAX_BATCH_MESSAGES messages.
+        const size_t batch = std::min(count, MAX_BATCH_MESSAGES);
+        TS_ZERO(hdr);
+        for (size_t i = 0; i < batch; ++i) {
+            vec[i].iov_base = messages[i].data;
+            vec[i].iov_len = messages[i].size;
+            hdr[i].msg_hdr.msg_name = &addr;
+            hdr[i].msg_hdr.msg_namelen = sizeof(addr);
+            hdr[i].msg_hdr.msg_iov = &vec[i];
+            hdr[i].msg_hdr.msg_iovlen = 1; // number of iovec structures
+        }
+
+        // Send the messages. Some messages may remain unsent, loop on them.
+        const int sent = ::sendmmsg(getSocket(), hdr, (unsigned int)(batch), 0);
+        if (sent <= 0) {
+            report.error(u"error sending UDP message: " + SocketErrorCodeMessage());
+            return false;
+        }
+        messages += sent;
+        count -= size_t(sent);
+    }
+    return true;
+
+#else
+
+    // No batch send, send messages one by one.
+    for (size_t i = 0; i < count; ++i) {
+        if (!send(messages[i].data, messages[i].size, _default_destination, report)) {
+            return false;
+        }
+    }
+    return true;
+
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Receive a message.
 // If abort interface is non-zero, invoke it when I/O is interrupted
@@ -416,13 +513,14 @@ bool ts::UDPSocket::receive(void* data,
                             SocketAddress& sender,
                             SocketAddress& destination,
                             const AbortInterface* abort,
-                            Report& report)
+                            Report& report,
+                            NanoSecond* timestamp)
 {
     // Loop on unsollicited interrupts
     for (;;) {
 
         // Wait for a message.
-        const SocketErrorCode err = receiveOne(data, max_size, ret_size, sender, destination, report);
+        const SocketErrorCode err = receiveOne(data, max_size, ret_size, sender, destination, timestamp, report);
 
         if (abort != nullptr && abort->aborting()) {
             // Aborting, no error message.
@@ -453,16 +551,147 @@ bool ts::UDPSocket::receive(void* data,
 }
 
 
+//----------------------------------------------------------------------------
+// Receive several messages.
+// Same error handling as receive() for one message.
+//----------------------------------------------------------------------------
+
+bool ts::UDPSocket::receive(Message* messages,
+                            size_t max_count,
+                            size_t& ret_count,
+                            const AbortInterface* abort,
+                            Report& report)
+{
+    ret_count = 0;
+
+    // Loop on unsollicited interrupts
+    while (max_count > 0) {
+
+        // Wait for at least one message.
+        const SocketErrorCode err = receiveBatch(messages, max_count, ret_count, report);
+
+        if (abort != nullptr && abort->aborting()) {
+            // Aborting, no error message.
+            return false;
+        }
+        else if (err == SYS_SUCCESS) {
+            // Sometimes, we get "successful" empty message coming from nowhere. Ignore them.
+            for (size_t i = 0; i < ret_count; ++i) {
+                if (messages[i].size > 0 || messages[i].sender.hasAddress()) {
+                    return true;
+                }
+            }
+        }
+        else if (abort != nullptr && abort->aborting()) {
+            // User-interrupt, end of processing but no error message
+            return false;
+        }
+#if !defined(TS_WINDOWS)
+        else if (err == EINTR) {
+            // Got a signal, not a user interrupt, will ignore it
+            report.debug(u"signal, not user interrupt");
+        }
+#endif
+        else {
+            // Abort on non-interrupt errors.
+            report.error(u"error receiving from UDP socket: %s", {SocketErrorCodeMessage(err)});
+            return false;
+        }
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Perform one receive operation for several messages.
+//----------------------------------------------------------------------------
+
+ts::SocketErrorCode ts::UDPSocket::receiveBatch(Message* messages, size_t max_count, size_t& ret_count, Report& report)
+{
+    ret_count = 0;
+
+#if defined(TS_LINUX)
+
+    // Linux implementation, use one recvmmsg() for several messages.
+    max_count = std::min(max_count, MAX_BATCH_MESSAGES);
+
+    ::mmsghdr hdr[MAX_BATCH_MESSAGES];
+    ::iovec vec[MAX_BATCH_MESSAGES];
+    ::sockaddr sender_sock[MAX_BATCH_MESSAGES];
+    uint8_t ancil_data[MAX_BATCH_MESSAGES][BATCH_ANCIL_SIZE];
+
+    TS_ZERO(hdr);
+    TS_ZERO(sender_sock);
+    TS_ZERO(ancil_data);
+
+    for (size_t i = 0; i < max_count; ++i) {
+        vec[i].iov_base = messages[i].data;
+        vec[i].iov_len = messages[i].max_size;
+        hdr[i].msg_hdr.msg_name = &sender_sock[i];
+        hdr[i].msg_hdr.msg_namelen = sizeof(sender_sock[i]);
+        hdr[i].msg_hdr.msg_iov = &vec[i];
+        hdr[i].msg_hdr.msg_iovlen = 1; // number of iovec structures
+        hdr[i].msg_hdr.msg_control = ancil_data[i];
+        hdr[i].msg_hdr.msg_controllen = sizeof(ancil_data[i]);
+    }
+
+    // Wait for the first message, then get all messages which are immediately available.
+    const int count = ::recvmmsg(getSocket(), hdr, (unsigned int)(max_count), MSG_WAITFORONE, nullptr);
+
+    if (count < 0) {
+        return LastSocketErrorCode();
+    }
+
+    // Offset between kernel time stamps and monotonic clock, computed once for all messages.
+    const NanoSecond offset = count > 0 ? KernelTimeOffset() : 0;
+
+    for (size_t i = 0; i < size_t(count); ++i) {
+        Message& msg(messages[i]);
+        msg.size = size_t(hdr[i].msg_len);
+        msg.sender = SocketAddress(sender_sock[i]);
+        msg.destination.clear();
+        msg.timestamp = 0;
+
+        // Browse returned ancillary data.
+        for (::cmsghdr* cmsg = CMSG_FIRSTHDR(&hdr[i].msg_hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(&hdr[i].msg_hdr, cmsg)) {
+            if (cmsg->cmsg_level == IPPROTO_IP && cmsg->cmsg_type == IP_PKTINFO && cmsg->cmsg_len >= sizeof(::in_pktinfo)) {
+                const ::in_pktinfo* info = reinterpret_cast<const ::in_pktinfo*>(CMSG_DATA(cmsg));
+                msg.destination = SocketAddress(info->ipi_addr, _local_address.port());
+            }
+            else if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS && cmsg->cmsg_len >= sizeof(::timespec)) {
+                msg.timestamp = KernelTimeStamp(*reinterpret_cast<const ::timespec*>(CMSG_DATA(cmsg)), offset);
+            }
+        }
+    }
+    ret_count = size_t(count);
+    return SYS_SUCCESS;
+
+#else
+
+    // Other systems, receive one message.
+    const SocketErrorCode err = receiveOne(messages[0].data, messages[0].max_size, messages[0].size, messages[0].sender, messages[0].destination, &messages[0].timestamp, report);
+    if (err == SYS_SUCCESS) {
+        ret_count = 1;
+    }
+    return err;
+
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Perform one receive operation. Hide the system mud.
 //----------------------------------------------------------------------------
 
-ts::SocketErrorCode ts::UDPSocket::receiveOne(void* data, size_t max_size, size_t& ret_size, SocketAddress& sender, SocketAddress& destination, Report& report)
+ts::SocketErrorCode ts::UDPSocket::receiveOne(void* data, size_t max_size, size_t& ret_size, SocketAddress& sender, SocketAddress& destination, NanoSecond* timestamp, Report& report)
 {
     // Clear returned values
     ret_size = 0;
     sender.clear();
     destination.clear();
+    if (timestamp != nullptr) {
+        *timestamp = 0;
+    }
 
     // Reserve a socket address to receive the sender address.
     ::sockaddr sender_sock;
@@ -568,6 +797,11 @@ ts::SocketErrorCode ts::UDPSocket::receiveOne(void* data, size_t max_size, size_
             const ::in_pktinfo* info = reinterpret_cast<const ::in_pktinfo*>(CMSG_DATA(cmsg));
             destination = SocketAddress(info->ipi_addr, _local_address.port());
         }
+#if defined(TS_LINUX)
+        else if (timestamp != nullptr && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS && cmsg->cmsg_len >= sizeof(::timespec)) {
+            *timestamp = KernelTimeStamp(*reinterpret_cast<const ::timespec*>(CMSG_DATA(cmsg)), KernelTimeOffset());
+        }
+#endif
     }
 
 #endif // Windows vs. UNIX
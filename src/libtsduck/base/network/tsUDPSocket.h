@@ -61,6 +61,42 @@ namespace ts {
         //!
         virtual ~UDPSocket();
 
+        //!
+        //! Maximum number of messages which are sent or received in one system call.
+        //! Batch operations on more messages are split into several system calls.
+        //!
+        static constexpr size_t MAX_BATCH_MESSAGES = 32;
+
+        //!
+        //! Description of one message in a batch of messages to send or receive.
+        //!
+        struct TSDUCKDLL Message
+        {
+            void*         data;         //!< Address of the message buffer.
+            size_t        max_size;     //!< Size in bytes of the message buffer (reception only).
+            size_t        size;         //!< Size in bytes of the message to send or of the received message.
+            SocketAddress sender;       //!< Socket address of the sender (reception only).
+            SocketAddress destination;  //!< Socket address of the message destination (reception only).
+            NanoSecond    timestamp;    //!< Reception time stamp, in the reference of Monotonic::CurrentNanoSeconds(), zero if unknown (reception only).
+
+            //!
+            //! Constructor.
+            //! @param [in] data_ Address of the message buffer.
+            //! @param [in] size_ Size in bytes of the message buffer.
+            //!
+            Message(void* data_ = nullptr, size_t size_ = 0) : data(data_), max_size(size_), size(size_), sender(), destination(), timestamp(0) {}
+            //! @cond nodoxygen
+            // Explicit default copy, required by -Weffc++ because of the pointer member.
+            Message(const Message&) = default;
+            Message& operator=(const Message&) = default;
+            //! @endcond
+        };
+
+        //!
+        //! Vector of messages.
+        //!
+        typedef std::vector<Message> MessageVector;
+
         //!
         //! Bind to a local address and port.
         //!
@@ -208,6 +244,18 @@ namespace ts {
         //!
         bool setBroadcastIfRequired(const IPAddress destination, Report& report = CERR);
 
+        //!
+        //! Enable or disable the reception time stamps of the datagrams.
+        //!
+        //! When enabled, the kernel reception time of each datagram is returned by receive().
+        //! This is currently supported on Linux only (SO_TIMESTAMPNS socket option). A failure
+        //! is not fatal for the socket, it is reported as a warning.
+        //! @param [in] on If true, the reception time stamps are activated on the socket.
+        //! @param [in,out] report Where to report warnings.
+        //! @return True on success, false on error or if not supported on this platform.
+        //!
+        bool setReceiveTimestamps(bool on, Report& report = CERR);
+
         //!
         //! Join a multicast group.
         //!
@@ -302,6 +350,9 @@ namespace ts {
         //! @param [in] abort If non-zero, invoked when I/O is interrupted
         //! (in case of user-interrupt, return, otherwise retry).
         //! @param [in,out] report Where to report error.
+        //! @param [out] timestamp If not null, receive the reception time stamp of the message, in nanoseconds,
+        //! in the reference of Monotonic::CurrentNanoSeconds(). On Linux, this is the time when the kernel
+        //! received the datagram (SO_TIMESTAMPNS). Zero when the time stamp is unknown.
         //! @return True on success, false on error.
         //!
         virtual bool receive(void* data,
@@ -310,6 +361,45 @@ namespace ts {
                              SocketAddress& sender,
                              SocketAddress& destination,
                              const AbortInterface* abort = nullptr,
+                             Report& report = CERR,
+                             NanoSecond* timestamp = nullptr);
+
+        //!
+        //! Send several messages to the default destination address and port.
+        //!
+        //! On Linux, several messages are sent in one single system call (sendmmsg).
+        //! On other systems, the messages are sent one by one.
+        //!
+        //! @param [in] messages Address of an array of messages to send. For each message, the
+        //! fields @a data and @a size are used. The content of the messages is not modified.
+        //! @param [in] count Number of messages to send.
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //!
+        virtual bool send(const Message* messages, size_t count, Report& report = CERR);
+
+        //!
+        //! Receive several messages in one operation.
+        //!
+        //! The method waits for at least one message and returns all messages which are
+        //! immediately available, up to @a max_count. On Linux, several messages are received
+        //! in one single system call (recvmmsg). On other systems, one message is returned.
+        //! Some returned messages may be empty, the caller shall ignore them.
+        //!
+        //! @param [in,out] messages Address of an array of messages. For each message, the fields
+        //! @a data and @a max_size are used as input. The fields @a size, @a sender, @a destination
+        //! and @a timestamp are returned for the first @a ret_count messages.
+        //! @param [in] max_count Number of messages in @a messages.
+        //! @param [out] ret_count Number of received messages.
+        //! @param [in] abort If non-zero, invoked when I/O is interrupted
+        //! (in case of user-interrupt, return, otherwise retry).
+        //! @param [in,out] report Where to report error.
+        //! @return True on success, false on error.
+        //!
+        virtual bool receive(Message* messages,
+                             size_t max_count,
+                             size_t& ret_count,
+                             const AbortInterface* abort = nullptr,
                              Report& report = CERR);
 
         // Implementation of Socket interface.
@@ -373,7 +463,10 @@ namespace ts {
         SSMReqSet     _ssmcast;  // Current set of source-specific multicast memberships
 
         // Perform one receive operation. Hide the system mud.
-        SocketErrorCode receiveOne(void* data, size_t max_size, size_t& ret_size, SocketAddress& sender, SocketAddress& destination, Report& report);
+        SocketErrorCode receiveOne(void* data, size_t max_size, size_t& ret_size, SocketAddress& sender, SocketAddress& destination, NanoSecond* timestamp, Report& report);
+
+        // Perform one receive operation for several messages.
+        SocketErrorCode receiveBatch(Message* messages, size_t max_count, size_t& ret_count, Report& report);
 
         // Furiously idiotic Windows feature, see comment in receiveOne()
 #if defined(TS_WINDOWS)
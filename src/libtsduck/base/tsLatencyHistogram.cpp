@@ -0,0 +1,247 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Lock-free histogram of latencies
+//
+//----------------------------------------------------------------------------
+
+#include "tsLatencyHistogram.h"
+#include <cmath>
+TSDUCK_SOURCE;
+
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr size_t ts::LatencyHistogram::SUB_BUCKET_BITS;
+constexpr size_t ts::LatencyHistogram::BUCKET_COUNT;
+#endif
+
+
+//----------------------------------------------------------------------------
+// Constructor.
+//----------------------------------------------------------------------------
+
+ts::LatencyHistogram::LatencyHistogram() :
+    _buckets(),
+    _count(0),
+    _sum(0),
+    _min(0),
+    _max(0),
+    _reset_request(0),
+    _reset_done(0)
+{
+    clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Bucket index of a value and highest value in a bucket.
+//----------------------------------------------------------------------------
+
+size_t ts::LatencyHistogram::BucketIndex(uint64_t value)
+{
+    if (value < (uint64_t(1) << SUB_BUCKET_BITS)) {
+        return size_t(value);
+    }
+
+    // Index of the most significant bit in value.
+#if defined(TS_GCC)
+    const size_t msb = 63 - size_t(__builtin_clzll(value));
+#else
+    size_t msb = SUB_BUCKET_BITS;
+    while ((value >> msb) > 1) {
+        msb++;
+    }
+#endif
+
+    // The sub-bucket is made of the bits which follow the most significant one.
+    const size_t sub = size_t(value >> (msb - SUB_BUCKET_BITS)) & ((1 << SUB_BUCKET_BITS) - 1);
+    return ((msb - SUB_BUCKET_BITS + 1) << SUB_BUCKET_BITS) + sub;
+}
+
+uint64_t ts::LatencyHistogram::BucketHighest(size_t index)
+{
+    if (index < (size_t(1) << SUB_BUCKET_BITS)) {
+        return index;
+    }
+    const size_t shift = (index >> SUB_BUCKET_BITS) - 1;
+    const uint64_t lowest = ((uint64_t(1) << SUB_BUCKET_BITS) + (index & ((1 << SUB_BUCKET_BITS) - 1))) << shift;
+    return lowest + ((uint64_t(1) << shift) - 1);
+}
+
+
+//----------------------------------------------------------------------------
+// Record a value in the histogram (writer thread only).
+//----------------------------------------------------------------------------
+
+void ts::LatencyHistogram::add(NanoSecond value)
+{
+    // Process a pending reset from another thread.
+    const uint32_t request = _reset_request.load(std::memory_order_acquire);
+    if (request != _reset_done.load(std::memory_order_relaxed)) {
+        clear();
+        _reset_done.store(request, std::memory_order_release);
+    }
+
+    // Only this thread modifies the histogram, no need for atomic read-modify-write operations.
+    const uint64_t val = value < 0 ? 0 : uint64_t(value);
+    std::atomic<uint64_t>& bucket(_buckets[BucketIndex(val)]);
+    bucket.store(bucket.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+    const uint64_t count = _count.load(std::memory_order_relaxed);
+    if (count == 0 || val < _min.load(std::memory_order_relaxed)) {
+        _min.store(val, std::memory_order_relaxed);
+    }
+    if (val > _max.load(std::memory_order_relaxed)) {
+        _max.store(val, std::memory_order_relaxed);
+    }
+    _sum.store(_sum.load(std::memory_order_relaxed) + val, std::memory_order_relaxed);
+    _count.store(count + 1, std::memory_order_relaxed);
+}
+
+
+//----------------------------------------------------------------------------
+// Reset the content of the histogram.
+//----------------------------------------------------------------------------
+
+void ts::LatencyHistogram::reset()
+{
+    // The actual cleanup is done by the writer thread.
+    _reset_request.fetch_add(1, std::memory_order_acq_rel);
+}
+
+void ts::LatencyHistogram::clear()
+{
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        _buckets[i].store(0, std::memory_order_relaxed);
+    }
+    _count.store(0, std::memory_order_relaxed);
+    _sum.store(0, std::memory_order_relaxed);
+    _min.store(0, std::memory_order_relaxed);
+    _max.store(0, std::memory_order_relaxed);
+}
+
+
+//----------------------------------------------------------------------------
+// Accessors, from any thread.
+//----------------------------------------------------------------------------
+
+uint64_t ts::LatencyHistogram::count() const
+{
+    return resetPending() ? 0 : _count.load(std::memory_order_relaxed);
+}
+
+ts::NanoSecond ts::LatencyHistogram::minimum() const
+{
+    return resetPending() ? 0 : NanoSecond(_min.load(std::memory_order_relaxed));
+}
+
+ts::NanoSecond ts::LatencyHistogram::maximum() const
+{
+    return resetPending() ? 0 : NanoSecond(_max.load(std::memory_order_relaxed));
+}
+
+ts::NanoSecond ts::LatencyHistogram::mean() const
+{
+    const uint64_t count = _count.load(std::memory_order_relaxed);
+    return resetPending() || count == 0 ? 0 : NanoSecond(_sum.load(std::memory_order_relaxed) / count);
+}
+
+
+//----------------------------------------------------------------------------
+// Get a percentile of the recorded values.
+//----------------------------------------------------------------------------
+
+ts::NanoSecond ts::LatencyHistogram::percentile(double percent) const
+{
+    if (resetPending()) {
+        return 0;
+    }
+
+    // Use the sum of the buckets, not _count, to be consistent if the writer is updating the histogram.
+    uint64_t total = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        total += _buckets[i].load(std::memory_order_relaxed);
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    // Rank of the requested value, from 1 to total.
+    percent = std::max(0.0, std::min(100.0, percent));
+    const uint64_t rank = std::max<uint64_t>(1, uint64_t(std::ceil(percent * double(total) / 100.0)));
+
+    uint64_t cumul = 0;
+    for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+        cumul += _buckets[i].load(std::memory_order_relaxed);
+        if (cumul >= rank) {
+            // Don't report more than the actual maximum.
+            return NanoSecond(std::min(BucketHighest(i), _max.load(std::memory_order_relaxed)));
+        }
+    }
+    return maximum();
+}
+
+
+//----------------------------------------------------------------------------
+// Format a duration in a short human-readable form.
+//----------------------------------------------------------------------------
+
+ts::UString ts::LatencyHistogram::FormatDuration(NanoSecond value)
+{
+    if (value < 10 * NanoSecPerMicroSec) {
+        return UString::Format(u"%'d ns", {value});
+    }
+    else if (value < 10 * NanoSecPerMilliSec) {
+        return UString::Format(u"%'d us", {value / NanoSecPerMicroSec});
+    }
+    else {
+        return UString::Format(u"%'d ms", {value / NanoSecPerMilliSec});
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Implementation of StringifyInterface.
+//----------------------------------------------------------------------------
+
+ts::UString ts::LatencyHistogram::toString() const
+{
+    const uint64_t cnt = count();
+    if (cnt == 0) {
+        return u"no data";
+    }
+    return UString::Format(u"count: %'d, min: %s, mean: %s, p50: %s, p90: %s, p99: %s, p99.9: %s, max: %s",
+                           {cnt,
+                            FormatDuration(minimum()),
+                            FormatDuration(mean()),
+                            FormatDuration(percentile(50.0)),
+                            FormatDuration(percentile(90.0)),
+                            FormatDuration(percentile(99.0)),
+                            FormatDuration(percentile(99.9)),
+                            FormatDuration(maximum())});
+}
@@ -0,0 +1,153 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Lock-free histogram of latencies
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsStringifyInterface.h"
+#include "tsUString.h"
+#include <atomic>
+
+namespace ts {
+    //!
+    //! Lock-free histogram of latencies, in nanoseconds.
+    //! @ingroup system
+    //!
+    //! The histogram uses logarithmic buckets with a fixed number of linear sub-buckets
+    //! per power of two, in the style of HDR histograms. With 8 sub-buckets per power
+    //! of two, the relative error on all reported values is at most 12.5%, on any range
+    //! of values from one nanosecond to centuries.
+    //!
+    //! The histogram is designed to be updated by one single thread, typically in the
+    //! packet path of a plugin thread, and read by any other thread at any time. Recording
+    //! a value is a few relaxed atomic operations, without lock and without system call.
+    //! All accesses from reading threads are also lock-free. The reported values are
+    //! consistent with a small error margin when the histogram is read while being updated.
+    //!
+    class TSDUCKDLL LatencyHistogram: public StringifyInterface
+    {
+        TS_NOCOPY(LatencyHistogram);
+    public:
+        //!
+        //! Default constructor.
+        //!
+        LatencyHistogram();
+
+        //!
+        //! Number of bits in the linear sub-buckets of each power of two.
+        //!
+        static constexpr size_t SUB_BUCKET_BITS = 3;
+
+        //!
+        //! Number of buckets in the histogram.
+        //!
+        static constexpr size_t BUCKET_COUNT = (65 - SUB_BUCKET_BITS) << SUB_BUCKET_BITS;
+
+        //!
+        //! Record a value in the histogram.
+        //! Must be called from one single thread, the writer of the histogram.
+        //! @param [in] value The value to record, in nanoseconds. Negative values are recorded as zero.
+        //!
+        void add(NanoSecond value);
+
+        //!
+        //! Reset the content of the histogram.
+        //! This method can be called from any thread. If called from another thread than the
+        //! writer, the histogram appears empty immediately and is actually cleared by the
+        //! writer on the next recorded value.
+        //!
+        void reset();
+
+        //!
+        //! Get the number of recorded values.
+        //! @return The number of recorded values.
+        //!
+        uint64_t count() const;
+
+        //!
+        //! Get the minimum recorded value.
+        //! @return The minimum recorded value in nanoseconds or zero if the histogram is empty.
+        //!
+        NanoSecond minimum() const;
+
+        //!
+        //! Get the maximum recorded value.
+        //! @return The maximum recorded value in nanoseconds or zero if the histogram is empty.
+        //!
+        NanoSecond maximum() const;
+
+        //!
+        //! Get the mean value of all recorded values.
+        //! @return The mean value in nanoseconds or zero if the histogram is empty.
+        //!
+        NanoSecond mean() const;
+
+        //!
+        //! Get a percentile of the recorded values.
+        //! @param [in] percent The percentile, from 0.0 to 100.0.
+        //! @return The highest value which is equivalent, in the histogram precision, to the
+        //! @a percent percentile of all recorded values, in nanoseconds. Zero if the histogram is empty.
+        //!
+        NanoSecond percentile(double percent) const;
+
+        //!
+        //! Format a duration in nanoseconds in a short human-readable form with a unit.
+        //! @param [in] value A duration in nanoseconds.
+        //! @return A string such as "850 ns", "1,234 us" or "12 ms".
+        //!
+        static UString FormatDuration(NanoSecond value);
+
+        // Implementation of StringifyInterface.
+        virtual UString toString() const override;
+
+    private:
+        // All fields are written by the writer thread only.
+        // The reset generations are used to let the writer clear the histogram.
+        std::atomic<uint64_t> _buckets[BUCKET_COUNT];
+        std::atomic<uint64_t> _count;
+        std::atomic<uint64_t> _sum;
+        std::atomic<uint64_t> _min;
+        std::atomic<uint64_t> _max;
+        std::atomic<uint32_t> _reset_request;  // Incremented by reset().
+        std::atomic<uint32_t> _reset_done;     // Set by the writer to the last processed reset request.
+
+        // Check if the histogram is being reset.
+        bool resetPending() const { return _reset_request.load(std::memory_order_acquire) != _reset_done.load(std::memory_order_acquire); }
+
+        // Clear all data, in the writer thread.
+        void clear();
+
+        // Get the bucket index of a value and the highest value in a bucket.
+        static size_t BucketIndex(uint64_t value);
+        static uint64_t BucketHighest(size_t index);
+    };
+}
@@ -231,3 +231,28 @@ ts::NanoSecond ts::Monotonic::SetPrecision(const NanoSecond& requested)
     #error "Unimplemented operating system"
 #endif
 }
+
+
+//----------------------------------------------------------------------------
+// Get the current value of a system-wide monotonic clock, in nano-seconds.
+//----------------------------------------------------------------------------
+
+ts::NanoSecond ts::Monotonic::CurrentNanoSeconds()
+{
+#if defined(TS_WINDOWS)
+
+    // Use the performance counter. Split the computation to avoid overflows.
+    ::LARGE_INTEGER count, freq;
+    if (!::QueryPerformanceCounter(&count) || !::QueryPerformanceFrequency(&freq) || freq.QuadPart <= 0) {
+        throw MonotonicError(u"cannot get system performance counter");
+    }
+    return (count.QuadPart / freq.QuadPart) * NanoSecPerSec + ((count.QuadPart % freq.QuadPart) * NanoSecPerSec) / freq.QuadPart;
+
+#elif defined(TS_UNIX)
+
+    return Time::UnixClockNanoSeconds(CLOCK_MONOTONIC);
+
+#else
+    #error "Unimplemented operating system"
+#endif
+}
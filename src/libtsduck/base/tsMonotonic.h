@@ -185,6 +185,15 @@ namespace ts {
         //!
         static NanoSecond SetPrecision(const NanoSecond& precision);
 
+        //!
+        //! Get the current value of a system-wide monotonic clock, in nano-seconds.
+        //! The origin of the clock is unspecified, only differences between two values
+        //! are meaningful. This static method is cheaper than the creation of a Monotonic
+        //! object since it does not allocate any system timer.
+        //! @return The current value of the monotonic clock in nano-seconds.
+        //!
+        static NanoSecond CurrentNanoSeconds();
+
     private:
         // Monotonic clock value in system ticks
         int64_t _value;
@@ -38,8 +38,18 @@
 #include "tsGuard.h"
 #include "tsMutex.h"
 #include "tsNullMutex.h"
+#include <atomic>
 
 namespace ts {
+
+    //! @cond nodoxygen
+    // Storage of the internal state of a SafePtr: plain values with NullMutex, atomic values otherwise.
+    template <class MUTEX, typename V>
+    struct SafePtrValue { typedef std::atomic<V> type; };
+    template <typename V>
+    struct SafePtrValue<NullMutex, V> { typedef V type; };
+    //! @endcond
+
     //!
     //!  Template safe pointer (reference-counted, auto-delete, thread-safe).
     //!  @ingroup cpp
@@ -74,17 +84,21 @@ namespace ts {
     //!  pointer is a null pointer, use the method @c isNull(). Do not
     //!  use comparisons such as <code>p == nullptr</code>, the result will be incorrect.
     //!
-    //!  The ts::SafePtr template class can be made thread-safe using a mutex.
-    //!  The type of mutex to use is given by the template parameter @a MUTEX
-    //!  which must be a subclass of ts::MutexInterface. By default,
+    //!  The ts::SafePtr template class can be made thread-safe using the template
+    //!  parameter @a MUTEX which must be a subclass of ts::MutexInterface. By default,
     //!  ts::NullMutex is used. The default implementation is consequently
     //!  not thread-safe but there is no synchronization overhead. To use
     //!  safe pointers in a multi-thread environment, specify an actual
-    //!  mutex implementation for the target environment.
+    //!  mutex class such as ts::Mutex.
+    //!
+    //!  The mutex class only selects the implementation at compile time. No mutex
+    //!  is actually locked: with ts::NullMutex, the reference counter and the pointer
+    //!  are plain values; with any other mutex class, they are atomic values and the
+    //!  reference counting uses lock-free atomic operations.
     //!
     //!  @tparam T The type of the pointed object. Cannot be an array type.
-    //!  @tparam MUTEX A subclass of ts::MutexInterface which is used to
-    //!  synchronize access to the safe pointer internal state.
+    //!  @tparam MUTEX A subclass of ts::MutexInterface which indicates if the
+    //!  safe pointer internal state shall be thread-safe.
     //!
     template <typename T, class MUTEX = NullMutex>
     class SafePtr
@@ -474,27 +488,49 @@ namespace ts {
         {
             TS_NOBUILD_NOCOPY(SafePtrShared);
         private:
-            // Private members:
-            T*    _ptr;        // pointer to actual object
-            int   _ref_count;  // reference counter
-            MUTEX _mutex;      // protect the SafePtrShared
+            // Private members, atomic values unless MUTEX is NullMutex.
+            typename SafePtrValue<MUTEX,T*>::type _ptr;        // pointer to actual object
+            typename SafePtrValue<MUTEX,int>::type _ref_count; // reference counter
+
+            // Operations on the private members, plain or atomic versions.
+            static T* Load(T* var) { return var; }
+            static T* Load(const std::atomic<T*>& var) { return var.load(std::memory_order_acquire); }
+            static T* Exchange(T*& var, T* value) { T* previous = var; var = value; return previous; }
+            static T* Exchange(std::atomic<T*>& var, T* value) { return var.exchange(value, std::memory_order_acq_rel); }
+            static bool CompareExchange(T*& var, T* expected, T* value) { const bool ok = var == expected; if (ok) { var = value; } return ok; }
+            static bool CompareExchange(std::atomic<T*>& var, T* expected, T* value) { return var.compare_exchange_strong(expected, value, std::memory_order_acq_rel); }
+            static int Load(int var) { return var; }
+            static int Load(const std::atomic<int>& var) { return var.load(std::memory_order_relaxed); }
+            static void Increment(int& var) { ++var; }
+            static void Increment(std::atomic<int>& var) { var.fetch_add(1, std::memory_order_relaxed); }
+            // GCC cannot see that a shared object is deleted only when its last reference
+            // is released and reports a use after free when two copies are released in a row.
+            TS_PUSH_WARNING()
+            TS_GCC_NOWARNING(use-after-free)
+            static int Decrement(int& var) { return --var; }
+            TS_POP_WARNING()
+            static int Decrement(std::atomic<int>& var) { return var.fetch_sub(1, std::memory_order_acq_rel) - 1; }
 
         public:
             // Constructor. Initial reference count is 1.
-            SafePtrShared(T* p) : _ptr(p), _ref_count(1), _mutex() {}
+            SafePtrShared(T* p) : _ptr(p), _ref_count(1) {}
 
             // Destructor. Deallocate actual object (if any).
             ~SafePtrShared();
 
             // Same semantics as SafePtr counterparts:
-            T* release();
+            T* release() { return Exchange(_ptr, nullptr); }
             void reset(T* p);
-            T* pointer();
-            int count();
-            bool isNull();
+            T* pointer() const { return Load(_ptr); }
+            int count() const { return Load(_ref_count); }
+            bool isNull() const { return Load(_ptr) == nullptr; }
 
             // Increment reference count and return this.
-            SafePtrShared* attach();
+            SafePtrShared* attach()
+            {
+                Increment(_ref_count);
+                return this;
+            }
 
             // Decrement reference count and deallocate this if needed.
             // Return true if deleted, false otherwise.
@@ -509,11 +545,12 @@ namespace ts {
             // Perform a class downcast (cast to a subclass).
             template <typename ST> SafePtr<ST,MUTEX> downcast()
             {
-                Guard lock(_mutex);
-                ST* sp = dynamic_cast<ST*>(_ptr);
-                if (sp != nullptr) {
-                    // Successful downcast, the original safe pointer must be released.
-                    _ptr = nullptr;
+                T* const p = Load(_ptr);
+                ST* sp = dynamic_cast<ST*>(p);
+                // Successful downcast, the original safe pointer must be released.
+                // If the pointer was concurrently modified, the downcast fails.
+                if (sp != nullptr && !CompareExchange(_ptr, p, nullptr)) {
+                    sp = nullptr;
                 }
                 return SafePtr<ST,MUTEX>(sp);
             }
@@ -521,19 +558,13 @@ namespace ts {
             // Perform a class upcast.
             template <typename ST> SafePtr<ST,MUTEX> upcast()
             {
-                Guard lock(_mutex);
-                ST* sp = _ptr;
-                _ptr = nullptr;
-                return SafePtr<ST,MUTEX>(sp);
+                return SafePtr<ST,MUTEX>(Exchange(_ptr, nullptr));
             }
 
             // Change mutex type.
             template <typename NEWMUTEX> SafePtr<T,NEWMUTEX> changeMutex()
             {
-                Guard lock(_mutex);
-                T* sp = _ptr;
-                _ptr = nullptr;
-                return SafePtr<T,NEWMUTEX>(sp);
+                return SafePtr<T,NEWMUTEX>(Exchange(_ptr, nullptr));
             }
         };
 
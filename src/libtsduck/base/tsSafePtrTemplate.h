@@ -91,28 +91,13 @@ ts::SafePtr<T,MUTEX>& ts::SafePtr<T,MUTEX>::operator=(T* p)
 template <typename T, class MUTEX>
 ts::SafePtr<T,MUTEX>::SafePtrShared::~SafePtrShared()
 {
-    if (_ptr != nullptr) {
-        delete _ptr;
-        _ptr = nullptr;
+    T* const p = Exchange(_ptr, nullptr);
+    if (p != nullptr) {
+        delete p;
     }
 }
 
 
-//----------------------------------------------------------------------------
-// Sets the pointer value to 0 and returns its old value.
-// Do not deallocate the object.
-//----------------------------------------------------------------------------
-
-template <typename T, class MUTEX>
-T* ts::SafePtr<T,MUTEX>::SafePtrShared::release()
-{
-    Guard lock(_mutex);
-    T* previous = _ptr;
-    _ptr = nullptr;
-    return previous;
-}
-
-
 //----------------------------------------------------------------------------
 // Deallocate previous pointer and sets the pointer to specified value.
 //----------------------------------------------------------------------------
@@ -120,60 +105,10 @@ T* ts::SafePtr<T,MUTEX>::SafePtrShared::release()
 template <typename T, class MUTEX>
 void ts::SafePtr<T,MUTEX>::SafePtrShared::reset(T* p)
 {
-    Guard lock(_mutex);
-    if (_ptr != nullptr) {
-        delete _ptr;
+    T* const previous = Exchange(_ptr, p);
+    if (previous != nullptr) {
+        delete previous;
     }
-    _ptr = p;
-}
-
-
-//----------------------------------------------------------------------------
-// Get the pointer value.
-//----------------------------------------------------------------------------
-
-template <typename T, class MUTEX>
-T* ts::SafePtr<T,MUTEX>::SafePtrShared::pointer()
-{
-    Guard lock(_mutex);
-    return _ptr;
-}
-
-
-//----------------------------------------------------------------------------
-// Get the reference count value.
-//----------------------------------------------------------------------------
-
-template <typename T, class MUTEX>
-int ts::SafePtr<T,MUTEX>::SafePtrShared::count()
-{
-    Guard lock(_mutex);
-    return _ref_count;
-}
-
-
-//----------------------------------------------------------------------------
-// Check for null pointer on SafePtr object
-//----------------------------------------------------------------------------
-
-template <typename T, class MUTEX>
-bool ts::SafePtr<T,MUTEX>::SafePtrShared::isNull()
-{
-    Guard lock(_mutex);
-    return _ptr == nullptr;
-}
-
-
-//----------------------------------------------------------------------------
-// Increment reference count and return this.
-//----------------------------------------------------------------------------
-
-template <typename T, class MUTEX>
-typename ts::SafePtr<T,MUTEX>::SafePtrShared* ts::SafePtr<T,MUTEX>::SafePtrShared::attach()
-{
-    Guard lock(_mutex);
-    _ref_count++;
-    return this;
 }
 
 
@@ -185,12 +120,9 @@ typename ts::SafePtr<T,MUTEX>::SafePtrShared* ts::SafePtr<T,MUTEX>::SafePtrShare
 template <typename T, class MUTEX>
 bool ts::SafePtr<T,MUTEX>::SafePtrShared::detach()
 {
-    int refcount;
-    {
-        Guard lock(_mutex);
-        refcount = --_ref_count;
-    }
-    if (refcount == 0) {
+    // The acquire-release decrement ensures that all accesses to the object
+    // from other threads are complete before the last one deletes it.
+    if (Decrement(_ref_count) == 0) {
         delete this;
         return true;
     }
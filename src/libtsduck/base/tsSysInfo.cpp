@@ -35,6 +35,11 @@
 #include <sys/param.h>
 #include <sys/sysctl.h>
 #endif
+#if (defined(TS_I386) || defined(TS_X86_64)) && defined(TS_MSC)
+#include <intrin.h>
+#elif defined(TS_I386) || defined(TS_X86_64)
+#include <cpuid.h>
+#endif
 TSDUCK_SOURCE;
 
 // Define singleton instance
@@ -75,6 +80,8 @@ ts::SysInfo::SysInfo() :
 #else
     _isIntel64(false),
 #endif
+    _hasAESInstructions(false),
+    _hasCarryLessMultiply(false),
     _systemVersion(),
     _systemName(),
     _hostName(),
@@ -222,4 +229,57 @@ ts::SysInfo::SysInfo() :
     }
 
 #endif
+
+    //
+    // Get CPU features.
+    //
+#if defined(TS_I386) || defined(TS_X86_64)
+
+    // CPUID leaf 1, feature flags in ECX.
+#if defined(TS_MSC)
+    int regs[4];
+    ::__cpuid(regs, 1);
+    const uint32_t ecx = uint32_t(regs[2]);
+#else
+    unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+    ::__get_cpuid(1, &eax, &ebx, &ecx, &edx);
+#endif
+    _hasAESInstructions = (ecx & 0x02000000) != 0;    // bit 25
+    _hasCarryLessMultiply = (ecx & 0x00000002) != 0;  // bit 1
+
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Get the physical location of a set of logical CPUs.
+//----------------------------------------------------------------------------
+
+void ts::SysInfo::getCPULocations(std::vector<CPULocation>& locations, const std::set<size_t>& cpus) const
+{
+    locations.clear();
+    locations.reserve(cpus.size());
+
+    for (auto it = cpus.begin(); it != cpus.end(); ++it) {
+        CPULocation loc;
+        loc.cpu = *it;
+        loc.core = *it;
+        loc.package = 0;
+#if defined(TS_LINUX)
+        // The topology of each CPU is described in sysfs.
+        const UString dir(UString::Format(u"/sys/devices/system/cpu/cpu%d/topology/", {*it}));
+        UStringList lines;
+        if (UString::Load(lines, dir + u"core_id") && !lines.empty()) {
+            lines.front().toInteger(loc.core);
+        }
+        if (UString::Load(lines, dir + u"physical_package_id") && !lines.empty()) {
+            lines.front().toInteger(loc.package);
+        }
+#endif
+        locations.push_back(loc);
+    }
+
+    std::sort(locations.begin(), locations.end(), [](const CPULocation& a, const CPULocation& b) {
+        return a.package != b.package ? a.package < b.package : (a.core != b.core ? a.core < b.core : a.cpu < b.cpu);
+    });
 }
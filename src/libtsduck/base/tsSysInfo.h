@@ -93,6 +93,16 @@ namespace ts {
         //!
         bool isIntel64() const { return _isIntel64; }
         //!
+        //! Check if the CPU supports the AES instructions (AES-NI on Intel and AMD processors).
+        //! @return True if the CPU supports the AES instructions.
+        //!
+        bool hasAESInstructions() const { return _hasAESInstructions; }
+        //!
+        //! Check if the CPU supports the carry-less multiplication instruction (PCLMULQDQ on Intel and AMD processors).
+        //! @return True if the CPU supports the carry-less multiplication instruction.
+        //!
+        bool hasCarryLessMultiply() const { return _hasCarryLessMultiply; }
+        //!
         //! Get the operating system version.
         //! @return The operating system version.
         //!
@@ -113,6 +123,26 @@ namespace ts {
         //!
         size_t memoryPageSize() const { return _memoryPageSize; }
 
+        //!
+        //! Location of a logical CPU in the physical topology of the system.
+        //!
+        struct CPULocation
+        {
+            size_t cpu;      //!< Index of the logical CPU.
+            size_t core;     //!< Identifier of the physical core inside its package.
+            size_t package;  //!< Identifier of the physical package (socket).
+        };
+
+        //!
+        //! Get the physical location of a set of logical CPUs.
+        //! The topology is currently available on Linux only. On other systems,
+        //! all logical CPUs are reported as distinct cores in package zero.
+        //! @param [out] locations Locations of all CPUs in @a cpus, sorted by package, core and CPU index.
+        //! Consecutive logical CPUs with the same package and core are hardware threads of the same core.
+        //! @param [in] cpus Set of logical CPU indexes.
+        //!
+        void getCPULocations(std::vector<CPULocation>& locations, const std::set<size_t>& cpus) const;
+
     private:
         bool    _isLinux;
         bool    _isFedora;
@@ -123,6 +153,8 @@ namespace ts {
         bool    _isWindows;
         bool    _isIntel32;
         bool    _isIntel64;
+        bool    _hasAESInstructions;
+        bool    _hasCarryLessMultiply;
         UString _systemVersion;
         UString _systemName;
         UString _hostName;
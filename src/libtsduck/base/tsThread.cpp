@@ -35,6 +35,11 @@
 #include "tsIntegerUtils.h"
 TSDUCK_SOURCE;
 
+#if defined(TS_MAC)
+#include <mach/mach.h>
+#include <mach/thread_info.h>
+#endif
+
 
 //----------------------------------------------------------------------------
 // Default constructor (all attributes have their default values).
@@ -137,6 +142,69 @@ void ts::Thread::Yield()
 }
 
 
+//----------------------------------------------------------------------------
+// Set / get the CPU affinity of the current thread.
+//----------------------------------------------------------------------------
+
+bool ts::Thread::SetCPUAffinity(const ThreadAttributes::CPUSet& cpus)
+{
+#if defined(TS_WINDOWS)
+    ::DWORD_PTR mask = 0;
+    for (auto it = cpus.begin(); it != cpus.end(); ++it) {
+        if (*it < 8 * sizeof(mask)) {
+            mask |= ::DWORD_PTR(1) << *it;
+        }
+    }
+    return mask != 0 && ::SetThreadAffinityMask(::GetCurrentThread(), mask) != 0;
+#elif defined(TS_LINUX)
+    ::cpu_set_t set;
+    CPU_ZERO(&set);
+    for (auto it = cpus.begin(); it != cpus.end(); ++it) {
+        if (*it < CPU_SETSIZE) {
+            CPU_SET(*it, &set);
+        }
+    }
+    return CPU_COUNT(&set) > 0 && ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set) == 0;
+#else
+    // CPU affinity not supported.
+    return false;
+#endif
+}
+
+bool ts::Thread::GetCPUAffinity(ThreadAttributes::CPUSet& cpus)
+{
+    cpus.clear();
+#if defined(TS_WINDOWS)
+    ::DWORD_PTR process_mask = 0;
+    ::DWORD_PTR system_mask = 0;
+    if (::GetProcessAffinityMask(::GetCurrentProcess(), &process_mask, &system_mask) == 0) {
+        return false;
+    }
+    for (size_t i = 0; i < 8 * sizeof(process_mask); ++i) {
+        if ((process_mask & (::DWORD_PTR(1) << i)) != 0) {
+            cpus.insert(i);
+        }
+    }
+    return true;
+#elif defined(TS_LINUX)
+    ::cpu_set_t set;
+    CPU_ZERO(&set);
+    if (::pthread_getaffinity_np(::pthread_self(), sizeof(set), &set) != 0) {
+        return false;
+    }
+    for (size_t i = 0; i < CPU_SETSIZE; ++i) {
+        if (CPU_ISSET(i, &set)) {
+            cpus.insert(i);
+        }
+    }
+    return true;
+#else
+    // CPU affinity not supported.
+    return false;
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Get a copy of the attributes of the thread.
 //----------------------------------------------------------------------------
@@ -181,6 +249,53 @@ bool ts::Thread::isCurrentThread() const
 }
 
 
+//----------------------------------------------------------------------------
+// Get the CPU time which was used by this thread so far.
+//----------------------------------------------------------------------------
+
+ts::NanoSecond ts::Thread::cpuTime() const
+{
+    // Critical section on flags, the thread cannot be joined meanwhile.
+    Guard lock(_mutex);
+    if (!_started) {
+        return 0;
+    }
+
+#if defined(TS_WINDOWS)
+
+    // Times are reported in 100-nanosecond units.
+    ::FILETIME creation_time, exit_time, kernel_time, user_time;
+    if (!::GetThreadTimes(_handle, &creation_time, &exit_time, &kernel_time, &user_time)) {
+        return 0;
+    }
+    const uint64_t kernel = (uint64_t(kernel_time.dwHighDateTime) << 32) | kernel_time.dwLowDateTime;
+    const uint64_t user = (uint64_t(user_time.dwHighDateTime) << 32) | user_time.dwLowDateTime;
+    return NanoSecond(kernel + user) * 100;
+
+#elif defined(TS_MAC)
+
+    ::thread_basic_info_data_t info;
+    ::mach_msg_type_number_t count = THREAD_BASIC_INFO_COUNT;
+    if (::thread_info(::pthread_mach_thread_np(_pthread), THREAD_BASIC_INFO, ::thread_info_t(&info), &count) != KERN_SUCCESS) {
+        return 0;
+    }
+    return NanoSecond(info.user_time.seconds + info.system_time.seconds) * NanoSecPerSec +
+           NanoSecond(info.user_time.microseconds + info.system_time.microseconds) * NanoSecPerMicroSec;
+
+#else
+
+    // The CPU-time clock of the thread can be read from any thread.
+    ::clockid_t clock = 0;
+    ::timespec value;
+    if (::pthread_getcpuclockid(_pthread, &clock) != 0 || ::clock_gettime(clock, &value) != 0) {
+        return 0;
+    }
+    return NanoSecond(value.tv_sec) * NanoSecPerSec + NanoSecond(value.tv_nsec);
+
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Internal version of isCurrentThread(), bypass checks
 //----------------------------------------------------------------------------
@@ -353,6 +468,11 @@ bool ts::Thread::waitForTermination()
 
 void ts::Thread::mainWrapper()
 {
+    // The CPU affinity is applied by the thread itself. If it cannot be applied, run on any CPU.
+    if (!_attributes._cpus.empty()) {
+        SetCPUAffinity(_attributes._cpus);
+    }
+
     try {
         main();
     }
@@ -195,6 +195,15 @@ namespace ts {
         //!
         bool isCurrentThread() const;
 
+        //!
+        //! Get the CPU time which was used by this thread so far.
+        //! This method can be invoked from any thread.
+        //! @return The CPU time (user and system) of this thread in nanoseconds.
+        //! Return zero if the thread is not started or if the operating system
+        //! does not report the CPU time of the thread.
+        //!
+        NanoSecond cpuTime() const;
+
         //!
         //! This hook is invoked in the context of the thread.
         //!
@@ -211,6 +220,22 @@ namespace ts {
         //!
         static void Yield();
 
+        //!
+        //! Set the CPU affinity of the current thread.
+        //! @param [in] cpus Set of logical CPU indexes on which the current thread can run.
+        //! @return True on success, false on error or if the CPU affinity is not supported on this system.
+        //! @see ThreadAttributes::setCPUAffinity()
+        //!
+        static bool SetCPUAffinity(const ThreadAttributes::CPUSet& cpus);
+
+        //!
+        //! Get the CPU affinity of the current thread.
+        //! On Windows, this is the CPU affinity of the process.
+        //! @param [out] cpus Set of logical CPU indexes on which the current thread can run.
+        //! @return True on success, false on error or if the CPU affinity is not supported on this system.
+        //!
+        static bool GetCPUAffinity(ThreadAttributes::CPUSet& cpus);
+
     protected:
         //!
         //! Set the type name.
@@ -48,6 +48,11 @@ namespace ts {
         //!
         ThreadAttributes();
 
+        //!
+        //! A set of logical CPU indexes, starting at zero.
+        //!
+        typedef std::set<size_t> CPUSet;
+
         //!
         //! Set the stack size in bytes for the thread.
         //!
@@ -184,6 +189,39 @@ namespace ts {
             return _priority;
         }
 
+        //!
+        //! Set the CPU affinity for the thread.
+        //!
+        //! The thread will run only on the specified logical CPUs. Restricting a thread to a
+        //! set of CPUs avoids the migration of the thread and its working data across CPU
+        //! caches and, on NUMA systems, across memory nodes.
+        //!
+        //! The CPU affinity is currently implemented on Linux and Windows (on Windows, only the
+        //! first 64 CPUs can be used). On other systems, it is ignored. A CPU affinity which
+        //! cannot be applied is ignored and the thread runs on any CPU.
+        //!
+        //! @param [in] cpus Set of logical CPU indexes. When empty (the default), the thread
+        //! can run on any CPU which is allowed for the process.
+        //! @return A reference to this object.
+        //!
+        ThreadAttributes& setCPUAffinity(const CPUSet& cpus)
+        {
+            _cpus = cpus;
+            return *this;
+        }
+
+        //!
+        //! Get the CPU affinity for the thread.
+        //!
+        //! @return A constant reference to the set of logical CPU indexes for the thread.
+        //! When the set is empty, the thread can run on any CPU.
+        //! @see setCPUAffinity()
+        //!
+        const CPUSet& getCPUAffinity() const
+        {
+            return _cpus;
+        }
+
         //!
         //! Get the minimum priority for a thread in this context of the operating system.
         //! @return The minimum priority for a thread.
@@ -241,6 +279,7 @@ namespace ts {
         size_t _stackSize;
         bool _deleteWhenTerminated;
         int _priority;
+        CPUSet _cpus;
 
         //
         // These fields describe the operating system priority range.
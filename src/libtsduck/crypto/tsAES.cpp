@@ -14,10 +14,28 @@
 //----------------------------------------------------------------------------
 
 #include "tsAES.h"
+#include "tsSysInfo.h"
 TSDUCK_SOURCE;
 
 #define BYTE(x,n) (((x) >> (8 * (n))) & 255)
 
+// Number of blocks which are processed in parallel with AES instructions.
+#define AESNI_PARALLEL_BLOCKS 8
+
+// The AES instructions (AES-NI) are available on Intel and AMD processors only.
+// With GCC and LLVM, the intrinsics must be compiled for a specific target
+// because the rest of the code shall run on CPU's without AES instructions.
+#if defined(TS_I386) || defined(TS_X86_64)
+    #define TS_AES_INSTRUCTIONS 1
+    #include <wmmintrin.h>
+    #if defined(TS_GCC) || defined(TS_LLVM)
+        #define AESNI_FUNCTION __attribute__((target("aes,sse2")))
+    #else
+        #define AESNI_FUNCTION
+    #endif
+    TS_LLVM_NOWARNING(cast-align)
+#endif
+
 namespace {
 
     // The precomputed tables for AES:
@@ -1012,6 +1030,95 @@ namespace {
 }
 
 
+//----------------------------------------------------------------------------
+// Encryption and decryption using AES instructions.
+//----------------------------------------------------------------------------
+
+#if defined(TS_AES_INSTRUCTIONS)
+namespace {
+
+    // Load the scheduled keys, Nr+1 round keys.
+    AESNI_FUNCTION void LoadKeysNI(__m128i* rk, const uint8_t* keys, int Nr)
+    {
+        for (int r = 0; r <= Nr; ++r) {
+            rk[r] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys + 16 * r));
+        }
+    }
+
+    // Encrypt a sequence of blocks. Several blocks are ciphered in parallel to fill the CPU pipeline.
+    AESNI_FUNCTION void EncryptNI(const uint8_t* keys, int Nr, const uint8_t* in, uint8_t* out, size_t count)
+    {
+        __m128i rk[15];
+        LoadKeysNI(rk, keys, Nr);
+
+        while (count >= AESNI_PARALLEL_BLOCKS) {
+            __m128i b[AESNI_PARALLEL_BLOCKS];
+            for (size_t i = 0; i < AESNI_PARALLEL_BLOCKS; ++i) {
+                b[i] = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16 * i)), rk[0]);
+            }
+            for (int r = 1; r < Nr; ++r) {
+                for (size_t i = 0; i < AESNI_PARALLEL_BLOCKS; ++i) {
+                    b[i] = _mm_aesenc_si128(b[i], rk[r]);
+                }
+            }
+            for (size_t i = 0; i < AESNI_PARALLEL_BLOCKS; ++i) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16 * i), _mm_aesenclast_si128(b[i], rk[Nr]));
+            }
+            in += 16 * AESNI_PARALLEL_BLOCKS;
+            out += 16 * AESNI_PARALLEL_BLOCKS;
+            count -= AESNI_PARALLEL_BLOCKS;
+        }
+
+        for (; count > 0; --count) {
+            __m128i b = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)), rk[0]);
+            for (int r = 1; r < Nr; ++r) {
+                b = _mm_aesenc_si128(b, rk[r]);
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_aesenclast_si128(b, rk[Nr]));
+            in += 16;
+            out += 16;
+        }
+    }
+
+    // Decrypt a sequence of blocks. The scheduled decryption keys are the same as in the
+    // table-based implementation (equivalent inverse cipher), as expected by AESDEC.
+    AESNI_FUNCTION void DecryptNI(const uint8_t* keys, int Nr, const uint8_t* in, uint8_t* out, size_t count)
+    {
+        __m128i rk[15];
+        LoadKeysNI(rk, keys, Nr);
+
+        while (count >= AESNI_PARALLEL_BLOCKS) {
+            __m128i b[AESNI_PARALLEL_BLOCKS];
+            for (size_t i = 0; i < AESNI_PARALLEL_BLOCKS; ++i) {
+                b[i] = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 16 * i)), rk[0]);
+            }
+            for (int r = 1; r < Nr; ++r) {
+                for (size_t i = 0; i < AESNI_PARALLEL_BLOCKS; ++i) {
+                    b[i] = _mm_aesdec_si128(b[i], rk[r]);
+                }
+            }
+            for (size_t i = 0; i < AESNI_PARALLEL_BLOCKS; ++i) {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16 * i), _mm_aesdeclast_si128(b[i], rk[Nr]));
+            }
+            in += 16 * AESNI_PARALLEL_BLOCKS;
+            out += 16 * AESNI_PARALLEL_BLOCKS;
+            count -= AESNI_PARALLEL_BLOCKS;
+        }
+
+        for (; count > 0; --count) {
+            __m128i b = _mm_xor_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)), rk[0]);
+            for (int r = 1; r < Nr; ++r) {
+                b = _mm_aesdec_si128(b, rk[r]);
+            }
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_aesdeclast_si128(b, rk[Nr]));
+            in += 16;
+            out += 16;
+        }
+    }
+}
+#endif
+
+
 //----------------------------------------------------------------------------
 // Schedule a new key. If rounds is zero, the default is used.
 //----------------------------------------------------------------------------
@@ -1164,6 +1271,12 @@ bool ts::AES::setKeyImpl(const void* key_, size_t key_length, size_t rounds)
     *rk++ = *rrk++;
     *rk   = *rrk;
 
+    // Same scheduled keys as byte sequences, for AES instructions.
+    for (i = 0; i < 4 * (_Nr + 1); i++) {
+        PutUInt32(_eKB + 4 * i, _eK[i]);
+        PutUInt32(_dKB + 4 * i, _dK[i]);
+    }
+
     return true;
 }
 
@@ -1181,6 +1294,17 @@ bool ts::AES::encryptImpl(const void* plain, size_t plain_length, void* cipher,
     const uint8_t* pt = reinterpret_cast<const uint8_t*> (plain);
     uint8_t* ct = reinterpret_cast<uint8_t*> (cipher);
 
+    if (cipher_length != nullptr) {
+        *cipher_length = BLOCK_SIZE;
+    }
+
+#if defined(TS_AES_INSTRUCTIONS)
+    if (_aesni) {
+        EncryptNI(_eKB, _Nr, pt, ct, 1);
+        return true;
+    }
+#endif
+
     uint32_t s0, s1, s2, s3, t0, t1, t2, t3, *rk;
     int Nr, r;
 
@@ -1285,10 +1409,6 @@ bool ts::AES::encryptImpl(const void* plain, size_t plain_length, void* cipher,
         rk[3];
     PutUInt32 (ct+12, s3);
 
-    if (cipher_length != nullptr) {
-        *cipher_length = BLOCK_SIZE;
-    }
-
     return true;
 }
 
@@ -1306,6 +1426,17 @@ bool ts::AES::decryptImpl(const void* cipher, size_t cipher_length, void* plain,
     const uint8_t* ct = reinterpret_cast<const uint8_t*> (cipher);
     uint8_t* pt = reinterpret_cast<uint8_t*> (plain);
 
+    if (plain_length != nullptr) {
+        *plain_length = BLOCK_SIZE;
+    }
+
+#if defined(TS_AES_INSTRUCTIONS)
+    if (_aesni) {
+        DecryptNI(_dKB, _Nr, ct, pt, 1);
+        return true;
+    }
+#endif
+
     uint32_t s0, s1, s2, s3, t0, t1, t2, t3, *rk;
     int Nr, r;
 
@@ -1411,11 +1542,34 @@ bool ts::AES::decryptImpl(const void* cipher, size_t cipher_length, void* plain,
         rk[3];
     PutUInt32 (pt+12, s3);
 
-    if (plain_length != nullptr) {
-        *plain_length = BLOCK_SIZE;
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Encryption / decryption of several blocks in ECB mode.
+//----------------------------------------------------------------------------
+
+bool ts::AES::encryptBlocksImpl(const void* plain, void* cipher, size_t count)
+{
+#if defined(TS_AES_INSTRUCTIONS)
+    if (_aesni) {
+        EncryptNI(_eKB, _Nr, reinterpret_cast<const uint8_t*>(plain), reinterpret_cast<uint8_t*>(cipher), count);
+        return true;
     }
+#endif
+    return BlockCipher::encryptBlocksImpl(plain, cipher, count);
+}
 
-    return true;
+bool ts::AES::decryptBlocksImpl(const void* cipher, void* plain, size_t count)
+{
+#if defined(TS_AES_INSTRUCTIONS)
+    if (_aesni) {
+        DecryptNI(_dKB, _Nr, reinterpret_cast<const uint8_t*>(cipher), reinterpret_cast<uint8_t*>(plain), count);
+        return true;
+    }
+#endif
+    return BlockCipher::decryptBlocksImpl(cipher, plain, count);
 }
 
 
@@ -1426,8 +1580,23 @@ bool ts::AES::decryptImpl(const void* cipher, size_t cipher_length, void* plain,
 ts::AES::AES() :
     _Nr(0),
     _eK(),
-    _dK()
+    _dK(),
+    _aesni(false),
+    _eKB(),
+    _dKB()
+{
+    useAESInstructions(true);
+}
+
+
+//----------------------------------------------------------------------------
+// Enable or disable the AES instructions of the CPU.
+//----------------------------------------------------------------------------
+
+void ts::AES::useAESInstructions(bool on)
 {
+    // SysInfo never reports AES instructions on other CPU's than Intel and AMD.
+    _aesni = on && SysInfo::Instance()->hasAESInstructions();
 }
 
 
@@ -40,6 +40,9 @@ namespace ts {
     //! AES block cipher
     //! @ingroup crypto
     //!
+    //! When the CPU supports the AES instructions (AES-NI on Intel and AMD processors),
+    //! they are automatically used. Otherwise, a portable table-based implementation is used.
+    //!
     class TSDUCKDLL AES: public BlockCipher
     {
         TS_NOCOPY(AES);
@@ -62,15 +65,35 @@ namespace ts {
         virtual size_t maxRounds() const override;
         virtual size_t defaultRounds() const override;
 
+        //!
+        //! Check if this instance uses the AES instructions of the CPU.
+        //! @return True if the AES instructions of the CPU are used.
+        //!
+        bool usesAESInstructions() const { return _aesni; }
+
+        //!
+        //! Enable or disable the AES instructions of the CPU.
+        //! By default, they are used when the CPU supports them. Disabling them is
+        //! mostly useful to test or compare with the portable implementation.
+        //! @param [in] on If true, use the AES instructions if the CPU supports them.
+        //! If false, always use the portable implementation.
+        //!
+        void useAESInstructions(bool on);
+
     protected:
         // Implementation of BlockCipher interface:
         virtual bool setKeyImpl(const void* key, size_t key_length, size_t rounds) override;
         virtual bool encryptImpl(const void* plain, size_t plain_length, void* cipher, size_t cipher_maxsize, size_t* cipher_length) override;
         virtual bool decryptImpl(const void* cipher, size_t cipher_length, void* plain, size_t plain_maxsize, size_t* plain_length) override;
+        virtual bool encryptBlocksImpl(const void* plain, void* cipher, size_t count) override;
+        virtual bool decryptBlocksImpl(const void* cipher, void* plain, size_t count) override;
 
     private:
-        int      _Nr;     //!< Number of rounds
-        uint32_t _eK[60]; //!< Scheduled encryption keys
-        uint32_t _dK[60]; //!< Scheduled decryption keys
+        int      _Nr;       //!< Number of rounds
+        uint32_t _eK[60];   //!< Scheduled encryption keys
+        uint32_t _dK[60];   //!< Scheduled decryption keys
+        bool     _aesni;    //!< Use the AES instructions of the CPU
+        uint8_t  _eKB[240]; //!< Scheduled encryption keys, as byte sequence for AES instructions
+        uint8_t  _dKB[240]; //!< Scheduled decryption keys, as byte sequence for AES instructions
     };
 }
@@ -186,3 +186,65 @@ bool ts::BlockCipher::decryptInPlaceImpl(void* data, size_t data_length, size_t*
     const size_t plain_max_size = max_actual_length != nullptr ? *max_actual_length : data_length;
     return decryptImpl(cipher.data(), cipher.size(), data, plain_max_size, max_actual_length);
 }
+
+
+//----------------------------------------------------------------------------
+// Encrypt several consecutive blocks of data.
+//----------------------------------------------------------------------------
+
+bool ts::BlockCipher::encryptBlocks(const void* plain, void* cipher, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        if (!allowEncrypt()) {
+            return false;
+        }
+    }
+    return encryptBlocksImpl(plain, cipher, count);
+}
+
+bool ts::BlockCipher::encryptBlocksImpl(const void* plain, void* cipher, size_t count)
+{
+    const size_t bsize = blockSize();
+    const uint8_t* pt = reinterpret_cast<const uint8_t*>(plain);
+    uint8_t* ct = reinterpret_cast<uint8_t*>(cipher);
+
+    for (size_t i = 0; i < count; ++i) {
+        if (!encryptImpl(pt, bsize, ct, bsize, nullptr)) {
+            return false;
+        }
+        pt += bsize;
+        ct += bsize;
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Decrypt several consecutive blocks of data.
+//----------------------------------------------------------------------------
+
+bool ts::BlockCipher::decryptBlocks(const void* cipher, void* plain, size_t count)
+{
+    for (size_t i = 0; i < count; ++i) {
+        if (!allowDecrypt()) {
+            return false;
+        }
+    }
+    return decryptBlocksImpl(cipher, plain, count);
+}
+
+bool ts::BlockCipher::decryptBlocksImpl(const void* cipher, void* plain, size_t count)
+{
+    const size_t bsize = blockSize();
+    const uint8_t* ct = reinterpret_cast<const uint8_t*>(cipher);
+    uint8_t* pt = reinterpret_cast<uint8_t*>(plain);
+
+    for (size_t i = 0; i < count; ++i) {
+        if (!decryptImpl(ct, bsize, pt, bsize, nullptr)) {
+            return false;
+        }
+        ct += bsize;
+        pt += bsize;
+    }
+    return true;
+}
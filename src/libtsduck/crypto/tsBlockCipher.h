@@ -189,6 +189,36 @@ namespace ts {
         //!
         bool decryptInPlace(void* data, size_t data_length, size_t* max_actual_length = nullptr);
 
+        //!
+        //! Encrypt several consecutive blocks of data, without chaining.
+        //!
+        //! This is equivalent to encrypt() on each block of blockSize() bytes but some block
+        //! ciphers, such as AES, process several blocks in parallel. Each block counts as one
+        //! encryption in the usage of the current key. This method is typically used by cipher
+        //! chainings on their underlying block cipher.
+        //!
+        //! @param [in] plain Address of plain text.
+        //! @param [out] cipher Address of buffer for cipher text, with the same size as the plain text.
+        //! @param [in] count Number of blocks in @a plain and @a cipher.
+        //! @return True on success, false on error.
+        //!
+        bool encryptBlocks(const void* plain, void* cipher, size_t count);
+
+        //!
+        //! Decrypt several consecutive blocks of data, without chaining.
+        //!
+        //! This is equivalent to decrypt() on each block of blockSize() bytes but some block
+        //! ciphers, such as AES, process several blocks in parallel. Each block counts as one
+        //! decryption in the usage of the current key. This method is typically used by cipher
+        //! chainings on their underlying block cipher.
+        //!
+        //! @param [in] cipher Address of cipher text.
+        //! @param [out] plain Address of buffer for plain text, with the same size as the cipher text.
+        //! @param [in] count Number of blocks in @a cipher and @a plain.
+        //! @return True on success, false on error.
+        //!
+        bool decryptBlocks(const void* cipher, void* plain, size_t count);
+
         //!
         //! Get the number of times the current key was used for encryption.
         //! @return The number of times the current key was used for encryption.
@@ -314,6 +344,44 @@ namespace ts {
         //!
         virtual bool decryptInPlaceImpl(void* data, size_t data_length, size_t* max_actual_length);
 
+        //!
+        //! Encrypt several consecutive blocks of data (implementation of algorithm-specific part).
+        //! The default implementation is to call encryptImpl() on each block.
+        //! A subclass may provide a more efficient implementation.
+        //! @param [in] plain Address of plain text.
+        //! @param [out] cipher Address of buffer for cipher text.
+        //! @param [in] count Number of blocks in @a plain and @a cipher.
+        //! @return True on success, false on error.
+        //!
+        virtual bool encryptBlocksImpl(const void* plain, void* cipher, size_t count);
+
+        //!
+        //! Decrypt several consecutive blocks of data (implementation of algorithm-specific part).
+        //! The default implementation is to call decryptImpl() on each block.
+        //! A subclass may provide a more efficient implementation.
+        //! @param [in] cipher Address of cipher text.
+        //! @param [out] plain Address of buffer for plain text.
+        //! @param [in] count Number of blocks in @a cipher and @a plain.
+        //! @return True on success, false on error.
+        //!
+        virtual bool decryptBlocksImpl(const void* cipher, void* plain, size_t count);
+
+        //!
+        //! Check if encryption is allowed with the current key and count one encryption.
+        //! This is automatically done by encrypt() and encryptInPlace(). A subclass which
+        //! provides other encryption methods shall call it once per encrypted message.
+        //! @return True if encryption is allowed, false otherwise.
+        //!
+        bool allowEncrypt();
+
+        //!
+        //! Check if decryption is allowed with the current key and count one decryption.
+        //! This is automatically done by decrypt() and decryptInPlace(). A subclass which
+        //! provides other decryption methods shall call it once per decrypted message.
+        //! @return True if decryption is allowed, false otherwise.
+        //!
+        bool allowDecrypt();
+
     private:
         bool      _key_set;                // Current key successfully set.
         int       _cipher_id;              // Cipher identity (from application).
@@ -323,9 +391,5 @@ namespace ts {
         size_t    _key_decrypt_max;        // Maximum number of times a key should be used for decryption.
         ByteBlock _current_key;            // Current unscheduled key.
         BlockCipherAlertInterface* _alert; // Alert handler.
-
-        // Check if encryption or decryption is allowed. Increment counters.
-        bool allowEncrypt();
-        bool allowDecrypt();
     };
 }
@@ -53,7 +53,7 @@ namespace ts {
         //!
         //! Constructor.
         //!
-        CBC() : CipherChainingTemplate<CIPHER>(1, 1, 1) {}
+        CBC() : CipherChainingTemplate<CIPHER>(1, 1, CipherChaining::PARALLEL_BLOCKS) {}
 
         // Implementation of BlockCipher and CipherChaining interfaces.
         // For some reason, doxygen is unable to automatically inherit the
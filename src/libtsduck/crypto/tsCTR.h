@@ -87,11 +87,11 @@ namespace ts {
     private:
         size_t _counter_bits; // size in bits of the counter part.
 
-        // We need two work blocks.
-        // The first one contains the "input block" or counter.
-        // The second one contains the "output block", the encrypted counter.
-        // This private method increments the counter block.
-        bool incrementCounter();
+        // The work buffer contains two areas of PARALLEL_BLOCKS blocks each.
+        // The first one contains the "input blocks" or successive counters.
+        // The second one contains the "output blocks", the encrypted counters.
+        // This private method increments a counter block.
+        void incrementCounter(uint8_t* counter);
     };
 }
 
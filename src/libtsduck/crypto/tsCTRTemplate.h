@@ -37,7 +37,7 @@
 
 template<class CIPHER>
 ts::CTR<CIPHER>::CTR(size_t counter_bits) :
-    CipherChainingTemplate<CIPHER>(1, 1, 2),
+    CipherChainingTemplate<CIPHER>(1, 1, 2 * CipherChaining::PARALLEL_BLOCKS),
     _counter_bits(0)
 {
     setCounterBits(counter_bits);
@@ -86,29 +86,22 @@ void ts::CTR<CIPHER>::setCounterBits(size_t counter_bits)
 
 
 //----------------------------------------------------------------------------
-// Increment the counter in the first work block.
+// Increment a counter block.
 //----------------------------------------------------------------------------
 
 template<class CIPHER>
-bool ts::CTR<CIPHER>::incrementCounter()
+void ts::CTR<CIPHER>::incrementCounter(uint8_t* counter)
 {
-    // We must have two work blocks.
-    if (this->work.size() < 2 * this->block_size) {
-        return false;
-    }
-
     size_t bits = _counter_bits;
     bool carry = true; // initial increment.
 
-    // The first work block contains the "input block" or counter to increment.
-    for (uint8_t* b = this->work.data() + this->block_size - 1; carry && bits > 0 && b > this->work.data(); --b) {
+    for (uint8_t* b = counter + this->block_size - 1; carry && bits > 0 && b > counter; --b) {
         const size_t bits_in_byte = std::min<size_t>(bits, 8);
         bits -= bits_in_byte;
         const uint8_t mask = uint8_t(0xFF >> (8 - bits_in_byte));
         *b = (*b & ~mask) | (((*b & mask) + 1) & mask);
         carry = (*b & mask) == 0x00;
     }
-    return true;
 }
 
 
@@ -130,30 +123,43 @@ bool ts::CTR<CIPHER>::encryptImpl(const void* plain, size_t plain_length, void*
         *cipher_length = plain_length;
     }
 
-    // work[0] = iv
-    ::memcpy(this->work.data(), this->iv.data(), this->block_size);
+    // The work buffer contains the counters, followed by the encrypted counters.
+    const size_t max_blocks = this->work.size() / (2 * this->block_size);
+    uint8_t* const counters = this->work.data();
+    uint8_t* const output = counters + max_blocks * this->block_size;
 
-    // Loop on all blocks, including last truncated one.
+    // counters[0] = iv
+    ::memcpy(counters, this->iv.data(), this->block_size);
+
+    // Loop on all blocks, including last truncated one, several blocks at a time.
 
     const uint8_t* pt = reinterpret_cast<const uint8_t*>(plain);
     uint8_t* ct = reinterpret_cast<uint8_t*>(cipher);
 
     while (plain_length > 0) {
-        // work[1] = encrypt(work[0])
-        if (!this->algo->encrypt(this->work.data(), this->block_size, this->work.data() + this->block_size, this->block_size)) {
+        // Number of blocks in this round:
+        const size_t count = std::min(max_blocks, (plain_length + this->block_size - 1) / this->block_size);
+        // counters[n] = counters[n-1] + 1
+        for (size_t n = 1; n < count; ++n) {
+            ::memcpy(counters + n * this->block_size, counters + (n - 1) * this->block_size, this->block_size);
+            incrementCounter(counters + n * this->block_size);
+        }
+        // output = encrypt(counters)
+        if (!this->algo->encryptBlocks(counters, output, count)) {
             return false;
         }
-        // This block size:
-        const size_t size = std::min(plain_length, this->block_size);
-        // cipher-text = plain-text XOR work[1]
+        // Size of this round:
+        const size_t size = std::min(plain_length, count * this->block_size);
+        // cipher-text = plain-text XOR output
         for (size_t i = 0; i < size; ++i) {
-            ct[i] = this->work[this->block_size + i] ^ pt[i];
+            ct[i] = output[i] ^ pt[i];
         }
-        // work[0] += 1
-        if (!incrementCounter()) {
-            return false;
+        // counters[0] = counters[count-1] + 1
+        if (count > 1) {
+            ::memcpy(counters, counters + (count - 1) * this->block_size, this->block_size);
         }
-        // advance one block
+        incrementCounter(counters);
+        // advance all blocks
         ct += size;
         pt += size;
         plain_length -= size;
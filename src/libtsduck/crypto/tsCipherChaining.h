@@ -100,6 +100,13 @@ namespace ts {
         ByteBlock    iv;          //!< Current initialization vector.
         ByteBlock    work;        //!< Temporary working buffer.
 
+        //!
+        //! Number of blocks which are processed at once by chaining modes which allow it,
+        //! such as CBC decryption or CTR, using decryptBlocks() or encryptBlocks() on the
+        //! underlying block cipher. Some block ciphers process these blocks in parallel.
+        //!
+        static const size_t PARALLEL_BLOCKS = 8;
+
         //!
         //! Constructor for subclasses.
         //! @param [in,out] cipher An instance of block cipher.
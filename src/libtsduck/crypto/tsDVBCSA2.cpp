@@ -29,6 +29,15 @@ TS_LLVM_NOWARNING(cast-align) // Because of casts to uint64_ptr
 
 #define MAX_NBLOCKS (184 / 8)
 
+// In batch mode, minimum number of data blocks to use the bitslice implementation.
+// With less data blocks, processing each one separately is faster.
+
+#define MIN_BITSLICE 8
+
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+const size_t ts::DVBCSA2::BATCH_SIZE;
+#endif
+
 
 //----------------------------------------------------------------------------
 // Manually perform entropy reduction on a control word.
@@ -333,6 +342,299 @@ void ts::DVBCSA2::StreamCipher::cipher(const uint8_t* sb, uint8_t *cb)
 }
 
 
+//----------------------------------------------------------------------------
+// Bitsliced stream cipher, used in batch mode.
+//----------------------------------------------------------------------------
+
+// In batch mode, the stream cipher is "bitsliced": each bit of the state is
+// stored in a 64-bit word containing the same bit for 64 distinct data blocks
+// (one bit "lane" per data block). The 64 lanes are clocked together using
+// boolean operations only. There is no table lookup, the s-boxes are evaluated
+// in algebraic normal form, as a xor of products of their input bits.
+
+namespace {
+
+    typedef uint64_t Slice;
+
+    const Slice SLICE_ONES = ~Slice(0);
+
+    // Algebraic normal form of the stream cipher s-boxes, computed once from the tables.
+    // For each output bit, list the monomials, as bit masks of the s-box inputs.
+    class SboxANF
+    {
+    public:
+        uint8_t terms[7][2][32];
+        size_t  count[7][2];
+
+        SboxANF();
+        static const SboxANF& Instance();
+    };
+
+    SboxANF::SboxANF() :
+        terms(),
+        count()
+    {
+        const int* const sbox[7] = {sbox1, sbox2, sbox3, sbox4, sbox5, sbox6, sbox7};
+        for (size_t s = 0; s < 7; ++s) {
+            for (size_t out = 0; out < 2; ++out) {
+                // Moebius transform of the truth table.
+                uint8_t anf[32];
+                for (size_t i = 0; i < 32; ++i) {
+                    anf[i] = uint8_t((sbox[s][i] >> out) & 1);
+                }
+                for (size_t bit = 1; bit < 32; bit <<= 1) {
+                    for (size_t i = 0; i < 32; ++i) {
+                        if ((i & bit) != 0) {
+                            anf[i] ^= anf[i ^ bit];
+                        }
+                    }
+                }
+                count[s][out] = 0;
+                for (size_t i = 0; i < 32; ++i) {
+                    if (anf[i] != 0) {
+                        terms[s][out][count[s][out]++] = uint8_t(i);
+                    }
+                }
+            }
+        }
+    }
+
+    const SboxANF& SboxANF::Instance()
+    {
+        static const SboxANF instance;
+        return instance;
+    }
+
+    // Evaluate one s-box on all lanes. The five inputs are given from the most
+    // significant one to the least significant one in the s-box table index.
+    inline void SliceSbox(const SboxANF& anf, size_t s, Slice in4, Slice in3, Slice in2, Slice in1, Slice in0, Slice& out0, Slice& out1)
+    {
+        const Slice in[5] = {in0, in1, in2, in3, in4};
+
+        // Compute all products of input bits, monomial m is the product of inputs in bit mask m.
+        Slice mono[32];
+        size_t m = 0;
+        mono[m++] = SLICE_ONES;
+        for (size_t i = 0; i < 5; ++i) {
+            for (size_t low = 0; low < (size_t(1) << i); ++low) {
+                mono[m++] = mono[low] & in[i];
+            }
+        }
+
+        out0 = out1 = 0;
+        for (size_t i = 0; i < anf.count[s][0]; ++i) {
+            out0 ^= mono[anf.terms[s][0][i]];
+        }
+        for (size_t i = 0; i < anf.count[s][1]; ++i) {
+            out1 ^= mono[anf.terms[s][1][i]];
+        }
+    }
+
+    // Transpose an 8x8 bit matrix, bit (8*r + c) is element (r,c).
+    inline uint64_t Transpose8x8(uint64_t x)
+    {
+        uint64_t t;
+        t = (x ^ (x >> 7)) & TS_UCONST64(0x00AA00AA00AA00AA);
+        x = x ^ t ^ (t << 7);
+        t = (x ^ (x >> 14)) & TS_UCONST64(0x0000CCCC0000CCCC);
+        x = x ^ t ^ (t << 14);
+        t = (x ^ (x >> 28)) & TS_UCONST64(0x00000000F0F0F0F0);
+        x = x ^ t ^ (t << 28);
+        return x;
+    }
+
+    // Bitsliced representation of 8 bytes per lane: slice[byte][bit].
+    typedef Slice ByteSlices[8][8];
+
+    // Load 8 bytes from each lane into bitsliced form. Missing lanes are zero.
+    void LoadSlices(ByteSlices& slices, const uint8_t* const* lanes, size_t count)
+    {
+        ::memset(slices, 0, sizeof(slices));
+        for (size_t group = 0; group * 8 < count; ++group) {
+            for (size_t i = 0; i < 8; ++i) {
+                // Matrix of 8 lanes (rows) x 8 bits (columns) for byte i.
+                uint64_t x = 0;
+                for (size_t l = 0; l < 8 && group * 8 + l < count; ++l) {
+                    x |= uint64_t(lanes[group * 8 + l][i]) << (8 * l);
+                }
+                x = Transpose8x8(x);
+                for (size_t bit = 0; bit < 8; ++bit) {
+                    slices[i][bit] |= ((x >> (8 * bit)) & 0xFF) << (8 * group);
+                }
+            }
+        }
+    }
+
+    // Store bitsliced data into 8 bytes per lane.
+    void StoreSlices(const ByteSlices& slices, uint8_t* const* lanes, size_t count)
+    {
+        for (size_t group = 0; group * 8 < count; ++group) {
+            for (size_t i = 0; i < 8; ++i) {
+                // Matrix of 8 bits (rows) x 8 lanes (columns) for byte i.
+                uint64_t x = 0;
+                for (size_t bit = 0; bit < 8; ++bit) {
+                    x |= ((slices[i][bit] >> (8 * group)) & 0xFF) << (8 * bit);
+                }
+                x = Transpose8x8(x);
+                for (size_t l = 0; l < 8 && group * 8 + l < count; ++l) {
+                    lanes[group * 8 + l][i] = uint8_t(x >> (8 * l));
+                }
+            }
+        }
+    }
+
+    // Bitsliced stream cipher state. Same structure as DVBCSA2::StreamCipher,
+    // nibble registers are stored as 4 slices, bit 0 first.
+    class SliceStreamCipher
+    {
+    public:
+        SliceStreamCipher(const uint8_t* key);
+        void cipher(const ByteSlices* sb, ByteSlices& cb);
+
+    private:
+        Slice A[11][4];
+        Slice B[11][4];
+        Slice X[4];
+        Slice Y[4];
+        Slice Z[4];
+        Slice D[4];
+        Slice E[4];
+        Slice F[4];
+        Slice p;
+        Slice q;
+        Slice r;
+        const SboxANF& _anf;
+
+        // Broadcast a nibble value into all lanes.
+        static void SetNibble(Slice nibble[4], int value);
+    };
+
+    void SliceStreamCipher::SetNibble(Slice nibble[4], int value)
+    {
+        for (size_t bit = 0; bit < 4; ++bit) {
+            nibble[bit] = ((value >> bit) & 1) != 0 ? SLICE_ONES : 0;
+        }
+    }
+
+    // Same initial state as DVBCSA2::StreamCipher::init(), in all lanes.
+    SliceStreamCipher::SliceStreamCipher(const uint8_t* key) :
+        A(),
+        B(),
+        X(),
+        Y(),
+        Z(),
+        D(),
+        E(),
+        F(),
+        p(0),
+        q(0),
+        r(0),
+        _anf(SboxANF::Instance())
+    {
+        for (size_t i = 0; i < 4; ++i) {
+            SetNibble(A[2*i+1], key[i] >> 4);
+            SetNibble(A[2*i+2], key[i] & 0x0F);
+            SetNibble(B[2*i+1], key[i+4] >> 4);
+            SetNibble(B[2*i+2], key[i+4] & 0x0F);
+        }
+    }
+
+    // Same as DVBCSA2::StreamCipher::cipher() on all lanes. The input is
+    // used in initialization mode only, when not null. In initialization
+    // mode, the output is not modified (the scalar version returns the input).
+    void SliceStreamCipher::cipher(const ByteSlices* sb, ByteSlices& cb)
+    {
+        const bool init = sb != nullptr;
+
+        for (size_t i = 0; i < 8; i++) {
+            for (size_t j = 0; j < 4; j++) {
+
+                // S-boxes, same inputs as the scalar version.
+                Slice s1[2], s2[2], s3[2], s4[2], s5[2], s6[2], s7[2];
+                SliceSbox(_anf, 0, A[4][0], A[1][2], A[6][1], A[7][3], A[9][0], s1[0], s1[1]);
+                SliceSbox(_anf, 1, A[2][1], A[3][2], A[6][3], A[7][0], A[9][1], s2[0], s2[1]);
+                SliceSbox(_anf, 2, A[1][3], A[2][0], A[5][1], A[5][3], A[6][2], s3[0], s3[1]);
+                SliceSbox(_anf, 3, A[3][3], A[1][1], A[2][3], A[4][2], A[8][0], s4[0], s4[1]);
+                SliceSbox(_anf, 4, A[5][2], A[4][3], A[6][0], A[8][1], A[9][2], s5[0], s5[1]);
+                SliceSbox(_anf, 5, A[3][1], A[4][1], A[5][0], A[7][2], A[9][3], s6[0], s6[1]);
+                SliceSbox(_anf, 6, A[2][2], A[3][0], A[7][1], A[8][2], A[8][3], s7[0], s7[1]);
+
+                // 4x4 xor to produce extra nibble for T3.
+                const Slice extra_B[4] = {
+                    B[9][2] ^ B[6][3] ^ B[3][1] ^ B[8][0],
+                    B[5][3] ^ B[8][2] ^ B[4][0] ^ B[5][1],
+                    B[6][0] ^ B[8][1] ^ B[3][3] ^ B[4][2],
+                    B[3][0] ^ B[6][1] ^ B[7][2] ^ B[9][3]
+                };
+
+                // Input nibbles in initialization mode.
+                const Slice* in_A = nullptr;
+                const Slice* in_B = nullptr;
+                if (init) {
+                    // Most significant nibble of input byte is first used in A, then in B.
+                    in_A = &(*sb)[i][(j % 2) ? 0 : 4];
+                    in_B = &(*sb)[i][(j % 2) ? 4 : 0];
+                }
+
+                // T1, T2, T3, T4 as in the scalar version.
+                Slice next_A1[4], next_B1[4], sum_F[4];
+                Slice carry = r;
+                for (size_t k = 0; k < 4; ++k) {
+                    next_A1[k] = A[10][k] ^ X[k];
+                    next_B1[k] = B[7][k] ^ B[10][k] ^ Y[k];
+                    if (init) {
+                        next_A1[k] ^= D[k] ^ in_A[k];
+                        next_B1[k] ^= in_B[k];
+                    }
+                    D[k] = E[k] ^ Z[k] ^ extra_B[k];
+                    sum_F[k] = Z[k] ^ E[k] ^ carry;
+                    carry = (Z[k] & E[k]) | (carry & (Z[k] ^ E[k]));
+                }
+
+                // If p=1, rotate left next_B1.
+                const Slice b3 = next_B1[3];
+                for (size_t k = 3; k > 0; --k) {
+                    next_B1[k] = (p & next_B1[k-1]) | (~p & next_B1[k]);
+                }
+                next_B1[0] = (p & b3) | (~p & next_B1[0]);
+
+                // If q=1, F = Z + E + r with carry in r, otherwise F = E. In all cases, E = previous F.
+                for (size_t k = 0; k < 4; ++k) {
+                    const Slice next_E = F[k];
+                    F[k] = (q & sum_F[k]) | (~q & E[k]);
+                    E[k] = next_E;
+                }
+                r = (q & carry) | (~q & r);
+
+                // Shift registers.
+                for (size_t n = 10; n > 1; --n) {
+                    for (size_t k = 0; k < 4; ++k) {
+                        A[n][k] = A[n-1][k];
+                        B[n][k] = B[n-1][k];
+                    }
+                }
+                for (size_t k = 0; k < 4; ++k) {
+                    A[1][k] = next_A1[k];
+                    B[1][k] = next_B1[k];
+                }
+
+                X[0] = s1[1]; X[1] = s2[1]; X[2] = s3[0]; X[3] = s4[0];
+                Y[0] = s3[1]; Y[1] = s4[1]; Y[2] = s5[0]; Y[3] = s6[0];
+                Z[0] = s5[1]; Z[1] = s6[1]; Z[2] = s1[0]; Z[3] = s2[0];
+                p = s7[1];
+                q = s7[0];
+
+                // 2 output bits per iteration, most significant bits first.
+                if (!init) {
+                    cb[i][7 - 2*j] = D[2] ^ D[3];
+                    cb[i][6 - 2*j] = D[0] ^ D[1];
+                }
+            }
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Block cipher
 //----------------------------------------------------------------------------
@@ -719,6 +1021,209 @@ bool ts::DVBCSA2::decryptInPlaceImpl(void* addr, size_t size, size_t* max_actual
 }
 
 
+//----------------------------------------------------------------------------
+// Encrypt / decrypt several data blocks in batch mode.
+//----------------------------------------------------------------------------
+
+bool ts::DVBCSA2::checkBatch(void* const* data, const size_t* size, size_t count) const
+{
+    if (!_init || (count > 0 && (data == nullptr || size == nullptr))) {
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (data[i] == nullptr || size[i] / 8 > MAX_NBLOCKS) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ts::DVBCSA2::encryptInPlaceBatch(void* const* data, const size_t* size, size_t count)
+{
+    if (!checkBatch(data, size, count)) {
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (!allowEncrypt()) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < count; i += BATCH_SIZE) {
+        const size_t n = std::min(count - i, BATCH_SIZE);
+        if (n < MIN_BITSLICE) {
+            // Not enough data blocks to use the bitslice implementation.
+            for (size_t k = 0; k < n; ++k) {
+                encryptInPlaceImpl(data[i+k], size[i+k], nullptr);
+            }
+        }
+        else {
+            encryptGroup(data + i, size + i, n);
+        }
+    }
+    return true;
+}
+
+bool ts::DVBCSA2::decryptInPlaceBatch(void* const* data, const size_t* size, size_t count)
+{
+    if (!checkBatch(data, size, count)) {
+        return false;
+    }
+    for (size_t i = 0; i < count; ++i) {
+        if (!allowDecrypt()) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < count; i += BATCH_SIZE) {
+        const size_t n = std::min(count - i, BATCH_SIZE);
+        if (n < MIN_BITSLICE) {
+            // Not enough data blocks to use the bitslice implementation.
+            for (size_t k = 0; k < n; ++k) {
+                decryptInPlaceImpl(data[i+k], size[i+k], nullptr);
+            }
+        }
+        else {
+            decryptGroup(data + i, size + i, n);
+        }
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Encrypt a group of up to BATCH_SIZE data blocks.
+//----------------------------------------------------------------------------
+
+void ts::DVBCSA2::encryptGroup(void* const* data, const size_t* size, size_t count)
+{
+    assert(count <= BATCH_SIZE);
+
+    uint8_t* lanes[BATCH_SIZE] = {nullptr};  // data blocks, one per lane, data blocks smaller than 8 bytes are ignored
+    size_t nblocks[BATCH_SIZE];              // number of 8-byte blocks per lane
+    size_t rsize[BATCH_SIZE];                // residue size per lane
+    size_t nlanes = 0;                       // number of used lanes
+    size_t nstream = 0;                      // max number of stream cipher outputs
+
+    for (size_t i = 0; i < count; ++i) {
+        if (size[i] >= 8) {
+            lanes[nlanes] = reinterpret_cast<uint8_t*>(data[i]);
+            nblocks[nlanes] = size[i] / 8;
+            rsize[nlanes] = size[i] % 8;
+            nstream = std::max(nstream, nblocks[nlanes] - 1 + (rsize[nlanes] > 0 ? 1 : 0));
+            nlanes++;
+        }
+    }
+
+    // Perform block cipher in reverse CBC mode in each lane, directly in the data block.
+    // After last block is initialization vector (zero in DVB-CSA).
+    for (size_t l = 0; l < nlanes; ++l) {
+        uint8_t iblock[8];
+        clear_8(iblock);
+        for (size_t i = nblocks[l]; i-- > 0; ) {
+            xor_8(iblock, lanes[l] + 8*i, iblock);
+            _block.encipher(iblock, lanes[l] + 8*i);
+            memcpy_8(iblock, lanes[l] + 8*i);
+        }
+    }
+
+    // The first block is scrambled using the block cipher only.
+    // Its scrambled value is used to initialize the stream cipher.
+    SliceStreamCipher stream(_key);
+    ByteSlices slices;
+    LoadSlices(slices, lanes, nlanes);
+    stream.cipher(&slices, slices);
+
+    // Now perform stream cipher in the reverse direction, skipping the first block.
+    uint8_t ostream[BATCH_SIZE][8];
+    uint8_t* ostream_lanes[BATCH_SIZE] = {nullptr};
+    for (size_t l = 0; l < nlanes; ++l) {
+        ostream_lanes[l] = ostream[l];
+    }
+    for (size_t i = 1; i <= nstream; ++i) {
+        stream.cipher(nullptr, slices);
+        StoreSlices(slices, ostream_lanes, nlanes);
+        for (size_t l = 0; l < nlanes; ++l) {
+            if (i < nblocks[l]) {
+                xor_8(lanes[l] + 8*i, lanes[l] + 8*i, ostream[l]);
+            }
+            else if (i == nblocks[l]) {
+                // Cipher residue, if any.
+                for (size_t k = 0; k < rsize[l]; ++k) {
+                    lanes[l][8*i + k] ^= ostream[l][k];
+                }
+            }
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Decrypt a group of up to BATCH_SIZE data blocks.
+//----------------------------------------------------------------------------
+
+void ts::DVBCSA2::decryptGroup(void* const* data, const size_t* size, size_t count)
+{
+    assert(count <= BATCH_SIZE);
+
+    uint8_t* lanes[BATCH_SIZE] = {nullptr};  // data blocks, one per lane, data blocks smaller than 8 bytes are ignored
+    size_t nblocks[BATCH_SIZE];              // number of 8-byte blocks per lane
+    size_t rsize[BATCH_SIZE];                // residue size per lane
+    size_t nlanes = 0;                       // number of used lanes
+    size_t nstream = 0;                      // max number of stream cipher outputs
+
+    for (size_t i = 0; i < count; ++i) {
+        if (size[i] >= 8) {
+            lanes[nlanes] = reinterpret_cast<uint8_t*>(data[i]);
+            nblocks[nlanes] = size[i] / 8;
+            rsize[nlanes] = size[i] % 8;
+            nstream = std::max(nstream, nblocks[nlanes] - 1 + (rsize[nlanes] > 0 ? 1 : 0));
+            nlanes++;
+        }
+    }
+
+    // Initialize stream cipher with first 8 bytes of scrambled data blocks.
+    // This scrambled block is the initial intermediate block.
+    uint8_t ib[BATCH_SIZE][8];
+    SliceStreamCipher stream(_key);
+    ByteSlices slices;
+    LoadSlices(slices, lanes, nlanes);
+    stream.cipher(&slices, slices);
+    for (size_t l = 0; l < nlanes; ++l) {
+        memcpy_8(ib[l], lanes[l]);
+    }
+
+    // Decipher all blocks except last one.
+    uint8_t ostream[BATCH_SIZE][8];
+    uint8_t* ostream_lanes[BATCH_SIZE] = {nullptr};
+    for (size_t l = 0; l < nlanes; ++l) {
+        ostream_lanes[l] = ostream[l];
+    }
+    for (size_t i = 1; i <= nstream; ++i) {
+        stream.cipher(nullptr, slices);
+        StoreSlices(slices, ostream_lanes, nlanes);
+        for (size_t l = 0; l < nlanes; ++l) {
+            if (i < nblocks[l]) {
+                uint8_t oblock[8];
+                _block.decipher(ib[l], oblock);
+                xor_8(ib[l], lanes[l] + 8*i, ostream[l]);
+                xor_8(lanes[l] + 8*(i-1), ib[l], oblock);
+            }
+            else if (i == nblocks[l]) {
+                // Decipher residue, if any.
+                for (size_t k = 0; k < rsize[l]; ++k) {
+                    lanes[l][8*i + k] ^= ostream[l][k];
+                }
+            }
+        }
+    }
+
+    // Last block - sb[nblocks+1] = IV = 0
+    // Xor with zero is a null operation -> decipher directly into plain.
+    for (size_t l = 0; l < nlanes; ++l) {
+        _block.decipher(ib[l], lanes[l] + 8*(nblocks[l]-1));
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Wrappers for encrypt and decrypt.
 //----------------------------------------------------------------------------
@@ -46,6 +46,7 @@ namespace ts {
     public:
         static const size_t KEY_BITS = 64;             //!< DVB CSA-2 control words size in bits.
         static const size_t KEY_SIZE = KEY_BITS / 8;   //!< DVB CSA-2 control words size in bytes.
+        static const size_t BATCH_SIZE = 64;           //!< Number of data blocks which are processed in parallel in batch mode.
 
         //!
         //! Control word entropy reduction.
@@ -88,6 +89,30 @@ namespace ts {
         //!
         static bool IsReducedCW(const uint8_t *cw);
 
+        //!
+        //! Encrypt several data blocks in place, typically the payloads of TS packets.
+        //! The result is identical to encryptInPlace() on each data block. But the stream
+        //! cipher is computed in parallel on groups of up to @link BATCH_SIZE @endlink data
+        //! blocks using a "bitslice" implementation, which is much faster on large batches.
+        //! @param [in,out] data Array of @a count addresses of data blocks to encrypt.
+        //! @param [in] size Array of @a count sizes of data blocks in bytes.
+        //! @param [in] count Number of data blocks.
+        //! @return True on success, false on error. When a parameter is invalid, no data block is modified.
+        //!
+        bool encryptInPlaceBatch(void* const* data, const size_t* size, size_t count);
+
+        //!
+        //! Decrypt several data blocks in place, typically the payloads of TS packets.
+        //! The result is identical to decryptInPlace() on each data block. But the stream
+        //! cipher is computed in parallel on groups of up to @link BATCH_SIZE @endlink data
+        //! blocks using a "bitslice" implementation, which is much faster on large batches.
+        //! @param [in,out] data Array of @a count addresses of data blocks to decrypt.
+        //! @param [in] size Array of @a count sizes of data blocks in bytes.
+        //! @param [in] count Number of data blocks.
+        //! @return True on success, false on error. When a parameter is invalid, no data block is modified.
+        //!
+        bool decryptInPlaceBatch(void* const* data, const size_t* size, size_t count);
+
         // Implementation of CipherChaining interface. Cannot set IV with DVB CSA.
         virtual bool setIV(const void*, size_t) override;
         virtual size_t minIVSize() const override;
@@ -151,5 +176,12 @@ namespace ts {
         uint8_t      _key[KEY_SIZE];
         BlockCipher  _block;
         StreamCipher _stream;
+
+        // Check the parameters of a batch operation.
+        bool checkBatch(void* const* data, const size_t* size, size_t count) const;
+
+        // Encrypt or decrypt a group of up to BATCH_SIZE data blocks.
+        void encryptGroup(void* const* data, const size_t* size, size_t count);
+        void decryptGroup(void* const* data, const size_t* size, size_t count);
     };
 }
@@ -45,7 +45,7 @@ TS_MSC_NOWARNING(4505) // warning C4505: 'ts::DVS042<ts::AES>::encrypt': unrefer
 
 template<class CIPHER>
 ts::DVS042<CIPHER>::DVS042() :
-    CipherChainingTemplate<CIPHER>(1, 1, 1),
+    CipherChainingTemplate<CIPHER>(1, 1, CipherChaining::PARALLEL_BLOCKS),
     shortIV(this->block_size)
 {
 }
@@ -192,21 +192,27 @@ bool ts::DVS042<CIPHER>::decryptImpl(const void* cipher, size_t cipher_length, v
     const uint8_t* ct = reinterpret_cast<const uint8_t*>(cipher);
     uint8_t* pt = reinterpret_cast<uint8_t*>(plain);
 
+    const size_t max_blocks = this->work.size() / this->block_size;
     while (cipher_length >= this->block_size) {
-        // work = decrypt (cipher-text)
-        if (!this->algo->decrypt(ct, this->block_size, this->work.data(), this->block_size)) {
+        // work = decrypt (cipher-text), several blocks at a time
+        const size_t count = std::min(cipher_length / this->block_size, max_blocks);
+        const size_t size = count * this->block_size;
+        if (!this->algo->decryptBlocks(ct, this->work.data(), count)) {
             return false;
         }
         // plain-text = previous-cipher XOR work
         for (size_t i = 0; i < this->block_size; ++i) {
             pt[i] = previous[i] ^ this->work[i];
         }
-        // previous-cipher = cipher-text
-        previous = ct;
-        // advance one block
-        ct += this->block_size;
-        pt += this->block_size;
-        cipher_length -= this->block_size;
+        for (size_t i = this->block_size; i < size; ++i) {
+            pt[i] = ct[i - this->block_size] ^ this->work[i];
+        }
+        // previous-cipher = last cipher-text
+        previous = ct + size - this->block_size;
+        // advance all blocks
+        ct += size;
+        pt += size;
+        cipher_length -= size;
     }
 
     // Process final block if incomplete
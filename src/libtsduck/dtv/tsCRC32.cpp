@@ -32,8 +32,27 @@
 //----------------------------------------------------------------------------
 
 #include "tsCRC32.h"
+#include "tsSysInfo.h"
+#include "tsMemory.h"
 TSDUCK_SOURCE;
 
+// Minimum data size for the carry-less multiplication method (4 blocks of 16 bytes).
+#define CLMUL_MIN_SIZE 64
+
+// Maximum number of zero bytes in one step when updating a CRC (max section size).
+#define ZEROS_MAX_SIZE 4096
+
+// Carry-less multiplication instructions are available on Intel and AMD processors.
+#if defined(TS_I386) || defined(TS_X86_64)
+    #define TS_CLMUL_INSTRUCTIONS 1
+    #include <wmmintrin.h>
+    #if defined(TS_GCC) || defined(TS_LLVM)
+        #define CLMUL_FUNCTION __attribute__((target("pclmul,sse2")))
+    #else
+        #define CLMUL_FUNCTION
+    #endif
+#endif
+
 
 // The FCS-32 generator polynomial:
 //     x**0 + x**1 + x**2 + x**4 + x**5 +
@@ -41,6 +60,8 @@ TSDUCK_SOURCE;
 //     x**22 + x**23 + x**26 + x**32.
 
 namespace {
+    const uint32_t POLYNOMIAL = 0x04C11DB7;
+
     const uint32_t fcstab_32 [256] = {
         0x00000000, 0x04C11DB7, 0x09823B6E, 0x0D4326D9,
         0x130476DC, 0x17C56B6B, 0x1A864DB2, 0x1E475005,
@@ -109,13 +130,262 @@ namespace {
     };
 }
 
-// Continue the computation of a data area, following a previous CRC32
 
-void ts::CRC32::add (const void* data, size_t size)
+
+//----------------------------------------------------------------------------
+// Precomputed data for the fast implementations, initialized once.
+//----------------------------------------------------------------------------
+
+namespace {
+    class FastCRC
+    {
+    public:
+        // slice[n][b] is the CRC32 of byte b followed by n zero bytes.
+        // slice[0] is the classical table.
+        uint32_t slice[8][256];
+
+        // Folding constants for the carry-less multiplication method.
+        // k512 = x^512 mod P, k576 = x^576 mod P, etc.
+        uint64_t k128, k192, k512, k576;
+
+        // zeros[n] = x^(8n-32) mod P, for n >= 4. Used to append n zero bytes to a CRC.
+        uint32_t zeros[ZEROS_MAX_SIZE + 1];
+
+        // True if the carry-less multiplication is supported by the CPU.
+        bool clmul;
+
+        static const FastCRC& Instance()
+        {
+            static const FastCRC instance;
+            return instance;
+        }
+
+    private:
+        FastCRC();
+
+        // Compute x^n mod P, with n >= 32.
+        static uint32_t XPowerModP(size_t n);
+    };
+
+    FastCRC::FastCRC() :
+        slice(),
+        k128(XPowerModP(128)),
+        k192(XPowerModP(192)),
+        k512(XPowerModP(512)),
+        k576(XPowerModP(576)),
+        zeros(),
+#if defined(TS_CLMUL_INSTRUCTIONS)
+        clmul(ts::SysInfo::Instance()->hasCarryLessMultiply())
+#else
+        clmul(false)
+#endif
+    {
+        zeros[4] = 1;  // x^0
+        for (size_t n = 5; n <= ZEROS_MAX_SIZE; ++n) {
+            uint32_t r = zeros[n-1];
+            for (size_t i = 0; i < 8; ++i) {
+                r = (r << 1) ^ ((r & 0x80000000) != 0 ? POLYNOMIAL : 0);
+            }
+            zeros[n] = r;
+        }
+        for (size_t b = 0; b < 256; ++b) {
+            slice[0][b] = fcstab_32[b];
+            for (size_t n = 1; n < 8; ++n) {
+                const uint32_t prev = slice[n-1][b];
+                slice[n][b] = (prev << 8) ^ fcstab_32[prev >> 24];
+            }
+        }
+    }
+
+    uint32_t FastCRC::XPowerModP(size_t n)
+    {
+        uint32_t r = POLYNOMIAL;  // x^32 mod P
+        for (size_t i = 32; i < n; ++i) {
+            r = (r << 1) ^ ((r & 0x80000000) != 0 ? POLYNOMIAL : 0);
+        }
+        return r;
+    }
+
+    // One table lookup per byte.
+    uint32_t CRCByteWise(uint32_t fcs, const uint8_t* cp, size_t size)
+    {
+        while (size-- > 0) {
+            fcs = (fcs << 8) ^ fcstab_32[((fcs >> 24) ^ (*cp++)) & 0xFF];
+        }
+        return fcs;
+    }
+
+    // Slicing-by-8: 8 bytes at a time using 8 tables.
+    uint32_t CRCSlicing8(uint32_t fcs, const uint8_t* cp, size_t size, const FastCRC& fast)
+    {
+        const uint32_t (&t)[8][256] = fast.slice;
+        while (size >= 8) {
+            const uint32_t hi = fcs ^ ts::GetUInt32(cp);
+            const uint32_t lo = ts::GetUInt32(cp + 4);
+            fcs = t[7][hi >> 24] ^ t[6][(hi >> 16) & 0xFF] ^ t[5][(hi >> 8) & 0xFF] ^ t[4][hi & 0xFF] ^
+                  t[3][lo >> 24] ^ t[2][(lo >> 16) & 0xFF] ^ t[1][(lo >> 8) & 0xFF] ^ t[0][lo & 0xFF];
+            cp += 8;
+            size -= 8;
+        }
+        return CRCByteWise(fcs, cp, size);
+    }
+
+#if defined(TS_CLMUL_INSTRUCTIONS)
+
+    // A 16-byte block is loaded as a 128-bit polynomial, first byte on most significant bits.
+    CLMUL_FUNCTION inline __m128i LoadBlock(const uint8_t* cp)
+    {
+        return _mm_set_epi64x(int64_t(ts::GetUInt64(cp)), int64_t(ts::GetUInt64(cp + 8)));
+    }
+
+    // Fold a 128-bit polynomial x = H.x^64 + L over a distance of d bits, then add the next block:
+    // return H.(x^(d+64) mod P) + L.(x^d mod P) + next, with k = {x^(d+64) mod P, x^d mod P}.
+    CLMUL_FUNCTION inline __m128i FoldBlock(__m128i x, __m128i k, __m128i next)
+    {
+        return _mm_xor_si128(_mm_xor_si128(_mm_clmulepi64_si128(x, k, 0x11), _mm_clmulepi64_si128(x, k, 0x00)), next);
+    }
+
+    // Fold 64-byte chunks in 4 parallel lanes, then 16-byte blocks. Require size >= CLMUL_MIN_SIZE.
+    // The remaining 128-bit polynomial is congruent modulo P to the processed data, its CRC is
+    // computed using the slicing-by-8 method, followed by the last partial block, if any.
+    CLMUL_FUNCTION uint32_t CRCFolding(uint32_t fcs, const uint8_t* cp, size_t size, const FastCRC& fast)
+    {
+        // The initial CRC value is added to the first 32 bits of the message.
+        __m128i x0 = _mm_xor_si128(LoadBlock(cp), _mm_set_epi64x(int64_t(uint64_t(fcs) << 32), 0));
+        __m128i x1 = LoadBlock(cp + 16);
+        __m128i x2 = LoadBlock(cp + 32);
+        __m128i x3 = LoadBlock(cp + 48);
+        cp += 64;
+        size -= 64;
+
+        const __m128i k4 = _mm_set_epi64x(int64_t(fast.k576), int64_t(fast.k512));
+        while (size >= 64) {
+            x0 = FoldBlock(x0, k4, LoadBlock(cp));
+            x1 = FoldBlock(x1, k4, LoadBlock(cp + 16));
+            x2 = FoldBlock(x2, k4, LoadBlock(cp + 32));
+            x3 = FoldBlock(x3, k4, LoadBlock(cp + 48));
+            cp += 64;
+            size -= 64;
+        }
+
+        const __m128i k1 = _mm_set_epi64x(int64_t(fast.k192), int64_t(fast.k128));
+        x0 = FoldBlock(x0, k1, x1);
+        x0 = FoldBlock(x0, k1, x2);
+        x0 = FoldBlock(x0, k1, x3);
+        while (size >= 16) {
+            x0 = FoldBlock(x0, k1, LoadBlock(cp));
+            cp += 16;
+            size -= 16;
+        }
+
+        uint64_t words[2];
+        uint8_t rem[16];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(words), x0);
+        ts::PutUInt64(rem, words[1]);
+        ts::PutUInt64(rem + 8, words[0]);
+        return CRCSlicing8(CRCSlicing8(0, rem, sizeof(rem), fast), cp, size, fast);
+    }
+
+#endif
+
+    // Carry-less multiplication of two 32-bit polynomials.
+    uint64_t CarryLessMultiply(uint32_t a, uint32_t b)
+    {
+        uint64_t r = 0;
+        for (size_t i = 0; i < 32; ++i) {
+            r ^= (uint64_t(a) << i) & (0 - uint64_t((b >> i) & 1));
+        }
+        return r;
+    }
+
+#if defined(TS_CLMUL_INSTRUCTIONS)
+    CLMUL_FUNCTION uint64_t CarryLessMultiplyInstruction(uint32_t a, uint32_t b)
+    {
+        uint64_t words[2];
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(words), _mm_clmulepi64_si128(_mm_set_epi64x(0, int64_t(a)), _mm_set_epi64x(0, int64_t(b)), 0x00));
+        return words[0];
+    }
+#endif
+
+    // Append zero bytes to a CRC computation. The CRC of n zero bytes following a message M
+    // is M.x^(8n+32) mod P = (M.x^32 mod P).x^(8n-32).x^32 mod P. The last step is the CRC of
+    // the 64-bit product, in 8 bytes, starting from a zero CRC.
+    uint32_t AppendZeros(uint32_t fcs, size_t count, const FastCRC& fast)
+    {
+        while (count >= 4 && fcs != 0) {
+            const size_t n = std::min<size_t>(count, ZEROS_MAX_SIZE);
+            uint64_t product = 0;
+#if defined(TS_CLMUL_INSTRUCTIONS)
+            if (fast.clmul) {
+                product = CarryLessMultiplyInstruction(fcs, fast.zeros[n]);
+            }
+            else
+#endif
+            {
+                product = CarryLessMultiply(fcs, fast.zeros[n]);
+            }
+            uint8_t bytes[8];
+            ts::PutUInt64(bytes, product);
+            fcs = CRCSlicing8(0, bytes, sizeof(bytes), fast);
+            count -= n;
+        }
+        while (count-- > 0 && fcs != 0) {
+            fcs = (fcs << 8) ^ fcstab_32[fcs >> 24];
+        }
+        return fcs;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Update the CRC32 of a data area after the modification of a few bytes.
+// The CRC is linear: for two messages of the same size, the difference of
+// their CRC's is the CRC of the difference of the messages, starting from
+// zero. The difference is zero everywhere, except in the modified bytes.
+//----------------------------------------------------------------------------
+
+uint32_t ts::CRC32::Update(uint32_t crc, const void* old_data, const void* new_data, size_t size, size_t trailing)
 {
-    const uint8_t* cp = static_cast <const uint8_t*> (data);
+    const uint8_t* op = static_cast<const uint8_t*>(old_data);
+    const uint8_t* np = static_cast<const uint8_t*>(new_data);
 
+    uint32_t delta = 0;
     while (size-- > 0) {
-        _fcs = (_fcs << 8) ^ fcstab_32 [((_fcs >> 24) ^ (*cp++)) & 0xFF];
+        delta = (delta << 8) ^ fcstab_32[((delta >> 24) ^ *op++ ^ *np++) & 0xFF];
+    }
+    return crc ^ AppendZeros(delta, trailing, FastCRC::Instance());
+}
+
+
+//----------------------------------------------------------------------------
+// Check if an implementation is supported on the current CPU.
+//----------------------------------------------------------------------------
+
+bool ts::CRC32::IsSupported(Implementation impl)
+{
+    return impl != CLMUL || FastCRC::Instance().clmul;
+}
+
+
+//----------------------------------------------------------------------------
+// Continue the computation of a data area, following a previous CRC32
+//----------------------------------------------------------------------------
+
+void ts::CRC32::add(const void* data, size_t size, Implementation impl)
+{
+    const uint8_t* cp = static_cast<const uint8_t*>(data);
+
+    if (impl == BYTEWISE) {
+        _fcs = CRCByteWise(_fcs, cp, size);
+    }
+    else {
+        const FastCRC& fast(FastCRC::Instance());
+#if defined(TS_CLMUL_INSTRUCTIONS)
+        if (impl != SLICING8 && fast.clmul && size >= CLMUL_MIN_SIZE) {
+            _fcs = CRCFolding(_fcs, cp, size, fast);
+            return;
+        }
+#endif
+        _fcs = CRCSlicing8(_fcs, cp, size, fast);
     }
 }
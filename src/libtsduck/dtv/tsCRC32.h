@@ -40,11 +40,36 @@
 namespace ts {
     //!
     //! Cyclic Redundancy Check as used in MPEG sections.
+    //!
+    //! Several implementations are available. The default one is the fastest
+    //! one on the current CPU: a folding method using carry-less multiplications
+    //! when the CPU supports it (PCLMULQDQ on Intel and AMD processors) and the
+    //! "slicing-by-8" table method otherwise. Short data areas always use the
+    //! slicing-by-8 method.
+    //!
     //! @ingroup mpeg
     //!
     class TSDUCKDLL CRC32
     {
     public:
+        //!
+        //! Implementation methods of the CRC32 computation.
+        //! All methods produce the same results, only the performance differs.
+        //!
+        enum Implementation {
+            BYTEWISE,   //!< Portable, one table lookup per byte.
+            SLICING8,   //!< Portable "slicing-by-8" method, eight table lookups per 8-byte word.
+            CLMUL,      //!< Folding using carry-less multiplications, falls back to SLICING8 when not supported.
+            FASTEST     //!< Fastest available method on the current CPU (the default).
+        };
+
+        //!
+        //! Check if an implementation of the CRC32 computation is supported on the current CPU.
+        //! @param [in] impl Implementation method to check.
+        //! @return True if @a impl is supported on the current CPU.
+        //!
+        static bool IsSupported(Implementation impl);
+
         //!
         //! Default constructor.
         //!
@@ -66,7 +91,28 @@ namespace ts {
         //! @param [in] data Address of area to analyze.
         //! @param [in] size Size in bytes of area to analyze.
         //!
-        void add(const void* data, size_t size);
+        void add(const void* data, size_t size) { add(data, size, FASTEST); }
+
+        //!
+        //! Continue the computation of a data area, following a previous CRC32, using a specific implementation.
+        //! @param [in] data Address of area to analyze.
+        //! @param [in] size Size in bytes of area to analyze.
+        //! @param [in] impl Implementation method to use.
+        //!
+        void add(const void* data, size_t size, Implementation impl);
+
+        //!
+        //! Update the CRC32 of a data area after the modification of a few bytes inside the area.
+        //! Only the modified bytes are processed. The computation time does not depend on the
+        //! size of the rest of the data area. This is useful to patch large sections.
+        //! @param [in] crc The CRC32 value of the complete data area, before modification.
+        //! @param [in] old_data Address of the modified bytes, before modification.
+        //! @param [in] new_data Address of the modified bytes, after modification.
+        //! @param [in] size Number of modified bytes.
+        //! @param [in] trailing Number of bytes after the modified bytes, up to the end of the data area.
+        //! @return The CRC32 value of the complete data area, after modification.
+        //!
+        static uint32_t Update(uint32_t crc, const void* old_data, const void* new_data, size_t size, size_t trailing);
 
         //!
         //! Get the value of the CRC32 as computed so far.
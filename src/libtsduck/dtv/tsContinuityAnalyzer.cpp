@@ -139,14 +139,14 @@ bool ts::ContinuityAnalyzer::hasPID(PID pid) const
 
 uint8_t ts::ContinuityAnalyzer::firstCC(PID pid) const
 {
-    auto it = _pid_states.find(pid);
-    return it == _pid_states.end() ? INVALID_CC : it->second.first_cc;
+    const PIDState* const state = _pid_states.get(pid);
+    return state == nullptr ? INVALID_CC : state->first_cc;
 }
 
 uint8_t ts::ContinuityAnalyzer::lastCC(PID pid) const
 {
-    auto it = _pid_states.find(pid);
-    return it == _pid_states.end() ? INVALID_CC : it->second.last_cc_out;
+    const PIDState* const state = _pid_states.get(pid);
+    return state == nullptr ? INVALID_CC : state->last_cc_out;
 }
 
 
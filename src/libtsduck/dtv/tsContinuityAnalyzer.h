@@ -35,6 +35,7 @@
 #pragma once
 #include "tsMPEG.h"
 #include "tsTSPacket.h"
+#include "tsPIDTable.h"
 #include "tsReport.h"
 
 namespace ts {
@@ -214,8 +215,8 @@ namespace ts {
             TSPacket last_pkt_in;  // Last input packet (before modification, if any).
         };
 
-        // A map of PID state, indexed by PID.
-        typedef std::map<PID,PIDState> PIDStateMap;
+        // A dense table of PID state, indexed by PID.
+        typedef PIDTable<PIDState> PIDStateMap;
 
         // Private members.
         Report*       _report;            // Where to report errors, never null.
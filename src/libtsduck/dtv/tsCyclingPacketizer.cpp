@@ -47,6 +47,7 @@ ts::CyclingPacketizer::CyclingPacketizer(PID pid, StuffingPolicy stuffing, BitRa
     _section_count(0),
     _sched_sections(),
     _other_sections(),
+    _index(),
     _sched_packets(0),
     _current_cycle(1),
     _remain_in_cycle(0),
@@ -101,16 +102,41 @@ void ts::CyclingPacketizer::addTable(DuckContext& duck, const AbstractTable& tab
 
 
 //----------------------------------------------------------------------------
-// Insert a scheduled section in the list, sorted by due_packet, after other
+// Insert a section in the schedule, sorted by due_packet, before other
 // sections with the same due_packet.
 //----------------------------------------------------------------------------
 
 void ts::CyclingPacketizer::addScheduledSection(const SectionDescPtr& sect)
 {
-    const PacketCounter due_packet = sect->due_packet;
-    SectionDescList::iterator it;
-    for (it = _sched_sections.begin(); it != _sched_sections.end() && (*it)->due_packet < due_packet; ++it) {}
-    _sched_sections.insert(it, sect);
+    // With a hint, the insertion is done just before the hint (C++11).
+    sect->sched_pos = _sched_sections.insert(_sched_sections.lower_bound(sect->due_packet), std::make_pair(sect->due_packet, sect));
+    sect->scheduled = true;
+}
+
+
+//----------------------------------------------------------------------------
+// Insert a section at the end of the list of unscheduled sections.
+//----------------------------------------------------------------------------
+
+void ts::CyclingPacketizer::addOtherSection(const SectionDescPtr& sect)
+{
+    sect->other_pos = _other_sections.insert(_other_sections.end(), sect);
+    sect->scheduled = false;
+}
+
+
+//----------------------------------------------------------------------------
+// Remove a section from the schedule or the list of unscheduled sections.
+//----------------------------------------------------------------------------
+
+void ts::CyclingPacketizer::unlinkSection(SectionDesc& sect)
+{
+    if (sect.scheduled) {
+        _sched_sections.erase(sect.sched_pos);
+    }
+    else {
+        _other_sections.erase(sect.other_pos);
+    }
 }
 
 
@@ -124,7 +150,7 @@ void ts::CyclingPacketizer::addSection(const SectionPtr& sect, MilliSecond rep_r
 
     if (rep_rate == 0 || _bitrate == 0) {
         // Unschedule section, simply add it at end of queue
-        _other_sections.push_back(desc);
+        addOtherSection(desc);
     }
     else {
         // Scheduled section, its due time is "now"
@@ -133,6 +159,9 @@ void ts::CyclingPacketizer::addSection(const SectionPtr& sect, MilliSecond rep_r
         _sched_packets += sect->packetCount();
     }
 
+    // Index the section by table id and table id extension for fast removal.
+    _index[(uint32_t(sect->tableId()) << 16) | sect->tableIdExtension()].push_back(desc);
+
     _section_count++;
     _remain_in_cycle++;
 }
@@ -144,8 +173,7 @@ void ts::CyclingPacketizer::addSection(const SectionPtr& sect, MilliSecond rep_r
 
 void ts::CyclingPacketizer::removeSections(TID tid)
 {
-    removeSections(_sched_sections, tid, 0, false, true);
-    removeSections(_other_sections, tid, 0, false, false);
+    removeIndexedSections(uint32_t(tid) << 16, (uint32_t(tid) << 16) | 0xFFFF);
 }
 
 
@@ -155,38 +183,34 @@ void ts::CyclingPacketizer::removeSections(TID tid)
 
 void ts::CyclingPacketizer::removeSections(TID tid, uint16_t tid_ext)
 {
-    removeSections(_sched_sections, tid, tid_ext, true, true);
-    removeSections(_other_sections, tid, tid_ext, true, false);
+    const uint32_t key = (uint32_t(tid) << 16) | tid_ext;
+    removeIndexedSections(key, key);
 }
 
 
 //----------------------------------------------------------------------------
-// Remove all sections with the specified tid/tid_ext in the specified list.
+// Remove all sections with a tid/tid_ext in the specified range of index keys.
 //----------------------------------------------------------------------------
 
-void ts::CyclingPacketizer::removeSections(SectionDescList& list, TID tid, uint16_t tid_ext, bool use_tid_ext, bool scheduled)
+void ts::CyclingPacketizer::removeIndexedSections(uint32_t first_key, uint32_t last_key)
 {
-    SectionDescList::iterator it(list.begin());
-    while (it != list.end()) {
-        const SectionDescPtr& sp(*it);
-        const Section& sect(*sp->section);
-        if (sect.tableId() == tid && (!use_tid_ext || sect.tableIdExtension() == tid_ext)) {
-            // Section match, remove it
+    auto it = _index.lower_bound(first_key);
+    while (it != _index.end() && it->first <= last_key) {
+        for (auto its = it->second.begin(); its != it->second.end(); ++its) {
+            SectionDesc& sp(**its);
             assert(_section_count > 0);
             _section_count--;
-            if (sp->last_cycle != _current_cycle) {
+            if (sp.last_cycle != _current_cycle) {
                 assert(_remain_in_cycle > 0);
                 _remain_in_cycle--;
             }
-            if (scheduled) {
-                assert(_sched_packets >= sect.packetCount());
-                _sched_packets -= sect.packetCount();
+            if (sp.scheduled) {
+                assert(_sched_packets >= sp.section->packetCount());
+                _sched_packets -= sp.section->packetCount();
             }
-            it = list.erase(it);
-        }
-        else {
-            ++it;
+            unlinkSection(sp);
         }
+        it = _index.erase(it);
     }
 }
 
@@ -202,6 +226,7 @@ void ts::CyclingPacketizer::removeAll()
     _sched_packets = 0;
     _sched_sections.clear();
     _other_sections.clear();
+    _index.clear();
 }
 
 
@@ -232,10 +257,10 @@ void ts::CyclingPacketizer::setBitRate(BitRate new_bitrate)
     else if (new_bitrate == 0) {
         // Bitrate now unknown, unable to schedule sections, move them all
         // into the list of unscheduled sections.
-        while (!_sched_sections.empty()) {
-            _other_sections.push_back(_sched_sections.front());
-            _sched_sections.pop_front();
+        for (auto it = _sched_sections.begin(); it != _sched_sections.end(); ++it) {
+            addOtherSection(it->second);
         }
+        _sched_sections.clear();
         _sched_packets = 0;
     }
     else if (_bitrate == 0) {
@@ -262,14 +287,14 @@ void ts::CyclingPacketizer::setBitRate(BitRate new_bitrate)
     }
     else {
         // Old and new bitrate not null. Compute new due packet for all
-        // scheduled sections and re-sort list according to new due packet.
-        SectionDescList tmp_list;
-        tmp_list.swap(_sched_sections);
-        while (!tmp_list.empty()) {
-            SectionDesc* sp(tmp_list.back().pointer());
+        // scheduled sections and re-sort the schedule according to new due packet.
+        // Sections with the same new due packet remain in the same order.
+        SectionDescSchedule tmp_sched;
+        tmp_sched.swap(_sched_sections);
+        for (auto it = tmp_sched.begin(); it != tmp_sched.end(); ++it) {
+            SectionDesc* sp(it->second.pointer());
             sp->due_packet = sp->last_packet + PacketDistance(new_bitrate, sp->repetition);
-            addScheduledSection(tmp_list.back());
-            tmp_list.pop_back();
+            sp->sched_pos = _sched_sections.insert(std::make_pair(sp->due_packet, it->second));
         }
     }
 
@@ -307,10 +332,10 @@ void ts::CyclingPacketizer::provideSection(SectionCounter counter, SectionPtr& s
          // .. or previous unscheduled section passed in this cycle a long time ago
          spp->last_packet + spp->section->packetCount() + _sched_packets < current_packet);
 
-    if (!force_unscheduled && !_sched_sections.empty() && _sched_sections.front()->due_packet <= current_packet) {
+    if (!force_unscheduled && !_sched_sections.empty() && _sched_sections.begin()->first <= current_packet) {
         // One scheduled section is ready
-        sp = _sched_sections.front();
-        _sched_sections.pop_front();
+        sp = _sched_sections.begin()->second;
+        _sched_sections.erase(_sched_sections.begin());
         // Reschedule the section. Make sure we add at least one packet to
         // ensure that all scheduled sections may pass.
         sp->due_packet = current_packet + std::max(PacketCounter(1), PacketDistance(_bitrate, sp->repetition));
@@ -319,9 +344,8 @@ void ts::CyclingPacketizer::provideSection(SectionCounter counter, SectionPtr& s
     else if (!_other_sections.empty()) {
         // An unscheduled section is ready
         sp = _other_sections.front();
-        _other_sections.pop_front();
-        // Move section back at end of queue
-        _other_sections.push_back(sp);
+        // Move section back at end of queue, the position of the section remains valid.
+        _other_sections.splice(_other_sections.end(), _other_sections, _other_sections.begin());
     }
 
     if (sp.isNull()) {
@@ -404,8 +428,8 @@ std::ostream& ts::CyclingPacketizer::display(std::ostream& strm) const
         << "  Stored sections: " << _section_count << std::endl
         << "  Scheduled sections: " << _sched_sections.size() << std::endl
         << "  Scheduled packets max: " << _sched_packets << std::endl;
-    for (SectionDescList::const_iterator it = _sched_sections.begin(); it != _sched_sections.end(); ++it) {
-        (*it)->display(strm);
+    for (SectionDescSchedule::const_iterator it = _sched_sections.begin(); it != _sched_sections.end(); ++it) {
+        it->second->display(strm);
     }
     strm << "  Unscheduled sections: " << _other_sections.size() << std::endl;
     for (SectionDescList::const_iterator it = _other_sections.begin(); it != _other_sections.end(); ++it) {
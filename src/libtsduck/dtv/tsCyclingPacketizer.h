@@ -212,6 +212,20 @@ namespace ts {
         virtual std::ostream& display(std::ostream& strm) const override;
 
     private:
+        class SectionDesc;
+
+        // Safe pointer for SectionDesc (not thread-safe)
+        typedef SafePtr <SectionDesc, NullMutex> SectionDescPtr;
+
+        // Scheduled sections, sorted by due packet.
+        typedef std::multimap <PacketCounter, SectionDescPtr> SectionDescSchedule;
+
+        // List of unscheduled sections.
+        typedef std::list <SectionDescPtr> SectionDescList;
+
+        // All sections with the same table id and table id extension, indexed by (tid << 16) | tid_ext.
+        typedef std::map <uint32_t, std::list<SectionDescPtr>> SectionDescIndex;
+
         // Each section is identified by a SectionDesc instance
         class SectionDesc
         {
@@ -222,10 +236,13 @@ namespace ts {
             PacketCounter  last_packet; // Packet index of last time the section was sent
             PacketCounter  due_packet;  // Packet index of next time
             SectionCounter last_cycle;  // Cycle index of last time the section was sent
+            bool           scheduled;   // The section is in the schedule, not in the list of unscheduled sections
+            SectionDescSchedule::iterator sched_pos;  // Position in the schedule (when scheduled)
+            SectionDescList::iterator     other_pos;  // Position in the list of unscheduled sections (when not scheduled)
 
             // Constructor
             SectionDesc(const SectionPtr& sec, MilliSecond rep) :
-                section(sec), repetition(rep), last_packet(0), due_packet(0), last_cycle(0)
+                section(sec), repetition(rep), last_packet(0), due_packet(0), last_cycle(0), scheduled(false), sched_pos(), other_pos()
             {
             }
 
@@ -233,31 +250,31 @@ namespace ts {
             std::ostream& display(std::ostream&) const;
         };
 
-        // Safe pointer for SectionDesc (not thread-safe)
-        typedef SafePtr <SectionDesc, NullMutex> SectionDescPtr;
-
-        // List of sections
-        typedef std::list <SectionDescPtr> SectionDescList;
-
         // Private members:
-        StuffingPolicy  _stuffing;
-        BitRate         _bitrate;
-        size_t          _section_count;   // Number of sections in the 2 lists
-        SectionDescList _sched_sections;  // Scheduled sections, with repetition rates
-        SectionDescList _other_sections;  // Unscheduled sections
-        PacketCounter   _sched_packets;   // Size in TS packets of all sections in _sched_sections
-        SectionCounter  _current_cycle;   // Cycle number (start at 1, always increasing)
-        size_t          _remain_in_cycle; // Number of unsent sections in this cycle
-        SectionCounter  _cycle_end;       // At end of cycle, contains the index of last section
+        StuffingPolicy      _stuffing;
+        BitRate             _bitrate;
+        size_t              _section_count;   // Number of sections in the 2 lists
+        SectionDescSchedule _sched_sections;  // Scheduled sections, with repetition rates
+        SectionDescList     _other_sections;  // Unscheduled sections
+        SectionDescIndex    _index;           // All sections, by table id and table id extension
+        PacketCounter       _sched_packets;   // Size in TS packets of all sections in _sched_sections
+        SectionCounter      _current_cycle;   // Cycle number (start at 1, always increasing)
+        size_t              _remain_in_cycle; // Number of unsent sections in this cycle
+        SectionCounter      _cycle_end;       // At end of cycle, contains the index of last section
 
         static const SectionCounter UNDEFINED = ~SectionCounter(0);
 
-        // Insert a scheduled section in the list, sorted by due_packet,
-        // after other sections with the same due_packet.
+        // Insert a section in the schedule, sorted by due_packet, before other sections with the same due_packet.
         void addScheduledSection(const SectionDescPtr&);
 
-        // Remove all sections with the specified tid/tid_ext in the specified list.
-        void removeSections(SectionDescList&, TID, uint16_t tid_ext, bool use_tid_ext, bool scheduled);
+        // Insert a section at the end of the list of unscheduled sections.
+        void addOtherSection(const SectionDescPtr&);
+
+        // Remove a section from the schedule or the list of unscheduled sections.
+        void unlinkSection(SectionDesc&);
+
+        // Remove all sections with a tid/tid_ext in the specified range of index keys.
+        void removeIndexedSections(uint32_t first_key, uint32_t last_key);
 
         // Inherited from SectionProviderInterface
         virtual void provideSection(SectionCounter, SectionPtr&) override;
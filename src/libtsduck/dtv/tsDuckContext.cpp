@@ -85,6 +85,24 @@ void ts::DuckContext::reset()
 }
 
 
+//----------------------------------------------------------------------------
+// Copy the preferences of another TSDuck context.
+//----------------------------------------------------------------------------
+
+void ts::DuckContext::copyPreferences(const DuckContext& other)
+{
+    if (&other != this) {
+        _dvbCharsetIn = other._dvbCharsetIn;
+        _dvbCharsetOut = other._dvbCharsetOut;
+        _casId = other._casId;
+        _defaultPDS = other._defaultPDS;
+        _cmdStandards = other._cmdStandards;
+        _accStandards = other._accStandards;
+        _hfDefaultRegion = other._hfDefaultRegion;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Set a new report for log and error messages.
 //----------------------------------------------------------------------------
@@ -89,6 +89,15 @@ namespace ts {
         //!
         void reset();
 
+        //!
+        //! Copy the preferences of another TSDuck context.
+        //! The preferences are the character sets, default CAS id and PDS, standards and HF region.
+        //! The report and the output stream are unchanged. This is typically used to create
+        //! equivalent contexts for other threads since a context is not thread-safe.
+        //! @param [in] other Another context to copy.
+        //!
+        void copyPreferences(const DuckContext& other);
+
         //!
         //! Get the current report for log and error messages.
         //! @return A reference to the current output report.
@@ -31,6 +31,7 @@
 #include "tsSection.h"
 #include "tsTime.h"
 #include "tsMJD.h"
+#include "tsCRC32.h"
 #include "tsFatal.h"
 TSDUCK_SOURCE;
 
@@ -351,60 +352,97 @@ void ts::EITProcessor::handleSection(SectionDemux& demux, const Section& section
     }
 
     // At this point, we need to keep the section.
-    // Build a copy of it for insertion in the queue.
-    const SectionPtr sp(new Section(section, COPY));
+    // Check if the section will be modified: renamed EIT or shifted start times.
+    bool patch = false;
+    if (is_eit) {
+        patch = _start_time_offset != 0;
+        for (auto it = _renamed.begin(); !patch && it != _renamed.end(); ++it) {
+            patch = Match(it->first, srv_id, ts_id, net_id);
+        }
+    }
+
+    // Unmodified sections share the data of the demux, without copy.
+    // Modified sections are copied and patched in place. Since only a few bytes
+    // are modified, the CRC32 is updated from the patched bytes only.
+    const SectionPtr sp(new Section(section, patch ? COPY : SHARE));
     CheckNonNull(sp.pointer());
 
-    // Update the section if this is an EIT.
-    if (is_eit) {
-        // Recompute CRC at end only.
+    if (patch) {
+        const uint8_t* const old_data = section.content();
+        uint8_t* const new_data = const_cast<uint8_t*>(sp->content());
+        const size_t pl_offset = section.payload() - old_data;
+        const size_t crc_offset = section.size() - 4;
+        uint32_t crc = section.isLongSection() ? GetUInt32(old_data + crc_offset) : 0;
         bool modified = false;
 
+        // Save the bytes of an area before patching it. The same area may be patched several
+        // times (several renames for the same service), the CRC32 must be updated from the
+        // previous content of the area, not the original section.
+        uint8_t saved[MJD_SIZE];
+        auto saving = [&](size_t offset, size_t size) {
+            assert(size <= sizeof(saved));
+            ::memcpy(saved, new_data + offset, size);  // Flawfinder: ignore: memcpy()
+        };
+
+        // Update the CRC32 after patching 'size' bytes at offset 'offset' in the section.
+        auto patched = [&](size_t offset, size_t size) {
+            if (offset + size <= crc_offset) {
+                crc = CRC32::Update(crc, saved, new_data + offset, size, crc_offset - offset - size);
+            }
+            modified = true;
+        };
+
         // Rename EIT's.
         for (auto it = _renamed.begin(); it != _renamed.end(); ++it) {
             if (Match(it->first, srv_id, ts_id, net_id)) {
                 // Rename the specified fields.
                 if (it->second.hasId()) {
-                    modified = true;
-                    sp->setTableIdExtension(it->second.getId(), false);
+                    saving(3, 2);
+                    PutUInt16(new_data + 3, it->second.getId());
+                    patched(3, 2);
                 }
                 if (it->second.hasTSId()) {
-                    modified = true;
-                    sp->setUInt16(0, it->second.getTSId(), false);
+                    saving(pl_offset, 2);
+                    PutUInt16(new_data + pl_offset, it->second.getTSId());
+                    patched(pl_offset, 2);
                 }
                 if (it->second.hasONId()) {
-                    modified = true;
-                    sp->setUInt16(2, it->second.getONId(), false);
+                    saving(pl_offset + 2, 2);
+                    PutUInt16(new_data + pl_offset + 2, it->second.getONId());
+                    patched(pl_offset + 2, 2);
                 }
             }
         }
 
         // Update all events start times.
         if (_start_time_offset != 0) {
-            uint8_t* data = const_cast<uint8_t*>(sp->payload() + 6);
-            const uint8_t* const end = sp->payload() + sp->payloadSize();
-            while (data + 12 <= end) {
+            size_t offset = pl_offset + 6;
+            const size_t end = pl_offset + pl_size;
+            while (offset + 12 <= end) {
                 // Update event start time.
                 Time time;
-                if (!DecodeMJD(data + 2, MJD_SIZE, time)) {
+                if (!DecodeMJD(new_data + offset + 2, MJD_SIZE, time)) {
                     _duck.report().warning(u"error decoding event start time from EIT");
                 }
                 else {
                     time += _start_time_offset;
-                    if (!EncodeMJD(time, data + 2, _date_only ? MJD_MIN_SIZE : MJD_SIZE)) {
+                    saving(offset + 2, MJD_SIZE);
+                    if (!EncodeMJD(time, new_data + offset + 2, _date_only ? MJD_MIN_SIZE : MJD_SIZE)) {
+                        // The MJD field was zeroed.
                         _duck.report().warning(u"error encoding event start time into EIT");
+                        patched(offset + 2, MJD_SIZE);
                     }
                     else {
-                        modified = true;
+                        patched(offset + 2, _date_only ? MJD_MIN_SIZE : MJD_SIZE);
                     }
                 }
-                data += 12 + (GetUInt16(data + 10) & 0x0FFF);
+                offset += 12 + (GetUInt16(new_data + offset + 10) & 0x0FFF);
             }
         }
 
-        // Update CRC if the section was modified.
-        if (modified) {
-            sp->recomputeCRC();
+        // Store the updated CRC if the section was modified.
+        if (modified && section.isLongSection()) {
+            PutUInt32(new_data + crc_offset, crc);
         }
     }
 
@@ -55,25 +55,27 @@ ts::NamesOUI::~NamesOUI() {}
 
 bool ts::names::HasTableSpecificName(uint8_t did, uint8_t tid)
 {
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"DescriptorId"));
     return tid != TID_NULL &&
         did < 0x80 &&
-        NamesMain::Instance()->nameExists(u"DescriptorId", (Names::Value(tid) << 40) | TS_UCONST64(0x000000FFFFFFFF00) | Names::Value(did));
+        NamesMain::Instance()->nameExists(section, (Names::Value(tid) << 40) | TS_UCONST64(0x000000FFFFFFFF00) | Names::Value(did));
 }
 
 ts::UString ts::names::DID(uint8_t did, uint32_t pds, uint8_t tid, Flags flags)
 {
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"DescriptorId"));
     if (did >= 0x80 && pds != 0 && pds != PDS_NULL) {
         // If this is a private descriptor, only consider the private value.
         // Do not fallback because the same value with PDS == 0 can be different.
-        return NamesMain::Instance()->nameFromSection(u"DescriptorId", (Names::Value(pds) << 8) | Names::Value(did), flags, 8);
+        return NamesMain::Instance()->nameFromSection(section, (Names::Value(pds) << 8) | Names::Value(did), flags, 8);
     }
     else if (tid != 0xFF) {
         // Could be a table-specific descriptor.
         const Names::Value fullValue = (Names::Value(tid) << 40) | TS_UCONST64(0x000000FFFFFFFF00) | Names::Value(did);
-        return NamesMain::Instance()->nameFromSectionWithFallback(u"DescriptorId", fullValue, Names::Value(did), flags, 8);
+        return NamesMain::Instance()->nameFromSectionWithFallback(section, fullValue, Names::Value(did), flags, 8);
     }
     else {
-        return NamesMain::Instance()->nameFromSection(u"DescriptorId", Names::Value(did), flags, 8);
+        return NamesMain::Instance()->nameFromSection(section, Names::Value(did), flags, 8);
     }
 }
 
@@ -83,158 +85,189 @@ ts::UString ts::names::DID(uint8_t did, uint32_t pds, uint8_t tid, Flags flags)
 
 ts::UString ts::names::TID(uint8_t tid, uint16_t cas, Flags flags)
 {
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"TableId"));
     // Use version with CAS first, then without CAS.
-    return NamesMain::Instance()->nameFromSectionWithFallback(u"TableId", (Names::Value(CASFamilyOf(cas)) << 8) | Names::Value(tid), Names::Value(tid), flags, 8);
+    return NamesMain::Instance()->nameFromSectionWithFallback(section, (Names::Value(CASFamilyOf(cas)) << 8) | Names::Value(tid), Names::Value(tid), flags, 8);
 }
 
 ts::UString ts::names::EDID(uint8_t edid, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"DVBExtendedDescriptorId", Names::Value(edid), flags, 8);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"DVBExtendedDescriptorId"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(edid), flags, 8);
 }
 
 ts::UString ts::names::StreamType(uint8_t type, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"StreamType", Names::Value(type), flags, 8);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"StreamType"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(type), flags, 8);
 }
 
 ts::UString ts::names::Content(uint8_t x, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"ContentId", Names::Value(x), flags, 8);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"ContentId"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(x), flags, 8);
 }
 
 ts::UString ts::names::PrivateDataSpecifier(uint32_t pds, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"PrivateDataSpecifier", Names::Value(pds), flags, 32);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"PrivateDataSpecifier"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(pds), flags, 32);
 }
 
 ts::UString ts::names::CASFamily(ts::CASFamily cas)
 {
-    return NamesMain::Instance()->nameFromSection(u"CASFamily", Names::Value(cas), NAME | DECIMAL);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"CASFamily"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(cas), NAME | DECIMAL);
 }
 
 ts::UString ts::names::CASId(uint16_t id, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"CASystemId", Names::Value(id), flags, 16);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"CASystemId"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(id), flags, 16);
 }
 
 ts::UString ts::names::BouquetId(uint16_t id, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"BouquetId", Names::Value(id), flags, 16);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"BouquetId"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(id), flags, 16);
 }
 
 ts::UString ts::names::OriginalNetworkId(uint16_t id, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"OriginalNetworkId", Names::Value(id), flags, 16);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"OriginalNetworkId"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(id), flags, 16);
 }
 
 ts::UString ts::names::NetworkId(uint16_t id, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"NetworkId", Names::Value(id), flags, 16);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"NetworkId"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(id), flags, 16);
 }
 
 ts::UString ts::names::PlatformId(uint32_t id, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"PlatformId", Names::Value(id), flags, 24);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"PlatformId"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(id), flags, 24);
 }
 
 ts::UString ts::names::DataBroadcastId(uint16_t id, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"DataBroadcastId", Names::Value(id), flags, 16);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"DataBroadcastId"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(id), flags, 16);
 }
 
 ts::UString ts::names::OUI(uint32_t oui, Flags flags)
 {
-    return NamesOUI::Instance()->nameFromSection(u"OUI", Names::Value(oui), flags, 24);
+    static const Names::SectionHandle section(NamesOUI::Instance()->sectionHandle(u"OUI"));
+    return NamesOUI::Instance()->nameFromSection(section, Names::Value(oui), flags, 24);
 }
 
 ts::UString ts::names::StreamId(uint8_t sid, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"StreamId", Names::Value(sid), flags, 8);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"StreamId"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(sid), flags, 8);
 }
 
 ts::UString ts::names::PESStartCode(uint8_t code, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"PESStartCode", Names::Value(code), flags, 8);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"PESStartCode"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(code), flags, 8);
 }
 
 ts::UString ts::names::AspectRatio(uint8_t ar, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"AspectRatio", Names::Value(ar), flags, 8);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"AspectRatio"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(ar), flags, 8);
 }
 
 ts::UString ts::names::ChromaFormat(uint8_t cf, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"ChromaFormat", Names::Value(cf), flags, 8);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"ChromaFormat"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(cf), flags, 8);
 }
 
 ts::UString ts::names::AVCUnitType(uint8_t type, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"AVCUnitType", Names::Value(type), flags, 8);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"AVCUnitType"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(type), flags, 8);
 }
 
 ts::UString ts::names::AVCProfile(int profile, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"AVCProfile", Names::Value(profile), flags, 8);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"AVCProfile"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(profile), flags, 8);
 }
 
 ts::UString ts::names::ServiceType(uint8_t type, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"ServiceType", Names::Value(type), flags, 8);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"ServiceType"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(type), flags, 8);
 }
 
 ts::UString ts::names::LinkageType(uint8_t type, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"LinkageType", Names::Value(type), flags, 8);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"LinkageType"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(type), flags, 8);
 }
 
 ts::UString ts::names::TeletextType(uint8_t type, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"TeletextType", Names::Value(type), flags, 8);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"TeletextType"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(type), flags, 8);
 }
 
 ts::UString ts::names::RunningStatus(uint8_t status, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"RunningStatus", Names::Value(status), flags, 8);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"RunningStatus"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(status), flags, 8);
 }
 
 ts::UString ts::names::AudioType(uint8_t type, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"AudioType", Names::Value(type), flags, 8);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"AudioType"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(type), flags, 8);
 }
 
 ts::UString ts::names::SubtitlingType(uint8_t type, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"SubtitlingType", Names::Value(type), flags, 8);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"SubtitlingType"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(type), flags, 8);
 }
 
 ts::UString ts::names::DTSSampleRateCode(uint8_t x, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"DTSSampleRate", Names::Value(x), flags, 8);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"DTSSampleRate"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(x), flags, 8);
 }
 
 ts::UString ts::names::DTSBitRateCode(uint8_t x, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"DTSBitRate", Names::Value(x), flags, 8);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"DTSBitRate"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(x), flags, 8);
 }
 
 ts::UString ts::names::DTSSurroundMode(uint8_t x, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"DTSSurroundMode", Names::Value(x), flags, 8);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"DTSSurroundMode"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(x), flags, 8);
 }
 
 ts::UString ts::names::DTSExtendedSurroundMode(uint8_t x, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"DTSExtendedSurroundMode", Names::Value(x), flags, 8);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"DTSExtendedSurroundMode"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(x), flags, 8);
 }
 
 ts::UString ts::names::ScramblingControl(uint8_t scv, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"ScramblingControl", Names::Value(scv), flags, 8);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"ScramblingControl"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(scv), flags, 8);
 }
 
 ts::UString ts::names::T2MIPacketType(uint8_t type, Flags flags)
 {
-    return NamesMain::Instance()->nameFromSection(u"T2MIPacketType", Names::Value(type), flags, 8);
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"T2MIPacketType"));
+    return NamesMain::Instance()->nameFromSection(section, Names::Value(type), flags, 8);
 }
 
 
@@ -244,6 +277,7 @@ ts::UString ts::names::T2MIPacketType(uint8_t type, Flags flags)
 
 ts::UString ts::names::ComponentType(uint16_t type, Flags flags)
 {
+    static const Names::SectionHandle section(NamesMain::Instance()->sectionHandle(u"ComponentType"));
     // There is a special case here. The binary layout of the 16 bits are:
     //   stream_content_ext (4 bits)
     //   stream_content (4 bits)
@@ -276,7 +310,7 @@ ts::UString ts::names::ComponentType(uint16_t type, Flags flags)
         return AC3ComponentType(nType & 0x00FF, flags);
     }
     else {
-        return NamesMain::Instance()->nameFromSection(u"ComponentType", Names::Value(nType), flags | names::ALTERNATE, 16, dType);
+        return NamesMain::Instance()->nameFromSection(section, Names::Value(nType), flags | names::ALTERNATE, 16, dType);
     }
 }
 
@@ -319,26 +353,310 @@ ts::UString ts::names::AC3ComponentType(uint8_t type, Flags flags)
 }
 
 
+//----------------------------------------------------------------------------
+// Layout of the binary image of a names file.
+//----------------------------------------------------------------------------
+//
+// All integers are in native byte order and all structures are 8-byte aligned.
+// The image starts with a header, followed by the displacement buckets and the
+// slots of the section table, the same for the values of each section, and the
+// pool of names in UTF-16.
+//
+// The section table and the single values of each section are perfect hash
+// tables: the slot of a key is Hash(key, bucket[Hash(key, 0) % bucket_count])
+// modulo the number of slots, where bucket[] is the table of displacements
+// which was computed when the image was built. Unused slots have an empty name.
+// The value ranges (first < last) of each section are stored in a separate
+// table, sorted by first value, and searched by dichotomy.
+//
+// Offsets are from the beginning of the image, except names offsets which are
+// in characters from the beginning of the pool of names.
+
+const ts::UChar* const ts::Names::IMAGE_SUFFIX = u".bin";
+
+struct ts::Names::ImageHeader
+{
+    uint32_t magic;            // IMAGE_MAGIC, also checks the byte order.
+    uint32_t version;          // IMAGE_VERSION.
+    uint64_t source_size;      // Size in bytes of the source configuration file.
+    uint64_t source_hash;      // Hash of the content of the source configuration file.
+    uint64_t image_size;       // Total size in bytes of the image.
+    uint32_t section_slots;    // Number of slots in the section table.
+    uint32_t section_buckets;  // Number of displacement buckets for the section table.
+    uint32_t buckets_offset;   // Offset of displacement buckets (uint32_t) for the section table.
+    uint32_t sections_offset;  // Offset of the section table (ImageSection).
+    uint32_t strings_offset;   // Offset of the pool of names (UChar).
+    uint32_t strings_length;   // Number of characters in the pool of names.
+};
+
+struct ts::Names::ImageSection
+{
+    uint64_t name_hash;        // Hash of the lower-case section name.
+    uint32_t name_offset;      // Offset of the lower-case section name in the pool.
+    uint32_t name_length;      // Length of the section name, zero for unused slots.
+    uint32_t bits;             // Number of significant bits in values.
+    uint32_t value_slots;      // Number of slots in the value table.
+    uint32_t value_buckets;    // Number of displacement buckets for the value table.
+    uint32_t buckets_offset;   // Offset of displacement buckets (uint32_t) for the value table.
+    uint32_t values_offset;    // Offset of the value table (ImageValue).
+    uint32_t range_count;      // Number of value ranges.
+    uint32_t ranges_offset;    // Offset of the range table (ImageRange).
+    uint32_t reserved;         // Padding.
+};
+
+struct ts::Names::ImageValue
+{
+    uint64_t value;            // Value.
+    uint32_t name_offset;      // Offset of the name in the pool.
+    uint32_t name_length;      // Length of the name, zero for unused slots.
+};
+
+struct ts::Names::ImageRange
+{
+    uint64_t first;            // First value in the range.
+    uint64_t last;             // Last value in the range.
+    uint32_t name_offset;      // Offset of the name in the pool.
+    uint32_t name_length;      // Length of the name.
+};
+
+namespace {
+    const uint32_t IMAGE_MAGIC = 0x4D4E5354;  // "TSNM" in little endian.
+    const uint32_t IMAGE_VERSION = 2;
+    const uint32_t MAX_DISPLACEMENT = 0x00100000;
+
+    // Hash a key with a seed (finalizer of splitmix64).
+    inline uint64_t HashKey(uint64_t key, uint32_t seed)
+    {
+        key += uint64_t(seed + 1) * TS_UCONST64(0x9E3779B97F4A7C15);
+        key = (key ^ (key >> 30)) * TS_UCONST64(0xBF58476D1CE4E5B9);
+        key = (key ^ (key >> 27)) * TS_UCONST64(0x94D049BB133111EB);
+        return key ^ (key >> 31);
+    }
+
+    // Get the size and a hash of the content of a file (FNV-1a on 64-bit words).
+    // Return false if the file cannot be read.
+    bool HashFile(const ts::UString& fileName, uint64_t& size, uint64_t& hash)
+    {
+        ts::ByteBlock data;
+        if (!data.loadFromFile(fileName)) {
+            return false;
+        }
+        size = data.size();
+        hash = TS_UCONST64(0xCBF29CE484222325);
+        size_t i = 0;
+        for (; i + 8 <= data.size(); i += 8) {
+            uint64_t word = 0;
+            ::memcpy(&word, data.data() + i, 8);  // Flawfinder: ignore: memcpy()
+            hash = (hash ^ word) * TS_UCONST64(0x00000100000001B3);
+        }
+        for (; i < data.size(); ++i) {
+            hash = (hash ^ data[i]) * TS_UCONST64(0x00000100000001B3);
+        }
+        hash = HashKey(hash, 0);
+        return true;
+    }
+
+    // Get the slot of a key in a perfect hash table.
+    inline size_t HashSlot(uint64_t key, const uint32_t* buckets, size_t bucket_count, size_t slot_count)
+    {
+        return size_t(HashKey(key, buckets[HashKey(key, 0) % bucket_count]) % slot_count);
+    }
+
+    // Hash a section name (FNV-1a), not case-sensitive, ignoring leading and trailing spaces.
+    // Return the hash and the position of the significant part of the name.
+    uint64_t HashName(const ts::UString& name, size_t& start, size_t& length)
+    {
+        start = 0;
+        size_t end = name.length();
+        while (start < end && ts::IsSpace(name[start])) {
+            start++;
+        }
+        while (end > start && ts::IsSpace(name[end - 1])) {
+            end--;
+        }
+        length = end - start;
+        uint64_t hash = TS_UCONST64(0xCBF29CE484222325);
+        for (size_t i = start; i < end; ++i) {
+            hash ^= uint64_t(ts::ToLower(name[i]));
+            hash *= TS_UCONST64(0x00000100000001B3);
+        }
+        return hash;
+    }
+
+    // Build a perfect hash table from distinct keys, using the "hash and displace" method.
+    // On output, slots[i] is the index of the key in slot i or NPOS for unused slots.
+    bool BuildPerfectHash(const std::vector<uint64_t>& keys, std::vector<uint32_t>& buckets, std::vector<size_t>& slots)
+    {
+        // Load factor of 80%, about 4 keys per bucket.
+        const size_t slot_count = keys.size() + keys.size() / 4 + 1;
+        const size_t bucket_count = keys.size() / 4 + 1;
+
+        // Distribute the keys in buckets.
+        std::vector<std::vector<size_t>> content(bucket_count);
+        for (size_t i = 0; i < keys.size(); ++i) {
+            content[HashKey(keys[i], 0) % bucket_count].push_back(i);
+        }
+
+        // Place the largest buckets first, while there are many free slots.
+        std::vector<size_t> order(bucket_count);
+        for (size_t b = 0; b < bucket_count; ++b) {
+            order[b] = b;
+        }
+        std::stable_sort(order.begin(), order.end(), [&content](size_t b1, size_t b2) { return content[b1].size() > content[b2].size(); });
+
+        // For each bucket, find a displacement which moves all its keys into free slots.
+        buckets.assign(bucket_count, 0);
+        slots.assign(slot_count, ts::NPOS);
+        std::vector<size_t> used;
+        for (auto b = order.begin(); b != order.end() && !content[*b].empty(); ++b) {
+            bool placed = false;
+            for (uint32_t disp = 1; !placed && disp < MAX_DISPLACEMENT; ++disp) {
+                placed = true;
+                used.clear();
+                for (auto k = content[*b].begin(); placed && k != content[*b].end(); ++k) {
+                    const size_t s = size_t(HashKey(keys[*k], disp) % slot_count);
+                    if (slots[s] == ts::NPOS) {
+                        slots[s] = *k;
+                        used.push_back(s);
+                    }
+                    else {
+                        placed = false;
+                    }
+                }
+                if (placed) {
+                    buckets[*b] = disp;
+                }
+                else {
+                    for (auto s = used.begin(); s != used.end(); ++s) {
+                        slots[*s] = ts::NPOS;
+                    }
+                }
+            }
+            if (!placed) {
+                // Should not happen with distinct keys.
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // Helper to build an image: append aligned data, return the offset.
+    size_t AppendAligned(ts::ByteBlock& image, const void* data, size_t size, size_t alignment = 8)
+    {
+        image.resize(image.size() + (alignment - image.size() % alignment) % alignment, 0);
+        const size_t offset = image.size();
+        image.append(data, size);
+        return offset;
+    }
+
+    // Helper to build an image: pool of names, same names are stored once.
+    class NamesPool
+    {
+    public:
+        NamesPool() : _pool(), _index() {}
+        const ts::UString& pool() const { return _pool; }
+        uint32_t add(const ts::UString& name)
+        {
+            const auto it = _index.find(name);
+            if (it != _index.end()) {
+                return it->second;
+            }
+            const uint32_t offset = uint32_t(_pool.length());
+            _pool.append(name);
+            _index.insert(std::make_pair(name, offset));
+            return offset;
+        }
+    private:
+        ts::UString _pool;
+        std::map<ts::UString, uint32_t> _index;
+    };
+}
+
+
+//----------------------------------------------------------------------------
+// Description of a configuration section.
+//----------------------------------------------------------------------------
+
+class ts::Names::ConfigSection
+{
+    TS_NOCOPY(ConfigSection);
+public:
+    UString             name;      // Lower-case section name.
+    size_t              bits;      // Number of significant bits in values of the type.
+    ConfigEntryMap      entries;   // Entries from text files, indexed by first value.
+    const uint8_t*      image;     // Base address of the image, null if the section is not in the image.
+    const ImageSection* section;   // Description of the section in the image.
+    const UChar*        strings;   // Pool of names in the image.
+    size_t              strings_length;
+
+    ConfigSection(const UString& n);
+    ~ConfigSection();
+
+    // Check if a range is free, ie no value is defined in the range.
+    bool freeRange(Value first, Value last) const;
+
+    // Add a new entry.
+    void addEntry(Value first, Value last, const UString& n);
+
+    // Get a name from a value, empty if not found.
+    UString getName(Value val) const;
+
+private:
+    // Get a name from the pool of the image.
+    UString imageName(uint32_t offset, uint32_t length) const;
+};
+
+
 //----------------------------------------------------------------------------
 // Constructor (load the configuration file).
 //----------------------------------------------------------------------------
 
-ts::Names::Names(const UString& fileName, bool mergeExtensions) :
+ts::Names::Names(const UString& fileName, bool mergeExtensions, bool useImage) :
     _log(CERR),
     _configFile(SearchConfigurationFile(fileName)),
+    _imageFile(),
     _configErrors(0),
-    _sections()
+    _sections(),
+    _imageSections(),
+    _imageData(),
+    _image(nullptr),
+    _imageSize(0),
+    _mapAddress(nullptr)
 {
-    // Locate the configuration file.
-    if (_configFile.empty()) {
+    // Use the compiled image if there is one, built from the same configuration file:
+    // same size and same content hash. Hashing the text file is much faster than parsing it.
+    const UString imageFile(useImage ? SearchConfigurationFile(fileName + IMAGE_SUFFIX) : UString());
+    if (!imageFile.empty() && mapImage(imageFile)) {
+        const ImageHeader* const header = reinterpret_cast<const ImageHeader*>(_image);
+        uint64_t size = 0;
+        uint64_t hash = 0;
+        const bool same_source = _configFile.empty() ||
+            (header->source_size == uint64_t(GetFileSize(_configFile)) &&
+             HashFile(_configFile, size, hash) &&
+             header->source_size == size &&
+             header->source_hash == hash);
+        if (same_source && attachImage()) {
+            _imageFile = imageFile;
+        }
+        else {
+            _log.debug(u"ignoring obsolete or invalid names image %s", {imageFile});
+            unmapImage();
+        }
+    }
+
+    if (!_imageFile.empty()) {
+        // Names were loaded from the image.
+    }
+    else if (_configFile.empty()) {
         // Cannot load configuration, names will not be available.
         _log.error(u"configuration file '%s' not found", {fileName});
     }
     else {
+        // Parse the text file. The image is built only when saved.
         loadFile(_configFile);
     }
 
-    // Merge extensions if required.
+    // Merge extensions if required. Their names overlay the names from the image.
     if (mergeExtensions) {
         // Get list of extension names.
         UStringList files;
@@ -394,7 +712,7 @@ void ts::Names::loadFile(const UString& fileName)
             }
             else {
                 // Create new section.
-                section = new ConfigSection;
+                section = new ConfigSection(line);
                 CheckNonNull(section);
                 _sections.insert(std::make_pair(line, section));
             }
@@ -451,7 +769,7 @@ bool ts::Names::decodeDefinition(const UString& line, ConfigSection* section)
         valid = range.substr(0, dash).toInteger(first) && range.substr(dash + 1).toInteger(last) && last >= first;
     }
 
-    // Add the definition.
+    // Add the definition. Ranges from extensions may overlap ranges from the image.
     if (valid) {
         if (section->freeRange(first, last)) {
             section->addEntry(first, last, value);
@@ -471,11 +789,286 @@ bool ts::Names::decodeDefinition(const UString& line, ConfigSection* section)
 
 ts::Names::~Names()
 {
-    // Deallocate all configuration sections.
+    clearSections();
+    unmapImage();
+}
+
+// Deallocate all configuration sections.
+void ts::Names::clearSections()
+{
     for (ConfigSectionMap::iterator it = _sections.begin(); it != _sections.end(); ++it) {
         delete it->second;
     }
     _sections.clear();
+    _imageSections.clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Build an image from the entries which were loaded from the text file.
+//----------------------------------------------------------------------------
+
+bool ts::Names::buildImage(ByteBlock& image) const
+{
+    NamesPool pool;
+    image.clear();
+
+    // Build the perfect hash table of section names.
+    std::vector<ConfigSection*> sections;
+    std::vector<uint64_t> keys;
+    for (auto it = _sections.begin(); it != _sections.end(); ++it) {
+        size_t start = 0;
+        size_t length = 0;
+        sections.push_back(it->second);
+        keys.push_back(HashName(it->first, start, length));
+    }
+    std::vector<uint32_t> buckets;
+    std::vector<size_t> slots;
+    if (!BuildPerfectHash(keys, buckets, slots)) {
+        return false;
+    }
+
+    // The header and the section table are filled at the end.
+    ImageHeader header;
+    TS_ZERO(header);
+    image.resize(sizeof(header), 0);
+    header.section_slots = uint32_t(slots.size());
+    header.section_buckets = uint32_t(buckets.size());
+    header.buckets_offset = uint32_t(AppendAligned(image, buckets.data(), buckets.size() * sizeof(uint32_t)));
+    std::vector<ImageSection> section_table(slots.size());  // value-initialized, all zero
+    header.sections_offset = uint32_t(AppendAligned(image, section_table.data(), section_table.size() * sizeof(ImageSection)));
+
+    // Build the tables of all sections.
+    for (size_t slot = 0; slot < slots.size(); ++slot) {
+        if (slots[slot] == NPOS) {
+            continue;
+        }
+        const ConfigSection* const section = sections[slots[slot]];
+        ImageSection& desc(section_table[slot]);
+        desc.name_hash = keys[slots[slot]];
+        desc.name_offset = pool.add(section->name);
+        desc.name_length = uint32_t(section->name.length());
+        desc.bits = uint32_t(section->bits);
+
+        // Single values go in a perfect hash table, ranges are sorted by first value.
+        std::vector<uint64_t> values;
+        std::vector<const ConfigEntry*> value_entries;
+        std::vector<ImageRange> ranges;
+        for (auto it = section->entries.begin(); it != section->entries.end(); ++it) {
+            if (it->first == it->second->last) {
+                values.push_back(it->first);
+                value_entries.push_back(it->second);
+            }
+            else {
+                ImageRange range;
+                range.first = it->first;
+                range.last = it->second->last;
+                range.name_offset = pool.add(it->second->name);
+                range.name_length = uint32_t(it->second->name.length());
+                ranges.push_back(range);
+            }
+        }
+        std::vector<uint32_t> value_buckets;
+        std::vector<size_t> value_slots;
+        if (!BuildPerfectHash(values, value_buckets, value_slots)) {
+            return false;
+        }
+        std::vector<ImageValue> value_table(value_slots.size());
+        for (size_t i = 0; i < value_slots.size(); ++i) {
+            ImageValue& val(value_table[i]);
+            if (value_slots[i] == NPOS) {
+                val.value = 0;
+                val.name_offset = val.name_length = 0;
+            }
+            else {
+                val.value = values[value_slots[i]];
+                val.name_offset = pool.add(value_entries[value_slots[i]]->name);
+                val.name_length = uint32_t(value_entries[value_slots[i]]->name.length());
+            }
+        }
+        desc.value_slots = uint32_t(value_slots.size());
+        desc.value_buckets = uint32_t(value_buckets.size());
+        desc.buckets_offset = uint32_t(AppendAligned(image, value_buckets.data(), value_buckets.size() * sizeof(uint32_t)));
+        desc.values_offset = uint32_t(AppendAligned(image, value_table.data(), value_table.size() * sizeof(ImageValue)));
+        desc.range_count = uint32_t(ranges.size());
+        desc.ranges_offset = uint32_t(AppendAligned(image, ranges.data(), ranges.size() * sizeof(ImageRange)));
+    }
+
+    // Pool of names at end of image.
+    header.strings_length = uint32_t(pool.pool().length());
+    header.strings_offset = uint32_t(AppendAligned(image, pool.pool().data(), pool.pool().length() * sizeof(UChar)));
+
+    // Now fill the header and section table.
+    header.magic = IMAGE_MAGIC;
+    header.version = IMAGE_VERSION;
+    if (!HashFile(_configFile, header.source_size, header.source_hash)) {
+        header.source_size = header.source_hash = 0;
+    }
+    header.image_size = image.size();
+    ::memcpy(image.data(), &header, sizeof(header));
+    ::memcpy(image.data() + header.sections_offset, section_table.data(), section_table.size() * sizeof(ImageSection));
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Memory-map an image file.
+//----------------------------------------------------------------------------
+
+bool ts::Names::mapImage(const UString& fileName)
+{
+    unmapImage();
+
+#if defined(TS_WINDOWS)
+
+    // No memory mapping, load the complete file.
+    if (!_imageData.loadFromFile(fileName) || _imageData.size() < sizeof(ImageHeader)) {
+        _imageData.clear();
+        return false;
+    }
+    _image = _imageData.data();
+    _imageSize = _imageData.size();
+
+#else
+
+    const int fd = ::open(fileName.toUTF8().c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < off_t(sizeof(ImageHeader))) {
+        ::close(fd);
+        return false;
+    }
+    void* const addr = ::mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (addr == MAP_FAILED) {
+        return false;
+    }
+    _mapAddress = addr;
+    _image = reinterpret_cast<const uint8_t*>(addr);
+    _imageSize = size_t(st.st_size);
+
+#endif
+
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Release the image.
+//----------------------------------------------------------------------------
+
+void ts::Names::unmapImage()
+{
+#if !defined(TS_WINDOWS)
+    if (_mapAddress != nullptr) {
+        ::munmap(_mapAddress, _imageSize);
+    }
+#endif
+    _mapAddress = nullptr;
+    _imageData.clear();
+    _image = nullptr;
+    _imageSize = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Attach the sections of the image to this instance.
+//----------------------------------------------------------------------------
+
+bool ts::Names::attachImage()
+{
+    // Check that a table is entirely inside the image.
+    const auto inside = [this](uint64_t offset, uint64_t count, size_t size, size_t alignment) {
+        return offset % alignment == 0 && offset <= _imageSize && count <= (_imageSize - offset) / size;
+    };
+
+    // Check the header.
+    const ImageHeader* const header = reinterpret_cast<const ImageHeader*>(_image);
+    if (_image == nullptr ||
+        _imageSize < sizeof(ImageHeader) ||
+        header->magic != IMAGE_MAGIC ||
+        header->version != IMAGE_VERSION ||
+        header->image_size != _imageSize ||
+        header->section_slots == 0 ||
+        header->section_buckets == 0 ||
+        !inside(header->buckets_offset, header->section_buckets, sizeof(uint32_t), 4) ||
+        !inside(header->sections_offset, header->section_slots, sizeof(ImageSection), 8) ||
+        !inside(header->strings_offset, header->strings_length, sizeof(UChar), 2))
+    {
+        return false;
+    }
+
+    // Check all sections before creating any of them. The values are only checked on access.
+    const ImageSection* const sections = reinterpret_cast<const ImageSection*>(_image + header->sections_offset);
+    for (size_t i = 0; i < header->section_slots; ++i) {
+        const ImageSection& sec(sections[i]);
+        if (sec.name_length > 0 &&
+            (sec.name_offset > header->strings_length ||
+             sec.name_length > header->strings_length - sec.name_offset ||
+             sec.value_slots == 0 ||
+             sec.value_buckets == 0 ||
+             !inside(sec.buckets_offset, sec.value_buckets, sizeof(uint32_t), 4) ||
+             !inside(sec.values_offset, sec.value_slots, sizeof(ImageValue), 8) ||
+             !inside(sec.ranges_offset, sec.range_count, sizeof(ImageRange), 8)))
+        {
+            return false;
+        }
+    }
+
+    // Create the sections.
+    const UChar* const strings = reinterpret_cast<const UChar*>(_image + header->strings_offset);
+    _imageSections.assign(header->section_slots, nullptr);
+    for (size_t i = 0; i < header->section_slots; ++i) {
+        const ImageSection& sec(sections[i]);
+        if (sec.name_length > 0) {
+            ConfigSection* const section = new ConfigSection(UString(strings + sec.name_offset, sec.name_length));
+            CheckNonNull(section);
+            section->bits = sec.bits;
+            section->image = _image;
+            section->section = &sec;
+            section->strings = strings;
+            section->strings_length = header->strings_length;
+            _imageSections[i] = section;
+            _sections.insert(std::make_pair(section->name, section));
+        }
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Save the compiled image of the configuration file.
+//----------------------------------------------------------------------------
+
+bool ts::Names::saveImage(const UString& fileName, Report& report) const
+{
+    // Save the memory-mapped image or build it from the entries of the text file.
+    ByteBlock built;
+    const uint8_t* image = _image;
+    size_t size = _imageSize;
+    if (image == nullptr) {
+        if (_sections.empty() || !buildImage(built)) {
+            report.error(u"cannot build names image from %s", {_configFile});
+            return false;
+        }
+        image = built.data();
+        size = built.size();
+    }
+
+    std::ofstream strm(fileName.toUTF8().c_str(), std::ios::out | std::ios::binary);
+    if (!strm) {
+        report.error(u"error creating file %s", {fileName});
+        return false;
+    }
+    strm.write(reinterpret_cast<const char*>(image), std::streamsize(size));
+    strm.close();
+    if (!strm) {
+        report.error(u"error writing file %s", {fileName});
+        return false;
+    }
+    return true;
 }
 
 
@@ -494,9 +1087,14 @@ ts::Names::ConfigEntry::ConfigEntry(Value l, const UString& n) :
 // Configuration section.
 //----------------------------------------------------------------------------
 
-ts::Names::ConfigSection::ConfigSection() :
+ts::Names::ConfigSection::ConfigSection(const UString& n) :
+    name(n),
     bits(0),
-    entries()
+    entries(),
+    image(nullptr),
+    section(nullptr),
+    strings(nullptr),
+    strings_length(0)
 {
 }
 
@@ -540,9 +1138,9 @@ bool ts::Names::ConfigSection::freeRange(Value first, Value last) const
 // Add a new configuration entry.
 //----------------------------------------------------------------------------
 
-void ts::Names::ConfigSection::addEntry(Value first, Value last, const UString& name)
+void ts::Names::ConfigSection::addEntry(Value first, Value last, const UString& n)
 {
-    ConfigEntry* entry = new ConfigEntry(last, name);
+    ConfigEntry* entry = new ConfigEntry(last, n);
     CheckNonNull(entry);
     entries.insert(std::make_pair(first, entry));
 }
@@ -554,25 +1152,41 @@ void ts::Names::ConfigSection::addEntry(Value first, Value last, const UString&
 
 ts::UString ts::Names::ConfigSection::getName(Value val) const
 {
-    // Eliminate trivial cases which would cause issues with code below.
-    if (entries.empty()) {
-        return UString();
+    // The entries from text files take precedence over the image.
+    if (!entries.empty()) {
+        // The key in the 'entries' map is the _first_ value of a range.
+        // Get the last range which starts at or before 'val'.
+        ConfigEntryMap::const_iterator it = entries.upper_bound(val);
+        if (it != entries.begin() && val <= (--it)->second->last) {
+            return it->second->name;
+        }
     }
 
-    // The key in the 'entries' map is the _first_ value of a range.
-    // Get an iterator pointing to the first element that is "not less" than 'val'.
-    ConfigEntryMap::const_iterator it = entries.lower_bound(val);
+    if (section != nullptr) {
+        // Single values are in a perfect hash table, only one slot to check.
+        const uint32_t* const buckets = reinterpret_cast<const uint32_t*>(image + section->buckets_offset);
+        const ImageValue* const values = reinterpret_cast<const ImageValue*>(image + section->values_offset);
+        const ImageValue& value(values[HashSlot(val, buckets, section->value_buckets, section->value_slots)]);
+        if (value.name_length > 0 && value.value == val) {
+            return imageName(value.name_offset, value.name_length);
+        }
 
-    if (it == entries.end() || (it != entries.begin() && it->first != val)) {
-        // There is no entry with a value range starting at 'val'.
-        // Maybe 'val' is in the range of the previous entry.
-        --it;
+        // Then look for the last range which starts at or before 'val'.
+        const ImageRange* const first = reinterpret_cast<const ImageRange*>(image + section->ranges_offset);
+        const ImageRange* const last = first + section->range_count;
+        const ImageRange* range = std::upper_bound(first, last, val, [](Value v, const ImageRange& r) { return v < r.first; });
+        if (range != first && val <= (--range)->last) {
+            return imageName(range->name_offset, range->name_length);
+        }
     }
 
-    assert(it != entries.end());
-    assert(it->second != nullptr);
+    return UString();
+}
 
-    return val >= it->first && val <= it->second->last ? it->second->name : UString();
+// Get a name from the pool of the image.
+ts::UString ts::Names::ConfigSection::imageName(uint32_t offset, uint32_t length) const
+{
+    return offset <= strings_length && length <= strings_length - offset ? UString(strings + offset, length) : UString();
 }
 
 
@@ -656,15 +1270,45 @@ ts::UString ts::Names::Formatted(Value value, const UString& name, names::Flags
 }
 
 
+
+//----------------------------------------------------------------------------
+// Get the handle of a section.
+//----------------------------------------------------------------------------
+
+ts::Names::SectionHandle ts::Names::sectionHandle(const UString& sectionName) const
+{
+    // Look in the perfect hash table of the image without building a normalized name.
+    if (!_imageSections.empty()) {
+        const ImageHeader* const header = reinterpret_cast<const ImageHeader*>(_image);
+        const uint32_t* const buckets = reinterpret_cast<const uint32_t*>(_image + header->buckets_offset);
+        size_t start = 0;
+        size_t length = 0;
+        const uint64_t hash = HashName(sectionName, start, length);
+        const ConfigSection* const section = _imageSections[HashSlot(hash, buckets, header->section_buckets, _imageSections.size())];
+        if (section != nullptr && section->section->name_hash == hash && section->name.length() == length) {
+            size_t i = 0;
+            while (i < length && section->name[i] == ToLower(sectionName[start + i])) {
+                i++;
+            }
+            if (i == length) {
+                return section;
+            }
+        }
+    }
+
+    // Sections which are not in the image, from extensions or when the text file was parsed.
+    const ConfigSectionMap::const_iterator it = _sections.find(sectionName.toTrimmed().toLower());
+    return it == _sections.end() ? nullptr : it->second;
+}
+
+
 //----------------------------------------------------------------------------
 // Check if a name exists in a specified section.
 //----------------------------------------------------------------------------
 
-bool ts::Names::nameExists(const UString& sectionName, Value value) const
+bool ts::Names::nameExists(SectionHandle section, Value value) const
 {
-    // Get the section, normalize the section name.
-    ConfigSectionMap::const_iterator it = _sections.find(sectionName.toTrimmed().toLower());
-    return it != _sections.end() && !it->second->getName(value).empty();
+    return section != nullptr && !section->getName(value).empty();
 }
 
 
@@ -672,12 +1316,8 @@ bool ts::Names::nameExists(const UString& sectionName, Value value) const
 // Get a name from a specified section.
 //----------------------------------------------------------------------------
 
-ts::UString ts::Names::nameFromSection(const UString& sectionName, Value value, names::Flags flags, size_t bits, Value alternateValue) const
+ts::UString ts::Names::nameFromSection(SectionHandle section, Value value, names::Flags flags, size_t bits, Value alternateValue) const
 {
-    // Get the section, normalize the section name.
-    ConfigSectionMap::const_iterator it = _sections.find(sectionName.toTrimmed().toLower());
-    const ConfigSection* section = it == _sections.end() ? nullptr : it->second;
-
     if (section == nullptr) {
         // Non-existent section, no name.
         return Formatted(value, UString(), flags, bits, alternateValue);
@@ -692,12 +1332,8 @@ ts::UString ts::Names::nameFromSection(const UString& sectionName, Value value,
 // Get a name from a specified section, with alternate fallback value.
 //----------------------------------------------------------------------------
 
-ts::UString ts::Names::nameFromSectionWithFallback(const UString& sectionName, Value value1, Value value2, names::Flags flags, size_t bits, Value alternateValue) const
+ts::UString ts::Names::nameFromSectionWithFallback(SectionHandle section, Value value1, Value value2, names::Flags flags, size_t bits, Value alternateValue) const
 {
-    // Get the section, normalize the section name.
-    ConfigSectionMap::const_iterator it = _sections.find(sectionName.toTrimmed().toLower());
-    const ConfigSection* section = it == _sections.end() ? nullptr : it->second;
-
     if (section == nullptr) {
         // Non-existent section, no name.
         return Formatted(value1, UString(), flags, bits, alternateValue);
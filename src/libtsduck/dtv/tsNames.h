@@ -39,6 +39,7 @@
 #include "tsMPEG.h"
 #include "tsReport.h"
 #include "tsSingletonManager.h"
+#include "tsByteBlock.h"
 
 namespace ts {
     //!
@@ -350,6 +351,14 @@ namespace ts {
     //! A repository of names for MPEG/DVB entities.
     //! All names are loaded from configuration files @em tsduck*.names.
     //!
+    //! A configuration file can be compiled into a compact binary image where each section
+    //! is a perfect hash table of values (see saveImage()). When a compiled image exists
+    //! (same file name with an additional @c .bin suffix), it is memory-mapped and the text
+    //! file is not parsed. The image is used only when the text file has the same size and
+    //! the same content hash as when the image was compiled. Otherwise, the text file is
+    //! parsed. The names files from extensions are loaded at runtime on top of the image
+    //! and take precedence over the names from the image.
+    //!
     class TSDUCKDLL Names
     {
         TS_NOBUILD_NOCOPY(Names);
@@ -358,8 +367,10 @@ namespace ts {
         //! Constructor.
         //! @param [in] fileName Configuration file name. Typically without directory name.
         //! @param [in] mergeExtensions If true, merge the content of names files from extensions.
+        //! @param [in] useImage If true, use the compiled image of the configuration file when
+        //! it exists and matches the configuration file. If false, always parse the text file.
         //!
-        Names(const UString& fileName, bool mergeExtensions = false);
+        Names(const UString& fileName, bool mergeExtensions = false, bool useImage = true);
 
         //!
         //! Virtual destructor.
@@ -371,6 +382,24 @@ namespace ts {
         //!
         typedef uint64_t Value;
 
+        //!
+        //! Description of a section of names. Opaque type for applications.
+        //!
+        class ConfigSection;
+
+        //!
+        //! Pre-resolved handle to a section of names.
+        //! A handle remains valid as long as the Names instance exists and can be cached
+        //! by applications to avoid the lookup of the section by name for each value.
+        //! A null handle designates a non-existent section.
+        //!
+        typedef const ConfigSection* SectionHandle;
+
+        //!
+        //! Suffix of the file name of the compiled image of a configuration file.
+        //!
+        static const UChar* const IMAGE_SUFFIX;
+
         //!
         //! Get the complete path of the configuration file from which the names were loaded.
         //! @return The complete path of the configuration file. Empty if does not exist.
@@ -380,6 +409,15 @@ namespace ts {
             return _configFile;
         }
 
+        //!
+        //! Get the complete path of the compiled image file which was memory-mapped.
+        //! @return The complete path of the image file. Empty if the names were loaded from the text file.
+        //!
+        UString imageFile() const
+        {
+            return _imageFile;
+        }
+
         //!
         //! Get the number of errors in the configuration file.
         //! @return The number of errors in the configuration file.
@@ -389,13 +427,31 @@ namespace ts {
             return _configErrors;
         }
 
+        //!
+        //! Get the handle of a section.
+        //! @param [in] sectionName Name of section to search. Not case-sensitive.
+        //! @return The section handle or a null handle if the section does not exist.
+        //!
+        SectionHandle sectionHandle(const UString& sectionName) const;
+
         //!
         //! Check if a name exists in a specified section.
         //! @param [in] sectionName Name of section to search. Not case-sensitive.
         //! @param [in] value Value to get the name for.
         //! @return True if a name exists for @a value in @a sectionName.
         //!
-        bool nameExists(const UString& sectionName, Value value) const;
+        bool nameExists(const UString& sectionName, Value value) const
+        {
+            return nameExists(sectionHandle(sectionName), value);
+        }
+
+        //!
+        //! Check if a name exists in a specified section.
+        //! @param [in] section Handle of the section to search.
+        //! @param [in] value Value to get the name for.
+        //! @return True if a name exists for @a value in @a section.
+        //!
+        bool nameExists(SectionHandle section, Value value) const;
 
         //!
         //! Get a name from a specified section.
@@ -406,7 +462,21 @@ namespace ts {
         //! @param [in] alternateValue Display this integer value if flags ALTERNATE is set.
         //! @return The corresponding name.
         //!
-        UString nameFromSection(const UString& sectionName, Value value, names::Flags flags = names::NAME, size_t bits = 0, Value alternateValue = 0) const;
+        UString nameFromSection(const UString& sectionName, Value value, names::Flags flags = names::NAME, size_t bits = 0, Value alternateValue = 0) const
+        {
+            return nameFromSection(sectionHandle(sectionName), value, flags, bits, alternateValue);
+        }
+
+        //!
+        //! Get a name from a specified section.
+        //! @param [in] section Handle of the section to search.
+        //! @param [in] value Value to get the name for.
+        //! @param [in] flags Presentation flags.
+        //! @param [in] bits Nominal size in bits of the data, optional.
+        //! @param [in] alternateValue Display this integer value if flags ALTERNATE is set.
+        //! @return The corresponding name.
+        //!
+        UString nameFromSection(SectionHandle section, Value value, names::Flags flags = names::NAME, size_t bits = 0, Value alternateValue = 0) const;
 
         //!
         //! Get a name from a specified section, with alternate fallback value.
@@ -418,7 +488,34 @@ namespace ts {
         //! @param [in] alternateValue Display this integer value if flags ALTERNATE is set.
         //! @return The corresponding name.
         //!
-        UString nameFromSectionWithFallback(const UString& sectionName, Value value1, Value value2, names::Flags flags = names::NAME, size_t bits = 0, Value alternateValue = 0) const;
+        UString nameFromSectionWithFallback(const UString& sectionName, Value value1, Value value2, names::Flags flags = names::NAME, size_t bits = 0, Value alternateValue = 0) const
+        {
+            return nameFromSectionWithFallback(sectionHandle(sectionName), value1, value2, flags, bits, alternateValue);
+        }
+
+        //!
+        //! Get a name from a specified section, with alternate fallback value.
+        //! @param [in] section Handle of the section to search.
+        //! @param [in] value1 Value to get the name for.
+        //! @param [in] value2 Alternate value if no name is found for @a value1.
+        //! @param [in] flags Presentation flags.
+        //! @param [in] bits Nominal size in bits of the data, optional.
+        //! @param [in] alternateValue Display this integer value if flags ALTERNATE is set.
+        //! @return The corresponding name.
+        //!
+        UString nameFromSectionWithFallback(SectionHandle section, Value value1, Value value2, names::Flags flags = names::NAME, size_t bits = 0, Value alternateValue = 0) const;
+
+        //!
+        //! Save the compiled image of the configuration file.
+        //! When the names were loaded from an image, this image is saved and the names from
+        //! extensions are not part of it. When the text file was parsed, the image is built
+        //! from all loaded names. Use an instance without extensions to compile a file.
+        //! @param [in] fileName Name of the image file to create. Typically the name
+        //! of the configuration file with suffix @link IMAGE_SUFFIX @endlink.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool saveImage(const UString& fileName, Report& report) const;
 
         //!
         //! Format a name using flags.
@@ -432,6 +529,12 @@ namespace ts {
         static UString Formatted(Value value, const UString& name, names::Flags flags, size_t bits, Value alternateValue = 0);
 
     private:
+        // Layout of the binary image, defined in the implementation.
+        struct ImageHeader;
+        struct ImageSection;
+        struct ImageValue;
+        struct ImageRange;
+
         // Description of a configuration entry.
         // The first value of the range is the key in a map.
         class ConfigEntry
@@ -446,27 +549,6 @@ namespace ts {
         // Map of configuration entries, indexed by first value of the range.
         typedef std::map<Value, ConfigEntry*> ConfigEntryMap;
 
-        // Description of a configuration section.
-        // The name of the section is the key in a map.
-        class ConfigSection
-        {
-        public:
-            size_t          bits;     // Number of significant bits in values of the type.
-            ConfigEntryMap  entries;  // All entries, indexed by names.
-
-            ConfigSection();
-            ~ConfigSection();
-
-            // Check if a range is free, ie no value is defined in the range.
-            bool freeRange(Value first, Value last) const;
-
-            // Add a new entry.
-            void addEntry(Value first, Value last, const UString& name);
-
-            // Get a name from a value, empty if not found.
-            UString getName(Value val) const;
-        };
-
         // Map of configuration sections, indexed by name.
         typedef std::map<UString, ConfigSection*> ConfigSectionMap;
 
@@ -482,11 +564,32 @@ namespace ts {
         // Load a configuration file and merge its content into this instance.
         void loadFile(const UString& fileName);
 
+        // Build an image from the entries which were loaded from the text configuration files.
+        bool buildImage(ByteBlock& image) const;
+
+        // Memory-map an image file. Return true on success, false if the file is not usable.
+        bool mapImage(const UString& fileName);
+
+        // Release the image.
+        void unmapImage();
+
+        // Attach the sections of the image to this instance.
+        bool attachImage();
+
+        // Deallocate all configuration sections.
+        void clearSections();
+
         // Names private fields.
-        Report&          _log;           // Error logger.
-        const UString    _configFile;    // Configuration file path.
-        size_t           _configErrors;  // Number of errors in configuration file.
-        ConfigSectionMap _sections;      // Configuration sections.
+        Report&                    _log;            // Error logger.
+        const UString              _configFile;     // Configuration file path.
+        UString                    _imageFile;      // Memory-mapped image file path.
+        size_t                     _configErrors;   // Number of errors in configuration file.
+        ConfigSectionMap           _sections;       // Configuration sections, indexed by lower-case name.
+        std::vector<ConfigSection*> _imageSections; // Configuration sections, indexed by slot in image.
+        ByteBlock                  _imageData;      // Image file loaded in memory, when not memory-mapped.
+        const uint8_t*             _image;          // Address of image (in memory or memory-mapped).
+        size_t                     _imageSize;      // Image size in bytes.
+        void*                      _mapAddress;     // Address of memory-mapped image file.
     };
 
     //!
@@ -525,6 +628,22 @@ namespace ts {
     {
         return NamesMain::Instance()->nameFromSection(sectionName, Names::Value(value), flags, bits, Names::Value(alternateValue));
     }
+
+    //!
+    //! Get a name from a pre-resolved section in the DVB names file.
+    //! @tparam INT An integer name.
+    //! @param [in] section Handle of the section to search, as returned by NamesMain::Instance()->sectionHandle().
+    //! @param [in] value Value to get the name for.
+    //! @param [in] flags Presentation flags.
+    //! @param [in] bits Nominal size in bits of the data, optional.
+    //! @param [in] alternateValue Display this integer value if flags ALTERNATE is set.
+    //! @return The corresponding name.
+    //!
+    template <typename INT, typename std::enable_if<std::is_integral<INT>::value>::type* = nullptr>
+    UString NameFromSection(Names::SectionHandle section, INT value, names::Flags flags = names::NAME, size_t bits = 0, INT alternateValue = 0)
+    {
+        return NamesMain::Instance()->nameFromSection(section, Names::Value(value), flags, bits, Names::Value(alternateValue));
+    }
 }
 
 TS_FLAGS_OPERATORS(ts::names::Flags)
@@ -82,17 +82,17 @@ ts::PESDemux::~PESDemux()
 //----------------------------------------------------------------------------
 
 ts::PESDemux::PIDContext::PIDContext() :
-    pes_count(0),
     continuity(0),
     sync(false),
     first_pkt(0),
     last_pkt(0),
+    pes_count(0),
+    ac3_count(0),
     ts(new ByteBlock()),
     audio(),
     video(),
     avc(),
-    ac3(),
-    ac3_count(0)
+    ac3()
 {
 }
 
@@ -127,52 +127,52 @@ void ts::PESDemux::immediateResetPID(PID pid)
 
 void ts::PESDemux::getAudioAttributes(PID pid, AudioAttributes& va) const
 {
-    PIDContextMap::const_iterator pci = _pids.find(pid);
-    if (pci == _pids.end() || !pci->second.audio.isValid()) {
+    const PIDContext* const pc = _pids.get(pid);
+    if (pc == nullptr || !pc->audio.isValid()) {
         va.invalidate();
     }
     else {
-        va = pci->second.audio;
+        va = pc->audio;
     }
 }
 
 void ts::PESDemux::getVideoAttributes(PID pid, VideoAttributes& va) const
 {
-    PIDContextMap::const_iterator pci = _pids.find(pid);
-    if (pci == _pids.end() || !pci->second.video.isValid()) {
+    const PIDContext* const pc = _pids.get(pid);
+    if (pc == nullptr || !pc->video.isValid()) {
         va.invalidate();
     }
     else {
-        va = pci->second.video;
+        va = pc->video;
     }
 }
 
 void ts::PESDemux::getAVCAttributes(PID pid, AVCAttributes& va) const
 {
-    PIDContextMap::const_iterator pci = _pids.find(pid);
-    if (pci == _pids.end() || !pci->second.avc.isValid()) {
+    const PIDContext* const pc = _pids.get(pid);
+    if (pc == nullptr || !pc->avc.isValid()) {
         va.invalidate();
     }
     else {
-        va = pci->second.avc;
+        va = pc->avc;
     }
 }
 
 void ts::PESDemux::getAC3Attributes(PID pid, AC3Attributes& va) const
 {
-    PIDContextMap::const_iterator pci = _pids.find (pid);
-    if (pci == _pids.end() || !pci->second.ac3.isValid()) {
+    const PIDContext* const pc = _pids.get(pid);
+    if (pc == nullptr || !pc->ac3.isValid()) {
         va.invalidate();
     }
     else {
-        va = pci->second.ac3;
+        va = pc->ac3;
     }
 }
 
 bool ts::PESDemux::allAC3(PID pid) const
 {
-    PIDContextMap::const_iterator pci = _pids.find(pid);
-    return pci != _pids.end() && pci->second.pes_count > 0 && pci->second.ac3_count == pci->second.pes_count;
+    const PIDContext* const pc = _pids.get(pid);
+    return pc != nullptr && pc->pes_count > 0 && pc->ac3_count == pc->pes_count;
 }
 
 
@@ -203,8 +203,8 @@ void ts::PESDemux::processPacket(const TSPacket& pkt)
 
     // Get PID and check if context exists
     PID pid = pkt.getPID();
-    PIDContextMap::iterator pci = _pids.find (pid);
-    bool pc_exists = pci != _pids.end();
+    PIDContext* pci = _pids.get(pid);
+    bool pc_exists = pci != nullptr;
 
     // If no context established and not at a unit start, ignore packet
     if (!pc_exists && !pkt.getPUSI()) {
@@ -212,12 +212,12 @@ void ts::PESDemux::processPacket(const TSPacket& pkt)
     }
 
     // If at a unit start and the context exists, process previous PES packet in context
-    if (pc_exists && pkt.getPUSI() && pci->second.sync) {
+    if (pc_exists && pkt.getPUSI() && pci->sync) {
         // Process packet, invoke all handlers
-        processPESPacket(pid, pci->second);
+        processPESPacket(pid, *pci);
         // Recheck PID context in case it was reset by a handler
-        pci = _pids.find(pid);
-        pc_exists = pci != _pids.end();
+        pci = _pids.get(pid);
+        pc_exists = pci != nullptr;
     }
 
     // If the packet is scrambled, we cannot get PES content.
@@ -257,10 +257,10 @@ void ts::PESDemux::processPacket(const TSPacket& pkt)
 
     // At this point, the TS packet contains part of a PES packet, but not beginning.
     // Check that PID context is valid.
-    if (!pc_exists || !pci->second.sync) {
+    if (!pc_exists || !pci->sync) {
         return;
     }
-    PIDContext& pc(pci->second);
+    PIDContext& pc(*pci);
 
     // Ignore duplicate packets (same CC)
     if (pkt.getCC() == pc.continuity) {
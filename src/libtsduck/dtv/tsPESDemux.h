@@ -41,6 +41,7 @@
 #include "tsAVCAttributes.h"
 #include "tsAC3Attributes.h"
 #include "tsSectionDemux.h"
+#include "tsPIDTable.h"
 
 namespace ts {
     //!
@@ -140,17 +141,19 @@ namespace ts {
         // This internal structure contains the analysis context for one PID.
         struct PIDContext
         {
-            PacketCounter   pes_count;   // Number of detected valid PES packets on this PID
+            // Data which are used on each TS packet (grouped in the same cache lines).
             uint8_t         continuity;  // Last continuity counter
             bool            sync;        // We are synchronous in this PID
             PacketCounter   first_pkt;   // Index of first TS packet for current PES packet
             PacketCounter   last_pkt;    // Index of last TS packet for current PES packet
+            PacketCounter   pes_count;   // Number of detected valid PES packets on this PID
+            PacketCounter   ac3_count;   // Number of PES packets with contents which looks like AC-3
             ByteBlockPtr    ts;          // TS payload buffer
+            // Data which are used only when a PES packet is complete.
             AudioAttributes audio;       // Current audio attributes
             VideoAttributes video;       // Current video attributes (MPEG-1, MPEG-2)
             AVCAttributes   avc;         // Current AVC attributes
             AC3Attributes   ac3;         // Current AC-3 attributes
-            PacketCounter   ac3_count;   // Number of PES packets with contents which looks like AC-3
 
             // Default constructor:
             PIDContext();
@@ -159,9 +162,9 @@ namespace ts {
             void syncLost() {sync = false; ts->clear();}
         };
 
-        // Map of PID contexts, indexed by PID.
+        // Dense table of PID contexts, indexed by PID.
         // One context is created per demuxed PES PID.
-        typedef std::map<PID,PIDContext> PIDContextMap;
+        typedef PIDTable<PIDContext> PIDContextMap;
 
         // Map of stream types (from PMT), indexed by PID.
         // All known PID's are referenced here, not only demuxed PES PID's.
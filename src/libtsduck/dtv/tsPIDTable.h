@@ -0,0 +1,219 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Dense table of contexts, indexed by PID.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsMPEG.h"
+
+namespace ts {
+    //!
+    //! Dense table of contexts, indexed by PID.
+    //!
+    //! This is a replacement for std::map<PID,T> in classes which look up a per-PID
+    //! context on each TS packet. The lookup is a direct array access. The contexts
+    //! are allocated on first access to the PID and never move in memory until they
+    //! are erased. The iteration is done in increasing order of PID values, like
+    //! in a std::map.
+    //!
+    //! @tparam T Type of the per-PID context. Must be default-constructible
+    //! when operator[] is used. Otherwise, contexts are created using assign().
+    //! @ingroup mpeg
+    //!
+    template <class T>
+    class PIDTable
+    {
+        TS_NOCOPY(PIDTable);
+    public:
+        //!
+        //! Constructor.
+        //!
+        PIDTable();
+
+        //!
+        //! Destructor.
+        //!
+        ~PIDTable();
+
+        //!
+        //! Get the number of PID's with an allocated context.
+        //! @return The number of PID's with an allocated context.
+        //!
+        size_t size() const
+        {
+            return _count;
+        }
+
+        //!
+        //! Check if the table is empty.
+        //! @return True if no PID has an allocated context.
+        //!
+        bool empty() const
+        {
+            return _count == 0;
+        }
+
+        //!
+        //! Check if a PID has an allocated context.
+        //! @param [in] pid The PID to check.
+        //! @return True if @a pid has an allocated context.
+        //!
+        bool contains(PID pid) const
+        {
+            return pid < PID_MAX && _slots[pid] != nullptr;
+        }
+
+        //!
+        //! Get the context of a PID, if it exists.
+        //! @param [in] pid The PID to search.
+        //! @return The address of the context of @a pid or a null pointer if there is none.
+        //!
+        T* get(PID pid) const
+        {
+            return pid < PID_MAX ? _slots[pid] : nullptr;
+        }
+
+        //!
+        //! Get the context of a PID, create it if it does not exist.
+        //! Like with std::map, the new context is value-initialized.
+        //! @param [in] pid The PID to search. Must be less than PID_MAX.
+        //! @return A reference to the context of @a pid.
+        //!
+        T& operator[](PID pid)
+        {
+            assert(pid < PID_MAX);
+            T* ctx = _slots[pid];
+            return ctx != nullptr ? *ctx : create(pid);
+        }
+
+        //!
+        //! Replace the context of a PID.
+        //! @param [in] pid The PID to set. Must be less than PID_MAX.
+        //! @param [in] ctx Address of a new context, allocated with @c new. The table takes
+        //! ownership of it. The previous context of @a pid, if any, is deleted. When null,
+        //! the context of @a pid is erased.
+        //!
+        void assign(PID pid, T* ctx);
+
+        //!
+        //! Remove the context of a PID, if it exists.
+        //! @param [in] pid The PID to remove.
+        //!
+        void erase(PID pid);
+
+        //!
+        //! Remove the contexts of all PID's.
+        //!
+        void clear();
+
+        //!
+        //! Get the first PID with an allocated context.
+        //! @return The first PID with an allocated context or PID_MAX if the table is empty.
+        //!
+        PID first() const
+        {
+            return lookup(0);
+        }
+
+        //!
+        //! Get the next PID with an allocated context.
+        //! Typical iteration: @code for (PID pid = t.first(); pid != PID_MAX; pid = t.next(pid)) @endcode
+        //! @param [in] pid The PID after which the search starts.
+        //! @return The first PID after @a pid with an allocated context or PID_MAX if there is none.
+        //!
+        PID next(PID pid) const
+        {
+            return pid >= PID_MAX ? PID(PID_MAX) : lookup(pid + 1);
+        }
+
+        //!
+        //! Iterator over the allocated contexts, in increasing order of PID values.
+        //! The iterated value is a pair of PID and context address, like the
+        //! iterators of a std::map<PID,T*>. The iterators remain valid as long as
+        //! the iterated context is not erased.
+        //!
+        class iterator
+        {
+        public:
+            //! The iterated value, a pair of PID and context address.
+            typedef std::pair<PID,T*> value_type;
+
+            //!
+            //! Constructor.
+            //! @param [in] table The table to iterate.
+            //! @param [in] pid The first PID to iterate. Must have an allocated context or be PID_MAX.
+            //!
+            iterator(const PIDTable* table = nullptr, PID pid = PID_MAX) : _table(table), _value(pid, table == nullptr ? nullptr : table->get(pid)) {}
+
+            //! @cond nodoxygen
+            const value_type& operator*() const { return _value; }
+            const value_type* operator->() const { return &_value; }
+            bool operator==(const iterator& other) const { return _value.first == other._value.first; }
+            bool operator!=(const iterator& other) const { return _value.first != other._value.first; }
+            iterator& operator++() { _value.first = _table->next(_value.first); _value.second = _table->get(_value.first); return *this; }
+            //! @endcond
+
+        private:
+            const PIDTable* _table;
+            value_type      _value;
+        };
+
+        //!
+        //! Iterators over a const table give access to non-const contexts, like with pointers.
+        //!
+        typedef iterator const_iterator;
+
+        //!
+        //! Get an iterator to the first allocated context.
+        //! @return An iterator to the first allocated context.
+        //!
+        iterator begin() const { return iterator(this, first()); }
+
+        //!
+        //! Get an iterator after the last allocated context.
+        //! @return An iterator after the last allocated context.
+        //!
+        iterator end() const { return iterator(this, PID_MAX); }
+
+    private:
+        std::vector<T*> _slots;  // Always PID_MAX entries, null when not allocated.
+        size_t          _count;  // Number of allocated contexts.
+
+        // Allocate a new context.
+        T& create(PID pid);
+
+        // Search the first allocated context, starting at the given PID.
+        PID lookup(PID pid) const;
+    };
+}
+
+#include "tsPIDTableTemplate.h"
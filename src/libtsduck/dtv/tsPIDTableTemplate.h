@@ -0,0 +1,118 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Dense table of contexts, indexed by PID.
+//  The template argument T is the per-PID context.
+//
+//----------------------------------------------------------------------------
+
+#pragma once
+
+
+//----------------------------------------------------------------------------
+// Constructor and destructor.
+//----------------------------------------------------------------------------
+
+template <class T>
+ts::PIDTable<T>::PIDTable() :
+    _slots(PID_MAX, nullptr),
+    _count(0)
+{
+}
+
+template <class T>
+ts::PIDTable<T>::~PIDTable()
+{
+    clear();
+}
+
+
+//----------------------------------------------------------------------------
+// Allocate, erase, clear contexts.
+//----------------------------------------------------------------------------
+
+template <class T>
+T& ts::PIDTable<T>::create(PID pid)
+{
+    T* ctx = new T();
+    _slots[pid] = ctx;
+    _count++;
+    return *ctx;
+}
+
+template <class T>
+void ts::PIDTable<T>::assign(PID pid, T* ctx)
+{
+    assert(pid < PID_MAX);
+    if (ctx == _slots[pid]) {
+        return;
+    }
+    erase(pid);
+    if (ctx != nullptr) {
+        _slots[pid] = ctx;
+        _count++;
+    }
+}
+
+template <class T>
+void ts::PIDTable<T>::erase(PID pid)
+{
+    if (pid < PID_MAX && _slots[pid] != nullptr) {
+        delete _slots[pid];
+        _slots[pid] = nullptr;
+        _count--;
+    }
+}
+
+template <class T>
+void ts::PIDTable<T>::clear()
+{
+    for (PID pid = 0; _count > 0 && pid < PID_MAX; ++pid) {
+        erase(pid);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Search the first allocated context, starting at the given PID.
+//----------------------------------------------------------------------------
+
+template <class T>
+ts::PID ts::PIDTable<T>::lookup(PID pid) const
+{
+    if (_count > 0) {
+        while (pid < PID_MAX) {
+            if (_slots[pid] != nullptr) {
+                return pid;
+            }
+            ++pid;
+        }
+    }
+    return PID_MAX;
+}
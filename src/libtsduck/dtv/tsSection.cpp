@@ -266,7 +266,11 @@ size_t ts::Section::SectionSize(const void* content, size_t content_size)
 
 void ts::Section::initialize(const ByteBlockPtr& bbp, PID pid, CRC32::Validation crc_op)
 {
-    initialize(pid);
+    // Do not use initialize(pid) which allocates a null safe pointer for nothing.
+    _is_valid = false;
+    _source_pid = pid;
+    _first_pkt = 0;
+    _last_pkt = 0;
     _data = bbp;
 
     // Basic validity check using section size
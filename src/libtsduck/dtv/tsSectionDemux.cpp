@@ -121,12 +121,14 @@ std::ostream& ts::SectionDemux::Status::display(std::ostream& strm, int indent,
 // Analysis context for one TID/TIDext into one PID.
 //----------------------------------------------------------------------------
 
-ts::SectionDemux::ETIDContext::ETIDContext() :
+ts::SectionDemux::ETIDContext::ETIDContext(const ETID& id) :
+    etid(id),
     notified(false),
     version(0),
     sect_expected(0),
     sect_received(0),
-    sects()
+    sects(),
+    received()
 {
 }
 
@@ -139,10 +141,11 @@ void ts::SectionDemux::ETIDContext::init(uint8_t new_version, uint8_t last_secti
     sect_received = 0;
     sects.resize(sect_expected);
 
-    // Mark all section entries as unused
-    for (size_t i = 0; i < sect_expected; i++) {
-        sects[i].reset();
-    }
+    // Mark all section entries as unused. The previous sections may still be
+    // referenced by the application or the section pool, do not delete them.
+    // They are released when replaced by the sections of the new version.
+    // Clearing the safe pointers here would allocate a new null one for each.
+    received.assign(sect_expected, false);
 }
 
 // Notify the application if the table is complete.
@@ -153,7 +156,9 @@ void ts::SectionDemux::ETIDContext::notify(SectionDemux& demux, bool pack, bool
         // Build the table
         BinaryTable table;
         for (size_t i = 0; i < sects.size(); ++i) {
-            table.addSection(sects[i]);
+            if (received[i]) {
+                table.addSection(sects[i]);
+            }
         }
 
         // Pack incomplete table with force.
@@ -184,7 +189,8 @@ ts::SectionDemux::PIDContext::PIDContext() :
     continuity(0),
     sync(false),
     ts(),
-    tids()
+    tids(),
+    last_tid(0)
 {
 }
 
@@ -195,6 +201,23 @@ void ts::SectionDemux::PIDContext::syncLost()
     ts.clear();
 }
 
+// Get the TID analysis context, create it if it does not exist.
+ts::SectionDemux::ETIDContext& ts::SectionDemux::PIDContext::getTID(const ETID& etid)
+{
+    // Fast path: same table as previous section.
+    if (last_tid < tids.size() && tids[last_tid].etid == etid) {
+        return tids[last_tid];
+    }
+
+    // Binary search, insert a new context at the right place if not found.
+    auto it = std::lower_bound(tids.begin(), tids.end(), etid, [](const ETIDContext& tc, const ETID& id) { return tc.etid < id; });
+    if (it == tids.end() || !(it->etid == etid)) {
+        it = tids.insert(it, ETIDContext(etid));
+    }
+    last_tid = it - tids.begin();
+    return *it;
+}
+
 
 //----------------------------------------------------------------------------
 // SectionDemux constructor and destructor.
@@ -205,6 +228,7 @@ ts::SectionDemux::SectionDemux(DuckContext& duck, TableHandlerInterface* table_h
     _table_handler(table_handler),
     _section_handler(section_handler),
     _pids(),
+    _pool(),
     _status(),
     _get_current(true),
     _get_next(false)
@@ -465,7 +489,7 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
             // The ETID context is created if did not exist.
             // Avoid accumulating partial sections when there is no table handler.
 
-            ETIDContext* tc = _table_handler == nullptr ? nullptr : &pc.tids[etid];
+            ETIDContext* tc = _table_handler == nullptr ? nullptr : &pc.getTID(etid);
 
             // If this is a new version of the table, reset the TID context.
             // Note that short sections do not have versions, so the version
@@ -489,11 +513,12 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
             }
 
             // Create a new Section object if necessary (ie. if a section
-            // hendler is registered or if this is a new section).
+            // hendler is registered or if this is a new section). Sections
+            // which are no longer referenced by the handlers are recycled.
             SectionPtr sect_ptr;
 
-            if (section_ok && (_section_handler != nullptr || (tc != nullptr && tc->sects[section_number].isNull()))) {
-                sect_ptr = new Section(ts_start, section_length, pid, CRC32::CHECK);
+            if (section_ok && (_section_handler != nullptr || (tc != nullptr && !tc->received[section_number]))) {
+                sect_ptr = _pool.allocate(ts_start, section_length, pid, CRC32::CHECK);
                 sect_ptr->setFirstTSPacketIndex(pusi_pkt_index);
                 sect_ptr->setLastTSPacketIndex(_packet_count);
                 if (!sect_ptr->isValid()) {
@@ -513,10 +538,11 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
                 }
 
                 // Save the section in the TID context if this is a new one.
-                if (section_ok && tc != nullptr && tc->sects[section_number].isNull()) {
+                if (section_ok && tc != nullptr && !tc->received[section_number]) {
 
                     // Save the section
                     tc->sects[section_number] = sect_ptr;
+                    tc->received[section_number] = true;
                     tc->sect_received++;
 
                     // If the table is completed and a handler is present, build the table.
@@ -562,9 +588,8 @@ void ts::SectionDemux::processPacket(const TSPacket& pkt)
 void ts::SectionDemux::fixAndFlush(bool pack, bool fill_eit)
 {
     // Loop on all PID's.
-    for (auto it1 = _pids.begin(); it1 != _pids.end(); ++it1) {
-        const PID pid = it1->first;
-        PIDContext& pc(it1->second);
+    for (PID pid = _pids.first(); pid != PID_MAX; pid = _pids.next(pid)) {
+        PIDContext& pc(_pids[pid]);
 
         // Mark that we are in the context of a table or section handler.
         // This is used to prevent the destruction of PID contexts during
@@ -572,9 +597,10 @@ void ts::SectionDemux::fixAndFlush(bool pack, bool fill_eit)
         beforeCallingHandler(pid);
         try {
             // Loop on all TID's currently found in the PID.
-            for (auto it2 = pc.tids.begin(); it2 != pc.tids.end(); ++it2) {
+            // Use an index, a handler may add new TID contexts.
+            for (size_t i = 0; i < pc.tids.size(); ++i) {
                 // Force a notification of the partial table, if any.
-                it2->second.notify(*this, pack, fill_eit);
+                pc.tids[i].notify(*this, pack, fill_eit);
             }
         }
         catch (...) {
@@ -38,6 +38,8 @@
 #include "tsSectionHandlerInterface.h"
 #include "tsDuckContext.h"
 #include "tsETID.h"
+#include "tsPIDTable.h"
+#include "tsSectionPool.h"
 
 namespace ts {
     //!
@@ -213,14 +215,16 @@ namespace ts {
         // This internal structure contains the analysis context for one TID/TIDext into one PID.
         struct ETIDContext
         {
+            ETID    etid;           // Table id and table id extension
             bool    notified;       // The table was reported to application through a handler
             uint8_t version;        // Version of this table
             size_t  sect_expected;  // Number of expected sections in table
             size_t  sect_received;  // Number of received sections in table
             SectionPtrVector sects; // Array of sections
+            std::vector<bool> received; // Sections of the current version which were received
 
-            // Default constructor.
-            ETIDContext();
+            // Constructor.
+            ETIDContext(const ETID& id = ETID());
 
             // Init for a new table.
             void init(uint8_t new_version, uint8_t last_section);
@@ -239,13 +243,19 @@ namespace ts {
             uint8_t       continuity;         // Last continuity counter
             bool          sync;               // We are synchronous in this PID
             ByteBlock     ts;                 // TS payload buffer
-            std::map<ETID,ETIDContext> tids;  // TID analysis contexts
+            std::vector<ETIDContext> tids;    // TID analysis contexts, sorted by ETID
+            size_t        last_tid;           // Index in tids of the last used TID context
 
             // Default constructor.
             PIDContext();
 
             // Called when packet synchronization is lost on the pid.
             void syncLost();
+
+            // Get the TID analysis context, create it if it does not exist.
+            // There are usually few TID/TIDext per PID and consecutive sections often
+            // belong to the same table. A small sorted vector is faster than a map.
+            ETIDContext& getTID(const ETID& etid);
         };
 
         // Notify the application if the table is complete.
@@ -257,7 +267,8 @@ namespace ts {
         // Private members:
         TableHandlerInterface*   _table_handler;
         SectionHandlerInterface* _section_handler;
-        std::map<PID,PIDContext> _pids;
+        PIDTable<PIDContext>     _pids;
+        SectionPool              _pool;
         Status                   _status;
         bool                     _get_current;
         bool                     _get_next;
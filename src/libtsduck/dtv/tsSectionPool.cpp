@@ -0,0 +1,153 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsSectionPool.h"
+TSDUCK_SOURCE;
+
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr size_t ts::SectionPool::DEFAULT_CLASS_SIZE;
+constexpr size_t ts::SectionPool::CLASS_COUNT;
+#endif
+
+
+//----------------------------------------------------------------------------
+// Constructors.
+//----------------------------------------------------------------------------
+
+ts::SectionPool::SectionPool(size_t class_size) :
+    _class_size(class_size),
+    _allocated(0),
+    _recycled(0),
+    _classes()
+{
+}
+
+ts::SectionPool::Slot::Slot() :
+    section(),
+    data()
+{
+}
+
+ts::SectionPool::SizeClass::SizeClass() :
+    slots(),
+    next(0)
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Check if a section is no longer referenced outside the pool.
+//----------------------------------------------------------------------------
+
+bool ts::SectionPool::Slot::isFree() const
+{
+    // The data block is referenced by the pool and by the section when it is valid.
+    // Any additional reference is a section sharing the data outside the pool.
+    // A section which was reset outside the pool can no longer be recycled.
+    return section.count() == 1 && !section.isNull() && data.count() == (section->isValid() ? 2 : 1);
+}
+
+
+//----------------------------------------------------------------------------
+// Size classes.
+//----------------------------------------------------------------------------
+
+size_t ts::SectionPool::ClassIndex(size_t size)
+{
+    return size <= 256 ? 0 : (size <= MAX_PSI_SECTION_SIZE ? 1 : 2);
+}
+
+size_t ts::SectionPool::ClassBlockSize(size_t index)
+{
+    return index == 0 ? 256 : (index == 1 ? MAX_PSI_SECTION_SIZE : MAX_PRIVATE_SECTION_SIZE);
+}
+
+
+//----------------------------------------------------------------------------
+// Forget all sections in the pool.
+//----------------------------------------------------------------------------
+
+void ts::SectionPool::clear()
+{
+    for (size_t i = 0; i < CLASS_COUNT; ++i) {
+        _classes[i].slots.clear();
+        _classes[i].next = 0;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Build a section from full binary content.
+//----------------------------------------------------------------------------
+
+ts::SectionPtr ts::SectionPool::allocate(const void* content, size_t content_size, PID source_pid, CRC32::Validation crc_op)
+{
+    // Sections which cannot be valid are not recycled.
+    if (_class_size == 0 || content == nullptr || content_size == 0 || content_size > MAX_PRIVATE_SECTION_SIZE) {
+        _allocated++;
+        return SectionPtr(new Section(content, content_size, source_pid, crc_op));
+    }
+
+    const size_t index = ClassIndex(content_size);
+    SizeClass& cl(_classes[index]);
+
+    // Look for a section which is no longer used, starting after the last allocated one.
+    for (size_t i = 0; i < cl.slots.size(); ++i) {
+        Slot& slot(cl.slots[cl.next]);
+        cl.next = (cl.next + 1) % cl.slots.size();
+        if (slot.isFree()) {
+            // Reuse the section and its data block, without reallocation since
+            // the capacity of the data block is the size of the size class.
+            slot.data->copy(content, content_size);
+            slot.section->reload(slot.data, source_pid, crc_op);
+            _recycled++;
+            return slot.section;
+        }
+    }
+
+    // All sections are still in use, allocate a new one. When the size class
+    // is full, the oldest section is forgotten and remains valid outside the pool.
+    Slot* slot = nullptr;
+    if (cl.slots.size() < _class_size) {
+        cl.slots.reserve(_class_size);
+        cl.slots.resize(cl.slots.size() + 1);
+        slot = &cl.slots.back();
+        cl.next = 0;
+    }
+    else {
+        slot = &cl.slots[cl.next];
+        cl.next = (cl.next + 1) % cl.slots.size();
+    }
+    slot->data = new ByteBlock;
+    slot->data->reserve(ClassBlockSize(index));
+    slot->data->copy(content, content_size);
+    slot->section = new Section(slot->data, source_pid, crc_op);
+    _allocated++;
+    return slot->section;
+}
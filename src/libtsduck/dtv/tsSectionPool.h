@@ -0,0 +1,141 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Pool of recycled sections.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsSection.h"
+
+namespace ts {
+    //!
+    //! Pool of recycled sections, used to build short-lived sections without memory allocation.
+    //!
+    //! When a section is extracted from a stream and passed to a handler which does not
+    //! keep it, the Section object, its data block and their safe pointers are allocated
+    //! and immediately deallocated. A SectionPool keeps references to the sections it
+    //! has built. When no other reference remains on one of them, the Section object and
+    //! its data block are reused for the next section of the same size class.
+    //!
+    //! The data blocks are allocated by size classes, up to the maximum section size.
+    //! A recycled data block is never reallocated for a section of the same size class.
+    //!
+    //! A section which is still referenced outside the pool is never modified. When
+    //! all sections of a size class are still referenced, the oldest one is forgotten
+    //! by the pool and a new section is allocated.
+    //!
+    //! This class is not thread-safe. The safe pointers to the sections (SectionPtr)
+    //! use a non thread-safe reference counter and must not be shared between threads.
+    //! @ingroup mpeg
+    //!
+    class TSDUCKDLL SectionPool
+    {
+        TS_NOCOPY(SectionPool);
+    public:
+        //!
+        //! Default number of sections per size class.
+        //!
+        static constexpr size_t DEFAULT_CLASS_SIZE = 16;
+
+        //!
+        //! Constructor.
+        //! @param [in] class_size Number of sections to keep in each size class.
+        //! When zero, there is no recycling, all sections are freshly allocated.
+        //!
+        explicit SectionPool(size_t class_size = DEFAULT_CLASS_SIZE);
+
+        //!
+        //! Build a section from full binary content.
+        //! The content is copied into the section if valid.
+        //! @param [in] content Address of the binary section data.
+        //! @param [in] content_size Size in bytes of the section.
+        //! @param [in] source_pid PID from which the section was read.
+        //! @param [in] crc_op How to process the CRC32.
+        //! @return A safe pointer to the new section. The section may be invalid.
+        //!
+        SectionPtr allocate(const void* content,
+                            size_t content_size,
+                            PID source_pid = PID_NULL,
+                            CRC32::Validation crc_op = CRC32::IGNORE);
+
+        //!
+        //! Forget all sections in the pool.
+        //! The sections which are still referenced outside the pool remain valid.
+        //!
+        void clear();
+
+        //!
+        //! Get the number of sections which were freshly allocated.
+        //! @return The number of sections which were freshly allocated.
+        //!
+        uint64_t allocatedCount() const { return _allocated; }
+
+        //!
+        //! Get the number of sections which were built using a recycled section.
+        //! @return The number of sections which were built using a recycled section.
+        //!
+        uint64_t recycledCount() const { return _recycled; }
+
+    private:
+        // A section and its data block, as allocated by the pool.
+        class Slot
+        {
+        public:
+            Slot();
+            SectionPtr   section;
+            ByteBlockPtr data;
+            // Check if the section and its data are no longer referenced outside the pool.
+            bool isFree() const;
+        };
+
+        // Sections of one size class, used in a circular way.
+        class SizeClass
+        {
+        public:
+            SizeClass();
+            std::vector<Slot> slots;  // Allocated sections.
+            size_t            next;   // Next slot to check.
+        };
+
+        // Number of size classes: 256, 1024 and 4096 bytes.
+        static constexpr size_t CLASS_COUNT = 3;
+
+        // Private members.
+        size_t    _class_size;
+        uint64_t  _allocated;
+        uint64_t  _recycled;
+        SizeClass _classes[CLASS_COUNT];
+
+        // Get the size class index and the data block size for a section size.
+        static size_t ClassIndex(size_t size);
+        static size_t ClassBlockSize(size_t index);
+    };
+}
@@ -89,6 +89,8 @@ ts::TSAnalyzer::TSAnalyzer(DuckContext& duck, BitRate bitrate_hint) :
     _pids(),
     _services(),
     _modified(false),
+    _is_snapshot(false),
+    _ts_pkt_offset(0),
     _ts_bitrate_sum(0),
     _ts_bitrate_cnt(0),
     _preceding_errors(0),
@@ -120,6 +122,8 @@ ts::TSAnalyzer::~TSAnalyzer()
 void ts::TSAnalyzer::reset()
 {
     _modified = false;
+    _is_snapshot = false;
+    _ts_pkt_offset = 0;
     _ts_id = 0;
     _ts_id_valid = false;
     _ts_pkt_cnt = 0;
@@ -171,6 +175,375 @@ void ts::TSAnalyzer::reset()
 }
 
 
+//----------------------------------------------------------------------------
+// Get a snapshot of the current state of the analysis.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::getSnapshot(TSAnalyzer& snapshot) const
+{
+    snapshot.reset();
+
+    // Raw analysis data. The synthetic data are rebuilt by recomputeStatistics() in the snapshot.
+    snapshot._ts_id = _ts_id;
+    snapshot._ts_id_valid = _ts_id_valid;
+    snapshot._ts_pkt_cnt = _ts_pkt_cnt;
+    snapshot._invalid_sync = _invalid_sync;
+    snapshot._transport_errors = _transport_errors;
+    snapshot._suspect_ignored = _suspect_ignored;
+    snapshot._scrambled_pid_cnt = _scrambled_pid_cnt;
+    snapshot._pcr_pid_cnt = _pcr_pid_cnt;
+    snapshot._ts_user_bitrate = _ts_user_bitrate;
+    snapshot._first_utc = _first_utc;
+    snapshot._first_local = _first_local;
+    snapshot._first_tdt = _first_tdt;
+    snapshot._last_tdt = _last_tdt;
+    snapshot._first_tot = _first_tot;
+    snapshot._last_tot = _last_tot;
+    snapshot._first_stt = _first_stt;
+    snapshot._last_stt = _last_stt;
+    snapshot._country_code = _country_code;
+    snapshot._tid_present = _tid_present;
+    snapshot._ts_bitrate_sum = _ts_bitrate_sum;
+    snapshot._ts_bitrate_cnt = _ts_bitrate_cnt;
+    snapshot._ts_pkt_offset = _ts_pkt_offset;
+
+    // The "last" system times are the time of the snapshot.
+    if (_is_snapshot) {
+        snapshot._last_utc = _last_utc;
+        snapshot._last_local = _last_local;
+    }
+    else {
+        snapshot._last_utc = Time::CurrentUTC();
+        snapshot._last_local = Time::CurrentLocalTime();
+    }
+    snapshot._is_snapshot = true;
+    snapshot._modified = true;
+
+    // Deep copy of all contexts.
+    for (auto it = _pids.begin(); it != _pids.end(); ++it) {
+        PIDContext* const pc = new PIDContext(*it->second);
+        pc->details = new PIDDetails(*pc->details);
+        for (auto its = pc->details->sections.begin(); its != pc->details->sections.end(); ++its) {
+            its->second = new ETIDContext(*its->second);
+        }
+        snapshot._pids.assign(it->first, pc);
+    }
+    for (auto it = _services.begin(); it != _services.end(); ++it) {
+        snapshot._services[it->first] = new ServiceContext(*it->second);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Transform a snapshot into statistics over an interval of time.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Subtract a previous value of a counter.
+    template <typename INT>
+    inline void SubtractCounter(INT& counter, INT previous)
+    {
+        counter = counter > previous ? counter - previous : 0;
+    }
+}
+
+void ts::TSAnalyzer::subtractSnapshot(const TSAnalyzer& previous)
+{
+    SubtractCounter(_ts_pkt_cnt, previous._ts_pkt_cnt);
+    SubtractCounter(_invalid_sync, previous._invalid_sync);
+    SubtractCounter(_transport_errors, previous._transport_errors);
+    SubtractCounter(_suspect_ignored, previous._suspect_ignored);
+    SubtractCounter(_ts_bitrate_sum, previous._ts_bitrate_sum);
+    SubtractCounter(_ts_bitrate_cnt, previous._ts_bitrate_cnt);
+
+    // The interval starts at the end of the previous snapshot.
+    _first_utc = previous._last_utc;
+    _first_local = previous._last_local;
+    if (previous._last_tdt != Time::Epoch) {
+        _first_tdt = previous._last_tdt;
+    }
+    if (previous._last_tot != Time::Epoch) {
+        _first_tot = previous._last_tot;
+    }
+    if (previous._last_stt != Time::Epoch) {
+        _first_stt = previous._last_stt;
+    }
+
+    for (auto it = _pids.begin(); it != _pids.end(); ++it) {
+        const PIDContext* const prev = previous._pids.get(it->first);
+        if (prev != nullptr) {
+            PIDContext& pc(*it->second);
+            const PIDContext& ppc(*prev);
+            SubtractCounter(pc.ts_pkt_cnt, ppc.ts_pkt_cnt);
+            SubtractCounter(pc.ts_af_cnt, ppc.ts_af_cnt);
+            SubtractCounter(pc.unit_start_cnt, ppc.unit_start_cnt);
+            SubtractCounter(pc.pl_start_cnt, ppc.pl_start_cnt);
+            SubtractCounter(pc.details->pmt_cnt, ppc.details->pmt_cnt);
+            SubtractCounter(pc.unexp_discont, ppc.unexp_discont);
+            SubtractCounter(pc.exp_discont, ppc.exp_discont);
+            SubtractCounter(pc.duplicated, ppc.duplicated);
+            SubtractCounter(pc.ts_sc_cnt, ppc.ts_sc_cnt);
+            SubtractCounter(pc.inv_ts_sc_cnt, ppc.inv_ts_sc_cnt);
+            SubtractCounter(pc.inv_pes_start, ppc.inv_pes_start);
+            SubtractCounter(pc.details->t2mi_cnt, ppc.details->t2mi_cnt);
+            SubtractCounter(pc.pcr_cnt, ppc.pcr_cnt);
+            SubtractCounter(pc.cryptop_cnt, ppc.cryptop_cnt);
+            SubtractCounter(pc.cryptop_ts_cnt, ppc.cryptop_ts_cnt);
+            SubtractCounter(pc.ts_bitrate_sum, ppc.ts_bitrate_sum);
+            SubtractCounter(pc.ts_bitrate_cnt, ppc.ts_bitrate_cnt);
+            for (auto itp = pc.details->t2mi_plp_ts.begin(); itp != pc.details->t2mi_plp_ts.end(); ++itp) {
+                const auto pplp = ppc.details->t2mi_plp_ts.find(itp->first);
+                if (pplp != ppc.details->t2mi_plp_ts.end()) {
+                    SubtractCounter(itp->second, pplp->second);
+                }
+            }
+            for (auto its = pc.details->sections.begin(); its != pc.details->sections.end(); ++its) {
+                const auto psec = ppc.details->sections.find(its->first);
+                if (psec != ppc.details->sections.end()) {
+                    SubtractCounter(its->second->table_count, psec->second->table_count);
+                    SubtractCounter(its->second->section_count, psec->second->section_count);
+                }
+            }
+        }
+    }
+    _modified = true;
+}
+
+
+//----------------------------------------------------------------------------
+// Set the index of the next packet in the complete stream.
+//----------------------------------------------------------------------------
+
+void ts::TSAnalyzer::setPacketIndex(PacketCounter index)
+{
+    _ts_pkt_offset = index >= _ts_pkt_cnt ? index - _ts_pkt_cnt : 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Append the analysis of the next part of the stream.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Merge a set of values.
+    template <typename T>
+    inline void MergeSet(std::set<T>& set, const std::set<T>& next)
+    {
+        set.insert(next.begin(), next.end());
+    }
+
+    // Merge a value which is known only when not empty or not zero. The most recent one is kept.
+    inline void MergeValue(ts::UString& value, const ts::UString& next)
+    {
+        if (!next.empty()) {
+            value = next;
+        }
+    }
+    template <typename INT>
+    inline void MergeValue(INT& value, INT next)
+    {
+        if (next != 0) {
+            value = next;
+        }
+    }
+    inline void MergeTime(ts::Time& value, const ts::Time& next)
+    {
+        if (next != ts::Time::Epoch) {
+            value = next;
+        }
+    }
+}
+
+void ts::TSAnalyzer::appendAnalysis(const TSAnalyzer& next)
+{
+    // Global counters.
+    _ts_pkt_cnt += next._ts_pkt_cnt;
+    _invalid_sync += next._invalid_sync;
+    _transport_errors += next._transport_errors;
+    _suspect_ignored += next._suspect_ignored;
+    _ts_bitrate_sum += next._ts_bitrate_sum;
+    _ts_bitrate_cnt += next._ts_bitrate_cnt;
+    _tid_present |= next._tid_present;
+    if (next._ts_id_valid) {
+        _ts_id = next._ts_id;
+        _ts_id_valid = true;
+    }
+    if (_ts_user_bitrate == 0) {
+        _ts_user_bitrate = next._ts_user_bitrate;
+    }
+    MergeValue(_country_code, next._country_code);
+
+    // Time stamps: first ones from the first part, last ones from the last part.
+    if (_first_utc == Time::Epoch) {
+        _first_utc = next._first_utc;
+        _first_local = next._first_local;
+    }
+    if (_first_tdt == Time::Epoch) {
+        _first_tdt = next._first_tdt;
+    }
+    if (_first_tot == Time::Epoch) {
+        _first_tot = next._first_tot;
+    }
+    if (_first_stt == Time::Epoch) {
+        _first_stt = next._first_stt;
+    }
+    MergeTime(_last_tdt, next._last_tdt);
+    MergeTime(_last_tot, next._last_tot);
+    MergeTime(_last_stt, next._last_stt);
+    if (next._is_snapshot) {
+        _last_utc = next._last_utc;
+        _last_local = next._last_local;
+    }
+
+    // Merge PID contexts.
+    for (auto it = next._pids.begin(); it != next._pids.end(); ++it) {
+        const PIDContext& npc(*it->second);
+        PIDContext* const pc = _pids.get(it->first);
+        if (pc == nullptr) {
+            // New PID, deep copy of the context.
+            PIDContext* const copy = new PIDContext(npc);
+            copy->details = new PIDDetails(*copy->details);
+            for (auto its = copy->details->sections.begin(); its != copy->details->sections.end(); ++its) {
+                its->second = new ETIDContext(*its->second);
+            }
+            _pids.assign(it->first, copy);
+            continue;
+        }
+
+        // Counters are summed.
+        pc->ts_pkt_cnt += npc.ts_pkt_cnt;
+        pc->ts_af_cnt += npc.ts_af_cnt;
+        pc->unit_start_cnt += npc.unit_start_cnt;
+        pc->pl_start_cnt += npc.pl_start_cnt;
+        pc->unexp_discont += npc.unexp_discont;
+        pc->exp_discont += npc.exp_discont;
+        pc->duplicated += npc.duplicated;
+        pc->ts_sc_cnt += npc.ts_sc_cnt;
+        pc->inv_ts_sc_cnt += npc.inv_ts_sc_cnt;
+        pc->pcr_cnt += npc.pcr_cnt;
+        pc->cryptop_cnt += npc.cryptop_cnt;
+        pc->cryptop_ts_cnt += npc.cryptop_ts_cnt;
+        pc->ts_bitrate_sum += npc.ts_bitrate_sum;
+        pc->ts_bitrate_cnt += npc.ts_bitrate_cnt;
+        pc->details->pmt_cnt += npc.details->pmt_cnt;
+        pc->inv_pes_start += npc.inv_pes_start;
+        pc->details->t2mi_cnt += npc.details->t2mi_cnt;
+        for (auto itp = npc.details->t2mi_plp_ts.begin(); itp != npc.details->t2mi_plp_ts.end(); ++itp) {
+            pc->details->t2mi_plp_ts[itp->first] += itp->second;
+        }
+
+        // Analysis state at end of stream.
+        pc->cur_continuity = npc.cur_continuity;
+        pc->cur_ts_sc = npc.cur_ts_sc;
+        pc->cur_ts_sc_pkt = npc.cur_ts_sc_pkt;
+        pc->last_pcr = npc.last_pcr;
+        pc->last_pcr_pkt = npc.last_pcr_pkt;
+
+        // Characteristics which are found in any part.
+        pc->scrambled = pc->scrambled || npc.scrambled;
+        pc->details->is_pmt_pid = pc->details->is_pmt_pid || npc.details->is_pmt_pid;
+        pc->details->is_pcr_pid = pc->details->is_pcr_pid || npc.details->is_pcr_pid;
+        pc->details->referenced = pc->details->referenced || npc.details->referenced;
+        pc->details->optional = pc->details->optional && npc.details->optional;
+        pc->details->carry_pes = pc->details->carry_pes || npc.details->carry_pes;
+        pc->details->carry_section = pc->details->carry_section || npc.details->carry_section;
+        pc->details->carry_ecm = pc->details->carry_ecm || npc.details->carry_ecm;
+        pc->details->carry_emm = pc->details->carry_emm || npc.details->carry_emm;
+        pc->details->carry_audio = pc->details->carry_audio || npc.details->carry_audio;
+        pc->details->carry_video = pc->details->carry_video || npc.details->carry_video;
+        pc->details->carry_t2mi = pc->details->carry_t2mi || npc.details->carry_t2mi;
+        MergeSet(pc->details->services, npc.details->services);
+        MergeSet(pc->details->cas_operators, npc.details->cas_operators);
+        MergeSet(pc->details->ssu_oui, npc.details->ssu_oui);
+        for (auto ita = npc.details->attributes.begin(); ita != npc.details->attributes.end(); ++ita) {
+            AppendUnique(pc->details->attributes, *ita);
+        }
+
+        // Descriptions: the most recent one is kept.
+        if (npc.details->description != UNREFERENCED) {
+            pc->details->description = npc.details->description;
+        }
+        MergeValue(pc->details->comment, npc.details->comment);
+        MergeValue(pc->details->language, npc.details->language);
+        MergeValue(pc->details->cas_id, npc.details->cas_id);
+
+        // PES stream id.
+        if (pc->pes_stream_id == 0) {
+            pc->pes_stream_id = npc.pes_stream_id;
+            pc->same_stream_id = npc.same_stream_id;
+        }
+        else if (npc.pes_stream_id != 0 && (npc.pes_stream_id != pc->pes_stream_id || !npc.same_stream_id)) {
+            pc->same_stream_id = false;
+        }
+
+        // Merge table contexts.
+        for (auto its = npc.details->sections.begin(); its != npc.details->sections.end(); ++its) {
+            const ETIDContext& netc(*its->second);
+            ETIDContextPtr& etc(pc->details->sections[its->first]);
+            if (etc.isNull()) {
+                etc = new ETIDContext(netc);
+                continue;
+            }
+            // Repetition intervals from each part, including the interval
+            // between the two parts when it is visible in the next part.
+            if (netc.max_repetition_ts > 0) {
+                if (etc->max_repetition_ts == 0 || netc.min_repetition_ts < etc->min_repetition_ts) {
+                    etc->min_repetition_ts = netc.min_repetition_ts;
+                }
+                if (netc.max_repetition_ts > etc->max_repetition_ts) {
+                    etc->max_repetition_ts = netc.max_repetition_ts;
+                }
+            }
+            if (etc->table_count == 0) {
+                etc->first_pkt = netc.first_pkt;
+                etc->first_version = netc.first_version;
+            }
+            if (netc.table_count > 0) {
+                etc->last_pkt = netc.last_pkt;
+                etc->last_version = netc.last_version;
+            }
+            etc->versions |= netc.versions;
+            etc->section_count += netc.section_count;
+            etc->table_count += netc.table_count;
+            if (etc->table_count > 1) {
+                etc->repetition_ts = (etc->last_pkt - etc->first_pkt + (etc->table_count - 1) / 2) / (etc->table_count - 1);
+            }
+        }
+    }
+
+    // Merge service contexts.
+    for (auto it = next._services.begin(); it != next._services.end(); ++it) {
+        const ServiceContext& nsc(*it->second);
+        ServiceContextPtr& sc(_services[it->first]);
+        if (sc.isNull()) {
+            sc = new ServiceContext(nsc);
+            continue;
+        }
+        MergeValue(sc->orig_netw_id, nsc.orig_netw_id);
+        MergeValue(sc->service_type, nsc.service_type);
+        MergeValue(sc->name, nsc.name);
+        MergeValue(sc->provider, nsc.provider);
+        MergeValue(sc->pmt_pid, nsc.pmt_pid);
+        MergeValue(sc->pcr_pid, nsc.pcr_pid);
+        sc->carry_ssu = sc->carry_ssu || nsc.carry_ssu;
+        sc->carry_t2mi = sc->carry_t2mi || nsc.carry_t2mi;
+    }
+
+    // Number of PID's with some properties.
+    _scrambled_pid_cnt = _pcr_pid_cnt = 0;
+    for (auto it = _pids.begin(); it != _pids.end(); ++it) {
+        if (it->second->scrambled) {
+            _scrambled_pid_cnt++;
+        }
+        if (it->second->pcr_cnt > 0) {
+            _pcr_pid_cnt++;
+        }
+    }
+
+    _modified = true;
+}
+
+
 //----------------------------------------------------------------------------
 // Reset the section demux.
 //----------------------------------------------------------------------------
@@ -196,6 +569,39 @@ void ts::TSAnalyzer::resetSectionDemux()
 
 ts::TSAnalyzer::PIDContext::PIDContext(PID pid_, const UString& description_) :
     pid(pid_),
+    cur_continuity(0),
+    cur_ts_sc(0),
+    scrambled(false),
+    same_stream_id(false),
+    pes_stream_id(0),
+    ts_pkt_cnt(0),
+    ts_af_cnt(0),
+    unit_start_cnt(0),
+    pl_start_cnt(0),
+    unexp_discont(0),
+    exp_discont(0),
+    duplicated(0),
+    ts_sc_cnt(0),
+    inv_ts_sc_cnt(0),
+    inv_pes_start(0),
+    pcr_cnt(0),
+    cur_ts_sc_pkt(0),
+    cryptop_cnt(0),
+    cryptop_ts_cnt(0),
+    last_pcr(0),
+    last_pcr_pkt(0),
+    ts_bitrate_sum(0),
+    ts_bitrate_cnt(0),
+    details(new PIDDetails(pid_, description_))
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Constructor for the PID descriptive data
+//----------------------------------------------------------------------------
+
+ts::TSAnalyzer::PIDDetails::PIDDetails(PID pid, const UString& description_) :
     description(description_),
     comment(),
     attributes(),
@@ -211,23 +617,9 @@ ts::TSAnalyzer::PIDContext::PIDContext(PID pid_, const UString& description_) :
     carry_audio(false),
     carry_video(false),
     carry_t2mi(false),
-    scrambled(false),
-    same_stream_id(false),
-    pes_stream_id(0),
-    ts_pkt_cnt(0),
-    ts_af_cnt(0),
-    unit_start_cnt(0),
-    pl_start_cnt(0),
     pmt_cnt(0),
     crypto_period(0),
-    unexp_discont(0),
-    exp_discont(0),
-    duplicated(0),
-    ts_sc_cnt(0),
-    inv_ts_sc_cnt(0),
-    inv_pes_start(0),
     t2mi_cnt(0),
-    pcr_cnt(0),
     ts_pcr_bitrate(0),
     bitrate(0),
     language(),
@@ -235,16 +627,7 @@ ts::TSAnalyzer::PIDContext::PIDContext(PID pid_, const UString& description_) :
     cas_operators(),
     sections(),
     ssu_oui(),
-    t2mi_plp_ts(),
-    cur_continuity(0),
-    cur_ts_sc(0),
-    cur_ts_sc_pkt(0),
-    cryptop_cnt(0),
-    cryptop_ts_cnt(0),
-    last_pcr(0),
-    last_pcr_pkt(0),
-    ts_bitrate_sum(0),
-    ts_bitrate_cnt(0)
+    t2mi_plp_ts()
 {
     // Guess the initial description, based on the PID
     // Global PID's (PAT, CAT, etc) are marked as "referenced" since they
@@ -463,16 +846,16 @@ ts::UString ts::TSAnalyzer::ServiceContext::getName() const
 ts::TSAnalyzer::ETIDContextPtr ts::TSAnalyzer::getETID(const Section& section)
 {
     const ETID etid = section.etid();
-    const PIDContextPtr pc(getPID(section.sourcePID()));
-    ETIDContextMap::const_iterator it(pc->sections.find(etid));
+    PIDContext* const pc = getPID(section.sourcePID());
+    ETIDContextMap::const_iterator it(pc->details->sections.find(etid));
 
-    if (it != pc->sections.end()) {
+    if (it != pc->details->sections.end()) {
         // ETID context found
         return it->second;
     }
     else {
         ETIDContextPtr result(new ETIDContext(etid));
-        pc->sections[etid] = result;
+        pc->details->sections[etid] = result;
         result->first_version = section.version();
         return result;
     }
@@ -483,17 +866,19 @@ ts::TSAnalyzer::ETIDContextPtr ts::TSAnalyzer::getETID(const Section& section)
 //  Return a PID context. Allocate a new entry if PID not found.
 //----------------------------------------------------------------------------
 
-ts::TSAnalyzer::PIDContextPtr ts::TSAnalyzer::getPID(PID pid, const UString& description)
+ts::TSAnalyzer::PIDContext* ts::TSAnalyzer::getPID(PID pid, const UString& description)
 {
-    const PIDContextPtr p(_pids[pid]);
-    if (p.isNull()) {
-        // The PID was not yet used, map entry just created.
-        return _pids[pid] = new PIDContext(pid, description);
+    PIDContext* const p = _pids.get(pid);
+    if (p == nullptr) {
+        // The PID was not yet used, create its context.
+        PIDContext* const pc = new PIDContext(pid, description);
+        _pids.assign(pid, pc);
+        return pc;
     }
     else {
         // If the PID was marked as unreferenced, now use actual description.
-        if (p->description == UNREFERENCED && description != UNREFERENCED) {
-            p->description = description;
+        if (p->details->description == UNREFERENCED && description != UNREFERENCED) {
+            p->details->description = description;
         }
         return p;
     }
@@ -522,7 +907,7 @@ ts::TSAnalyzer::ServiceContextPtr ts::TSAnalyzer::getService(uint16_t service_id
 //  services, we add the service into this list, if not already in.
 //----------------------------------------------------------------------------
 
-void ts::TSAnalyzer::PIDContext::addService(uint16_t service_id)
+void ts::TSAnalyzer::PIDDetails::addService(uint16_t service_id)
 {
     // The PID now belongs to a service
     referenced = true;
@@ -544,6 +929,7 @@ void ts::TSAnalyzer::handleSection(SectionDemux&, const Section& section)
 {
     ETIDContextPtr etc(getETID(section));
     const uint8_t version = section.version();
+    const uint64_t packet_index = _ts_pkt_offset + _ts_pkt_cnt;
 
     // Count one section
     etc->section_count++;
@@ -552,13 +938,13 @@ void ts::TSAnalyzer::handleSection(SectionDemux&, const Section& section)
     if (section.sectionNumber() == 0) {
         if (etc->table_count++ == 0) {
             // First occurence of table
-            etc->first_pkt = _ts_pkt_cnt;
+            etc->first_pkt = packet_index;
             if (section.isLongSection()) {
                 etc->first_version = version;
             }
         }
         else {
-            const uint64_t rep = _ts_pkt_cnt - etc->last_pkt;
+            const uint64_t rep = packet_index - etc->last_pkt;
             if (etc->table_count == 2) {
                 // First time we are able to compute an interval
                 etc->repetition_ts = etc->min_repetition_ts = etc->max_repetition_ts = rep;
@@ -571,10 +957,10 @@ void ts::TSAnalyzer::handleSection(SectionDemux&, const Section& section)
                     etc->max_repetition_ts = rep;
                 }
                 assert(etc->table_count > 2);
-                etc->repetition_ts = (_ts_pkt_cnt - etc->first_pkt + (etc->table_count - 1) / 2) / (etc->table_count - 1);
+                etc->repetition_ts = (packet_index - etc->first_pkt + (etc->table_count - 1) / 2) / (etc->table_count - 1);
             }
         }
-        etc->last_pkt = _ts_pkt_cnt;
+        etc->last_pkt = packet_index;
         if (section.isLongSection()) {
             etc->versions.set(version);
             etc->last_version = version;
@@ -694,11 +1080,11 @@ void ts::TSAnalyzer::analyzePAT(const PAT& pat)
         uint16_t service_id(it->first);
         PID pmt_pid(it->second);
         // Register the PMT PID
-        PIDContextPtr ps(getPID(pmt_pid));
-        ps->description = u"PMT";
-        ps->addService(service_id);
-        ps->is_pmt_pid = true;
-        ps->carry_section = true;
+        PIDContext* ps = getPID(pmt_pid);
+        ps->details->description = u"PMT";
+        ps->details->addService(service_id);
+        ps->details->is_pmt_pid = true;
+        ps->details->carry_section = true;
         // Add a filter on the referenced PID to get the PMT
         _demux.addPID(pmt_pid);
         // Describe the service
@@ -726,8 +1112,8 @@ void ts::TSAnalyzer::analyzeCAT(const CAT& cat)
 void ts::TSAnalyzer::analyzePMT(PID pid, const PMT& pmt)
 {
     // Count the number of PMT's on this PID
-    PIDContextPtr ps(getPID(pid));
-    ps->pmt_cnt++;
+    PIDContext* ps = getPID(pid);
+    ps->details->pmt_cnt++;
 
     // Get service description
     ServiceContextPtr svp(getService(pmt.service_id));
@@ -736,8 +1122,8 @@ void ts::TSAnalyzer::analyzePMT(PID pid, const PMT& pmt)
     if (svp->pmt_pid != pid) {
         // PAT/PMT inconsistency: Found a PMT on a PID which was not
         // referenced as a PMT PID in the PAT.
-        ps->addService(pmt.service_id);
-        ps->description = u"PMT";
+        ps->details->addService(pmt.service_id);
+        ps->details->description = u"PMT";
     }
 
     // Locate PCR PID
@@ -747,8 +1133,8 @@ void ts::TSAnalyzer::analyzePMT(PID pid, const PMT& pmt)
         // will normally be replaced later by "Audio", "Video", etc.
         // Some encoders, however, generate a dedicated PID for PCR's.
         ps = getPID(pmt.pcr_pid, u"PCR (not otherwise referenced)");
-        ps->is_pcr_pid = true;
-        ps->addService(pmt.service_id);
+        ps->details->is_pcr_pid = true;
+        ps->details->addService(pmt.service_id);
     }
 
     // Process "program info" list of descriptors.
@@ -759,16 +1145,16 @@ void ts::TSAnalyzer::analyzePMT(PID pid, const PMT& pmt)
         const PID es_pid = it->first;
         const PMT::Stream& stream(it->second);
         ps = getPID(es_pid);
-        ps->addService(pmt.service_id);
-        ps->carry_audio = ps->carry_audio || IsAudioST(stream.stream_type);
-        ps->carry_video = ps->carry_video || IsVideoST(stream.stream_type);
-        ps->carry_pes = ps->carry_pes || IsPES(stream.stream_type);
-        if (!ps->carry_section && !ps->carry_t2mi && IsSectionST(stream.stream_type)) {
-            ps->carry_section = true;
+        ps->details->addService(pmt.service_id);
+        ps->details->carry_audio = ps->details->carry_audio || IsAudioST(stream.stream_type);
+        ps->details->carry_video = ps->details->carry_video || IsVideoST(stream.stream_type);
+        ps->details->carry_pes = ps->details->carry_pes || IsPES(stream.stream_type);
+        if (!ps->details->carry_section && !ps->details->carry_t2mi && IsSectionST(stream.stream_type)) {
+            ps->details->carry_section = true;
             _demux.addPID(es_pid);
         }
-        ps->description = names::StreamType(stream.stream_type);
-        analyzeDescriptors(stream.descs, svp.pointer(), ps.pointer());
+        ps->details->description = names::StreamType(stream.stream_type);
+        analyzeDescriptors(stream.descs, svp.pointer(), ps);
     }
 }
 
@@ -844,13 +1230,13 @@ void ts::TSAnalyzer::analyzeMGT(const MGT& mgt)
         const UString name(u"ATSC " + MGT::TableTypeName(tab.table_type));
 
         // Get the PID context.
-        const PIDContextPtr ps(getPID(tab.table_type_PID, name));
-        ps->referenced = true;
-        ps->carry_section = true;
+        PIDContext* const ps = getPID(tab.table_type_PID, name);
+        ps->details->referenced = true;
+        ps->details->carry_section = true;
 
         // An ATSC PID may carry more than one table type.
-        if (ps->description != name) {
-            AppendUnique(ps->attributes, name);
+        if (ps->details->description != name) {
+            AppendUnique(ps->details->attributes, name);
         }
 
         // Some additional PSIP PID's shall be analyzed.
@@ -910,7 +1296,7 @@ void ts::TSAnalyzer::analyzeSTT(const STT& stt)
 // Return a full description, with comment and optionally attributes
 //----------------------------------------------------------------------------
 
-ts::UString ts::TSAnalyzer::PIDContext::fullDescription(bool include_attributes) const
+ts::UString ts::TSAnalyzer::PIDDetails::fullDescription(bool include_attributes) const
 {
     // Additional description
     UString more(comment);
@@ -959,14 +1345,14 @@ void ts::TSAnalyzer::analyzeDescriptors(const DescriptorList& descs, ServiceCont
             case DID_LANGUAGE: {
                 if (size >= 4 && ps != nullptr) {
                     // First 3 bytes contains the audio language
-                    ps->language = UString::FromDVB(data, 3);
+                    ps->details->language = UString::FromDVB(data, 3);
                     // Next byte contains audio type, 0 is the default
                     uint8_t audio_type(data[3]);
                     if (audio_type == 0) {
-                        ps->comment = ps->language;
+                        ps->details->comment = ps->details->language;
                     }
                     else {
-                        ps->comment = ps->language + u", " + names::AudioType(audio_type);
+                        ps->details->comment = ps->details->language + u", " + names::AudioType(audio_type);
                     }
                 }
                 break;
@@ -974,63 +1360,63 @@ void ts::TSAnalyzer::analyzeDescriptors(const DescriptorList& descs, ServiceCont
             case DID_AC3: {
                 if (ps != nullptr) {
                     // The presence of this descriptor indicates an AC-3 audio track.
-                    ps->description = u"AC-3 Audio";
-                    ps->carry_audio = true;
+                    ps->details->description = u"AC-3 Audio";
+                    ps->details->carry_audio = true;
                 }
                 break;
             }
             case DID_ENHANCED_AC3: {
                 if (ps != nullptr) {
                     // The presence of this descriptor indicates an Enhanced AC-3 audio track.
-                    ps->description = u"E-AC-3 Audio";
-                    ps->carry_audio = true;
+                    ps->details->description = u"E-AC-3 Audio";
+                    ps->details->carry_audio = true;
                 }
                 break;
             }
             case DID_AAC: {
                 if (ps != nullptr) {
                     // The presence of this descriptor indicates an HE-AAC audio track.
-                    ps->description = u"HE-AAC Audio";
-                    ps->carry_audio = true;
+                    ps->details->description = u"HE-AAC Audio";
+                    ps->details->carry_audio = true;
                 }
                 break;
             }
             case DID_DTS: {
                 if (ps != nullptr) {
                     // The presence of this descriptor indicates a DTS audio track.
-                    ps->description = u"DTS Audio";
-                    ps->carry_audio = true;
+                    ps->details->description = u"DTS Audio";
+                    ps->details->carry_audio = true;
                 }
                 break;
             }
             case DID_SUBTITLING: {
                 if (size >= 4 && ps != nullptr) {
                     // First 3 bytes contains the language
-                    ps->language = UString::FromDVB(data, 3);
+                    ps->details->language = UString::FromDVB(data, 3);
                     // Next byte contains subtitling type
                     uint8_t type = data[3];
-                    ps->description = u"Subtitles";
-                    ps->comment = ps->language;
-                    AppendUnique(ps->attributes, names::SubtitlingType(type));
+                    ps->details->description = u"Subtitles";
+                    ps->details->comment = ps->details->language;
+                    AppendUnique(ps->details->attributes, names::SubtitlingType(type));
                 }
                 break;
             }
             case DID_TELETEXT: {
                 if (size >= 4 && ps != nullptr) {
                     // First 3 bytes contains the language
-                    ps->language = UString::FromDVB(data, 3);
+                    ps->details->language = UString::FromDVB(data, 3);
                     // Next byte contains teletext type
                     uint8_t type(data[3] >> 3);
-                    ps->description = u"Teletext";
-                    ps->comment = ps->language;
-                    AppendUnique(ps->attributes, names::TeletextType(type));
+                    ps->details->description = u"Teletext";
+                    ps->details->comment = ps->details->language;
+                    AppendUnique(ps->details->attributes, names::TeletextType(type));
                 }
                 break;
             }
             case DID_APPLI_SIGNALLING: {
                 if (ps != nullptr) {
                     // The presence of this descriptor indicates a PID carrying an AIT.
-                    ps->comment = u"AIT";
+                    ps->details->comment = u"AIT";
                 }
                 break;
             }
@@ -1040,20 +1426,20 @@ void ts::TSAnalyzer::analyzeDescriptors(const DescriptorList& descs, ServiceCont
                     switch (data[0]) {
                         case EDID_AC4: {
                             // The presence of this descriptor indicates an AC-4 audio track.
-                            ps->description = u"AC-4 Audio";
-                            ps->carry_audio = true;
+                            ps->details->description = u"AC-4 Audio";
+                            ps->details->carry_audio = true;
                             break;
                         }
                         case EDID_DTS_HD_AUDIO: {
                             // The presence of this descriptor indicates an DTS-HD audio track.
-                            ps->description = u"DTS-HD Audio";
-                            ps->carry_audio = true;
+                            ps->details->description = u"DTS-HD Audio";
+                            ps->details->carry_audio = true;
                             break;
                         }
                         case EDID_DTS_NEURAL: {
                             // The presence of this descriptor indicates an DTS-Neural audio track.
-                            ps->description = u"DTS Neural Surround Audio";
-                            ps->carry_audio = true;
+                            ps->details->description = u"DTS Neural Surround Audio";
+                            ps->details->carry_audio = true;
                             break;
                         }
                         default: {
@@ -1096,7 +1482,7 @@ void ts::TSAnalyzer::analyzeDescriptors(const DescriptorList& descs, ServiceCont
                                     }
                                     data += slength; size -= slength; dlength -= slength;
                                     // Store OUI in PID context
-                                    ps->ssu_oui.insert(oui);
+                                    ps->details->ssu_oui.insert(oui);
                                 }
                             }
                             break;
@@ -1104,27 +1490,27 @@ void ts::TSAnalyzer::analyzeDescriptors(const DescriptorList& descs, ServiceCont
                         case 0x0005: {
                             // Multi-Protocol Encapsulation.
                             if (ps != nullptr) {
-                                ps->comment = u"MPE";
+                                ps->details->comment = u"MPE";
                             }
                             break;
                         }
                         case 0x000B: {
                             // IP/MAC Notification Table.
                             if (ps != nullptr) {
-                                ps->comment = u"INT";
+                                ps->details->comment = u"INT";
                             }
                             break;
                         }
                         case 0x0123: {
                             // HbbTV data carousel.
                             if (ps != nullptr) {
-                                ps->comment = u"HbbTV";
+                                ps->details->comment = u"HbbTV";
                             }
                             break;
                         }
                         default: {
                             if (ps != nullptr) {
-                                ps->comment =  names::DataBroadcastId(dbid);
+                                ps->details->comment =  names::DataBroadcastId(dbid);
                             }
                             break;
                         }
@@ -1170,14 +1556,14 @@ void ts::TSAnalyzer::analyzeCADescriptor(const Descriptor& desc, ServiceContext*
             PID pid(GetUInt16(data) & 0x1FFF);
             uint16_t opi(GetUInt16(data + 2));
             // Found an ECM PID for the service
-            PIDContextPtr eps(getPID(pid));
-            eps->addService(svp->service_id);
-            eps->carry_ecm = true;
-            eps->cas_id = ca_sysid;
-            eps->cas_operators.insert(opi);
-            eps->carry_section = true;
+            PIDContext* eps = getPID(pid);
+            eps->details->addService(svp->service_id);
+            eps->details->carry_ecm = true;
+            eps->details->cas_id = ca_sysid;
+            eps->details->cas_operators.insert(opi);
+            eps->details->carry_section = true;
             _demux.addPID(ca_pid);
-            eps->description.format(u"MediaGuard ECM for OPI %d (0x%X)", {opi, opi});
+            eps->details->description.format(u"MediaGuard ECM for OPI %d (0x%X)", {opi, opi});
             data += 15; size -= 15;
         }
     }
@@ -1187,14 +1573,14 @@ void ts::TSAnalyzer::analyzeCADescriptor(const Descriptor& desc, ServiceContext*
         // MediaGuard CA descriptor in the CAT, new format
         uint16_t etypes(GetUInt16(data));
         uint16_t opi(GetUInt16(data + 2));
-        PIDContextPtr eps(getPID(ca_pid));
-        eps->referenced = true;
-        eps->carry_emm = true;
-        eps->cas_id = ca_sysid;
-        eps->cas_operators.insert(opi);
-        eps->carry_section = true;
+        PIDContext* eps = getPID(ca_pid);
+        eps->details->referenced = true;
+        eps->details->carry_emm = true;
+        eps->details->cas_id = ca_sysid;
+        eps->details->cas_operators.insert(opi);
+        eps->details->carry_section = true;
         _demux.addPID(ca_pid);
-        eps->description.format(u"MediaGuard EMM for OPI %d (0x%X), EMM types: 0x%X", {opi, opi, etypes});
+        eps->details->description.format(u"MediaGuard EMM for OPI %d (0x%X), EMM types: 0x%X", {opi, opi, etypes});
     }
 
     else if (cas == CAS_MEDIAGUARD && svp == nullptr && size >= 1) {
@@ -1202,25 +1588,25 @@ void ts::TSAnalyzer::analyzeCADescriptor(const Descriptor& desc, ServiceContext*
         // MediaGuard CA descriptor in the CAT, old format
         uint8_t nb_opi = data[0];
         data++; size --;
-        PIDContextPtr eps(getPID(ca_pid));
-        eps->referenced = true;
-        eps->carry_emm = true;
-        eps->cas_id = ca_sysid;
-        eps->carry_section = true;
+        PIDContext* eps = getPID(ca_pid);
+        eps->details->referenced = true;
+        eps->details->carry_emm = true;
+        eps->details->cas_id = ca_sysid;
+        eps->details->carry_section = true;
         _demux.addPID(ca_pid);
-        eps->description = u"MediaGuard Individual EMM";
+        eps->details->description = u"MediaGuard Individual EMM";
 
         while (nb_opi > 0 && size >= 4) {
             PID pid(GetUInt16(data) & 0x1FFF);
             uint16_t opi(GetUInt16(data + 2));
-            PIDContextPtr eps1(getPID(pid));
-            eps1->referenced = true;
-            eps1->carry_emm = true;
-            eps1->cas_id = ca_sysid;
-            eps1->cas_operators.insert(opi);
-            eps1->carry_section = true;
+            PIDContext* eps1 = getPID(pid);
+            eps1->details->referenced = true;
+            eps1->details->carry_emm = true;
+            eps1->details->cas_id = ca_sysid;
+            eps1->details->cas_operators.insert(opi);
+            eps1->details->carry_section = true;
             _demux.addPID(ca_pid);
-            eps1->description = UString::Format(u"MediaGuard Group EMM for OPI %d (0x%X)", {opi, opi});
+            eps1->details->description = UString::Format(u"MediaGuard Group EMM for OPI %d (0x%X)", {opi, opi});
             data += 4; size -= 4; nb_opi--;
         }
     }
@@ -1229,46 +1615,46 @@ void ts::TSAnalyzer::analyzeCADescriptor(const Descriptor& desc, ServiceContext*
 
         // SafeAccess CA descriptor in the CAT
         data++; size --; // skip applicable EMM bitmask
-        PIDContextPtr eps(getPID(ca_pid));
-        eps->referenced = true;
-        eps->carry_emm = true;
-        eps->cas_id = ca_sysid;
-        eps->carry_section = true;
+        PIDContext* eps = getPID(ca_pid);
+        eps->details->referenced = true;
+        eps->details->carry_emm = true;
+        eps->details->cas_id = ca_sysid;
+        eps->details->carry_section = true;
         _demux.addPID(ca_pid);
-        eps->description = u"SafeAccess EMM";
+        eps->details->description = u"SafeAccess EMM";
 
         while (size >= 2) {
             uint16_t ppid = GetUInt16(data);
             data += 2; size -= 2;
-            if (eps->cas_operators.empty()) {
-                eps->description += UString::Format(u" for PPID %d (0x%X)", {ppid, ppid});
+            if (eps->details->cas_operators.empty()) {
+                eps->details->description += UString::Format(u" for PPID %d (0x%X)", {ppid, ppid});
             }
             else {
-                eps->description += UString::Format(u", %d (0x%X)", {ppid, ppid});
+                eps->details->description += UString::Format(u", %d (0x%X)", {ppid, ppid});
             }
-            eps->cas_operators.insert(ppid);
+            eps->details->cas_operators.insert(ppid);
         }
     }
 
     else if (cas == CAS_VIACCESS) {
 
         // Viaccess CA descriptor in the CAT or PMT
-        PIDContextPtr eps(getPID(ca_pid));
-        eps->referenced = true;
-        eps->cas_id = ca_sysid;
-        eps->carry_section = true;
+        PIDContext* eps = getPID(ca_pid);
+        eps->details->referenced = true;
+        eps->details->cas_id = ca_sysid;
+        eps->details->carry_section = true;
         _demux.addPID(ca_pid);
 
         if (svp == nullptr) {
             // No service, this is an EMM PID
-            eps->carry_emm = true;
-            eps->description = u"Viaccess EMM";
+            eps->details->carry_emm = true;
+            eps->details->description = u"Viaccess EMM";
         }
         else {
             // Found an ECM PID for the service
-            eps->carry_ecm = true;
-            eps->addService(svp->service_id);
-            eps->description = u"Viaccess ECM";
+            eps->details->carry_ecm = true;
+            eps->details->addService(svp->service_id);
+            eps->details->description = u"Viaccess ECM";
         }
 
         while (size >= 2) {
@@ -1280,13 +1666,13 @@ void ts::TSAnalyzer::analyzeCADescriptor(const Descriptor& desc, ServiceContext*
             }
             if (tag == 0x14 && len == 3) {
                 const uint32_t soid = GetUInt24(data);
-                if (eps->cas_operators.empty()) {
-                    eps->description += UString::Format(u" for SOID %d (0x%06X)", {soid, soid});
+                if (eps->details->cas_operators.empty()) {
+                    eps->details->description += UString::Format(u" for SOID %d (0x%06X)", {soid, soid});
                 }
                 else {
-                    eps->description += UString::Format(u", %d (0x%06X)", {soid, soid});
+                    eps->details->description += UString::Format(u", %d (0x%06X)", {soid, soid});
                 }
-                eps->cas_operators.insert(soid);
+                eps->details->cas_operators.insert(soid);
             }
             data += len; size -= len;
         }
@@ -1295,22 +1681,22 @@ void ts::TSAnalyzer::analyzeCADescriptor(const Descriptor& desc, ServiceContext*
     else {
 
         // Other CA descriptor, general format
-        PIDContextPtr eps(getPID(ca_pid));
-        eps->referenced = true;
-        eps->cas_id = ca_sysid;
-        eps->carry_section = true;
+        PIDContext* eps = getPID(ca_pid);
+        eps->details->referenced = true;
+        eps->details->cas_id = ca_sysid;
+        eps->details->carry_section = true;
         _demux.addPID(ca_pid);
 
         if (svp == nullptr) {
             // No service, this is an EMM PID
-            eps->carry_emm = true;
-            eps->description = names::CASId(ca_sysid) + u" EMM";
+            eps->details->carry_emm = true;
+            eps->details->description = names::CASId(ca_sysid) + u" EMM";
         }
         else {
             // Found an ECM PID for the service
-            eps->carry_ecm = true;
-            eps->addService(svp->service_id);
-            eps->description = names::CASId(ca_sysid) + u" ECM";
+            eps->details->carry_ecm = true;
+            eps->details->addService(svp->service_id);
+            eps->details->description = names::CASId(ca_sysid) + u" ECM";
         }
     }
 }
@@ -1323,7 +1709,7 @@ void ts::TSAnalyzer::analyzeCADescriptor(const Descriptor& desc, ServiceContext*
 
 void ts::TSAnalyzer::handleNewAudioAttributes(PESDemux&, const PESPacket& pkt, const AudioAttributes& attr)
 {
-    AppendUnique(getPID(pkt.getSourcePID())->attributes, attr.toString());
+    AppendUnique(getPID(pkt.getSourcePID())->details->attributes, attr.toString());
 }
 
 
@@ -1334,7 +1720,7 @@ void ts::TSAnalyzer::handleNewAudioAttributes(PESDemux&, const PESPacket& pkt, c
 
 void ts::TSAnalyzer::handleNewAC3Attributes(PESDemux&, const PESPacket& pkt, const AC3Attributes& attr)
 {
-    AppendUnique(getPID(pkt.getSourcePID())->attributes, attr.toString());
+    AppendUnique(getPID(pkt.getSourcePID())->details->attributes, attr.toString());
 }
 
 
@@ -1345,7 +1731,7 @@ void ts::TSAnalyzer::handleNewAC3Attributes(PESDemux&, const PESPacket& pkt, con
 
 void ts::TSAnalyzer::handleNewVideoAttributes(PESDemux&, const PESPacket& pkt, const VideoAttributes& attr)
 {
-    AppendUnique(getPID(pkt.getSourcePID())->attributes, attr.toString());
+    AppendUnique(getPID(pkt.getSourcePID())->details->attributes, attr.toString());
 }
 
 
@@ -1356,7 +1742,7 @@ void ts::TSAnalyzer::handleNewVideoAttributes(PESDemux&, const PESPacket& pkt, c
 
 void ts::TSAnalyzer::handleNewAVCAttributes(PESDemux&, const PESPacket& pkt, const AVCAttributes& attr)
 {
-    AppendUnique(getPID(pkt.getSourcePID())->attributes, attr.toString());
+    AppendUnique(getPID(pkt.getSourcePID())->details->attributes, attr.toString());
 }
 
 
@@ -1375,10 +1761,10 @@ void ts::TSAnalyzer::handleT2MINewPID(T2MIDemux& demux, const PMT& pmt, PID pid,
     }
 
     // Identify this PID as T2-MI, if not yet identified.
-    PIDContextPtr pc(getPID(pid));
-    pc->description = u"T2-MI";
-    pc->carry_t2mi = true;
-    pc->carry_section = false;
+    PIDContext* pc = getPID(pid);
+    pc->details->description = u"T2-MI";
+    pc->details->carry_t2mi = true;
+    pc->details->carry_section = false;
 
     // And demux all T2-MI packets.
     _t2mi_demux.addPID(pid);
@@ -1392,18 +1778,18 @@ void ts::TSAnalyzer::handleT2MINewPID(T2MIDemux& demux, const PMT& pmt, PID pid,
 
 void ts::TSAnalyzer::handleT2MIPacket(T2MIDemux& demux, const T2MIPacket& pkt)
 {
-    PIDContextPtr pc(getPID(pkt.getSourcePID(), u"T2-MI"));
+    PIDContext* pc = getPID(pkt.getSourcePID(), u"T2-MI");
 
     // Count T2-MI packets.
-    pc->t2mi_cnt++;
+    pc->details->t2mi_cnt++;
 
     // Process PLP (only in baseband frame).
     if (pkt.plpValid()) {
         // Make sure the PLP is referenced, even if no TS packet is demux'ed.
-        pc->t2mi_plp_ts[pkt.plp()];
+        pc->details->t2mi_plp_ts[pkt.plp()];
 
         // Add the PLP as attributes of this PID.
-        AppendUnique(pc->attributes, UString::Format(u"PLP: 0x%X (%d)", {pkt.plp(), pkt.plp()}));
+        AppendUnique(pc->details->attributes, UString::Format(u"PLP: 0x%X (%d)", {pkt.plp(), pkt.plp()}));
     }
 }
 
@@ -1415,10 +1801,10 @@ void ts::TSAnalyzer::handleT2MIPacket(T2MIDemux& demux, const T2MIPacket& pkt)
 
 void ts::TSAnalyzer::handleTSPacket(T2MIDemux& demux, const T2MIPacket& t2mi, const TSPacket& ts)
 {
-    PIDContextPtr pc(getPID(t2mi.getSourcePID(), u"T2-MI"));
+    PIDContext* pc = getPID(t2mi.getSourcePID(), u"T2-MI");
 
     // Count demux'ed TS packets from this PLP.
-    pc->t2mi_plp_ts[t2mi.plp()]++;
+    pc->details->t2mi_plp_ts[t2mi.plp()]++;
 }
 
 
@@ -1441,7 +1827,7 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt)
 
     // Count TS packets
     _ts_pkt_cnt++;
-    uint64_t packet_index(_ts_pkt_cnt);
+    uint64_t packet_index(_ts_pkt_offset + _ts_pkt_cnt);
 
     // Detect and ignore invalid packets
     bool invalid_packet = false;
@@ -1479,8 +1865,11 @@ void ts::TSAnalyzer::feedPacket(const TSPacket& pkt)
     _pes_demux.feedPacket(pkt);
     _t2mi_demux.feedPacket(pkt);
 
-    // Get PID context
-    PIDContextPtr ps(getPID(pkt.getPID()));
+    // Get PID context (direct access when it already exists, the most common case)
+    PIDContext* ps = _pids.get(pkt.getPID());
+    if (ps == nullptr) {
+        ps = getPID(pkt.getPID());
+    }
     ps->ts_pkt_cnt++;
 
     // Accumulate stat from packet
@@ -1652,9 +2041,11 @@ void ts::TSAnalyzer::recomputeStatistics()
         return;
     }
 
-    // Store "last" system times
-    _last_utc = Time::CurrentUTC();
-    _last_local = Time::CurrentLocalTime();
+    // Store "last" system times (already set in snapshots)
+    if (!_is_snapshot) {
+        _last_utc = Time::CurrentUTC();
+        _last_local = Time::CurrentLocalTime();
+    }
 
     // Compute bitrate and broadcast duration
     _ts_pcr_bitrate_188 = _ts_bitrate_cnt == 0 ? 0 : BitRate(_ts_bitrate_sum / _ts_bitrate_cnt);
@@ -1687,22 +2078,22 @@ void ts::TSAnalyzer::recomputeStatistics()
 
         // Compute TS bitrate from the PCR's of this PID
         if (pc.ts_bitrate_cnt != 0) {
-            pc.ts_pcr_bitrate = uint32_t(pc.ts_bitrate_sum / pc.ts_bitrate_cnt);
+            pc.details->ts_pcr_bitrate = uint32_t(pc.ts_bitrate_sum / pc.ts_bitrate_cnt);
         }
 
         // Compute average PID bitrate
         if (_ts_pkt_cnt != 0) {
-            pc.bitrate = uint32_t((uint64_t(_ts_bitrate) * uint64_t(pc.ts_pkt_cnt)) / uint64_t(_ts_pkt_cnt));
+            pc.details->bitrate = uint32_t((uint64_t(_ts_bitrate) * uint64_t(pc.ts_pkt_cnt)) / uint64_t(_ts_pkt_cnt));
         }
 
         // Compute average crypto-period for this PID
         // Remember that first crypto-period was ignored.
         if (pc.cryptop_cnt > 1) {
-            pc.crypto_period = pc.cryptop_ts_cnt / (pc.cryptop_cnt - 1);
+            pc.details->crypto_period = pc.cryptop_ts_cnt / (pc.cryptop_cnt - 1);
         }
 
         // If the PID belongs to some services, update services info.
-        for (ServiceIdSet::iterator it = pc.services.begin(); it != pc.services.end(); ++it) {
+        for (ServiceIdSet::iterator it = pc.details->services.begin(); it != pc.details->services.end(); ++it) {
             ServiceContextPtr scp(getService(*it));
             scp->pid_cnt++;
             scp->ts_pkt_cnt += pc.ts_pkt_cnt;
@@ -1712,7 +2103,7 @@ void ts::TSAnalyzer::recomputeStatistics()
         }
 
         // Enforce PES when carrying audio or video
-        pc.carry_pes = pc.carry_pes || pc.carry_audio || pc.carry_video;
+        pc.details->carry_pes = pc.details->carry_pes || pc.details->carry_audio || pc.details->carry_video;
 
         // Count non-empty PID's
         if (pc.ts_pkt_cnt != 0) {
@@ -1720,7 +2111,7 @@ void ts::TSAnalyzer::recomputeStatistics()
         }
 
         // Count unreferenced PID's
-        if (!pc.referenced && pc.ts_pkt_cnt != 0) {
+        if (!pc.details->referenced && pc.ts_pkt_cnt != 0) {
             _unref_pid_cnt++;
             _unref_pkt_cnt += pc.ts_pkt_cnt;
             if (pc.scrambled) {
@@ -1729,7 +2120,7 @@ void ts::TSAnalyzer::recomputeStatistics()
         }
 
         // Count global PID's
-        if (pc.referenced && pc.services.size() == 0 && pc.ts_pkt_cnt != 0) {
+        if (pc.details->referenced && pc.details->services.size() == 0 && pc.ts_pkt_cnt != 0) {
             _global_pid_cnt++;
             _global_pkt_cnt += pc.ts_pkt_cnt;
             if (pc.scrambled) {
@@ -1738,7 +2129,7 @@ void ts::TSAnalyzer::recomputeStatistics()
         }
 
         // Count global PSI/SI PID's
-        if (pc.pid <= PID_DVB_LAST && pc.services.size() == 0 && pc.ts_pkt_cnt != 0) {
+        if (pc.pid <= PID_DVB_LAST && pc.details->services.size() == 0 && pc.ts_pkt_cnt != 0) {
             _psisi_pid_cnt++;
             _psisi_pkt_cnt += pc.ts_pkt_cnt;
             if (pc.scrambled) {
@@ -1820,7 +2211,7 @@ void ts::TSAnalyzer::getGlobalPIDs(std::vector<PID>& list)
     list.clear();
 
     for (PIDContextMap::const_iterator it = _pids.begin(); it != _pids.end(); ++it) {
-        if (it->second->referenced && it->second->services.empty() && it->second->ts_pkt_cnt > 0) {
+        if (it->second->details->referenced && it->second->details->services.empty() && it->second->ts_pkt_cnt > 0) {
             list.push_back(it->first);
         }
     }
@@ -1837,7 +2228,7 @@ void ts::TSAnalyzer::getUnreferencedPIDs(std::vector<PID>& list)
     list.clear();
 
     for (PIDContextMap::const_iterator it = _pids.begin(); it != _pids.end(); ++it) {
-        if (!it->second->referenced && it->second->ts_pkt_cnt > 0) {
+        if (!it->second->details->referenced && it->second->ts_pkt_cnt > 0) {
             list.push_back(it->first);
         }
     }
@@ -1854,7 +2245,7 @@ void ts::TSAnalyzer::getPIDsOfService(std::vector<PID>& list, uint16_t service_i
     list.clear();
 
     for (PIDContextMap::const_iterator it = _pids.begin(); it != _pids.end(); ++it) {
-        if (it->second->services.count(service_id) > 0) {
+        if (it->second->details->services.count(service_id) > 0) {
             list.push_back(it->first);
         }
     }
@@ -1871,7 +2262,7 @@ void ts::TSAnalyzer::getPIDsWithPES(std::vector<PID>& list)
     list.clear();
 
     for (PIDContextMap::const_iterator it = _pids.begin(); it != _pids.end(); ++it) {
-        if (it->second->carry_pes) {
+        if (it->second->details->carry_pes) {
             list.push_back(it->first);
         }
     }
@@ -35,6 +35,7 @@
 #pragma once
 #include "tsMPEG.h"
 #include "tsTSPacket.h"
+#include "tsPIDTable.h"
 #include "tsSectionDemux.h"
 #include "tsPESDemux.h"
 #include "tsT2MIDemux.h"
@@ -92,6 +93,69 @@ namespace ts {
         //!
         void reset();
 
+        //!
+        //! Get a snapshot of the current state of the analysis.
+        //!
+        //! All analysis data (global counters, PID, table and service contexts) are copied
+        //! into another analyzer. This is much faster than producing a report. The snapshot
+        //! is typically used to produce a report in another thread while this analyzer
+        //! continues to process packets. The snapshot shall not be fed with packets.
+        //!
+        //! @param [out] snapshot The analyzer which receives the snapshot. It is reset first.
+        //!
+        void getSnapshot(TSAnalyzer& snapshot) const;
+
+        //!
+        //! Transform a snapshot into statistics over an interval of time.
+        //!
+        //! The counters of a previous snapshot of the same analysis are subtracted from this
+        //! object. After that, this object describes the interval between the two snapshots:
+        //! number of packets, errors, sections, tables, PCR-based bitrates, etc. The structure
+        //! of the stream (services, PID's, table versions) is unchanged, it remains the one
+        //! which is known since the beginning of the analysis. This is how cumulative and
+        //! interval statistics are produced side by side, without resetting the analysis.
+        //! The minimum, maximum and average repetition rates of tables remain cumulative.
+        //!
+        //! @param [in] previous A previous snapshot of the same analysis (without reset in between).
+        //!
+        void subtractSnapshot(const TSAnalyzer& previous);
+
+        //!
+        //! Set the index of the next packet in the complete stream.
+        //!
+        //! This is used when the analysis of a large stream is split into consecutive
+        //! parts which are analyzed independently and then merged using appendAnalysis().
+        //! The packet indexes which are used to evaluate table repetition rates, crypto-periods
+        //! and PCR-based bitrates are then expressed relatively to the beginning of the complete
+        //! stream in all parts. The packet counters are not modified.
+        //!
+        //! @param [in] index Index in the complete stream of the next packet to analyze.
+        //!
+        void setPacketIndex(PacketCounter index);
+
+        //!
+        //! Append the analysis of the next part of the stream.
+        //!
+        //! The stream is split into consecutive parts which are analyzed independently.
+        //! All parts are then appended, in order, into one analyzer, typically an empty one.
+        //! Counters are summed, the structure of the stream (services, PID's, tables) is
+        //! merged, with the most recent information taking precedence, and the repetition
+        //! rates of tables are recomputed over the complete stream.
+        //!
+        //! The analysis of a part does not start from scratch. The analysis of the part must
+        //! start slightly before its first packet, using setPacketIndex() and a "warm-up"
+        //! sequence of packets. The analysis of the part is then a snapshot at the end of the
+        //! part, minus a snapshot at the end of the warm-up sequence (see subtractSnapshot()).
+        //! This way, the PSI structure is known and the continuity counters and PCR's of the
+        //! last packets of the previous part are checked against the first packets of the part.
+        //! The result is identical to the analysis of the complete stream when the warm-up
+        //! sequence contains the complete PSI and at least one packet of each PID.
+        //!
+        //! @param [in] next The analysis of the part of the stream which immediately follows
+        //! the last part which was appended to this object.
+        //!
+        void appendAnalysis(const TSAnalyzer& next);
+
         //!
         //! Specify a "bitrate hint" for the analysis.
         //! @param [in] bitrate_hint Optional bitrate "hint" for the analysis.
@@ -173,7 +237,8 @@ namespace ts {
         //!
         class TSDUCKDLL ServiceContext
         {
-            TS_NOBUILD_NOCOPY(ServiceContext);
+            ServiceContext() = delete;
+            ServiceContext& operator=(const ServiceContext&) = delete;
         public:
             // Public members - Synthetic data (do not modify outside ServiceContext methods)
             const uint16_t service_id;         //!< Service id.
@@ -196,6 +261,12 @@ namespace ts {
             //!
             ServiceContext(uint16_t serv_id);
 
+            //!
+            //! Copy constructor, used in analysis snapshots.
+            //! @param [in] other Other instance to copy.
+            //!
+            ServiceContext(const ServiceContext& other) = default;
+
             //!
             //! Destructor.
             //!
@@ -248,7 +319,8 @@ namespace ts {
         //!
         class TSDUCKDLL ETIDContext
         {
-            TS_NOBUILD_NOCOPY(ETIDContext);
+            ETIDContext() = delete;
+            ETIDContext& operator=(const ETIDContext&) = delete;
         public:
             // Public members - Synthetic data (do not modify outside ETIDContext methods)
             const ETID etid;                      //!< ETID value.
@@ -270,6 +342,12 @@ namespace ts {
             //! @param [in] etid Extended table id.
             //!
             ETIDContext(const ETID& etid);
+
+            //!
+            //! Copy constructor, used in analysis snapshots.
+            //! @param [in] other Other instance to copy.
+            //!
+            ETIDContext(const ETIDContext& other) = default;
         };
 
         //!
@@ -297,14 +375,16 @@ namespace ts {
         // -------------------
 
         //!
-        //! This protected inner class contains the analysis context for one PID.
+        //! This protected inner class contains the descriptive data for one PID.
+        //! These data are not updated on each packet. They are allocated outside
+        //! the PIDContext to keep the per-packet data of all PID's compact.
         //!
-        class TSDUCKDLL PIDContext
+        class TSDUCKDLL PIDDetails
         {
-            TS_NOBUILD_NOCOPY(PIDContext);
+            PIDDetails() = delete;
+            PIDDetails& operator=(const PIDDetails&) = delete;
         public:
-            // Public members - Synthetic data (do not modify outside PIDContext methods)
-            const PID     pid;             //!< PID value.
+            // Public members - Synthetic data (do not modify outside TSAnalyzer methods)
             UString       description;     //!< Readable description string (ie "MPEG-2 Audio").
             UString       comment;         //!< Additional description (ie language).
             UStringVector attributes;      //!< Audio or video attributes (several lines if attributes changed).
@@ -320,23 +400,9 @@ namespace ts {
             bool          carry_audio;     //!< This PID carries audio data.
             bool          carry_video;     //!< This PID carries video data.
             bool          carry_t2mi;      //!< Carry T2-MI encasulated data.
-            bool          scrambled;       //!< Contains some scrambled packets.
-            bool          same_stream_id;  //!< All PES packets have same stream_id.
-            uint8_t       pes_stream_id;   //!< Stream_id in PES packets on this PID.
-            uint64_t      ts_pkt_cnt;      //!< Number of TS packets.
-            uint64_t      ts_af_cnt;       //!< Number of TS packets with adaptation field.
-            uint64_t      unit_start_cnt;  //!< Number of unit_start in packets.
-            uint64_t      pl_start_cnt;    //!< Number of unit_start & has_payload in packets.
             uint64_t      pmt_cnt;         //!< Number of PMT (for PMT PID's).
             uint64_t      crypto_period;   //!< Average number of TS packets per crypto-period.
-            uint64_t      unexp_discont;   //!< Number of unexpected discontinuities.
-            uint64_t      exp_discont;     //!< Number of expected discontinuities.
-            uint64_t      duplicated;      //!< Number of duplicated packets.
-            uint64_t      ts_sc_cnt;       //!< Number of scrambled packets.
-            uint64_t      inv_ts_sc_cnt;   //!< Number of invalid scrambling control in TS headers.
-            uint64_t      inv_pes_start;   //!< Number of invalid PES start code.
             uint64_t      t2mi_cnt;        //!< Number of T2-MI packets.
-            uint64_t      pcr_cnt;         //!< Number of PCR's.
             uint32_t      ts_pcr_bitrate;  //!< Average TS bitrate in b/s (eval from PCR).
             uint32_t      bitrate;         //!< Average PID bitrate in b/s.
             UString       language;        //!< For audio or subtitles (3 chars).
@@ -346,25 +412,19 @@ namespace ts {
             std::set<uint32_t>         ssu_oui;       //!< Set of applicable OUI's for SSU.
             std::map<uint8_t,uint64_t> t2mi_plp_ts;   //!< For T2-MI streams, map key = PLP (Physical Layer Pipe) to value = number of embedded TS packets.
 
-            // Public members - Analysis data:
-            uint8_t        cur_continuity;  //!< Current continuity count.
-            // Public members - Analysis data: Crypto-period evaluation:
-            uint8_t        cur_ts_sc;       //!< Current scrambling control in TS header.
-            uint64_t       cur_ts_sc_pkt;   //!< First packet index of current crypto-period.
-            uint64_t       cryptop_cnt;     //!< Number of crypto-periods.
-            uint64_t       cryptop_ts_cnt;  //!< Number of TS packets in all crypto-periods.
-            // Public members - Analysis data: Bitrate evaluation
-            uint64_t       last_pcr;        //!< Last PCR value.
-            uint64_t       last_pcr_pkt;    //!< Index of packet with last PCR.
-            uint64_t       ts_bitrate_sum;  //!< Sum of all computed TS bitrates.
-            uint64_t       ts_bitrate_cnt;  //!< Number of computed TS bitrates.
-
             //!
-            //! Default constructor.
+            //! Constructor.
             //! @param [in] pid PID value.
             //! @param [in] description PID description.
             //!
-            PIDContext(PID pid, const UString& description = UNREFERENCED);
+            PIDDetails(PID pid, const UString& description = UNREFERENCED);
+
+            //!
+            //! Copy constructor, used in analysis snapshots.
+            //! The table contexts in @a sections are shared with @a other.
+            //! @param [in] other Other instance to copy.
+            //!
+            PIDDetails(const PIDDetails& other) = default;
 
             //!
             //! Register a service id for the PID.
@@ -381,30 +441,83 @@ namespace ts {
         };
 
         //!
-        //! Safe pointer to a PIDContext (not thread-safe).
+        //! Safe pointer to a PIDDetails (not thread-safe).
+        //!
+        typedef SafePtr<PIDDetails, NullMutex> PIDDetailsPtr;
+
         //!
-        typedef SafePtr<PIDContext, NullMutex> PIDContextPtr;
+        //! This protected inner class contains the analysis context for one PID.
+        //! Only the data which are updated on each packet are directly stored here.
+        //!
+        class TSDUCKDLL PIDContext
+        {
+            PIDContext() = delete;
+            PIDContext& operator=(const PIDContext&) = delete;
+        public:
+            // Public members - Data which are updated on each packet.
+            const PID      pid;            //!< PID value.
+            uint8_t        cur_continuity; //!< Current continuity count.
+            uint8_t        cur_ts_sc;      //!< Current scrambling control in TS header.
+            bool           scrambled;      //!< Contains some scrambled packets.
+            bool           same_stream_id; //!< All PES packets have same stream_id.
+            uint8_t        pes_stream_id;  //!< Stream_id in PES packets on this PID.
+            uint64_t       ts_pkt_cnt;     //!< Number of TS packets.
+            uint64_t       ts_af_cnt;      //!< Number of TS packets with adaptation field.
+            uint64_t       unit_start_cnt; //!< Number of unit_start in packets.
+            uint64_t       pl_start_cnt;   //!< Number of unit_start & has_payload in packets.
+            uint64_t       unexp_discont;  //!< Number of unexpected discontinuities.
+            uint64_t       exp_discont;    //!< Number of expected discontinuities.
+            uint64_t       duplicated;     //!< Number of duplicated packets.
+            uint64_t       ts_sc_cnt;      //!< Number of scrambled packets.
+            uint64_t       inv_ts_sc_cnt;  //!< Number of invalid scrambling control in TS headers.
+            uint64_t       inv_pes_start;  //!< Number of invalid PES start code.
+            uint64_t       pcr_cnt;        //!< Number of PCR's.
+            uint64_t       cur_ts_sc_pkt;  //!< First packet index of current crypto-period.
+            uint64_t       cryptop_cnt;    //!< Number of crypto-periods.
+            uint64_t       cryptop_ts_cnt; //!< Number of TS packets in all crypto-periods.
+            uint64_t       last_pcr;       //!< Last PCR value.
+            uint64_t       last_pcr_pkt;   //!< Index of packet with last PCR.
+            uint64_t       ts_bitrate_sum; //!< Sum of all computed TS bitrates.
+            uint64_t       ts_bitrate_cnt; //!< Number of computed TS bitrates.
+            PIDDetailsPtr  details;        //!< Descriptive data, never null.
+
+            //!
+            //! Default constructor.
+            //! @param [in] pid PID value.
+            //! @param [in] description PID description.
+            //!
+            PIDContext(PID pid, const UString& description = UNREFERENCED);
+
+            //!
+            //! Copy constructor, used in analysis snapshots.
+            //! The descriptive data in @a details are shared with @a other.
+            //! @param [in] other Other instance to copy.
+            //!
+            PIDContext(const PIDContext& other) = default;
+        };
 
         //!
-        //! Map of PIDContext, indexed by PID.
+        //! Dense table of PIDContext, indexed by PID.
+        //! The lookup of a PID context on each packet is a direct array access.
         //!
-        typedef std::map <PID, PIDContextPtr> PIDContextMap;
+        typedef PIDTable<PIDContext> PIDContextMap;
 
         //!
         //! Check if a PID context exists.
         //! @param [in] pid PID to search.
         //! @return True if the PID exists, false otherwise.
         //!
-        bool pidExists(PID pid) const {return _pids.find(pid) != _pids.end();}
+        bool pidExists(PID pid) const {return _pids.contains(pid);}
 
         //!
         //! Get a PID context.
         //! Allocate a new entry if PID not found.
         //! @param [in] pid PID to search.
         //! @param [in] description Initial description of the PID if the context is created.
-        //! @return A safe pointer to the PID context.
+        //! @return The address of the PID context, never null. The context remains valid
+        //! until the analyzer is reset.
         //!
-        PIDContextPtr getPID(PID pid, const UString& description = UNREFERENCED);
+        PIDContext* getPID(PID pid, const UString& description = UNREFERENCED);
 
     protected:
 
@@ -511,6 +624,8 @@ namespace ts {
 
         // TSAnalyzer private members (state data, used during analysis):
         bool              _modified;                  // Internal data modified, need recomputeStatistics
+        bool              _is_snapshot;               // This object is a snapshot, the "last" system times are frozen
+        PacketCounter     _ts_pkt_offset;             // Index in the complete stream of the first analyzed packet
         uint64_t          _ts_bitrate_sum;            // Sum of all computed TS bitrates
         uint64_t          _ts_bitrate_cnt;            // Number of computed TS bitrates
         uint64_t          _preceding_errors;          // Number of contiguous invalid packets before current packet
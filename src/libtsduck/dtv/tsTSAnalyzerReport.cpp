@@ -322,13 +322,13 @@ void ts::TSAnalyzerReport::reportServiceSubtotal(Grid& grid, const UString& head
 
 void ts::TSAnalyzerReport::reportServicePID(Grid& grid, const PIDContext& pc) const
 {
-    const UString access{pc.scrambled ? u'S' : u'C', pc.services.size() > 1 ? u'+' : u' '};
+    const UString access{pc.scrambled ? u'S' : u'C', pc.details->services.size() > 1 ? u'+' : u' '};
 
     // Build a description string for the PID.
-    UString description(pc.fullDescription(true));
-    if (!pc.ssu_oui.empty()) {
+    UString description(pc.details->fullDescription(true));
+    if (!pc.details->ssu_oui.empty()) {
         bool first = true;
-        for (std::set<uint32_t>::const_iterator it = pc.ssu_oui.begin(); it != pc.ssu_oui.end(); ++it) {
+        for (std::set<uint32_t>::const_iterator it = pc.details->ssu_oui.begin(); it != pc.details->ssu_oui.end(); ++it) {
             description += first ? u" (SSU " : u", ";
             description += names::OUI(*it);
             first = false;
@@ -340,7 +340,7 @@ void ts::TSAnalyzerReport::reportServicePID(Grid& grid, const PIDContext& pc) co
     // of the first column contains only one field (the hexa value).
     grid.putLayout({{UString::Format(u"0x%X", {pc.pid}), UString::Format(u"(%d)", {pc.pid})},
                     {description, access},
-                    {_ts_bitrate == 0 ? u"Unknown" : UString::Format(u"%'d b/s", {pc.bitrate})}});
+                    {_ts_bitrate == 0 ? u"Unknown" : UString::Format(u"%'d b/s", {pc.details->bitrate})}});
 }
 
 
@@ -369,7 +369,7 @@ void ts::TSAnalyzerReport::reportServices(Grid& grid, const UString& title)
 
     for (PIDContextMap::const_iterator it = _pids.begin(); it != _pids.end(); ++it) {
         const PIDContext& pc(*it->second);
-        if (pc.referenced && pc.services.empty() && (pc.ts_pkt_cnt != 0 || !pc.optional)) {
+        if (pc.details->referenced && pc.details->services.empty() && (pc.ts_pkt_cnt != 0 || !pc.details->optional)) {
             reportServicePID(grid, pc);
         }
     }
@@ -384,7 +384,7 @@ void ts::TSAnalyzerReport::reportServices(Grid& grid, const UString& title)
 
         for (PIDContextMap::const_iterator it = _pids.begin(); it != _pids.end(); ++it) {
             const PIDContext& pc(*it->second);
-            if (!pc.referenced && (pc.ts_pkt_cnt != 0 || !pc.optional)) {
+            if (!pc.details->referenced && (pc.ts_pkt_cnt != 0 || !pc.details->optional)) {
                 reportServicePID(grid, pc);
             }
         }
@@ -409,7 +409,7 @@ void ts::TSAnalyzerReport::reportServices(Grid& grid, const UString& title)
         reportServiceHeader(grid, names::ServiceType(sv.service_type), sv.scrambled_pid_cnt > 0, sv.bitrate, _ts_bitrate, wide);
         for (PIDContextMap::const_iterator pid_it = _pids.begin(); pid_it != _pids.end(); ++pid_it) {
             const PIDContext& pc(*pid_it->second);
-            if (pc.services.find(sv.service_id) != pc.services.end()) {
+            if (pc.details->services.find(sv.service_id) != pc.details->services.end()) {
                 reportServicePID(grid, pc);
             }
         }
@@ -429,7 +429,7 @@ void ts::TSAnalyzerReport::reportServices(Grid& grid, const UString& title)
 
 void ts::TSAnalyzerReport::reportServicesForPID(Grid& grid, const PIDContext& pc) const
 {
-    for (ServiceIdSet::const_iterator it = pc.services.begin(); it != pc.services.end(); ++it) {
+    for (ServiceIdSet::const_iterator it = pc.details->services.begin(); it != pc.details->services.end(); ++it) {
         const uint16_t serv_id = *it;
         ServiceContextMap::const_iterator serv_it(_services.find(serv_id));
         grid.putLine(UString::Format(u"Service: 0x%X (%d) %s", {serv_id, serv_id, serv_it == _services.end() ? UString() : serv_it->second->getName()}));
@@ -461,13 +461,13 @@ void ts::TSAnalyzerReport::reportPIDs(Grid& grid, const UString& title)
 
         // Type of PID.
         UString pid_type;
-        if (pc.services.size() == 1) {
+        if (pc.details->services.size() == 1) {
             pid_type = u"Single Service PID";
         }
-        else if (pc.services.size() > 1) {
+        else if (pc.details->services.size() > 1) {
             pid_type = u"Shared PID";
         }
-        else if (pc.referenced) {
+        else if (pc.details->referenced) {
             pid_type = u"Global PID";
         }
         else {
@@ -476,19 +476,19 @@ void ts::TSAnalyzerReport::reportPIDs(Grid& grid, const UString& title)
 
         // The crypto-period is measured in number of TS packets, translate it.
         UString crypto_period;
-        if (!pc.scrambled || pc.crypto_period == 0) {
+        if (!pc.scrambled || pc.details->crypto_period == 0) {
             crypto_period = u"Unknown";
         }
         else if (_ts_bitrate == 0) {
-            crypto_period = UString::Format(u"%d pkt", {pc.crypto_period});
+            crypto_period = UString::Format(u"%d pkt", {pc.details->crypto_period});
         }
         else {
-            crypto_period = UString::Format(u"%d sec", {(pc.crypto_period * PKT_SIZE * 8) / _ts_bitrate});
+            crypto_period = UString::Format(u"%d sec", {(pc.details->crypto_period * PKT_SIZE * 8) / _ts_bitrate});
         }
 
         // Header lines
         grid.section();
-        grid.putLine(UString::Format(u"PID: 0x%X (%d)", {pc.pid, pc.pid}), pc.fullDescription(false), false);
+        grid.putLine(UString::Format(u"PID: 0x%X (%d)", {pc.pid, pc.pid}), pc.details->fullDescription(false), false);
 
         // Type of PES data, if available
         if (pc.same_stream_id) {
@@ -496,7 +496,7 @@ void ts::TSAnalyzerReport::reportPIDs(Grid& grid, const UString& title)
         }
 
         // Audio/video attributes
-        for (UStringVector::const_iterator it1 = pc.attributes.begin(); it1 != pc.attributes.end(); ++it1) {
+        for (UStringVector::const_iterator it1 = pc.details->attributes.begin(); it1 != pc.details->attributes.end(); ++it1) {
             if (!it1->empty()) {
                 grid.putLine(*it1);
             }
@@ -506,7 +506,7 @@ void ts::TSAnalyzerReport::reportPIDs(Grid& grid, const UString& title)
         reportServicesForPID(grid, pc);
 
         // List of System Software Update OUI's on this PID
-        for (std::set<uint32_t>::const_iterator it1 = pc.ssu_oui.begin(); it1 != pc.ssu_oui.end(); ++it1) {
+        for (std::set<uint32_t>::const_iterator it1 = pc.details->ssu_oui.begin(); it1 != pc.details->ssu_oui.end(); ++it1) {
             grid.putLine(u"SSU OUI: " + names::OUI(*it1, names::FIRST));
         }
         grid.subSection();
@@ -516,7 +516,7 @@ void ts::TSAnalyzerReport::reportPIDs(Grid& grid, const UString& title)
         grid.putLayout({{pid_type}, {u"Transport:"}, {u"Discontinuities:"}});
 
         grid.setLayout({grid.bothTruncateLeft(24, u'.'), grid.bothTruncateLeft(24, u'.'), grid.bothTruncateLeft(21, u'.')});
-        grid.putLayout({{u"Bitrate:", _ts_bitrate == 0 ? u"Unknown" : UString::Format(u"%'d b/s", {pc.bitrate})},
+        grid.putLayout({{u"Bitrate:", _ts_bitrate == 0 ? u"Unknown" : UString::Format(u"%'d b/s", {pc.details->bitrate})},
                         {u"Packets:", UString::Decimal(pc.ts_pkt_cnt)},
                         {u"Expected:", UString::Decimal(pc.exp_discont)}});
         grid.putLayout({{u"Access:", pc.scrambled ? u"Scrambled" : u"Clear"},
@@ -526,17 +526,17 @@ void ts::TSAnalyzerReport::reportPIDs(Grid& grid, const UString& title)
         grid.setLayout({grid.bothTruncateLeft(24, u'.'), grid.bothTruncateLeft(24, u'.'), grid.left(21)});
         grid.putLayout({{pc.scrambled ? u"Crypto-Per:" : u"", pc.scrambled ? crypto_period : u""},
                         {u"Duplicated:", UString::Decimal(pc.duplicated)},
-                        {pc.carry_pes ? u"PES:" : u"Sections:"}});
+                        {pc.details->carry_pes ? u"PES:" : u"Sections:"}});
 
         grid.setLayout({grid.bothTruncateLeft(24, u'.'), grid.bothTruncateLeft(24, u'.'), grid.bothTruncateLeft(21, u'.')});
         grid.putLayout({{pc.scrambled ? u"Inv.scramb.:" : u"", pc.scrambled ? UString::Decimal(pc.inv_ts_sc_cnt) : u""},
                         {u"PCR:", UString::Decimal(pc.pcr_cnt)},
-                        {pc.carry_pes ? u"Packets:" : u"Unit start:", UString::Decimal(pc.carry_pes ? pc.pl_start_cnt : pc.unit_start_cnt)}});
+                        {pc.details->carry_pes ? u"Packets:" : u"Unit start:", UString::Decimal(pc.details->carry_pes ? pc.pl_start_cnt : pc.unit_start_cnt)}});
 
-        if (pc.ts_pcr_bitrate > 0 || pc.carry_pes) {
+        if (pc.details->ts_pcr_bitrate > 0 || pc.details->carry_pes) {
             grid.putLayout({{u""},
-                            {pc.ts_pcr_bitrate > 0 ? u"TSrate:" : u"", pc.ts_pcr_bitrate > 0 ? UString::Format(u"%'d b/s", {pc.ts_pcr_bitrate}) : u""},
-                            {pc.carry_pes ? u"Inv.Start:" : u"", pc.carry_pes ? UString::Decimal(pc.inv_pes_start) : u""}});
+                            {pc.details->ts_pcr_bitrate > 0 ? u"TSrate:" : u"", pc.details->ts_pcr_bitrate > 0 ? UString::Format(u"%'d b/s", {pc.details->ts_pcr_bitrate}) : u""},
+                            {pc.details->carry_pes ? u"Inv.Start:" : u"", pc.details->carry_pes ? UString::Decimal(pc.inv_pes_start) : u""}});
         }
     }
 
@@ -561,19 +561,19 @@ void ts::TSAnalyzerReport::reportTables(Grid& grid, const UString& title)
 
         // Get PID description, ignore if PID without sections
         const PIDContext& pc(*pci->second);
-        if (pc.sections.empty()) {
+        if (pc.details->sections.empty()) {
             continue;
         }
 
         // Header line: PID
         grid.section();
-        grid.putLine(UString::Format(u"PID: 0x%X (%d)", {pc.pid, pc.pid}), pc.fullDescription(false), false);
+        grid.putLine(UString::Format(u"PID: 0x%X (%d)", {pc.pid, pc.pid}), pc.details->fullDescription(false), false);
 
         // Header lines: list of services to which the PID belongs to
         reportServicesForPID(grid, pc);
 
         // Loop on all tables on this PID
-        for (ETIDContextMap::const_iterator it = pc.sections.begin(); it != pc.sections.end(); ++it) {
+        for (ETIDContextMap::const_iterator it = pc.details->sections.begin(); it != pc.details->sections.end(); ++it) {
             const ETIDContext& etc(*it->second);
             const TID tid = etc.etid.tid();
             const bool isShort = etc.etid.isShortSection();
@@ -617,7 +617,7 @@ void ts::TSAnalyzerReport::reportTables(Grid& grid, const UString& title)
 
             // Header line: TID
             grid.subSection();
-            grid.putLine(names::TID(tid, pc.cas_id, names::BOTH_FIRST) +
+            grid.putLine(names::TID(tid, pc.details->cas_id, names::BOTH_FIRST) +
                          (isShort ? u"" : UString::Format(u", TID ext: 0x%X (%d)", {etc.etid.tidExt(), etc.etid.tidExt()})));
 
             // 4-columns output, first column remains empty.
@@ -731,21 +731,21 @@ void ts::TSAnalyzerReport::reportErrors(std::ostream& stm, const UString& title)
             error_count++;
             stm << UString::Format(u"PID:%d:0x%X: Invalid scrambling control values: %d", {pc.pid, pc.pid, pc.inv_ts_sc_cnt}) << std::endl;
         }
-        if (pc.carry_pes && pc.inv_pes_start > 0) {
+        if (pc.details->carry_pes && pc.inv_pes_start > 0) {
             error_count++;
             stm << UString::Format(u"PID:%d:0x%X: Invalid PES header start codes: %d", {pc.pid, pc.pid, pc.inv_pes_start}) << std::endl;
         }
-        if (pc.is_pmt_pid && pc.pmt_cnt == 0) {
-            assert(!pc.services.empty());
-            int service_id(*(pc.services.begin()));
+        if (pc.details->is_pmt_pid && pc.details->pmt_cnt == 0) {
+            assert(!pc.details->services.empty());
+            int service_id(*(pc.details->services.begin()));
             error_count++;
             stm << UString::Format(u"PID:%d:0x%X: No PMT (PMT PID of service %d, 0x%X)", {pc.pid, pc.pid, service_id, service_id}) << std::endl;
         }
-        if (pc.is_pcr_pid && pc.pcr_cnt == 0) {
+        if (pc.details->is_pcr_pid && pc.pcr_cnt == 0) {
             error_count++;
-            stm << UString::Format(u"PID:%d:0x%X: No PCR, PCR PID of service%s", {pc.pid, pc.pid, pc.services.size() > 1 ? u"s" : u""});
-            for (ServiceIdSet::const_iterator i = pc.services.begin(); i != pc.services.end(); ++i) {
-                if (i != pc.services.begin()) {
+            stm << UString::Format(u"PID:%d:0x%X: No PCR, PCR PID of service%s", {pc.pid, pc.pid, pc.details->services.size() > 1 ? u"s" : u""});
+            for (ServiceIdSet::const_iterator i = pc.details->services.begin(); i != pc.details->services.end(); ++i) {
+                if (i != pc.details->services.begin()) {
                     stm << ",";
                 }
                 stm << UString::Format(u" %d (0x%X)", {*i, *i});
@@ -850,7 +850,7 @@ void ts::TSAnalyzerReport::reportNormalized(std::ostream& stm, const UString& ti
     bool first = true;
     for (PIDContextMap::const_iterator it = _pids.begin(); it != _pids.end(); ++it) {
         const PIDContext& pc(*it->second);
-        if (pc.referenced && pc.services.size() == 0 && (pc.ts_pkt_cnt != 0 || !pc.optional)) {
+        if (pc.details->referenced && pc.details->services.size() == 0 && (pc.ts_pkt_cnt != 0 || !pc.details->optional)) {
             stm << (first ? "" : ",") << pc.pid;
             first = false;
         }
@@ -871,7 +871,7 @@ void ts::TSAnalyzerReport::reportNormalized(std::ostream& stm, const UString& ti
     first = true;
     for (PIDContextMap::const_iterator it = _pids.begin(); it != _pids.end(); ++it) {
         const PIDContext& pc (*it->second);
-        if (!pc.referenced && (pc.ts_pkt_cnt != 0 || !pc.optional)) {
+        if (!pc.details->referenced && (pc.ts_pkt_cnt != 0 || !pc.details->optional)) {
             stm << (first ? "" : ",") << pc.pid;
             first = false;
         }
@@ -909,7 +909,7 @@ void ts::TSAnalyzerReport::reportNormalized(std::ostream& stm, const UString& ti
         stm << "pidlist=";
         first = true;
         for (PIDContextMap::const_iterator it_pid = _pids.begin(); it_pid != _pids.end(); ++it_pid) {
-            if (it_pid->second->services.count(sv.service_id) != 0) {
+            if (it_pid->second->details->services.count(sv.service_id) != 0) {
                 // This PID belongs to the service
                 stm << (first ? "" : ",") << it_pid->first;
                 first = false;
@@ -925,51 +925,51 @@ void ts::TSAnalyzerReport::reportNormalized(std::ostream& stm, const UString& ti
 
     for (PIDContextMap::const_iterator it = _pids.begin(); it != _pids.end(); ++it) {
         const PIDContext& pc(*it->second);
-        if (pc.ts_pkt_cnt == 0 && pc.optional) {
+        if (pc.ts_pkt_cnt == 0 && pc.details->optional) {
             continue;
         }
         stm << "pid:pid=" << pc.pid << ":";
-        if (pc.is_pmt_pid) {
+        if (pc.details->is_pmt_pid) {
             stm << "pmt:";
         }
-        if (pc.carry_ecm) {
+        if (pc.details->carry_ecm) {
             stm << "ecm:";
         }
-        if (pc.carry_emm) {
+        if (pc.details->carry_emm) {
             stm << "emm:";
         }
-        if (pc.cas_id != 0) {
-            stm << "cas=" << pc.cas_id << ":";
+        if (pc.details->cas_id != 0) {
+            stm << "cas=" << pc.details->cas_id << ":";
         }
-        for (std::set<uint32_t>::const_iterator it2 = pc.cas_operators.begin(); it2 != pc.cas_operators.end(); ++it2) {
+        for (std::set<uint32_t>::const_iterator it2 = pc.details->cas_operators.begin(); it2 != pc.details->cas_operators.end(); ++it2) {
             stm << "operator=" << (*it2) << ":";
         }
         stm << "access=" << (pc.scrambled ? "scrambled" : "clear") << ":";
-        if (pc.crypto_period != 0 && _ts_bitrate != 0) {
-            stm << "cryptoperiod=" << ((pc.crypto_period * PKT_SIZE * 8) / _ts_bitrate) << ":";
+        if (pc.details->crypto_period != 0 && _ts_bitrate != 0) {
+            stm << "cryptoperiod=" << ((pc.details->crypto_period * PKT_SIZE * 8) / _ts_bitrate) << ":";
         }
         if (pc.same_stream_id) {
             stm << "streamid=" << int (pc.pes_stream_id) << ":";
         }
-        if (pc.carry_audio) {
+        if (pc.details->carry_audio) {
             stm << "audio:";
         }
-        if (pc.carry_video) {
+        if (pc.details->carry_video) {
             stm << "video:";
         }
-        if (!pc.language.empty()) {
-            stm << "language=" << pc.language << ":";
+        if (!pc.details->language.empty()) {
+            stm << "language=" << pc.details->language << ":";
         }
-        stm << "servcount=" << pc.services.size() << ":";
-        if (!pc.referenced) {
+        stm << "servcount=" << pc.details->services.size() << ":";
+        if (!pc.details->referenced) {
             stm << "unreferenced:";
         }
-        else if (pc.services.size() == 0) {
+        else if (pc.details->services.size() == 0) {
             stm << "global:";
         }
         else {
             first = true;
-            for (ServiceIdSet::const_iterator it1 = pc.services.begin(); it1 != pc.services.end(); ++it1) {
+            for (ServiceIdSet::const_iterator it1 = pc.details->services.begin(); it1 != pc.details->services.end(); ++it1) {
                 stm << (first ? "servlist=" : ",") << *it1;
                 first = false;
             }
@@ -978,17 +978,17 @@ void ts::TSAnalyzerReport::reportNormalized(std::ostream& stm, const UString& ti
             }
         }
         first = true;
-        for (std::set<uint32_t>::const_iterator it1 = pc.ssu_oui.begin(); it1 != pc.ssu_oui.end(); ++it1) {
+        for (std::set<uint32_t>::const_iterator it1 = pc.details->ssu_oui.begin(); it1 != pc.details->ssu_oui.end(); ++it1) {
             stm << (first ? "ssuoui=" : ",") << *it1;
             first = false;
         }
         if (!first) {
             stm << ":";
         }
-        if (pc.carry_t2mi) {
+        if (pc.details->carry_t2mi) {
             stm << "t2mi:";
             first = true;
-            for (std::map<uint8_t, uint64_t>::const_iterator it1 = pc.t2mi_plp_ts.begin(); it1 != pc.t2mi_plp_ts.end(); ++it1) {
+            for (std::map<uint8_t, uint64_t>::const_iterator it1 = pc.details->t2mi_plp_ts.begin(); it1 != pc.details->t2mi_plp_ts.end(); ++it1) {
                 stm << (first ? "plp=" : ",") << int(it1->first);
                 first = false;
             }
@@ -996,8 +996,8 @@ void ts::TSAnalyzerReport::reportNormalized(std::ostream& stm, const UString& ti
                 stm << ":";
             }
         }
-        stm << "bitrate=" << pc.bitrate << ":"
-            << "bitrate204=" << ToBitrate204(pc.bitrate) << ":"
+        stm << "bitrate=" << pc.details->bitrate << ":"
+            << "bitrate204=" << ToBitrate204(pc.details->bitrate) << ":"
             << "packets=" << pc.ts_pkt_cnt << ":"
             << "clear=" << (pc.ts_pkt_cnt - pc.ts_sc_cnt - pc.inv_ts_sc_cnt) << ":"
             << "scrambled=" << pc.ts_sc_cnt << ":"
@@ -1006,21 +1006,21 @@ void ts::TSAnalyzerReport::reportNormalized(std::ostream& stm, const UString& ti
             << "pcr=" << pc.pcr_cnt << ":"
             << "discontinuities=" << pc.unexp_discont << ":"
             << "duplicated=" << pc.duplicated << ":";
-        if (pc.carry_pes) {
+        if (pc.details->carry_pes) {
             stm << "pes=" << pc.pl_start_cnt << ":"
                 << "invalidpesprefix=" << pc.inv_pes_start << ":";
         }
         else {
             stm << "unitstart=" << pc.unit_start_cnt << ":";
         }
-        stm << "description=" << pc.fullDescription(true) << std::endl;
+        stm << "description=" << pc.details->fullDescription(true) << std::endl;
     }
 
     // Print one line per table
 
     for (PIDContextMap::const_iterator pci = _pids.begin(); pci != _pids.end(); ++pci) {
         const PIDContext& pc(*pci->second);
-        for (ETIDContextMap::const_iterator it = pc.sections.begin(); it != pc.sections.end(); ++it) {
+        for (ETIDContextMap::const_iterator it = pc.details->sections.begin(); it != pc.details->sections.end(); ++it) {
             const ETIDContext& etc(*it->second);
             stm << "table:"
                 << "pid=" << pc.pid << ":"
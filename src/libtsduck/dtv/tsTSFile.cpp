@@ -30,8 +30,15 @@
 #include "tsTSFile.h"
 #include "tsNullReport.h"
 #include "tsSysUtils.h"
+#include "tsSysInfo.h"
 TSDUCK_SOURCE;
 
+// Memory-mapped files are mapped by windows of this size.
+#define MAP_WINDOW_SIZE    (64 * 1024 * 1024)
+
+// In a mapped window, read-ahead is requested by chunks of this size.
+#define MAP_READAHEAD_SIZE (4 * 1024 * 1024)
+
 
 //----------------------------------------------------------------------------
 // Default constructor.
@@ -50,6 +57,16 @@ ts::TSFile::TSFile() :
     _at_eof(false),
     _aborted(false),
     _rewindable(false),
+    _mmap_request(false),
+    _mmap_active(false),
+    _map_base(nullptr),
+    _map_size(0),
+    _map_ahead(0),
+    _map_offset(0),
+    _map_pos(0),
+    _file_size(0),
+    _partial_size(0),
+    _read_buffer(),
 #if defined(TS_WINDOWS)
     _handle(INVALID_HANDLE_VALUE)
 #else
@@ -76,6 +93,16 @@ ts::TSFile::TSFile(const TSFile& other) :
     _at_eof(false),
     _aborted(false),
     _rewindable(false),
+    _mmap_request(other._mmap_request),
+    _mmap_active(false),
+    _map_base(nullptr),
+    _map_size(0),
+    _map_ahead(0),
+    _map_offset(0),
+    _map_pos(0),
+    _file_size(0),
+    _partial_size(0),
+    _read_buffer(),
 #if defined(TS_WINDOWS)
     _handle(INVALID_HANDLE_VALUE)
 #else
@@ -102,6 +129,16 @@ ts::TSFile::TSFile(TSFile&& other) noexcept :
     _at_eof(other._at_eof),
     _aborted(other._aborted),
     _rewindable(other._rewindable),
+    _mmap_request(other._mmap_request),
+    _mmap_active(other._mmap_active),
+    _map_base(other._map_base),
+    _map_size(other._map_size),
+    _map_ahead(other._map_ahead),
+    _map_offset(other._map_offset),
+    _map_pos(other._map_pos),
+    _file_size(other._file_size),
+    _partial_size(other._partial_size),
+    _read_buffer(std::move(other._read_buffer)),
 #if defined(TS_WINDOWS)
     _handle(other._handle)
 #else
@@ -110,6 +147,9 @@ ts::TSFile::TSFile(TSFile&& other) noexcept :
 {
     // Mark other object as closed, just in case.
     other._is_open = false;
+    other._mmap_active = false;
+    other._map_base = nullptr;
+    other._map_size = 0;
 #if defined(TS_WINDOWS)
     other._handle = INVALID_HANDLE_VALUE;
 #else
@@ -327,6 +367,11 @@ bool ts::TSFile::openInternal(Report& report)
     if (write_access && keep_file) {
         uflags |= O_EXCL;
     }
+#if defined(O_DIRECT)
+    if (write_access && (_flags & DIRECT) != 0) {
+        uflags |= O_DIRECT;
+    }
+#endif
 
     if (_filename.empty()) {
         // File name is empty means standard input or output. No need to open.
@@ -383,9 +428,22 @@ bool ts::TSFile::openInternal(Report& report)
         return false;
     }
 
+    // Check if the file can be read using memory mapping. The windows are mapped on demand.
+    _mmap_active = false;
+    if (_mmap_request && read_only) {
+        struct stat st;
+        if (::fstat(_fd, &st) == 0 && S_ISREG(st.st_mode)) {
+            _mmap_active = true;
+            _file_size = uint64_t(st.st_size);
+            _map_pos = _start_offset;
+            report.debug(u"reading %s using memory mapping", {getDisplayFileName()});
+        }
+    }
+
 #endif
 
     _total_read = _total_write = 0;
+    _partial_size = 0;
     _at_eof = _aborted = false;
     _is_open = true;
     return true;
@@ -398,6 +456,13 @@ bool ts::TSFile::openInternal(Report& report)
 
 bool ts::TSFile::seekInternal(uint64_t index, Report& report)
 {
+    // In memory-mapped mode, simply move the read position.
+    if (_mmap_active) {
+        _map_pos = _start_offset + index;
+        _at_eof = false;
+        return true;
+    }
+
 #if defined(TS_WINDOWS)
     // In Win32, LARGE_INTEGER is a 64-bit structure, not an integer type
     uint64_t where = _start_offset + index;
@@ -448,6 +513,9 @@ bool ts::TSFile::close(Report& report)
         return false;
     }
 
+    unmapWindow();
+    _mmap_active = false;
+
     if (!_filename.empty()) {
 #if defined(TS_WINDOWS)
         ::CloseHandle(_handle);
@@ -483,6 +551,23 @@ size_t ts::TSFile::read(TSPacket* buffer, size_t max_packets, Report& report)
         return 0;
     }
 
+    // In memory-mapped mode, copy packets from the mapped windows.
+    if (_mmap_active) {
+        size_t count = 0;
+        while (count < max_packets) {
+            const size_t n = std::min(max_packets - count, mappedPackets(report));
+            if (n == 0) {
+                break;
+            }
+            TSPacket::Copy(buffer + count, _map_base + (_map_pos - _map_offset), n);
+            _map_pos += n * PKT_SIZE;
+            count += n;
+        }
+        readAhead();
+        _total_read += count;
+        return count;
+    }
+
     char* data = reinterpret_cast<char*>(buffer);
     const size_t req_size = max_packets * PKT_SIZE;
     size_t got_size = 0;
@@ -525,7 +610,8 @@ size_t ts::TSFile::read(TSPacket* buffer, size_t max_packets, Report& report)
 
         // At end-of-file, truncate partial packet.
         if (_at_eof) {
-            got_size -= got_size % PKT_SIZE;
+            _partial_size = got_size % PKT_SIZE;
+            got_size -= _partial_size;
         }
 
         // At end of file, if the file must be repeated a finite number of times,
@@ -548,6 +634,157 @@ size_t ts::TSFile::read(TSPacket* buffer, size_t max_packets, Report& report)
 }
 
 
+//----------------------------------------------------------------------------
+// Read TS packets without copying them into a user buffer.
+//----------------------------------------------------------------------------
+
+size_t ts::TSFile::readInPlace(const TSPacket*& packets, size_t max_packets, Report& report)
+{
+    packets = nullptr;
+
+    // Without memory mapping, read packets in the internal buffer.
+    if (!_mmap_active) {
+        if (_read_buffer.size() < max_packets) {
+            _read_buffer.resize(max_packets);
+        }
+        packets = _read_buffer.data();
+        return read(_read_buffer.data(), max_packets, report);
+    }
+    else if (_aborted || _at_eof) {
+        return 0;
+    }
+
+    // Return packets which are contiguous in the current mapped window.
+    const size_t count = std::min(max_packets, mappedPackets(report));
+    if (count > 0) {
+        packets = reinterpret_cast<const TSPacket*>(_map_base + (_map_pos - _map_offset));
+        _map_pos += count * PKT_SIZE;
+        _total_read += count;
+        readAhead();
+    }
+    return count;
+}
+
+
+//----------------------------------------------------------------------------
+// Memory-mapped mode: get the number of contiguous packets which are
+// available in the current window at the current read position. Map
+// another window, loop back to start offset or detect end of file
+// when necessary. Return zero on end of file or error.
+//----------------------------------------------------------------------------
+
+size_t ts::TSFile::mappedPackets(Report& report)
+{
+    for (;;) {
+        // Packets which are already mapped after the current read position.
+        if (_map_base != nullptr && _map_pos >= _map_offset && _map_pos < _map_offset + _map_size) {
+            const size_t count = size_t((_map_offset + _map_size - _map_pos) / PKT_SIZE);
+            if (count > 0) {
+                return count;
+            }
+        }
+
+        // Not even one complete packet in the file, the file may be growing.
+#if !defined(TS_WINDOWS)
+        if (_map_pos + PKT_SIZE > _file_size) {
+            struct stat st;
+            if (::fstat(_fd, &st) == 0) {
+                _file_size = uint64_t(st.st_size);
+            }
+        }
+#endif
+
+        if (_map_pos + PKT_SIZE > _file_size) {
+            // End of file. Truncate partial packet. If the file must be repeated, loop back to start offset.
+            // Without at least one packet after start offset, there is nothing to repeat.
+            if (_start_offset + PKT_SIZE <= _file_size && (_repeat == 0 || ++_counter < _repeat)) {
+                _map_pos = _start_offset;
+            }
+            else {
+                _at_eof = true;
+                _partial_size = _map_pos < _file_size ? size_t(_file_size - _map_pos) : 0;
+                return 0;
+            }
+        }
+        else if (!mapWindow(report)) {
+            return 0;
+        }
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Memory-mapped mode: map the window containing the current read position.
+//----------------------------------------------------------------------------
+
+bool ts::TSFile::mapWindow(Report& report)
+{
+    unmapWindow();
+
+#if defined(TS_WINDOWS)
+
+    report.log(_severity, u"memory mapping not supported on %s", {getDisplayFileName()});
+    return false;
+
+#else
+
+    // The window starts on a page boundary and contains at least the packet at current position.
+    const uint64_t page_size = std::max<uint64_t>(1, SysInfo::Instance()->memoryPageSize());
+    _map_offset = _map_pos - _map_pos % page_size;
+    _map_size = size_t(std::min<uint64_t>(MAP_WINDOW_SIZE, _file_size - _map_offset));
+
+    void* const addr = ::mmap(nullptr, _map_size, PROT_READ, MAP_SHARED, _fd, off_t(_map_offset));
+    if (addr == MAP_FAILED) {
+        const ErrorCode err = LastErrorCode();
+        report.log(_severity, u"error mapping file %s: %s", {getDisplayFileName(), ErrorCodeMessage(err)});
+        _map_size = 0;
+        return false;
+    }
+
+    // Advise the system that the window is read sequentially. Errors are ignored, these are only hints.
+    _map_base = reinterpret_cast<uint8_t*>(addr);
+    _map_ahead = 0;
+    ::madvise(addr, _map_size, MADV_SEQUENTIAL);
+    readAhead();
+    return true;
+
+#endif
+}
+
+
+//----------------------------------------------------------------------------
+// Memory-mapped mode: unmap the current window.
+//----------------------------------------------------------------------------
+
+void ts::TSFile::unmapWindow()
+{
+#if !defined(TS_WINDOWS)
+    if (_map_base != nullptr) {
+        ::munmap(_map_base, _map_size);
+    }
+#endif
+    _map_base = nullptr;
+    _map_size = _map_ahead = 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Memory-mapped mode: request read-ahead of the next chunk of the window
+// when the read position comes close to the previously advised part.
+//----------------------------------------------------------------------------
+
+void ts::TSFile::readAhead()
+{
+#if !defined(TS_WINDOWS)
+    while (_map_base != nullptr && _map_ahead < _map_size && _map_pos + MAP_READAHEAD_SIZE > _map_offset + _map_ahead) {
+        const size_t size = std::min<size_t>(MAP_READAHEAD_SIZE, _map_size - _map_ahead);
+        ::madvise(_map_base + _map_ahead, size, MADV_WILLNEED);
+        _map_ahead += size;
+    }
+#endif
+}
+
+
 //----------------------------------------------------------------------------
 // Write method
 //----------------------------------------------------------------------------
@@ -613,6 +850,19 @@ bool ts::TSFile::write(const TSPacket* buffer, size_t packet_count, Report& repo
             data += outsize;
             remain -= std::max(remain, size_t (outsize));
         }
+#if defined(O_DIRECT)
+        else if ((error_code = LastErrorCode()) == EINVAL && (_flags & DIRECT) != 0) {
+            // Direct I/O requires aligned buffers, sizes and file offsets.
+            // Revert to cached I/O and retry the same write.
+            report.debug(u"unaligned direct I/O on %s, reverting to cached I/O", {getDisplayFileName()});
+            _flags &= ~DIRECT;
+            const int fflags = ::fcntl(_fd, F_GETFL);
+            if (fflags == -1 || ::fcntl(_fd, F_SETFL, fflags & ~O_DIRECT) == -1) {
+                error_code = LastErrorCode();
+                got_error = true;
+            }
+        }
+#endif
         else if ((error_code = LastErrorCode()) != EINTR) {
             // Actual error (not an interrupt)
             report.debug(u"write error on %s, fd=%d, error_code=%d", {getDisplayFileName(), _fd, error_code});
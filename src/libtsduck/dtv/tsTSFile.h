@@ -107,6 +107,7 @@ namespace ts {
             KEEP      = 0x0008,   //!< Keep previous file with same name. Fail if it already exists.
             SHARED    = 0x0010,   //!< Write open with shared read for other processes. Windows only. Always shared on Unix.
             TEMPORARY = 0x0020,   //!< Temporary file, deleted on close, not always visible in the file system.
+            DIRECT    = 0x0040,   //!< Write with direct I/O, bypassing the system cache, when supported (Linux only). Unaligned writes revert to cached I/O.
         };
 
         //!
@@ -170,6 +171,38 @@ namespace ts {
         //!
         size_t read(TSPacket* buffer, size_t max_packets, Report& report);
 
+        //!
+        //! Read TS packets without copying them into a user buffer.
+        //! When the file is memory mapped, the returned packets are directly located in the
+        //! mapped memory. Otherwise, the packets are read into an internal buffer. In both cases,
+        //! the returned packets remain valid until the next read, seek, rewind or close operation.
+        //! Reading packets transparently loops back at end if file as with read().
+        //! @param [out] packets Receive the address of the first read packet.
+        //! @param [in] max_packets Maximum number of packets to read.
+        //! @param [in,out] report Where to report errors.
+        //! @return The actual number of read packets. It can be less than @a max_packets
+        //! before end of file. Returning zero means error or end of file repetition.
+        //! @see setMemoryMapped()
+        //!
+        size_t readInPlace(const TSPacket*& packets, size_t max_packets, Report& report);
+
+        //!
+        //! Request the use of memory mapping to read the file.
+        //! Memory mapping is used only when the file is opened in read-only mode, is a regular file
+        //! and the operating system is a UNIX system. Otherwise, the file is read using standard I/O.
+        //! The file is mapped by windows of a few tens of megabytes, with a sequential access hint
+        //! to the system, so that huge files can be read without exhausting the address space.
+        //! Must be called before opening the file.
+        //! @param [in] on When true, use memory mapping when possible.
+        //!
+        void setMemoryMapped(bool on) { _mmap_request = on; }
+
+        //!
+        //! Check if the file is currently read using memory mapping.
+        //! @return True if the file is currently read using memory mapping.
+        //!
+        bool isMemoryMapped() const { return _mmap_active; }
+
         //!
         //! Write TS packets to the file.
         //! @param [in] buffer Address of first packet to write.
@@ -217,6 +250,15 @@ namespace ts {
         //!
         PacketCounter getWriteCount() const { return _total_write; }
 
+        //!
+        //! Get the size of the truncated packet at end of file.
+        //! When the size of the input file is not a multiple of the packet size,
+        //! the trailing partial packet is silently dropped by read().
+        //! @return The size in bytes of the partial packet which was dropped at
+        //! the last end of file, zero if the file ends on a packet boundary.
+        //!
+        size_t getTruncatedSize() const { return _partial_size; }
+
     protected:
         UString       _filename;        //!< Input file name.
         PacketCounter _total_read;      //!< Total read packets.
@@ -232,6 +274,16 @@ namespace ts {
         volatile bool _at_eof;        //!< End of file has been reached
         volatile bool _aborted;       //!< Operation has been aborted, no operation available
         bool          _rewindable;    //!< Opened in rewindable mode
+        bool          _mmap_request;  //!< Use memory mapping when possible
+        bool          _mmap_active;   //!< File is currently read using memory mapping
+        uint8_t*      _map_base;      //!< Address of current mapped window
+        size_t        _map_size;      //!< Size in bytes of current mapped window
+        size_t        _map_ahead;     //!< Size in bytes of the part of the window which was already advised for read-ahead
+        uint64_t      _map_offset;    //!< File offset of current mapped window
+        uint64_t      _map_pos;       //!< File offset of next packet to read in mapped mode
+        uint64_t      _file_size;     //!< File size in mapped mode
+        size_t        _partial_size;  //!< Size of the truncated packet at end of file
+        TSPacketVector _read_buffer;  //!< Packet buffer for readInPlace() when the file is not mapped
 #if defined(TS_WINDOWS)
         ::HANDLE      _handle;        //!< File handle
 #else
@@ -241,6 +293,10 @@ namespace ts {
         // Internal methods
         bool openInternal(Report& report);
         bool seekInternal(uint64_t index, Report& report);
+        bool mapWindow(Report& report);
+        void unmapWindow();
+        void readAhead();
+        size_t mappedPackets(Report& report);
 
         // Inaccessible operations.
         TSFile& operator=(TSFile&) = delete;
@@ -0,0 +1,261 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSFileOutputAsync.h"
+#include "tsGuard.h"
+#include "tsMonotonic.h"
+#include "tsNullReport.h"
+TSDUCK_SOURCE;
+
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr size_t ts::TSFileOutputAsync::BUFFER_PACKETS;
+constexpr size_t ts::TSFileOutputAsync::DEFAULT_BUFFER_COUNT;
+#endif
+
+
+//----------------------------------------------------------------------------
+// Constructors and destructors.
+//----------------------------------------------------------------------------
+
+ts::TSFileOutputAsync::Statistics::Statistics() :
+    packets(0),
+    buffers(0),
+    max_busy(0),
+    wait_count(0),
+    wait_time(0)
+{
+}
+
+ts::TSFileOutputAsync::TSFileOutputAsync() :
+    Thread(ThreadAttributes().setPriority(ThreadAttributes::GetHighPriority())),
+    _file(),
+    _report(nullptr),
+    _buffer(nullptr),
+    _buffer_count(0),
+    _fill_index(0),
+    _fill_packets(0),
+    _write_index(0),
+    _mutex(),
+    _work_to_do(),
+    _work_done(),
+    _filled(0),
+    _terminate(false),
+    _error(false),
+    _stats()
+{
+}
+
+ts::TSFileOutputAsync::~TSFileOutputAsync()
+{
+    if (isOpen()) {
+        close(NULLREP);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Create the file and start the writer thread.
+//----------------------------------------------------------------------------
+
+bool ts::TSFileOutputAsync::open(const UString& filename, TSFile::OpenFlags flags, size_t buffer_count, Report& report)
+{
+    if (isOpen()) {
+        report.error(u"%s is already open", {getDisplayFileName()});
+        return false;
+    }
+    else if ((flags & TSFile::READ) != 0) {
+        report.error(u"asynchronous output file cannot be open for read");
+        return false;
+    }
+    else if (!_file.open(filename, flags | TSFile::WRITE, report)) {
+        return false;
+    }
+
+    // Reset the state. The writer thread is not running, no need to lock the mutex.
+    _report = &report;
+    _buffer_count = std::max<size_t>(2, buffer_count);
+    _buffer = new ResidentBuffer<TSPacket>(_buffer_count * BUFFER_PACKETS);
+    _fill_index = _fill_packets = _write_index = _filled = 0;
+    _terminate = _error = false;
+    _stats = Statistics();
+
+    if (!_buffer->isLocked()) {
+        report.debug(u"cannot lock output buffers in memory: %s", {ErrorCodeMessage(_buffer->lockErrorCode())});
+    }
+
+    // Start the writer thread.
+    if (!start()) {
+        report.error(u"cannot start writer thread for %s", {getDisplayFileName()});
+        _file.close(report);
+        delete _buffer;
+        _buffer = nullptr;
+        return false;
+    }
+    return true;
+}
+
+
+//----------------------------------------------------------------------------
+// Write TS packets to the file (application thread).
+//----------------------------------------------------------------------------
+
+bool ts::TSFileOutputAsync::write(const TSPacket* buffer, size_t packet_count, Report& report)
+{
+    if (!isOpen()) {
+        report.error(u"file not open");
+        return false;
+    }
+
+    while (packet_count > 0) {
+
+        // Stop on write error from the writer thread. The error was already reported.
+        if (_error) {
+            return false;
+        }
+
+        // Copy as many packets as possible in the current buffer.
+        const size_t count = std::min(packet_count, BUFFER_PACKETS - _fill_packets);
+        TSPacket::Copy(_buffer->base() + _fill_index * BUFFER_PACKETS + _fill_packets, buffer, count);
+        buffer += count;
+        packet_count -= count;
+        _fill_packets += count;
+
+        // When the current buffer is full, pass it to the writer thread.
+        if (_fill_packets == BUFFER_PACKETS) {
+            Guard lock(_mutex);
+            _filled++;
+            _stats.max_busy = std::max(_stats.max_busy, _filled);
+            _work_to_do.signal();
+
+            // Wait for the next buffer to be free (back-pressure from the file system).
+            if (_filled >= _buffer_count) {
+                const NanoSecond start = Monotonic::CurrentNanoSeconds();
+                _stats.wait_count++;
+                while (_filled >= _buffer_count) {
+                    _work_done.wait(_mutex, Infinite);
+                }
+                _stats.wait_time += Monotonic::CurrentNanoSeconds() - start;
+            }
+            _fill_index = (_fill_index + 1) % _buffer_count;
+            _fill_packets = 0;
+        }
+    }
+    return !_error;
+}
+
+
+//----------------------------------------------------------------------------
+// Close the file (application thread).
+//----------------------------------------------------------------------------
+
+bool ts::TSFileOutputAsync::close(Report& report)
+{
+    if (!isOpen()) {
+        report.error(u"file not open");
+        return false;
+    }
+
+    // Request the writer thread to terminate after writing all filled buffers.
+    {
+        Guard lock(_mutex);
+        _terminate = true;
+        _work_to_do.signal();
+    }
+    waitForTermination();
+
+    // Now, we are alone. Write the last partially filled buffer.
+    bool ok = !_error;
+    if (ok && _fill_packets > 0) {
+        ok = _file.write(_buffer->base() + _fill_index * BUFFER_PACKETS, _fill_packets, report);
+        if (ok) {
+            _stats.packets += _fill_packets;
+            _stats.buffers++;
+        }
+    }
+    _fill_packets = 0;
+
+    ok = _file.close(report) && ok;
+    delete _buffer;
+    _buffer = nullptr;
+    _report = nullptr;
+    return ok;
+}
+
+
+//----------------------------------------------------------------------------
+// Get the current statistics of the output file.
+//----------------------------------------------------------------------------
+
+ts::TSFileOutputAsync::Statistics ts::TSFileOutputAsync::getStatistics() const
+{
+    Guard lock(_mutex);
+    return _stats;
+}
+
+
+//----------------------------------------------------------------------------
+// Writer thread.
+//----------------------------------------------------------------------------
+
+void ts::TSFileOutputAsync::main()
+{
+    for (;;) {
+
+        // Wait for a filled buffer or termination.
+        {
+            Guard lock(_mutex);
+            while (_filled == 0 && !_terminate) {
+                _work_to_do.wait(_mutex, Infinite);
+            }
+            if (_filled == 0) {
+                // Terminated and all buffers written.
+                break;
+            }
+        }
+
+        // Write the buffer without holding the mutex. After an error, buffers are
+        // discarded so that the application thread never waits forever.
+        const bool ok = !_error && _file.write(_buffer->base() + _write_index * BUFFER_PACKETS, BUFFER_PACKETS, *_report);
+        _write_index = (_write_index + 1) % _buffer_count;
+
+        // Release the buffer.
+        {
+            Guard lock(_mutex);
+            if (ok) {
+                _stats.packets += BUFFER_PACKETS;
+                _stats.buffers++;
+            }
+            else {
+                _error = true;
+            }
+            _filled--;
+            _work_done.signal();
+        }
+    }
+}
@@ -0,0 +1,157 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Transport stream output file with asynchronous writes.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTSFile.h"
+#include "tsResidentBuffer.h"
+#include "tsThread.h"
+#include "tsMutex.h"
+#include "tsCondition.h"
+
+namespace ts {
+    //!
+    //! Transport stream output file with asynchronous writes.
+    //! @ingroup mpeg
+    //!
+    //! The packets are copied into a ring of memory-resident buffers which are aligned on
+    //! memory pages. The filled buffers are written to the file by a dedicated thread. The
+    //! application thread is blocked only when all buffers are full, meaning that the file
+    //! system does not follow the output rate (back-pressure). The size of a buffer is a
+    //! multiple of the usual page and disk block sizes, making it suitable for direct I/O.
+    //!
+    class TSDUCKDLL TSFileOutputAsync: private Thread
+    {
+        TS_NOCOPY(TSFileOutputAsync);
+    public:
+        //!
+        //! Number of TS packets per buffer.
+        //! The buffer size, 1024 x 188 bytes, is a multiple of 4096 bytes.
+        //!
+        static constexpr size_t BUFFER_PACKETS = 1024;
+
+        //!
+        //! Default number of buffers in the ring.
+        //!
+        static constexpr size_t DEFAULT_BUFFER_COUNT = 32;
+
+        //!
+        //! Statistics of the output file.
+        //!
+        struct TSDUCKDLL Statistics
+        {
+            Statistics();                //!< Constructor.
+            PacketCounter packets;       //!< Number of packets which were written to the file.
+            uint64_t      buffers;       //!< Number of buffers which were written to the file.
+            size_t        max_busy;      //!< Maximum number of simultaneously filled buffers (high-water mark).
+            uint64_t      wait_count;    //!< Number of times the application waited for a free buffer.
+            NanoSecond    wait_time;     //!< Total time the application waited for free buffers.
+        };
+
+        //!
+        //! Constructor.
+        //!
+        TSFileOutputAsync();
+
+        //!
+        //! Destructor.
+        //!
+        virtual ~TSFileOutputAsync() override;
+
+        //!
+        //! Create the file and start the writer thread.
+        //! @param [in] filename File name. If empty, use standard output.
+        //! @param [in] flags Bit mask of open flags. WRITE is implicitly added. READ is not allowed.
+        //! @param [in] buffer_count Number of buffers in the ring. Each buffer contains BUFFER_PACKETS packets.
+        //! @param [in,out] report Where to report errors. This object is also used by the writer
+        //! thread until the file is closed. It must be thread-safe.
+        //! @return True on success, false on error.
+        //!
+        bool open(const UString& filename, TSFile::OpenFlags flags, size_t buffer_count, Report& report);
+
+        //!
+        //! Check if the file is open.
+        //! @return True if the file is open.
+        //!
+        bool isOpen() const { return _buffer != nullptr; }
+
+        //!
+        //! Get the file name as a display string.
+        //! @return The file name as a display string.
+        //!
+        UString getDisplayFileName() const { return _file.getDisplayFileName(); }
+
+        //!
+        //! Write TS packets to the file.
+        //! The packets are copied in the ring of buffers. The method waits only when all buffers are full.
+        //! @param [in] buffer Address of first packet to write.
+        //! @param [in] packet_count Number of packets to write.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error. Errors from the writer thread are reported here.
+        //!
+        bool write(const TSPacket* buffer, size_t packet_count, Report& report);
+
+        //!
+        //! Close the file.
+        //! All buffered packets are written first.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool close(Report& report);
+
+        //!
+        //! Get the current statistics of the output file.
+        //! @return A copy of the statistics.
+        //!
+        Statistics getStatistics() const;
+
+    private:
+        TSFile                    _file;          // Output file, written by the writer thread.
+        Report*                   _report;        // Where the writer thread reports errors.
+        ResidentBuffer<TSPacket>* _buffer;        // Ring of buffers, contiguous in memory.
+        size_t                    _buffer_count;  // Number of buffers in the ring.
+        size_t                    _fill_index;    // Index of buffer being filled (application thread only).
+        size_t                    _fill_packets;  // Number of packets in buffer being filled (application thread only).
+        size_t                    _write_index;   // Index of next buffer to write (writer thread only).
+        mutable Mutex             _mutex;         // Protect the following fields.
+        Condition                 _work_to_do;    // Signaled by the application when a buffer is filled or on termination.
+        Condition                 _work_done;     // Signaled by the writer thread when a buffer is free.
+        size_t                    _filled;        // Number of filled buffers, waiting to be written.
+        bool                      _terminate;     // The writer thread shall terminate after writing all filled buffers.
+        volatile bool             _error;         // A write error occured in the writer thread.
+        Statistics                _stats;         // Output statistics.
+
+        // Implementation of Thread.
+        virtual void main() override;
+    };
+}
@@ -0,0 +1,172 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSPacketReader.h"
+#include "tsNullReport.h"
+TSDUCK_SOURCE;
+
+#if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
+constexpr size_t ts::TSPacketReader::DEFAULT_BUFFER_SIZE;
+#endif
+
+
+//----------------------------------------------------------------------------
+// Constructor and destructor.
+//----------------------------------------------------------------------------
+
+ts::TSPacketReader::TSPacketReader(size_t buffer_size) :
+    _file(),
+    _buffer_size(std::max<size_t>(buffer_size, 1)),
+    _packets(nullptr),
+    _next(0),
+    _avail(0),
+    _count(0),
+    _eof(true)
+{
+}
+
+ts::TSPacketReader::~TSPacketReader()
+{
+    close(NULLREP);
+}
+
+
+//----------------------------------------------------------------------------
+// Open and close the file.
+//----------------------------------------------------------------------------
+
+bool ts::TSPacketReader::open(const UString& filename, Report& report)
+{
+    if (_file.isOpen()) {
+        report.error(u"file %s is already open", {_file.getDisplayFileName()});
+        return false;
+    }
+
+    _packets = nullptr;
+    _next = _avail = 0;
+    _count = 0;
+
+    // The standard input may be a regular file which was already partially read, never map it.
+    _file.setMemoryMapped(!filename.empty());
+    _eof = !_file.openRead(filename, 1, 0, report);
+    return !_eof;
+}
+
+bool ts::TSPacketReader::close(Report& report)
+{
+    _packets = nullptr;
+    _next = _avail = 0;
+    _eof = true;
+    return !_file.isOpen() || _file.close(report);
+}
+
+
+//----------------------------------------------------------------------------
+// Format a "after N TS packets" message suffix, same as TSPacket::read().
+//----------------------------------------------------------------------------
+
+ts::UString ts::TSPacketReader::afterPackets() const
+{
+    return _count > 0 ? UString::Format(u" after %'d TS packets", {_count}) : UString();
+}
+
+
+//----------------------------------------------------------------------------
+// Get the next packets from the file.
+//----------------------------------------------------------------------------
+
+bool ts::TSPacketReader::fill(Report& report)
+{
+    _next = 0;
+    _avail = _eof ? 0 : _file.readInPlace(_packets, _buffer_size, report);
+    if (_avail == 0 && !_eof) {
+        _eof = true;
+        if (_file.getTruncatedSize() > 0) {
+            report.error(u"truncated TS packet (%d bytes)%s", {_file.getTruncatedSize(), afterPackets()});
+        }
+    }
+    return _avail > 0;
+}
+
+
+//----------------------------------------------------------------------------
+// Read contiguous TS packets without copy.
+//----------------------------------------------------------------------------
+
+size_t ts::TSPacketReader::read(const TSPacket*& packets, size_t max_packets, Report& report)
+{
+    packets = nullptr;
+    if (max_packets == 0 || (_next >= _avail && !fill(report))) {
+        return 0;
+    }
+
+    // Return valid packets only, up to the first packet with an invalid sync byte.
+    const TSPacket* const first = _packets + _next;
+    size_t count = std::min(max_packets, _avail - _next);
+    for (size_t i = 0; i < count; ++i) {
+        if (first[i].b[0] != SYNC_BYTE) {
+            count = i;
+            break;
+        }
+    }
+
+    if (count == 0) {
+        report.error(u"synchronization lost%s, got 0x%X instead of 0x%X at start of TS packet", {afterPackets(), first->b[0], SYNC_BYTE});
+        _next = _avail = 0;
+        _eof = true;
+        return 0;
+    }
+
+    packets = first;
+    _next += count;
+    _count += count;
+    return count;
+}
+
+
+//----------------------------------------------------------------------------
+// Read the next TS packet.
+//----------------------------------------------------------------------------
+
+const ts::TSPacket* ts::TSPacketReader::read(Report& report)
+{
+    const TSPacket* pkt = nullptr;
+    read(pkt, 1, report);
+    return pkt;
+}
+
+bool ts::TSPacketReader::read(TSPacket& packet, Report& report)
+{
+    const TSPacket* pkt = nullptr;
+    if (read(pkt, 1, report) == 0) {
+        return false;
+    }
+    packet = *pkt;
+    return true;
+}
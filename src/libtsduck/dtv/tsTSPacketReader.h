@@ -0,0 +1,155 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//!
+//!  @file
+//!  Sequential reader of transport stream packets.
+//!
+//----------------------------------------------------------------------------
+
+#pragma once
+#include "tsTSFile.h"
+
+namespace ts {
+    //!
+    //! Sequential reader of transport stream packets from a file or the standard input.
+    //! @ingroup mpeg
+    //!
+    //! This class is a replacement for a loop on TSPacket::read() on a standard input
+    //! stream. The packets are read by large blocks, directly from the operating system,
+    //! and are returned one by one or by contiguous groups of packets, without copy.
+    //! Regular files are read using memory mapping when possible.
+    //!
+    //! As with TSPacket::read(), the synchronization byte of each packet is checked.
+    //! A lost synchronization or a truncated packet at end of file is reported as
+    //! an error and terminates the reading.
+    //!
+    class TSDUCKDLL TSPacketReader
+    {
+        TS_NOCOPY(TSPacketReader);
+    public:
+        //!
+        //! Default size in packets of the read buffer.
+        //!
+        static constexpr size_t DEFAULT_BUFFER_SIZE = 4096;
+
+        //!
+        //! Constructor.
+        //! @param [in] buffer_size Size of the read buffer in number of TS packets.
+        //! This is the maximum number of packets which are read at a time from the
+        //! operating system when the file is not memory-mapped.
+        //!
+        explicit TSPacketReader(size_t buffer_size = DEFAULT_BUFFER_SIZE);
+
+        //!
+        //! Destructor.
+        //!
+        ~TSPacketReader();
+
+        //!
+        //! Open the file for read.
+        //! @param [in] filename File name. If empty, use standard input.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool open(const UString& filename, Report& report);
+
+        //!
+        //! Close the file.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false on error.
+        //!
+        bool close(Report& report);
+
+        //!
+        //! Check if the file is open.
+        //! @return True if the file is open.
+        //!
+        bool isOpen() const { return _file.isOpen(); }
+
+        //!
+        //! Get the file name as a display string.
+        //! @return The file name as a display string.
+        //!
+        UString getDisplayFileName() const { return _file.getDisplayFileName(); }
+
+        //!
+        //! Read the next TS packet without copy.
+        //! @param [in,out] report Where to report errors.
+        //! @return The address of the next packet or a null pointer at end of file or
+        //! on error. The returned packet remains valid until the next read operation.
+        //!
+        const TSPacket* read(Report& report);
+
+        //!
+        //! Read the next TS packet into a user packet.
+        //! @param [out] packet Receive the next packet.
+        //! @param [in,out] report Where to report errors.
+        //! @return True on success, false at end of file or on error.
+        //!
+        bool read(TSPacket& packet, Report& report);
+
+        //!
+        //! Read contiguous TS packets without copy.
+        //! @param [out] packets Receive the address of the first read packet.
+        //! @param [in] max_packets Maximum number of packets to read.
+        //! @param [in,out] report Where to report errors.
+        //! @return The number of read packets. It can be less than @a max_packets
+        //! before end of file. Returning zero means end of file or error. The returned
+        //! packets remain valid until the next read operation.
+        //!
+        size_t read(const TSPacket*& packets, size_t max_packets, Report& report);
+
+        //!
+        //! Check if the end of file or an error was reached.
+        //! @return True if no more packet can be read.
+        //!
+        bool endOfFile() const { return _eof; }
+
+        //!
+        //! Get the number of packets which were returned by read().
+        //! @return The number of read packets.
+        //!
+        PacketCounter getReadCount() const { return _count; }
+
+    private:
+        TSFile          _file;         // Underlying file.
+        size_t          _buffer_size;  // Max number of packets per read from the file.
+        const TSPacket* _packets;      // Packets in TSFile buffer or mapped memory.
+        size_t          _next;         // Index in _packets of next packet to return.
+        size_t          _avail;        // Number of packets in _packets.
+        PacketCounter   _count;        // Number of returned packets.
+        bool            _eof;          // End of file or error.
+
+        // Get the next packets from the file. Return false at end of file or on error.
+        bool fill(Report& report);
+
+        // Format a "after N TS packets" message suffix.
+        UString afterPackets() const;
+    };
+}
@@ -582,3 +582,140 @@ bool ts::TSScrambling::decrypt(TSPacket& pkt)
     }
     return ok;
 }
+
+
+//----------------------------------------------------------------------------
+// Encrypt or decrypt a group of DVB-CSA2 packets with the same parity.
+//----------------------------------------------------------------------------
+
+bool ts::TSScrambling::processGroup(bool encrypt, uint8_t scv, TSPacket** group, size_t& count)
+{
+    if (count == 0) {
+        return true;
+    }
+
+    void* data[DVBCSA2::BATCH_SIZE];
+    size_t size[DVBCSA2::BATCH_SIZE];
+    assert(count <= DVBCSA2::BATCH_SIZE);
+
+    for (size_t i = 0; i < count; ++i) {
+        data[i] = group[i]->getPayload();
+        size[i] = group[i]->getPayloadSize();
+    }
+
+    DVBCSA2& algo(_dvbcsa[scv & 1]);
+    const bool ok = encrypt ? algo.encryptInPlaceBatch(data, size, count) : algo.decryptInPlaceBatch(data, size, count);
+    if (ok) {
+        for (size_t i = 0; i < count; ++i) {
+            group[i]->setScrambling(encrypt ? scv : uint8_t(SC_CLEAR));
+        }
+    }
+    else {
+        _report.error(u"packet %s error using %s", {encrypt ? u"encryption" : u"decryption", algo.name()});
+    }
+    count = 0;
+    return ok;
+}
+
+
+//----------------------------------------------------------------------------
+// Encrypt several TS packets with the current parity and corresponding CW.
+//----------------------------------------------------------------------------
+
+bool ts::TSScrambling::encrypt(TSPacket* const* pkt, size_t count)
+{
+    // Only DVB-CSA2 has a batch mode, encrypt other algorithms one packet at a time.
+    if (_scrambling_type != SCRAMBLING_DVB_CSA2) {
+        for (size_t i = 0; i < count; ++i) {
+            if (!encrypt(*pkt[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    TSPacket* group[DVBCSA2::BATCH_SIZE];
+    size_t group_count = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+
+        // Filter out encrypted packets, after encrypting all previous ones.
+        if (pkt[i]->isScrambled()) {
+            processGroup(true, _encrypt_scv, group, group_count);
+            _report.error(u"try to scramble an already scrambled packet");
+            return false;
+        }
+
+        // Silently pass packets without payload.
+        if (!pkt[i]->hasPayload()) {
+            continue;
+        }
+
+        // If no current parity is set, start with even by default.
+        if (_encrypt_scv == SC_CLEAR && !setEncryptParity(SC_EVEN_KEY)) {
+            return false;
+        }
+
+        group[group_count++] = pkt[i];
+        if (group_count == DVBCSA2::BATCH_SIZE && !processGroup(true, _encrypt_scv, group, group_count)) {
+            return false;
+        }
+    }
+    return processGroup(true, _encrypt_scv, group, group_count);
+}
+
+
+//----------------------------------------------------------------------------
+// Decrypt several TS packets with the CW corresponding to their parity.
+//----------------------------------------------------------------------------
+
+bool ts::TSScrambling::decrypt(TSPacket* const* pkt, size_t count)
+{
+    // Only DVB-CSA2 has a batch mode, decrypt other algorithms one packet at a time.
+    if (_scrambling_type != SCRAMBLING_DVB_CSA2) {
+        for (size_t i = 0; i < count; ++i) {
+            if (!decrypt(*pkt[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    TSPacket* group[DVBCSA2::BATCH_SIZE];
+    size_t group_count = 0;
+
+    for (size_t i = 0; i < count; ++i) {
+
+        // Clear or invalid packets are silently accepted.
+        const uint8_t scv = pkt[i]->getScrambling();
+        if (scv != SC_EVEN_KEY && scv != SC_ODD_KEY) {
+            continue;
+        }
+
+        // On parity change, decrypt all previous packets before switching key.
+        if (scv != _decrypt_scv) {
+            if (!processGroup(false, _decrypt_scv, group, group_count)) {
+                return false;
+            }
+            const uint8_t previous_scv = _decrypt_scv;
+            _decrypt_scv = scv;
+
+            // In case of fixed control word, use next key when the scrambling control changes.
+            if (hasFixedCW() && previous_scv != _decrypt_scv && !setNextFixedCW(_decrypt_scv)) {
+                return false;
+            }
+        }
+
+        // Packets without payload just need to be marked as clear.
+        if (pkt[i]->getPayloadSize() == 0) {
+            pkt[i]->setScrambling(SC_CLEAR);
+            continue;
+        }
+
+        group[group_count++] = pkt[i];
+        if (group_count == DVBCSA2::BATCH_SIZE && !processGroup(false, _decrypt_scv, group, group_count)) {
+            return false;
+        }
+    }
+    return processGroup(false, _decrypt_scv, group, group_count);
+}
@@ -192,6 +192,26 @@ namespace ts {
         //!
         bool decrypt(TSPacket& pkt);
 
+        //!
+        //! Encrypt several TS packets with the current parity and corresponding CW.
+        //! The result is identical to encrypt() on each packet in sequence. With DVB-CSA2,
+        //! the packets are scrambled in parallel using the batch mode of ts::DVBCSA2.
+        //! @param [in,out] pkt Array of @a count addresses of packets to encrypt.
+        //! @param [in] count Number of packets.
+        //! @return True on success, false on error. An already encrypted packet is an error.
+        //!
+        bool encrypt(TSPacket* const* pkt, size_t count);
+
+        //!
+        //! Decrypt several TS packets with the CW corresponding to the parity in each packet.
+        //! The result is identical to decrypt() on each packet in sequence. With DVB-CSA2,
+        //! the packets are descrambled in parallel using the batch mode of ts::DVBCSA2.
+        //! @param [in,out] pkt Array of @a count addresses of packets to decrypt.
+        //! @param [in] count Number of packets.
+        //! @return True on success, false on error. A clear packet is not an error.
+        //!
+        bool decrypt(TSPacket* const* pkt, size_t count);
+
     private:
         // List of control words
         typedef std::list<ByteBlock> CWList;
@@ -215,6 +235,9 @@ namespace ts {
         // Set the next fixed control word as scrambling key.
         bool setNextFixedCW(int parity);
 
+        // Encrypt or decrypt a group of DVB-CSA2 packets with the same parity, reset the group.
+        bool processGroup(bool encrypt, uint8_t scv, TSPacket** group, size_t& count);
+
         // Implementation of BlockCipherAlertInterface.
         virtual bool handleBlockCipherAlert(BlockCipher& cipher, AlertReason reason) override;
 
@@ -40,13 +40,136 @@
 #include "tsDuckProtocol.h"
 #include "tsxmlComment.h"
 #include "tsxmlElement.h"
+#include "tsGuardCondition.h"
+#include "tsThread.h"
 TSDUCK_SOURCE;
 
 #if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
 constexpr size_t ts::TablesLogger::DEFAULT_LOG_SIZE;
+constexpr size_t ts::TablesLogger::PIPELINE_QUEUE_PER_THREAD;
 #endif
 
 
+//----------------------------------------------------------------------------
+// Pipelined mode: formatting context of a worker thread.
+// Each worker uses its own TSDuck context and display object since they are
+// not thread-safe. Messages are collected in the result of the current job.
+//----------------------------------------------------------------------------
+
+class ts::TablesLogger::PipelineFormatter: public Report
+{
+    TS_NOBUILD_NOCOPY(PipelineFormatter);
+public:
+    PipelineFormatter(int max_severity);
+
+    std::ostringstream text;     // Text output of the current job.
+    DuckContext        duck;     // Context of the worker thread.
+    TablesDisplay      display;  // Display object of the worker thread, writing to text.
+    xml::Document      doc;      // XML document to convert tables.
+    PipelineResult*    result;   // Result of the current job.
+
+protected:
+    virtual void writeLog(int severity, const UString& msg) override;
+};
+
+ts::TablesLogger::PipelineFormatter::PipelineFormatter(int max_severity) :
+    Report(max_severity),
+    text(),
+    duck(this, &text),
+    display(duck),
+    doc(*this),
+    result(nullptr)
+{
+}
+
+void ts::TablesLogger::PipelineFormatter::writeLog(int severity, const UString& msg)
+{
+    if (result != nullptr) {
+        result->messages.push_back(std::make_pair(severity, msg));
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Pipelined mode: worker thread.
+//----------------------------------------------------------------------------
+
+class ts::TablesLogger::PipelineWorker: public Thread
+{
+    TS_NOBUILD_NOCOPY(PipelineWorker);
+public:
+    PipelineWorker(TablesLogger& logger, PipelineFormatter& fmt) : Thread(), _logger(logger), _fmt(fmt) {}
+    virtual ~PipelineWorker() override { waitForTermination(); }
+
+private:
+    TablesLogger&      _logger;
+    PipelineFormatter& _fmt;
+
+    virtual void main() override;
+};
+
+void ts::TablesLogger::PipelineWorker::main()
+{
+    PipelineJobQueue::MessagePtr job;
+    while (_logger._jobs.dequeue(job) && !job.isNull()) {
+
+        PipelineResult* const result = new PipelineResult;
+        _fmt.result = result;
+        _fmt.text.str(std::string());
+
+        if (_logger._use_text) {
+            if (job->section.isNull()) {
+                _logger.displayTable(_fmt.display, job->table, job->cas, job->time, job->first);
+            }
+            else {
+                _logger.displaySection(_fmt.display, *job->section, job->cas, job->time, job->first);
+            }
+            result->text = _fmt.text.str();
+        }
+
+        if (_logger._use_xml && job->section.isNull()) {
+            // Format the table as if it was printed inside the root element of the document.
+            xml::Element* elem = _logger.buildXML(_fmt.duck, _fmt.doc, job->table, job->time);
+            if (elem != nullptr) {
+                TextFormatter out(_fmt);
+                out.setString();
+                out << ts::indent << ts::margin;
+                elem->print(out, false);
+                out << std::endl;
+                result->has_xml = out.getString(result->xml);
+                delete elem;
+            }
+        }
+
+        _fmt.result = nullptr;
+        _logger.storeResult(job->seq, result);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Pipelined mode: jobs and results.
+//----------------------------------------------------------------------------
+
+ts::TablesLogger::PipelineJob::PipelineJob(uint64_t seq_, const Time& time_, uint16_t cas_, bool first_) :
+    seq(seq_),
+    time(time_),
+    cas(cas_),
+    first(first_),
+    table(),
+    section()
+{
+}
+
+ts::TablesLogger::PipelineResult::PipelineResult() :
+    text(),
+    xml(),
+    has_xml(false),
+    messages()
+{
+}
+
+
 //----------------------------------------------------------------------------
 // Constructor
 //----------------------------------------------------------------------------
@@ -85,6 +208,7 @@ ts::TablesLogger::TablesLogger(TablesDisplay& display) :
     _use_next(false),
     _xml_tweaks(),
     _initial_pids(),
+    _threads(1),
     _display(display),
     _duck(_display.duck()),
     _report(_duck.report()),
@@ -102,7 +226,15 @@ ts::TablesLogger::TablesLogger(TablesDisplay& display) :
     _shortSections(),
     _allSections(),
     _sectionsOnce(),
-    _section_filters()
+    _section_filters(),
+    _formatters(),
+    _workers(),
+    _jobs(),
+    _results_mutex(),
+    _results_cond(),
+    _results(),
+    _next_job(0),
+    _next_output(0)
 {
     // Create an instance of each registered section filter.
     TablesLoggerFilterRepository::Instance()->createFilters(_section_filters);
@@ -261,6 +393,14 @@ void ts::TablesLogger::defineArgs(Args& args) const
     args.option(u"text-output", 0, Args::STRING);
     args.help(u"text-output", u"A synonym for --output-file.");
 
+    args.option(u"threads", 0, Args::POSITIVE);
+    args.help(u"threads",
+              u"Number of threads which format the tables and sections in text or XML format. "
+              u"The demux and the selection of the tables remain in the main processing thread. "
+              u"The output is produced in the same order as with one single thread. "
+              u"This can be useful with large transport streams with many tables to format. "
+              u"The default is 1, meaning that all tables are formatted in the main processing thread.");
+
     args.option(u"time-stamp");
     args.help(u"time-stamp", u"Display a time stamp (current local time) with each table.");
 
@@ -330,6 +470,7 @@ bool ts::TablesLogger::loadArgs(DuckContext& duck, Args& args)
     _udp_raw = args.present(u"no-encapsulation");
     _use_current = !args.present(u"exclude-current");
     _use_next = args.present(u"include-next");
+    _threads = args.intValue<size_t>(u"threads", 1);
 
     // Check consistency of options.
     if (_rewrite_binary && _multi_files) {
@@ -348,7 +489,22 @@ bool ts::TablesLogger::loadArgs(DuckContext& duck, Args& args)
     }
 
     // Load XML options.
-    return _xml_tweaks.loadArgs(duck, args);
+    if (!_xml_tweaks.loadArgs(duck, args)) {
+        return false;
+    }
+
+    // With multiple threads, each formatter loads the display options, like the main display.
+    _formatters.clear();
+    if (_threads > 1) {
+        for (size_t i = 0; i < _threads; ++i) {
+            PipelineFormatterPtr fmt(new PipelineFormatter(_report.maxSeverity()));
+            if (!fmt->display.loadArgs(fmt->duck, args)) {
+                return false;
+            }
+            _formatters.push_back(fmt);
+        }
+    }
+    return true;
 }
 
 
@@ -404,6 +560,9 @@ bool ts::TablesLogger::open()
     // Set XML options in document.
     _xmlDoc.setTweaks(_xml_tweaks);
 
+    // Start the formatting threads. This must be done before any output.
+    startPipeline();
+
     // Open/create the XML output.
     if (_use_xml && !_rewrite_xml && !createXML(_xml_destination)) {
         _abort = true;
@@ -450,6 +609,9 @@ void ts::TablesLogger::close()
             _demux.fillAndFlushEITs();
         }
 
+        // Output all pending tables.
+        stopPipeline();
+
         // Close files and documents.
         closeXML();
         if (_binfile.is_open()) {
@@ -476,6 +638,140 @@ void ts::TablesLogger::feedPacket(const TSPacket& pkt)
         _cas_mapper.feedPacket(pkt);
         _packet_count++;
     }
+    // In pipelined mode, output formatted tables as soon as possible.
+    if (_next_output < _next_job) {
+        outputResults(false);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Pipelined mode: start and stop the worker threads.
+//----------------------------------------------------------------------------
+
+void ts::TablesLogger::startPipeline()
+{
+    _next_job = _next_output = 0;
+    _results.clear();
+    _workers.clear();
+
+    if (_formatters.empty() || (!_use_text && !_use_xml)) {
+        return;
+    }
+
+    _jobs.setMaxMessages(PIPELINE_QUEUE_PER_THREAD * _formatters.size());
+    for (auto it = _formatters.begin(); it != _formatters.end(); ++it) {
+        PipelineFormatter& fmt(**it);
+        fmt.duck.copyPreferences(_duck);
+        fmt.doc.setTweaks(_xml_tweaks);
+        fmt.doc.initialize(u"tsduck");
+        PipelineWorkerPtr worker(new PipelineWorker(*this, fmt));
+        if (worker->start()) {
+            _workers.push_back(worker);
+        }
+        else {
+            _report.warning(u"cannot start table formatting thread");
+        }
+    }
+    if (pipelined()) {
+        _report.debug(u"TablesLogger uses %d formatting threads", {_workers.size()});
+    }
+}
+
+void ts::TablesLogger::stopPipeline()
+{
+    if (pipelined()) {
+        // Send one termination message per worker, after all pending jobs.
+        for (size_t i = 0; i < _workers.size(); ++i) {
+            _jobs.forceEnqueue(nullptr);
+        }
+        // The worker destructor waits for the termination of the thread.
+        _workers.clear();
+        outputResults(true);
+        _jobs.clear();
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Pipelined mode: enqueue a job for the formatting threads.
+//----------------------------------------------------------------------------
+
+void ts::TablesLogger::enqueueJob(PipelineJob* job)
+{
+    PipelineJobQueue::MessagePtr ptr(job);
+    _next_job++;
+
+    // The queue is bounded. When full, output the available results
+    // before waiting for the workers.
+    while (!_jobs.enqueue(ptr, 0)) {
+        outputResults(false);
+        if (_jobs.enqueue(ptr, 10)) {
+            break;
+        }
+    }
+    outputResults(false);
+}
+
+
+//----------------------------------------------------------------------------
+// Pipelined mode: store a result from a formatting thread.
+//----------------------------------------------------------------------------
+
+void ts::TablesLogger::storeResult(uint64_t seq, PipelineResult* result)
+{
+    GuardCondition lock(_results_mutex, _results_cond);
+    _results[seq] = PipelineResultPtr(result);
+    lock.signal();
+}
+
+
+//----------------------------------------------------------------------------
+// Pipelined mode: output the results in the order of the jobs.
+// If wait is true, wait for all pending jobs.
+//----------------------------------------------------------------------------
+
+void ts::TablesLogger::outputResults(bool wait)
+{
+    while (_next_output < _next_job) {
+
+        // Get the next result, if already available.
+        PipelineResultPtr result;
+        {
+            GuardCondition lock(_results_mutex, _results_cond);
+            auto it = _results.find(_next_output);
+            while (wait && it == _results.end()) {
+                lock.waitCondition();
+                it = _results.find(_next_output);
+            }
+            if (it == _results.end()) {
+                return;
+            }
+            result = it->second;
+            _results.erase(it);
+        }
+        _next_output++;
+
+        // Output the result. This is done in the thread which feeds the packets.
+        for (auto it = result->messages.begin(); it != result->messages.end(); ++it) {
+            _report.log(it->first, it->second);
+        }
+        if (_use_text && !result->text.empty()) {
+            _duck.out() << result->text;
+            postDisplay();
+        }
+        if (_use_xml && result->has_xml && (!_rewrite_xml || createXML(_xml_destination))) {
+            if (!_xmlOpen) {
+                // The root element is still empty, print the document header.
+                _xmlOpen = true;
+                _xmlDoc.print(_xmlOut, true);
+            }
+            _xmlOut << result->xml;
+            if (_rewrite_xml) {
+                closeXML();
+            }
+        }
+    }
 }
 
 
@@ -516,27 +812,29 @@ void ts::TablesLogger::handleTable(SectionDemux&, const BinaryTable& table)
     }
 
     // Filtering done, now save data.
-    if (_use_text) {
-        preDisplay(table.getFirstTSPacketIndex(), table.getLastTSPacketIndex());
-        if (_logger) {
-            // Short log message
-            logSection(*table.sectionAt(0));
-        }
-        else {
-            // Full table formatting
-            _display.displayTable(table, 0, _cas_mapper.casId(pid)) << std::endl;
-        }
-        postDisplay();
-    }
+    const Time now(_time_stamp ? Time::CurrentLocalTime() : Time::Epoch);
 
-    if (_use_xml) {
-        // In case of rewrite for each table, create a new file.
-        if (_rewrite_xml && !createXML(_xml_destination)) {
-            return;
+    if (pipelined()) {
+        // Text and XML formatting in the worker threads.
+        PipelineJob* job = new PipelineJob(_next_job, now, cas, _table_count == 0);
+        job->table.copy(table);
+        enqueueJob(job);
+    }
+    else {
+        if (_use_text) {
+            displayTable(_display, table, cas, now, _table_count == 0);
+            postDisplay();
         }
-        saveXML(table);
-        if (_rewrite_xml) {
-            closeXML();
+
+        if (_use_xml) {
+            // In case of rewrite for each table, create a new file.
+            if (_rewrite_xml && !createXML(_xml_destination)) {
+                return;
+            }
+            saveXML(table, now);
+            if (_rewrite_xml) {
+                closeXML();
+            }
         }
     }
 
@@ -632,16 +930,17 @@ void ts::TablesLogger::handleSection(SectionDemux& demux, const Section& sect)
     // Note that no XML can be produced since valid XML structures contain complete tables only.
 
     if (_use_text) {
-        preDisplay(sect.getFirstTSPacketIndex(), sect.getLastTSPacketIndex());
-        if (_logger) {
-            // Short log message
-            logSection(sect);
+        const Time now(_time_stamp ? Time::CurrentLocalTime() : Time::Epoch);
+        if (pipelined()) {
+            // Text formatting in the worker threads.
+            PipelineJob* job = new PipelineJob(_next_job, now, cas, _table_count == 0);
+            job->section = new Section(sect, COPY);
+            enqueueJob(job);
         }
         else {
-            // Full section formatting.
-            _display.displaySection(sect, 0, _cas_mapper.casId(pid)) << std::endl;
+            displaySection(_display, sect, cas, now, _table_count == 0);
+            postDisplay();
         }
-        postDisplay();
     }
 
     if (_use_binary) {
@@ -887,25 +1186,33 @@ bool ts::TablesLogger::createXML(const ts::UString& name)
     return true;
 }
 
-void ts::TablesLogger::saveXML(const ts::BinaryTable& table)
+ts::xml::Element* ts::TablesLogger::buildXML(DuckContext& duck, xml::Document& doc, const BinaryTable& table, const Time& time) const
 {
     // Convert the table into an XML structure.
-    xml::Element* elem = table.toXML(_duck, _xmlDoc.rootElement(), false);
+    xml::Element* elem = table.toXML(duck, doc.rootElement(), false);
+    if (elem != nullptr) {
+        // Add an XML comment as first child of the table.
+        UString comment(UString::Format(u" PID 0x%X (%d)", {table.sourcePID(), table.sourcePID()}));
+        if (_time_stamp) {
+            comment += u", at " + UString(time);
+        }
+        if (_packet_index) {
+            comment += UString::Format(u", first TS packet: %'d, last: %'d", {table.getFirstTSPacketIndex(), table.getLastTSPacketIndex()});
+        }
+        new xml::Comment(elem, comment + u" ", false); // first position
+    }
+    return elem;
+}
+
+void ts::TablesLogger::saveXML(const ts::BinaryTable& table, const Time& time)
+{
+    // Convert the table into an XML structure.
+    xml::Element* elem = buildXML(_duck, _xmlDoc, table, time);
     if (elem == nullptr) {
         // XML conversion error, message already displayed.
         return;
     }
 
-    // Add an XML comment as first child of the table.
-    UString comment(UString::Format(u" PID 0x%X (%d)", {table.sourcePID(), table.sourcePID()}));
-    if (_time_stamp) {
-        comment += u", at " + UString(Time::CurrentLocalTime());
-    }
-    if (_packet_index) {
-        comment += UString::Format(u", first TS packet: %'d, last: %'d", {table.getFirstTSPacketIndex(), table.getLastTSPacketIndex()});
-    }
-    new xml::Comment(elem, comment + u" ", false); // first position
-
     // Print the new table.
     if (_xmlOpen) {
         _xmlOut << ts::margin;
@@ -932,17 +1239,48 @@ void ts::TablesLogger::closeXML()
 }
 
 
+//----------------------------------------------------------------------------
+// Format a table or section as text in a display object.
+//----------------------------------------------------------------------------
+
+void ts::TablesLogger::displayTable(TablesDisplay& display, const BinaryTable& table, uint16_t cas, const Time& time, bool first) const
+{
+    preDisplay(display.duck().out(), table.getFirstTSPacketIndex(), table.getLastTSPacketIndex(), time, first);
+    if (_logger) {
+        // Short log message
+        logSection(display, *table.sectionAt(0), cas, time);
+    }
+    else {
+        // Full table formatting
+        display.displayTable(table, 0, cas) << std::endl;
+    }
+}
+
+void ts::TablesLogger::displaySection(TablesDisplay& display, const Section& sect, uint16_t cas, const Time& time, bool first) const
+{
+    preDisplay(display.duck().out(), sect.getFirstTSPacketIndex(), sect.getLastTSPacketIndex(), time, first);
+    if (_logger) {
+        // Short log message
+        logSection(display, sect, cas, time);
+    }
+    else {
+        // Full section formatting.
+        display.displaySection(sect, 0, cas) << std::endl;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 //  Log a table (option --log)
 //----------------------------------------------------------------------------
 
-void ts::TablesLogger::logSection(const Section& sect)
+void ts::TablesLogger::logSection(TablesDisplay& display, const Section& sect, uint16_t cas, const Time& time) const
 {
     UString header;
 
     // Display time stamp if required.
     if (_time_stamp) {
-        header += UString(Time::CurrentLocalTime());
+        header += UString(time);
         header += u": ";
     }
 
@@ -959,7 +1297,7 @@ void ts::TablesLogger::logSection(const Section& sect)
     header += u": ";
 
     // Output the line through the display object.
-    _display.logSectionData(sect, header, _log_size, _cas_mapper.casId(sect.sourcePID()));
+    display.logSectionData(sect, header, _log_size, cas);
 }
 
 
@@ -989,12 +1327,10 @@ bool ts::TablesLogger::isFiltered(const Section& sect, uint16_t cas)
 //  Display header information, before a table
 //----------------------------------------------------------------------------
 
-void ts::TablesLogger::preDisplay(PacketCounter first, PacketCounter last)
+void ts::TablesLogger::preDisplay(std::ostream& strm, PacketCounter first, PacketCounter last, const Time& time, bool first_display) const
 {
-    std::ostream& strm(_display.duck().out());
-
     // Initial spacing
-    if (_table_count == 0 && !_logger) {
+    if (first_display && !_logger) {
         strm << std::endl;
     }
 
@@ -1002,7 +1338,7 @@ void ts::TablesLogger::preDisplay(PacketCounter first, PacketCounter last)
     if ((_time_stamp || _packet_index) && !_logger) {
         strm << "* ";
         if (_time_stamp) {
-            strm << "At " << Time::CurrentLocalTime();
+            strm << "At " << time;
         }
         if (_packet_index && _time_stamp) {
             strm << ", ";
@@ -45,6 +45,9 @@
 #include "tsCASMapper.h"
 #include "tsxmlTweaks.h"
 #include "tsxmlDocument.h"
+#include "tsMessageQueue.h"
+#include "tsCondition.h"
+#include "tsTime.h"
 
 namespace ts {
     //!
@@ -77,6 +80,12 @@ namespace ts {
         //!
         static constexpr size_t DEFAULT_LOG_SIZE = 8;
 
+        //!
+        //! Maximum number of pending tables or sections per worker thread (option -\-threads).
+        //! When the limit is reached, the packet processing waits for the workers.
+        //!
+        static constexpr size_t PIPELINE_QUEUE_PER_THREAD = 16;
+
         // Implementation of ArgsSupplierInterface.
         virtual void defineArgs(Args& args) const override;
         virtual bool loadArgs(DuckContext& duck, Args& args) override;
@@ -174,6 +183,7 @@ namespace ts {
         bool                     _use_next;          // Use tables with "next" flag.
         xml::Tweaks              _xml_tweaks;        // XML tweak options.
         PIDSet                   _initial_pids;      // Initial PID's to filter.
+        size_t                   _threads;           // Number of formatting threads, 1 means no pipeline.
 
         // Working data:
         TablesDisplay&           _display;
@@ -195,6 +205,55 @@ namespace ts {
         std::set<uint64_t>       _sectionsOnce;      // Tracking sets of PID/TID/TDIext/secnum/version with --all-once.
         TablesLoggerFilterVector _section_filters;   // All registered section filters.
 
+        // Pipelined mode (option --threads): the demux and the filtering remain in the thread
+        // which feeds the packets. The text and XML formatting of tables and sections is done
+        // by a pool of worker threads. The results are output in the original order.
+        class PipelineFormatter;
+        class PipelineWorker;
+        typedef SafePtr<PipelineFormatter,NullMutex> PipelineFormatterPtr;
+        typedef SafePtr<PipelineWorker,NullMutex> PipelineWorkerPtr;
+
+        // A table or section to format. A null job terminates a worker.
+        struct PipelineJob
+        {
+            PipelineJob(uint64_t seq_, const Time& time_, uint16_t cas_, bool first_);
+            uint64_t    seq;      // Sequence number of the job.
+            Time        time;     // Collection time (with --time-stamp).
+            uint16_t    cas;      // CAS id of the PID.
+            bool        first;    // First displayed table or section.
+            BinaryTable table;    // Table to format, empty when formatting a section.
+            SectionPtr  section;  // Section to format, null when formatting a table.
+        };
+        typedef MessageQueue<PipelineJob,Mutex> PipelineJobQueue;
+
+        // Result of a job: formatted text and XML, messages from the formatter.
+        struct PipelineResult
+        {
+            PipelineResult();
+            std::string text;     // Text output.
+            UString     xml;      // XML output.
+            bool        has_xml;  // The XML output is valid.
+            std::list<std::pair<int,UString>> messages;  // Messages from the formatter, by severity.
+        };
+        typedef SafePtr<PipelineResult,NullMutex> PipelineResultPtr;
+
+        std::vector<PipelineFormatterPtr>     _formatters;     // One formatting context per worker thread.
+        std::vector<PipelineWorkerPtr>        _workers;        // Running worker threads.
+        PipelineJobQueue                      _jobs;           // Jobs to format.
+        Mutex                                 _results_mutex;  // Protect _results.
+        Condition                             _results_cond;   // Signaled when a result is available.
+        std::map<uint64_t,PipelineResultPtr>  _results;        // Results waiting for output, by sequence number.
+        uint64_t                              _next_job;       // Sequence number of next job.
+        uint64_t                              _next_output;    // Sequence number of next result to output.
+
+        // Start, stop the pipeline, enqueue a job, output available results.
+        bool pipelined() const { return !_workers.empty(); }
+        void startPipeline();
+        void stopPipeline();
+        void enqueueJob(PipelineJob* job);
+        void storeResult(uint64_t seq, PipelineResult* result);
+        void outputResults(bool wait);
+
         // Create a binary file. On error, set _abort and return false.
         bool createBinaryFile(const UString& name);
 
@@ -203,22 +262,29 @@ namespace ts {
 
         // Open/write/close XML tables.
         bool createXML(const UString& name);
-        void saveXML(const BinaryTable& table);
+        void saveXML(const BinaryTable& table, const Time& time);
         void closeXML();
 
+        // Build the XML element of a table, with its leading comment.
+        xml::Element* buildXML(DuckContext& duck, xml::Document& doc, const BinaryTable& table, const Time& time) const;
+
         // Send UDP table and section.
         void sendUDP(const BinaryTable& table);
         void sendUDP(const Section& section);
 
+        // Format a table or section as text in a display object.
+        void displayTable(TablesDisplay& display, const BinaryTable& table, uint16_t cas, const Time& time, bool first) const;
+        void displaySection(TablesDisplay& display, const Section& section, uint16_t cas, const Time& time, bool first) const;
+
         // Pre/post-display of a table or section
-        void preDisplay(PacketCounter first, PacketCounter last);
+        void preDisplay(std::ostream& strm, PacketCounter first, PacketCounter last, const Time& time, bool first_display) const;
         void postDisplay();
 
         // Check if a specific section must be filtered and displayed.
         bool isFiltered(const Section& section, uint16_t cas);
 
         // Log a section (option --log).
-        void logSection(const Section& section);
+        void logSection(TablesDisplay& display, const Section& section, uint16_t cas, const Time& time) const;
     };
 
     //!
@@ -34,6 +34,8 @@
 #include "tsReportBuffer.h"
 #include "tsTelnetConnection.h"
 #include "tsGuard.h"
+#include "tsGuardCondition.h"
+#include "tsMonotonic.h"
 #include "tsSysUtils.h"
 TSDUCK_SOURCE;
 
@@ -53,12 +55,16 @@ ts::tsp::ControlServer::ControlServer(TSProcessorArgs& options, Report& log, Mut
     _input(input),
     _output(nullptr),
     _plugins(),
+    _start_time(Monotonic::CurrentNanoSeconds()),
+    _stats(*this, log),
     _handlers{{TSPControlCommand::CMD_EXIT,    &ControlServer::executeExit},
               {TSPControlCommand::CMD_SETLOG,  &ControlServer::executeSetLog},
               {TSPControlCommand::CMD_LIST,    &ControlServer::executeList},
               {TSPControlCommand::CMD_SUSPEND, &ControlServer::executeSuspend},
               {TSPControlCommand::CMD_RESUME,  &ControlServer::executeResume},
-              {TSPControlCommand::CMD_RESTART, &ControlServer::executeRestart}}
+              {TSPControlCommand::CMD_RESTART, &ControlServer::executeRestart},
+              {TSPControlCommand::CMD_STATS,   &ControlServer::executeStats},
+              {TSPControlCommand::CMD_LATENCY, &ControlServer::executeLatency}}
 {
     // Locate output plugin, count packet processor plugins.
     if (_input != nullptr) {
@@ -93,6 +99,11 @@ ts::tsp::ControlServer::~ControlServer()
 
 bool ts::tsp::ControlServer::open()
 {
+    // The periodic statistics do not depend on the control server.
+    if (_options.stats_interval > 0 && _input != nullptr) {
+        _stats.start();
+    }
+
     if (_options.control_port == 0) {
         // No control server, do nothing.
         return true;
@@ -122,6 +133,9 @@ bool ts::tsp::ControlServer::open()
 
 void ts::tsp::ControlServer::close()
 {
+    // Stop the periodic statistics.
+    _stats.stop();
+
     if (_is_open) {
         // Close the TCP server. This will force the server thread to terminate.
         _terminate = true;
@@ -356,3 +370,130 @@ void ts::tsp::ControlServer::executeRestart(const Args* args, Report& response)
         plugin->restart(params, response);
     }
 }
+
+
+//----------------------------------------------------------------------------
+// Stats command.
+//----------------------------------------------------------------------------
+
+void ts::tsp::ControlServer::executeStats(const Args* args, Report& response)
+{
+    reportStatistics(response);
+}
+
+void ts::tsp::ControlServer::reportStatistics(Report& report)
+{
+    // All statistics are read using lock-free operations, the plugin threads are not disturbed.
+    const NanoSecond duration = Monotonic::CurrentNanoSeconds() - _start_time;
+
+    statsOnePlugin(0, u'I', _input, duration, report);
+    size_t index = 1;
+    for (size_t i = 0; i < _plugins.size(); ++i) {
+        statsOnePlugin(index++, u'P', _plugins[i], duration, report);
+    }
+    statsOnePlugin(index, u'O', _output, duration, report);
+}
+
+void ts::tsp::ControlServer::statsOnePlugin(size_t index, UChar type, PluginExecutor* plugin, NanoSecond duration, Report& report)
+{
+    const PacketCounter total = plugin->totalPacketsInThread();
+    const PacketCounter packets = plugin->pluginPackets();
+    const NanoSecond cpu = plugin->cpuTime();
+    const NanoSecond wait = plugin->waitTime();
+
+    report.info(u"%2d: %c-%s: packets: %'d, in plugin: %'d, cpu: %'d ms (%d%%), %'d ns/packet, wait: %'d ms (%d%%), buffer: %'d/%'d",
+                {index, type, plugin->pluginName(),
+                 total, packets,
+                 cpu / NanoSecPerMilliSec, duration <= 0 ? 0 : (100 * cpu) / duration,
+                 total == 0 ? 0 : cpu / NanoSecond(total),
+                 wait / NanoSecPerMilliSec, duration <= 0 ? 0 : (100 * wait) / duration,
+                 plugin->bufferedPackets(), plugin->bufferSize()});
+}
+
+
+//----------------------------------------------------------------------------
+// Latency command.
+//----------------------------------------------------------------------------
+
+void ts::tsp::ControlServer::executeLatency(const Args* args, Report& response)
+{
+    reportLatency(response);
+
+    const bool start = args->present(u"start");
+    const bool stop = args->present(u"stop");
+    const bool reset = args->present(u"reset");
+
+    if (start && stop) {
+        response.error(u"--start and --stop are mutually exclusive");
+    }
+    else if (start || stop || reset) {
+        PluginExecutor* proc = _input;
+        do {
+            if (reset) {
+                proc->resetLatency();
+            }
+            if (start || stop) {
+                proc->setLatencyRecording(start);
+            }
+        } while ((proc = proc->ringNext<PluginExecutor>()) != _input);
+    }
+}
+
+void ts::tsp::ControlServer::reportLatency(Report& report)
+{
+    // All histograms are read using lock-free operations, the plugin threads are not disturbed.
+    latencyOnePlugin(0, u'I', _input, report);
+    size_t index = 1;
+    for (size_t i = 0; i < _plugins.size(); ++i) {
+        latencyOnePlugin(index++, u'P', _plugins[i], report);
+    }
+    latencyOnePlugin(index, u'O', _output, report);
+}
+
+void ts::tsp::ControlServer::latencyOnePlugin(size_t index, UChar type, PluginExecutor* plugin, Report& report)
+{
+    const UChar* const status = plugin->getLatencyRecording() ? u"" : u" (stopped)";
+    report.info(u"%2d: %c-%s%s: batch: %s", {index, type, plugin->pluginName(), status, plugin->batchLatency().toString()});
+    report.info(u"%2d: %c-%s%s: wait: %s", {index, type, plugin->pluginName(), status, plugin->waitLatency().toString()});
+}
+
+
+//----------------------------------------------------------------------------
+// Thread which periodically reports the statistics of all plugins.
+//----------------------------------------------------------------------------
+
+ts::tsp::ControlServer::StatsReporter::StatsReporter(ControlServer& server, Report& log) :
+    Thread(),
+    _server(server),
+    _log(log, u"stats: "),
+    _mutex(),
+    _wake(),
+    _terminate(false)
+{
+}
+
+ts::tsp::ControlServer::StatsReporter::~StatsReporter()
+{
+    stop();
+}
+
+void ts::tsp::ControlServer::StatsReporter::stop()
+{
+    {
+        GuardCondition lock(_mutex, _wake);
+        _terminate = true;
+        lock.signal();
+    }
+    waitForTermination();
+}
+
+void ts::tsp::ControlServer::StatsReporter::main()
+{
+    GuardCondition lock(_mutex, _wake);
+    while (!_terminate) {
+        // A timeout of the condition means that it is time to report.
+        if (!lock.waitCondition(_server._options.stats_interval) && !_terminate) {
+            _server.reportStatistics(_log);
+        }
+    }
+}
@@ -40,6 +40,7 @@
 #include "tsTSPControlCommand.h"
 #include "tsThread.h"
 #include "tsMutex.h"
+#include "tsCondition.h"
 #include "tsTCPServer.h"
 #include "tsReportWithPrefix.h"
 
@@ -79,7 +80,30 @@ namespace ts {
             //!
             void close();
 
+            //!
+            //! Report the latency histograms of all plugins.
+            //! @param [in,out] report Where to report the histograms.
+            //!
+            void reportLatency(Report& report);
+
         private:
+            // Thread which periodically reports the statistics of all plugins.
+            class StatsReporter : public Thread
+            {
+                TS_NOBUILD_NOCOPY(StatsReporter);
+            public:
+                StatsReporter(ControlServer& server, Report& log);
+                virtual ~StatsReporter() override;
+                void stop();
+            private:
+                ControlServer&   _server;
+                ReportWithPrefix _log;
+                Mutex            _mutex;
+                Condition        _wake;
+                bool             _terminate;
+                virtual void main() override;
+            };
+
             volatile bool     _is_open;
             volatile bool     _terminate;
             TSProcessorArgs&  _options;
@@ -90,6 +114,8 @@ namespace ts {
             InputExecutor*    _input;
             OutputExecutor*   _output;
             std::vector<ProcessorExecutor*> _plugins;  // Packet processing plugins
+            NanoSecond        _start_time;  // Monotonic time of start, for statistics.
+            StatsReporter     _stats;
 
             // Implementation of Thread.
             virtual void main() override;
@@ -106,6 +132,13 @@ namespace ts {
             void executeResume(const Args*, Report&);
             void executeSuspendResume(bool state, const Args*, Report&);
             void executeRestart(const Args*, Report&);
+            void executeStats(const Args*, Report&);
+            void statsOnePlugin(size_t index, UChar type, PluginExecutor* plugin, NanoSecond duration, Report& report);
+            void executeLatency(const Args*, Report&);
+            void latencyOnePlugin(size_t index, UChar type, PluginExecutor* plugin, Report& report);
+
+            // Report the statistics of all plugins.
+            void reportStatistics(Report& report);
         };
     }
 }
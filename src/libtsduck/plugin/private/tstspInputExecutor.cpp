@@ -29,6 +29,7 @@
 
 #include "tstspInputExecutor.h"
 #include "tsTime.h"
+#include "tsMonotonic.h"
 TSDUCK_SOURCE;
 
 // Minimum number of PID's and PCR/DTS to analyze before getting a valid bitrate.
@@ -217,6 +218,18 @@ size_t ts::tsp::InputExecutor::receiveAndValidate(size_t index, size_t max_packe
         _watchdog.suspend();
     }
 
+    // Time stamp packets which were not time stamped by the plugin.
+    // Read the clock only once for all packets of the same input operation.
+    NanoSecond now = 0;
+    for (size_t n = 0; n < count; ++n) {
+        if (!data[n].hasInputTimeStamp()) {
+            if (now == 0) {
+                now = Monotonic::CurrentNanoSeconds();
+            }
+            data[n].setInputTimeStamp(now);
+        }
+    }
+
     // Validate sync byte (0x47) at beginning of each packet
     for (size_t n = 0; n < count; ++n) {
         if (pkt[n].hasValidSync()) {
@@ -31,8 +31,12 @@
 #include "tsPluginRepository.h"
 #include "tsGuardCondition.h"
 #include "tsGuard.h"
+#include "tsMonotonic.h"
 TSDUCK_SOURCE;
 
+// In lock-free mode, number of times to check for work before sleeping.
+#define LOCK_FREE_SPIN_COUNT 1000
+
 
 //----------------------------------------------------------------------------
 // Constructors and destructors.
@@ -55,6 +59,12 @@ ts::tsp::PluginExecutor::PluginExecutor(const TSProcessorArgs& options,
     _pkt_cnt(0),
     _input_end(false),
     _bitrate(0),
+    _sleeping(false),
+    _wait_time(0),
+    _latency_on(options.latency),
+    _batch_start(0),
+    _batch_latency(),
+    _wait_latency(),
     _restart(false),
     _restart_data()
 {
@@ -100,6 +110,19 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, BitRate bitrate, bool in
 
     log(10, u"passPackets(count = %'d, bitrate = %'d, input_end = %s, aborted = %s)", {count, bitrate, input_end, aborted});
 
+    // Record the processing time of the batch. A batch starts when waitWork() returns or after
+    // the previous passPackets() when the packet area is passed in several parts.
+    if (count > 0 && _batch_start != 0) {
+        const NanoSecond now = Monotonic::CurrentNanoSeconds();
+        _batch_latency.add(now - _batch_start);
+        _batch_start = now;
+    }
+
+    // In lock-free mode, the global mutex is used only to wake up sleeping threads.
+    if (_options.lock_free) {
+        return passPacketsLockFree(count, bitrate, input_end, aborted);
+    }
+
     // We access data under the protection of the global mutex.
     Guard lock(_global_mutex);
 
@@ -137,6 +160,51 @@ bool ts::tsp::PluginExecutor::passPackets(size_t count, BitRate bitrate, bool in
 }
 
 
+//----------------------------------------------------------------------------
+// Signal that packets have been processed, lock-free version.
+//----------------------------------------------------------------------------
+
+bool ts::tsp::PluginExecutor::passPacketsLockFree(size_t count, BitRate bitrate, bool input_end, bool aborted)
+{
+    // Update our buffer. Only this thread modifies _pkt_first and decrements _pkt_cnt.
+    _pkt_first = (_pkt_first + count) % _buffer->count();
+    _pkt_cnt -= count;
+
+    // Update next processor's buffer. The end of input is set after the packet count
+    // so that the next processor sees the final packet count when the end of input is set.
+    PluginExecutor* next = ringNext<PluginExecutor>();
+    next->_bitrate = bitrate;
+    next->_pkt_cnt += count;
+    if (input_end) {
+        next->_input_end = true;
+    }
+
+    // Wake the next processor only when it sleeps on its condition.
+    // The condition is signaled under the global mutex to avoid a lost wake-up.
+    if ((count > 0 || input_end) && next->_sleeping) {
+        Guard lock(_global_mutex);
+        next->_to_do.signal();
+    }
+
+    // Force to abort our processor when the next one is aborting.
+    // Don't do that if current is output and next is input because
+    // there is no propagation of packets from output back to input.
+    if (plugin()->type() != OUTPUT_PLUGIN) {
+        aborted = aborted || next->_tsp_aborting;
+    }
+
+    // Wake the previous processor when we abort
+    if (aborted) {
+        Guard lock(_global_mutex);
+        _tsp_aborting = true; // volatile bool in TSP superclass
+        ringPrevious<PluginExecutor>()->_to_do.signal();
+    }
+
+    // Return false when the current processor shall stop.
+    return !input_end && !aborted;
+}
+
+
 //----------------------------------------------------------------------------
 // This method sets the current processor in an abort state.
 //----------------------------------------------------------------------------
@@ -159,6 +227,27 @@ bool ts::tsp::PluginExecutor::isRealTime() const
 }
 
 
+//----------------------------------------------------------------------------
+// Get the size of the global packet buffer.
+//----------------------------------------------------------------------------
+
+size_t ts::tsp::PluginExecutor::bufferSize() const
+{
+    return _buffer == nullptr ? 0 : _buffer->count();
+}
+
+
+//----------------------------------------------------------------------------
+// Reset the latency histograms of the plugin thread.
+//----------------------------------------------------------------------------
+
+void ts::tsp::PluginExecutor::resetLatency()
+{
+    _batch_latency.reset();
+    _wait_latency.reset();
+}
+
+
 //----------------------------------------------------------------------------
 // Wait for packets to process or some error condition.
 //----------------------------------------------------------------------------
@@ -167,25 +256,61 @@ void ts::tsp::PluginExecutor::waitWork(size_t& pkt_first, size_t& pkt_cnt, BitRa
 {
     log(10, u"waitWork(...)");
 
-    // We access data under the protection of the global mutex.
-    GuardCondition lock(_global_mutex, _to_do);
-
     PluginExecutor* next = ringNext<PluginExecutor>();
     timeout = false;
 
-    while (_pkt_cnt == 0 && !_input_end && !timeout && !next->_tsp_aborting) {
-        // If packet area for this processor is empty, wait for some packet.
-        // The mutex is implicitely released, we wait for the condition
-        // '_to_do' and, once we get it, implicitely relock the mutex.
-        // We loop on this until packets are actually available.
-        // If there is a timeout in the packet reception, call the plugin handler.
-        timeout = !lock.waitCondition(_tsp_timeout) && !plugin()->handlePacketTimeout();
+    // Measure the wait time only when there is nothing to do, the clock is not read in the packet path,
+    // unless the latency histograms are recorded.
+    const bool latency = _latency_on;
+    const bool idle = _pkt_cnt == 0 && !_input_end && !next->_tsp_aborting;
+    const NanoSecond wait_start = idle || latency ? Monotonic::CurrentNanoSeconds() : 0;
+
+    // In lock-free mode, poll the packet area a bounded number of times before sleeping.
+    size_t spin = 0;
+    while (_options.lock_free && _pkt_cnt == 0 && !_input_end && !next->_tsp_aborting && spin++ < LOCK_FREE_SPIN_COUNT) {
+        Thread::Yield();
+    }
+
+    if (!_options.lock_free || (_pkt_cnt == 0 && !_input_end && !next->_tsp_aborting)) {
+
+        // We access data under the protection of the global mutex.
+        GuardCondition lock(_global_mutex, _to_do);
+
+        // In lock-free mode, declare that we may sleep before checking the packet area
+        // so that the previous processor signals the condition after passing packets.
+        _sleeping = _options.lock_free;
+
+        while (_pkt_cnt == 0 && !_input_end && !timeout && !next->_tsp_aborting) {
+            // If packet area for this processor is empty, wait for some packet.
+            // The mutex is implicitely released, we wait for the condition
+            // '_to_do' and, once we get it, implicitely relock the mutex.
+            // We loop on this until packets are actually available.
+            // If there is a timeout in the packet reception, call the plugin handler.
+            timeout = !lock.waitCondition(_tsp_timeout) && !plugin()->handlePacketTimeout();
+        }
+
+        _sleeping = false;
     }
 
+    // Only this thread updates the wait time and the histograms, other threads only read them.
+    const NanoSecond wait_end = idle || latency ? Monotonic::CurrentNanoSeconds() : 0;
+    if (idle) {
+        _wait_time.store(_wait_time.load(std::memory_order_relaxed) + wait_end - wait_start, std::memory_order_relaxed);
+    }
+    if (latency) {
+        _wait_latency.add(wait_end - wait_start);
+    }
+    _batch_start = latency ? wait_end : 0;
+
+    // The end of input is set by the previous processor after the last packets.
+    // Read it first so that the packet count is final when it is set.
+    const bool end = _input_end;
+    const size_t cnt = _pkt_cnt;
+
     pkt_first = _pkt_first;
-    pkt_cnt = timeout ? 0 : std::min(_pkt_cnt, _buffer->count() - _pkt_first);
+    pkt_cnt = timeout ? 0 : std::min(cnt, _buffer->count() - _pkt_first);
     bitrate = _bitrate;
-    input_end = _input_end && pkt_cnt == _pkt_cnt;
+    input_end = end && pkt_cnt == cnt;
 
     // Force to abort our processor when the next one is aborting.
     // Don't do that if current is output and next is input because
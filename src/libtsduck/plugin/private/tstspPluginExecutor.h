@@ -41,6 +41,8 @@
 #include "tsCondition.h"
 #include "tsMutex.h"
 #include "tsThread.h"
+#include "tsLatencyHistogram.h"
+#include <atomic>
 
 namespace ts {
     namespace tsp {
@@ -143,6 +145,61 @@ namespace ts {
             //!
             void restart(Report& report);
 
+            //!
+            //! Get the cumulated time during which the plugin thread waited for packets.
+            //! For the input plugin, this is the time waiting for free space in the buffer.
+            //! This method can be invoked from any thread.
+            //! @return The cumulated wait time in nanoseconds.
+            //!
+            NanoSecond waitTime() const { return _wait_time.load(std::memory_order_relaxed); }
+
+            //!
+            //! Get the number of packets which are currently in the area of this plugin in the buffer.
+            //! For the input plugin, this is the free space in the buffer.
+            //! This method can be invoked from any thread.
+            //! @return The number of packets in the area of this plugin.
+            //!
+            size_t bufferedPackets() const { return _pkt_cnt; }
+
+            //!
+            //! Get the size of the global packet buffer.
+            //! @return The size in packets of the global packet buffer.
+            //!
+            size_t bufferSize() const;
+
+            //!
+            //! Start or stop the recording of the latency histograms of the plugin thread.
+            //! This method can be invoked from any thread.
+            //! @param [in] on When true, record the latency histograms. When false, stop recording.
+            //!
+            void setLatencyRecording(bool on) { _latency_on = on; }
+
+            //!
+            //! Check if the latency histograms of the plugin thread are currently recorded.
+            //! @return True when the latency histograms are recorded.
+            //!
+            bool getLatencyRecording() const { return _latency_on; }
+
+            //!
+            //! Get the histogram of the processing time of each batch of packets in the plugin thread.
+            //! A batch is a set of contiguous packets which are passed at once to the next plugin.
+            //! For the input and output plugins, this is the time in the receive and send operations.
+            //! @return A constant reference to the histogram. Can be read from any thread.
+            //!
+            const LatencyHistogram& batchLatency() const { return _batch_latency; }
+
+            //!
+            //! Get the histogram of the wait time of the plugin thread before each batch of packets.
+            //! @return A constant reference to the histogram. Can be read from any thread.
+            //!
+            const LatencyHistogram& waitLatency() const { return _wait_latency; }
+
+            //!
+            //! Reset the latency histograms of the plugin thread.
+            //! This method can be invoked from any thread.
+            //!
+            void resetLatency();
+
         protected:
             PacketBuffer*         _buffer;    //!< Description of shared packet buffer.
             PacketMetadataBuffer* _metadata;  //!< Description of shared packet metadata buffer.
@@ -203,14 +260,22 @@ namespace ts {
             typedef SafePtr<RestartData,Mutex> RestartDataPtr;
 
             // The following private data must be accessed exclusively under the protection of the global mutex.
+            // In lock-free mode, the packet area is updated using atomic operations and the global mutex
+            // is used only when a thread sleeps on its condition and for abort and restart signalling.
             // Implementation details: see the file src/docs/developing-plugins.dox
-            Condition      _to_do;         // Notify processor to do something.
-            size_t         _pkt_first;     // Starting index of packets area
-            size_t         _pkt_cnt;       // Size of packets area
-            bool           _input_end;     // No more packet after current ones
-            BitRate        _bitrate;       // Input bitrate (set by previous plugin)
-            bool           _restart;       // Restart the plugni asap using _restart_data
-            RestartDataPtr _restart_data;  // How to restart the plugin
+            Condition            _to_do;         // Notify processor to do something.
+            size_t               _pkt_first;     // Starting index of packets area (updated by this plugin only)
+            std::atomic<size_t>  _pkt_cnt;       // Size of packets area
+            std::atomic<bool>    _input_end;     // No more packet after current ones
+            std::atomic<BitRate> _bitrate;       // Input bitrate (set by previous plugin)
+            std::atomic<bool>    _sleeping;      // Lock-free mode: the plugin thread is waiting on _to_do.
+            std::atomic<NanoSecond> _wait_time;  // Cumulated wait time in waitWork() (updated by this plugin only).
+            std::atomic<bool>    _latency_on;    // Record the latency histograms.
+            NanoSecond           _batch_start;   // Start time of current batch, zero if not recorded (plugin thread only).
+            LatencyHistogram     _batch_latency; // Processing time of each batch (updated by this plugin only).
+            LatencyHistogram     _wait_latency;  // Wait time before each batch (updated by this plugin only).
+            bool                 _restart;       // Restart the plugni asap using _restart_data
+            RestartDataPtr       _restart_data;  // How to restart the plugin
 
             // Description of a restart operation.
             class RestartData
@@ -230,6 +295,9 @@ namespace ts {
 
             // Restart this plugin.
             void restart(const RestartDataPtr&);
+
+            // Lock-free version of passPackets().
+            bool passPacketsLockFree(size_t count, BitRate bitrate, bool input_end, bool aborted);
         };
     }
 }
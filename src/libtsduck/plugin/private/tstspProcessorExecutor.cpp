@@ -42,11 +42,76 @@ ts::tsp::ProcessorExecutor::ProcessorExecutor(const TSProcessorArgs& options,
                                               Report* report) :
 
     PluginExecutor(options, PROCESSOR_PLUGIN, pl_options, attributes, global_mutex, report),
-    _processor(dynamic_cast<ProcessorPlugin*>(PluginThread::plugin()))
+    _processor(dynamic_cast<ProcessorPlugin*>(PluginThread::plugin())),
+    _status(),
+    _pkt_state()
 {
 }
 
 
+//----------------------------------------------------------------------------
+// Submit a batch of contiguous packets to the plugin.
+//----------------------------------------------------------------------------
+
+size_t ts::tsp::ProcessorExecutor::processBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, size_t count, const TSPacketMetadata::LabelSet& only_labels)
+{
+    // Make sure the work areas are large enough.
+    if (_status.size() < count) {
+        _status.resize(count);
+        _pkt_state.resize(count);
+    }
+
+    // Read the suspended state once for the whole batch.
+    const bool suspended = _suspended;
+
+    // Classify one packet. Return true if the packet shall be submitted to the plugin.
+    auto submit = [&](size_t i) -> bool {
+        if (pkt[i].b[0] == 0) {
+            // The packet has already been dropped by a previous packet processor.
+            _pkt_state[i] = PKT_DROPPED;
+            return false;
+        }
+        else {
+            _status[i] = ProcessorPlugin::TSP_OK;
+            pkt_data[i].setFlush(false);
+            pkt_data[i].setBitrateChanged(false);
+            if (!suspended && (only_labels.none() || pkt_data[i].hasAnyLabel(only_labels))) {
+                // Either no --only-label option or the packet has a specified label => process it.
+                _pkt_state[i] = pkt[i].getPID() == PID_NULL ? PKT_NULL : PKT_NOT_NULL;
+                return true;
+            }
+            else {
+                // The plugin is suspended or some --only-label was specified but the packet does
+                // not have any required label. Pass the packet without submitting it to the plugin.
+                _pkt_state[i] = PKT_SKIPPED;
+                return false;
+            }
+        }
+    };
+
+    size_t index = 0;
+    while (index < count) {
+        // Skip packets which are not submitted to the plugin.
+        while (index < count && !submit(index)) {
+            index++;
+        }
+        // Locate the next run of packets to submit to the plugin.
+        const size_t first = index;
+        while (index < count && submit(index)) {
+            index++;
+        }
+        // Submit the run of packets. Stop at the first TSP_END.
+        if (index > first) {
+            const size_t done = _processor->processPacketBatch(pkt + first, pkt_data + first, index - first, &_status[first]);
+            if (done < index - first) {
+                return first + done;
+            }
+        }
+    }
+    return count;
+}
+
+
 //----------------------------------------------------------------------------
 // Packet processor plugin thread
 //----------------------------------------------------------------------------
@@ -110,85 +175,89 @@ void ts::tsp::ProcessorExecutor::main()
 
         while (pkt_done < pkt_cnt && !aborted) {
 
-            TSPacket* const pkt = _buffer->base() + pkt_first + pkt_done;
-            TSPacketMetadata* const pkt_data = _metadata->base() + pkt_first + pkt_done;
+            // Submit packets to the plugin by batch, up to the next periodic flush.
+            size_t batch_cnt = pkt_cnt - pkt_done;
+            if (_options.max_flush_pkt > 0) {
+                batch_cnt = std::min(batch_cnt, _options.max_flush_pkt - pkt_flush % _options.max_flush_pkt);
+            }
+            TSPacket* const batch_pkt = _buffer->base() + pkt_first + pkt_done;
+            TSPacketMetadata* const batch_data = _metadata->base() + pkt_first + pkt_done;
+            batch_cnt = processBatch(batch_pkt, batch_data, batch_cnt, only_labels);
 
-            pkt_done++;
-            pkt_flush++;
+            // Then use the returned status of each packet.
+            for (size_t i = 0; i < batch_cnt && !aborted; ++i) {
 
-            if (pkt->b[0] == 0) {
-                // The packet has already been dropped by a previous packet processor.
-                addNonPluginPackets(1);
-            }
-            else {
-                // Apply the processing routine to the packet
-                const bool was_null = pkt->getPID() == PID_NULL;
-                pkt_data->setFlush(false);
-                pkt_data->setBitrateChanged(false);
-                ProcessorPlugin::Status status = ProcessorPlugin::TSP_OK;
-                if (!_suspended && (only_labels.none() || pkt_data->hasAnyLabel(only_labels))) {
-                    // Either no --only-label option or the packet has a specified label => process it.
-                    status = _processor->processPacket(*pkt, *pkt_data);
-                    addPluginPackets(1);
-                }
-                else {
-                    // The plugin is suspended or some --only-label was specified but the packet does
-                    // not have any required label. Pass the packet without submitting it to the plugin.
+                TSPacket* const pkt = batch_pkt + i;
+                TSPacketMetadata* const pkt_data = batch_data + i;
+
+                pkt_done++;
+                pkt_flush++;
+
+                if (_pkt_state[i] == PKT_DROPPED) {
+                    // The packet has already been dropped by a previous packet processor.
                     addNonPluginPackets(1);
                 }
+                else {
+                    // Packets which were not submitted to the plugin have a TSP_OK status.
+                    // Packets which were submitted to the plugin have already been counted by the plugin.
+                    const ProcessorPlugin::Status status = _status[i];
+                    if (_pkt_state[i] == PKT_SKIPPED) {
+                        addNonPluginPackets(1);
+                    }
 
-                // Use the returned status
-                switch (status) {
-                    case ProcessorPlugin::TSP_OK:
-                        // Normal case, pass packet
-                        passed_packets++;
-                        break;
-                    case ProcessorPlugin::TSP_NULL:
-                        // Replace the packet with a complete null packet
-                        *pkt = NullPacket;
-                        break;
-                    case ProcessorPlugin::TSP_DROP:
-                        // Drop this packet.
-                        pkt->b[0] = 0;
-                        dropped_packets++;
-                        break;
-                    case ProcessorPlugin::TSP_END:
-                        // Signal end of input to successors and abort
-                        // to predecessors
-                        input_end = aborted = true;
-                        pkt_done--;
-                        pkt_flush--;
-                        pkt_cnt = pkt_done;
-                        break;
-                    default:
-                        // Invalid status, report error and accept packet.
-                        error(u"invalid packet processing status %d", {status});
-                        break;
-                }
+                    // Use the returned status
+                    switch (status) {
+                        case ProcessorPlugin::TSP_OK:
+                            // Normal case, pass packet
+                            passed_packets++;
+                            break;
+                        case ProcessorPlugin::TSP_NULL:
+                            // Replace the packet with a complete null packet
+                            *pkt = NullPacket;
+                            break;
+                        case ProcessorPlugin::TSP_DROP:
+                            // Drop this packet.
+                            pkt->b[0] = 0;
+                            dropped_packets++;
+                            break;
+                        case ProcessorPlugin::TSP_END:
+                            // Signal end of input to successors and abort
+                            // to predecessors
+                            input_end = aborted = true;
+                            pkt_done--;
+                            pkt_flush--;
+                            pkt_cnt = pkt_done;
+                            break;
+                        default:
+                            // Invalid status, report error and accept packet.
+                            error(u"invalid packet processing status %d", {status});
+                            break;
+                    }
 
-                // Detect if the packet was nullified by the plugin, either by returning TSP_NULL or by overwriting the packet.
-                if (!was_null && pkt->getPID() == PID_NULL) {
-                    pkt_data->setNullified(true);
-                    nullified_packets++;
-                }
+                    // Detect if the packet was nullified by the plugin, either by returning TSP_NULL or by overwriting the packet.
+                    if (_pkt_state[i] == PKT_NOT_NULL && pkt->getPID() == PID_NULL) {
+                        pkt_data->setNullified(true);
+                        nullified_packets++;
+                    }
 
-                // If the packet processor has signaled a new bitrate, get it.
-                if (pkt_data->getBitrateChanged()) {
-                    const BitRate new_bitrate = _processor->getBitrate();
-                    if (new_bitrate != 0) {
-                        bitrate_never_modified = false;
-                        output_bitrate = new_bitrate;
+                    // If the packet processor has signaled a new bitrate, get it.
+                    if (pkt_data->getBitrateChanged()) {
+                        const BitRate new_bitrate = _processor->getBitrate();
+                        if (new_bitrate != 0) {
+                            bitrate_never_modified = false;
+                            output_bitrate = new_bitrate;
+                        }
                     }
                 }
-            }
 
-            // Do not wait to process pkt_cnt packets before notifying
-            // the next processor. Perform periodic flush to avoid waiting
-            // too long before two output operations.
+                // Do not wait to process pkt_cnt packets before notifying
+                // the next processor. Perform periodic flush to avoid waiting
+                // too long before two output operations.
 
-            if (pkt_data->getFlush() || pkt_done == pkt_cnt || (_options.max_flush_pkt > 0 && pkt_flush % _options.max_flush_pkt == 0)) {
-                aborted = !passPackets(pkt_flush, output_bitrate, pkt_done == pkt_cnt && input_end, aborted);
-                pkt_flush = 0;
+                if (pkt_data->getFlush() || pkt_done == pkt_cnt || (_options.max_flush_pkt > 0 && pkt_flush % _options.max_flush_pkt == 0)) {
+                    aborted = !passPackets(pkt_flush, output_bitrate, pkt_done == pkt_cnt && input_end, aborted);
+                    pkt_flush = 0;
+                }
             }
         }
 
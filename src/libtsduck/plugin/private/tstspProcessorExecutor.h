@@ -68,7 +68,21 @@ namespace ts {
             ProcessorPlugin* plugin() {return _processor;}
 
         private:
-            ProcessorPlugin* _processor;
+            // State of a packet in a batch, before submission to the plugin.
+            enum PacketState : uint8_t {
+                PKT_DROPPED,    // Already dropped by a previous plugin.
+                PKT_SKIPPED,    // Passed without submission to the plugin (suspended or --only-label).
+                PKT_NULL,       // Null packet before processing.
+                PKT_NOT_NULL,   // Non-null packet before processing.
+            };
+
+            ProcessorPlugin*                     _processor;
+            std::vector<ProcessorPlugin::Status> _status;     // Processing status of packets in current batch.
+            std::vector<PacketState>             _pkt_state;  // Initial state of packets in current batch.
+
+            // Submit a batch of contiguous packets to the plugin, using runs of packets to process.
+            // Fill _status and _pkt_state. Return the number of packets to consider (less than count on TSP_END).
+            size_t processBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, size_t count, const TSPacketMetadata::LabelSet& only_labels);
 
             // Inherited from Thread
             virtual void main() override;
@@ -36,7 +36,7 @@ TSDUCK_SOURCE;
 // Input constructor
 //----------------------------------------------------------------------------
 
-ts::AbstractDatagramInputPlugin::AbstractDatagramInputPlugin(TSP* tsp_, size_t buffer_size, const UString& description, const UString& syntax) :
+ts::AbstractDatagramInputPlugin::AbstractDatagramInputPlugin(TSP* tsp_, size_t buffer_size, const UString& description, const UString& syntax, size_t max_datagrams) :
     InputPlugin(tsp_, description, syntax),
     _eval_time(0),
     _display_time(0),
@@ -47,9 +47,14 @@ ts::AbstractDatagramInputPlugin::AbstractDatagramInputPlugin(TSP* tsp_, size_t b
     _packets_0(0),
     _start_1(Time::Epoch),
     _packets_1(0),
+    _datagram_size(buffer_size),
+    _max_datagrams(std::max<size_t>(1, max_datagrams)),
     _inbuf_count(0),
     _inbuf_next(0),
-    _inbuf(buffer_size)
+    _inbuf(_datagram_size * _max_datagrams),
+    _inbuf_sizes(_max_datagrams),
+    _inbuf_times(_max_datagrams),
+    _pkt_times(_inbuf.size() / PKT_SIZE)
 {
     option(u"display-interval", 'd', POSITIVE);
     help(u"display-interval",
@@ -103,6 +108,21 @@ bool ts::AbstractDatagramInputPlugin::start()
 }
 
 
+//----------------------------------------------------------------------------
+// Default implementation of multiple datagram reception: receive one.
+//----------------------------------------------------------------------------
+
+bool ts::AbstractDatagramInputPlugin::receiveDatagrams(uint8_t* buffer, size_t buffer_size, size_t max_count, size_t* ret_size, NanoSecond* timestamps, size_t& ret_count)
+{
+    ret_count = 0;
+    if (max_count > 0 && receiveDatagram(buffer, buffer_size, ret_size[0])) {
+        timestamps[0] = 0;
+        ret_count = 1;
+    }
+    return ret_count > 0;
+}
+
+
 //----------------------------------------------------------------------------
 // Input bitrate evaluation method
 //----------------------------------------------------------------------------
@@ -135,21 +155,32 @@ size_t ts::AbstractDatagramInputPlugin::receive(TSPacket* buffer, TSPacketMetada
     // Loop until we get some TS packets.
     while (_inbuf_count == 0) {
 
-        // Wait for a datagram message
-        size_t insize = 0;
-        if (!receiveDatagram(_inbuf.data(), _inbuf.size(), insize)) {
+        // Wait for one or more datagram messages.
+        size_t count = 0;
+        if (!receiveDatagrams(_inbuf.data(), _datagram_size, _max_datagrams, _inbuf_sizes.data(), _inbuf_times.data(), count)) {
             return 0;
         }
 
-        // Look for TS packets in the UDP message.
-        new_packets = TSPacket::Locate(_inbuf.data(), insize, _inbuf_next, _inbuf_count);
-
-        if (new_packets) {
-            break; // found packets.
+        // Look for TS packets in each message. Move them at the beginning of the input buffer,
+        // contiguously after the packets of the previous messages.
+        _inbuf_next = 0;
+        for (size_t i = 0; i < count; ++i) {
+            const uint8_t* const msg = _inbuf.data() + i * _datagram_size;
+            size_t start = 0;
+            size_t pkt_count = 0;
+            if (TSPacket::Locate(msg, _inbuf_sizes[i], start, pkt_count)) {
+                ::memmove(_inbuf.data() + _inbuf_count * PKT_SIZE, msg + start, pkt_count * PKT_SIZE);
+                std::fill(_pkt_times.begin() + _inbuf_count, _pkt_times.begin() + _inbuf_count + pkt_count, _inbuf_times[i]);
+                _inbuf_count += pkt_count;
+            }
+            else if (_inbuf_sizes[i] > 0) {
+                // No TS packet found in message, ignore it.
+                tsp->debug(u"no TS packet in message, %s bytes", {_inbuf_sizes[i]});
+            }
         }
 
-        // No TS packet found in UDP message, wait for another one.
-        tsp->debug(u"no TS packet in message, %s bytes", {insize});
+        // If no TS packet was found in any message, wait for other ones.
+        new_packets = _inbuf_count > 0;
     }
 
     // If new packets were received, we may need to re-evaluate the real-time input bitrate.
@@ -195,6 +226,9 @@ size_t ts::AbstractDatagramInputPlugin::receive(TSPacket* buffer, TSPacketMetada
     // Return packets from the input buffer
     size_t pkt_cnt = std::min(_inbuf_count, max_packets);
     TSPacket::Copy(buffer, _inbuf.data() + _inbuf_next, pkt_cnt);
+    for (size_t i = 0; i < pkt_cnt; ++i) {
+        pkt_data[i].setInputTimeStamp(_pkt_times[_inbuf_next / PKT_SIZE + i]);
+    }
     _inbuf_count -= pkt_cnt;
     _inbuf_next += pkt_cnt * PKT_SIZE;
 
@@ -52,11 +52,14 @@ namespace ts {
         //! Constructor.
         //! @param [in] tsp Associated callback to @c tsp executable.
         //! @param [in] buffer_size Size in bytes of input buffer.
+        //! Must be large enough to contain the largest datagram.
         //! @param [in] description A short one-line description, eg. "Wonderful File Copier".
         //! @param [in] syntax A short one-line syntax summary, eg. "[options] filename ...".
-        //! Must be large enough to contain the largest datagram.
+        //! @param [in] max_datagrams Maximum number of datagrams to receive in one operation.
+        //! The actual input buffer contains @a max_datagrams buffers of @a buffer_size bytes.
+        //! @see receiveDatagrams()
         //!
-        AbstractDatagramInputPlugin(TSP* tsp, size_t buffer_size, const UString& description = UString(), const UString& syntax = UString());
+        AbstractDatagramInputPlugin(TSP* tsp, size_t buffer_size, const UString& description = UString(), const UString& syntax = UString(), size_t max_datagrams = 1);
 
         // Implementation of plugin API.
         virtual bool getOptions() override;
@@ -76,6 +79,24 @@ namespace ts {
         //!
         virtual bool receiveDatagram(void* buffer, size_t buffer_size, size_t& ret_size) = 0;
 
+        //!
+        //! Receive several datagram messages in one operation.
+        //! The default implementation receives one datagram using receiveDatagram().
+        //! Subclasses may redefine it when they can receive several datagrams at once.
+        //! @param [out] buffer Address of the buffer for the received messages. The datagram
+        //! messages are received at offsets which are multiple of @a buffer_size.
+        //! @param [in] buffer_size Size in bytes of the reception buffer of one message.
+        //! @param [in] max_count Maximum number of messages to receive.
+        //! @param [out] ret_size Array of @a max_count sizes. Receive the size in bytes of each
+        //! received message. A message with a zero size shall be ignored.
+        //! @param [out] timestamps Array of @a max_count time stamps. Receive the reception time stamp
+        //! of each message in nanoseconds, in the reference of Monotonic::CurrentNanoSeconds(). Zero means
+        //! that the time stamp is unknown. The time stamps are propagated in the metadata of the TS packets.
+        //! @param [out] ret_count Number of received messages.
+        //! @return True on success, false on error.
+        //!
+        virtual bool receiveDatagrams(uint8_t* buffer, size_t buffer_size, size_t max_count, size_t* ret_size, NanoSecond* timestamps, size_t& ret_count);
+
     private:
         MilliSecond   _eval_time;          // Bitrate evaluation interval in milli-seconds
         MilliSecond   _display_time;       // Bitrate display interval in milli-seconds
@@ -86,8 +107,13 @@ namespace ts {
         PacketCounter _packets_0;          // Number of received packets since _start_0
         Time          _start_1;            // Start of previous bitrate evaluation period
         PacketCounter _packets_1;          // Number of received packets since _start_1
+        size_t        _datagram_size;      // Buffer size for one datagram
+        size_t        _max_datagrams;      // Maximum number of datagrams per receive operation
         size_t        _inbuf_count;        // Remaining TS packets in inbuf
         size_t        _inbuf_next;         // Index in inbuf of next TS packet to return
         ByteBlock     _inbuf;              // Input buffer
+        std::vector<size_t> _inbuf_sizes;  // Sizes of datagrams in last receive operation
+        std::vector<NanoSecond> _inbuf_times;  // Time stamps of datagrams in last receive operation
+        std::vector<NanoSecond> _pkt_times;    // Time stamps of TS packets in inbuf
     };
 }
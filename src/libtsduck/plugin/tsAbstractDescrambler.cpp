@@ -49,6 +49,8 @@ ts::AbstractDescrambler::AbstractDescrambler(TSP* tsp_, const UString& descripti
     _swap_cw(false),
     _scrambling(*tsp),
     _pids(),
+    _in_batch(false),
+    _batch_pkts(),
     _service(duck, this),
     _stack_usage(stack_usage),
     _demux(duck, nullptr, this),
@@ -517,7 +519,7 @@ ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt
     // If there is a user-specified list of PID's, we don't manage a service
     // and there is nothing else to do.
     if (_pids.any()) {
-        return !_pids.test(pid) || _scrambling.decrypt(pkt) ? TSP_OK : TSP_END;
+        return !_pids.test(pid) || decryptFixed(pkt) ? TSP_OK : TSP_END;
     }
 
     // Filter sections to locate the service and grab ECM's.
@@ -539,7 +541,7 @@ ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt
 
     // Without ECM's, we descramble using fixed control words.
     if (!_need_ecm) {
-        return _scrambling.decrypt(pkt) ? TSP_OK : TSP_END;
+        return decryptFixed(pkt) ? TSP_OK : TSP_END;
     }
 
     // Get PID context. If the PID is not known as a scrambled PID,
@@ -594,3 +596,54 @@ ts::ProcessorPlugin::Status ts::AbstractDescrambler::processPacket(TSPacket& pkt
     // Descramble the packet payload.
     return pecm->scrambling.decrypt(pkt) ? TSP_OK : TSP_END;
 }
+
+
+//----------------------------------------------------------------------------
+// Descramble a packet using fixed control words.
+//----------------------------------------------------------------------------
+
+bool ts::AbstractDescrambler::decryptFixed(TSPacket& pkt)
+{
+    // In batch mode, all packets are descrambled together at end of batch.
+    if (_in_batch) {
+        _batch_pkts.push_back(&pkt);
+        return true;
+    }
+    else {
+        return _scrambling.decrypt(pkt);
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Batch packet processing method
+//----------------------------------------------------------------------------
+
+size_t ts::AbstractDescrambler::processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, size_t count, Status* status)
+{
+    // With control words from ECM's, the keys may change at any packet.
+    if (_need_ecm && _pids.none()) {
+        return ProcessorPlugin::processPacketBatch(pkt, pkt_data, count, status);
+    }
+
+    // With fixed control words, collect the packets to descramble and process them together.
+    // The virtual processPacket() is still used in case it is overridden by the subclass.
+    _in_batch = true;
+    size_t processed = 0;
+    while (processed < count) {
+        status[processed] = processPacket(pkt[processed], pkt_data[processed]);
+        if (status[processed++] == TSP_END) {
+            break;
+        }
+    }
+    _in_batch = false;
+
+    // In case of descrambling error, stop at the first packet which was not descrambled.
+    if (!_batch_pkts.empty() && !_scrambling.decrypt(_batch_pkts.data(), _batch_pkts.size())) {
+        processed = size_t(_batch_pkts.front() - pkt) + 1;
+        status[processed - 1] = TSP_END;
+    }
+    _batch_pkts.clear();
+    countPluginPackets(processed);
+    return processed;
+}
@@ -62,6 +62,7 @@ namespace ts {
         virtual bool start() override;
         virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t processPacketBatch(TSPacket*, TSPacketMetadata*, size_t, Status*) override;
 
     protected:
         //!
@@ -255,6 +256,9 @@ namespace ts {
         // releases the mutex while deciphering the ECM and relocks it before exiting.
         void processECM(ECMStream&);
 
+        // Descramble a packet using fixed control words (deferred in batch mode).
+        bool decryptFixed(TSPacket& pkt);
+
         // Analyze a list of descriptors from the PMT, looking for ECM PID's
         void analyzeDescriptors(const DescriptorList& dlist, std::set<PID>& ecm_pids, uint8_t& scrambling);
 
@@ -266,6 +270,8 @@ namespace ts {
         bool               _swap_cw;           // Swap even/odd CW from ECM.
         TSScrambling       _scrambling;        // Default descrambling (used with fixed control words).
         PIDSet             _pids;              // Explicit PID's to descramble.
+        bool               _in_batch;          // Currently processing a batch of packets with fixed control words.
+        std::vector<TSPacket*> _batch_pkts;    // Packets to descramble with fixed control words at end of batch.
         ServiceDiscovery   _service;           // Service to descramble (by name, id or none).
         size_t             _stack_usage;       // Stack usage for ECM deciphering.
         SectionDemux       _demux;             // Section demux to extract ECM's.
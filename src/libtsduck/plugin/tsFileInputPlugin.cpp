@@ -40,6 +40,7 @@ ts::FileInputPlugin::FileInputPlugin(TSP* tsp_) :
     _aborted(true),
     _interleave(false),
     _first_terminate(false),
+    _memory_map(false),
     _interleave_chunk(0),
     _interleave_remain(0),
     _current_filename(0),
@@ -89,6 +90,12 @@ ts::FileInputPlugin::FileInputPlugin(TSP* tsp_) :
          u"For a given file, if the computed label is above the maximum (" +
          UString::Decimal(TSPacketMetadata::LABEL_MAX) + u"), its packets are not labelled.");
 
+    option(u"memory-map", 'm');
+    help(u"memory-map",
+         u"Read regular files using memory mapping, when supported by the operating system. "
+         u"This reduces the number of system calls and the CPU load when reading very large files. "
+         u"Files which are not regular files, such as pipes, are read as usual.");
+
     option(u"packet-offset", 'p', UNSIGNED);
     help(u"packet-offset",
          u"Start reading each file at the specified TS packet (default: 0). "
@@ -114,6 +121,7 @@ bool ts::FileInputPlugin::getOptions()
     _interleave = present(u"interleave");
     _interleave_chunk = intValue<size_t>(u"interleave", 1);
     _first_terminate = present(u"first-terminate");
+    _memory_map = present(u"memory-map");
     _base_label = intValue<size_t>(u"label-base", TSPacketMetadata::LABEL_MAX + 1);
 
     // If there is no file, then this is the standard input, an empty file name.
@@ -155,6 +163,7 @@ bool ts::FileInputPlugin::openFile(size_t name_index, size_t file_index)
     }
 
     // Actually open the file.
+    _files[file_index].setMemoryMapped(_memory_map);
     return _files[file_index].openRead(name, _repeat_count, _start_offset, *tsp);
 }
 
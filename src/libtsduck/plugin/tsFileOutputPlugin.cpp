@@ -39,7 +39,10 @@ ts::FileOutputPlugin::FileOutputPlugin(TSP* tsp_) :
     OutputPlugin(tsp_, u"Write packets to a file", u"[options] [file-name]"),
     _name(),
     _flags(TSFile::NONE),
-    _file()
+    _async(false),
+    _async_buffers(0),
+    _file(),
+    _async_file()
 {
     option(u"", 0, STRING, 0, 1);
     help(u"", u"Name of the created output file. Use standard output by default.");
@@ -47,6 +50,24 @@ ts::FileOutputPlugin::FileOutputPlugin(TSP* tsp_) :
     option(u"append", 'a');
     help(u"append", u"If the file already exists, append to the end of the file. By default, existing files are overwritten.");
 
+    option(u"asynchronous", 0);
+    help(u"asynchronous",
+         u"Write the file asynchronously. The packets are copied into a ring of memory buffers "
+         u"which are written to the file by a dedicated thread. The packet processing is blocked "
+         u"only when all buffers are full, for instance during a long file system stall. "
+         u"Back-pressure statistics are reported in verbose mode when the file is closed.");
+
+    option(u"async-buffers", 0, POSITIVE);
+    help(u"async-buffers",
+         u"With --asynchronous, specify the number of buffers in the ring. Each buffer contains " +
+         UString::Decimal(TSFileOutputAsync::BUFFER_PACKETS) + u" TS packets. The default is " +
+         UString::Decimal(TSFileOutputAsync::DEFAULT_BUFFER_COUNT) + u" buffers.");
+
+    option(u"direct-io", 0);
+    help(u"direct-io",
+         u"With --asynchronous, write the file using direct I/O, bypassing the system cache (Linux only). "
+         u"This avoids filling the system cache with large recordings which are never read back.");
+
     option(u"keep", 'k');
     help(u"keep", u"Keep existing file (abort if the specified file already exists). By default, existing files are overwritten.");
 }
@@ -66,20 +87,37 @@ bool ts::FileOutputPlugin::getOptions()
     if (present(u"keep")) {
         _flags |= TSFile::KEEP;
     }
+    _async = present(u"asynchronous");
+    _async_buffers = intValue<size_t>(u"async-buffers", TSFileOutputAsync::DEFAULT_BUFFER_COUNT);
+    if (present(u"direct-io")) {
+        if (!_async) {
+            tsp->error(u"--direct-io requires --asynchronous");
+            return false;
+        }
+        _flags |= TSFile::DIRECT;
+    }
     return true;
 }
 
 bool ts::FileOutputPlugin::start()
 {
-    return _file.open(_name, _flags, *tsp);
+    return _async ? _async_file.open(_name, _flags, _async_buffers, *tsp) : _file.open(_name, _flags, *tsp);
 }
 
 bool ts::FileOutputPlugin::stop()
 {
-    return _file.close(*tsp);
+    if (!_async) {
+        return _file.close(*tsp);
+    }
+
+    const bool ok = _async_file.close(*tsp);
+    const TSFileOutputAsync::Statistics stats(_async_file.getStatistics());
+    tsp->verbose(u"asynchronous output: %'d packets in %'d buffers, max %d/%d buffers used, waited %'d times for free buffers, %'d ms",
+                 {stats.packets, stats.buffers, stats.max_busy, _async_buffers, stats.wait_count, stats.wait_time / NanoSecPerMilliSec});
+    return ok;
 }
 
 bool ts::FileOutputPlugin::send(const TSPacket* buffer, const TSPacketMetadata* pkt_data, size_t packet_count)
 {
-    return _file.write(buffer, packet_count, *tsp);
+    return _async ? _async_file.write(buffer, packet_count, *tsp) : _file.write(buffer, packet_count, *tsp);
 }
@@ -35,6 +35,7 @@
 #pragma once
 #include "tsPlugin.h"
 #include "tsTSFile.h"
+#include "tsTSFileOutputAsync.h"
 
 namespace ts {
     //!
@@ -60,6 +61,9 @@ namespace ts {
     private:
         UString           _name;
         TSFile::OpenFlags _flags;
-        TSFile            _file;
+        bool              _async;          // Use asynchronous writes.
+        size_t            _async_buffers;  // Number of buffers in asynchronous mode.
+        TSFile            _file;           // Output file in synchronous mode.
+        TSFileOutputAsync _async_file;     // Output file in asynchronous mode.
     };
 }
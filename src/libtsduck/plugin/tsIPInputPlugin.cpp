@@ -32,14 +32,18 @@
 #include "tsSysUtils.h"
 TSDUCK_SOURCE;
 
+// Maximum number of datagrams to receive in one operation.
+#define MAX_DATAGRAMS 16
+
 
 //----------------------------------------------------------------------------
 // Input constructor
 //----------------------------------------------------------------------------
 
 ts::IPInputPlugin::IPInputPlugin(TSP* tsp_) :
-    AbstractDatagramInputPlugin(tsp_, IP_MAX_PACKET_SIZE, u"Receive TS packets from UDP/IP, multicast or unicast", u"[options] [address:]port"),
-    _sock(*tsp_)
+    AbstractDatagramInputPlugin(tsp_, IP_MAX_PACKET_SIZE, u"Receive TS packets from UDP/IP, multicast or unicast", u"[options] [address:]port", MAX_DATAGRAMS),
+    _sock(*tsp_),
+    _messages()
 {
     // Add UDP receiver common options.
     _sock.defineArgs(*this);
@@ -113,3 +117,27 @@ bool ts::IPInputPlugin::receiveDatagram(void* buffer, size_t buffer_size, size_t
     SocketAddress destination;
     return _sock.receive(buffer, buffer_size, ret_size, sender, destination, tsp, *tsp);
 }
+
+
+//----------------------------------------------------------------------------
+// Receive several datagrams in one operation.
+//----------------------------------------------------------------------------
+
+bool ts::IPInputPlugin::receiveDatagrams(uint8_t* buffer, size_t buffer_size, size_t max_count, size_t* ret_size, NanoSecond* timestamps, size_t& ret_count)
+{
+    // Describe the reception buffers of all messages.
+    _messages.resize(max_count);
+    for (size_t i = 0; i < max_count; ++i) {
+        _messages[i] = UDPSocket::Message(buffer + i * buffer_size, buffer_size);
+    }
+
+    // Receive messages. Filtered messages are returned with a zero size.
+    if (!_sock.receive(_messages.data(), max_count, ret_count, tsp, *tsp)) {
+        return false;
+    }
+    for (size_t i = 0; i < ret_count; ++i) {
+        ret_size[i] = _messages[i].size;
+        timestamps[i] = _messages[i].timestamp;
+    }
+    return true;
+}
@@ -61,8 +61,10 @@ namespace ts {
     protected:
         // Implementation of AbstractDatagramInputPlugin.
         virtual bool receiveDatagram(void* buffer, size_t buffer_size, size_t& ret_size) override;
+        virtual bool receiveDatagrams(uint8_t* buffer, size_t buffer_size, size_t max_count, size_t* ret_size, NanoSecond* timestamps, size_t& ret_count) override;
 
     private:
-        UDPReceiver _sock; // Incoming socket with associated command line options.
+        UDPReceiver              _sock;      // Incoming socket with associated command line options.
+        UDPSocket::MessageVector _messages;  // Message descriptions for multiple receive.
     };
 }
@@ -36,6 +36,9 @@ TSDUCK_SOURCE;
 #define DEF_PACKET_BURST    7  // 1316 B, fits (with headers) in Ethernet MTU
 #define MAX_PACKET_BURST  128  // ~ 48 kB
 
+// Maximum number of datagrams which are sent in one batch.
+#define DATAGRAM_BATCH     32
+
 
 //----------------------------------------------------------------------------
 // Output constructor
@@ -67,7 +70,10 @@ ts::IPOutputPlugin::IPOutputPlugin(TSP* tsp_) :
     _pkt_count(0),
     _sock(false, *tsp_),
     _out_count(0),
-    _out_buffer()
+    _out_buffer(),
+    _msg_count(0),
+    _messages(),
+    _rtp_buffer()
 {
     option(u"", 0, STRING, 1, 1);
     help(u"",
@@ -200,6 +206,13 @@ bool ts::IPOutputPlugin::start()
         _out_count = 0;
     }
 
+    // Batch of datagrams to send. RTP datagrams are built in a dedicated buffer.
+    _messages.resize(DATAGRAM_BATCH);
+    _msg_count = 0;
+    if (_use_rtp) {
+        _rtp_buffer.resize(DATAGRAM_BATCH * (RTP_HEADER_SIZE + _pkt_burst * PKT_SIZE));
+    }
+
     // Initialize RTP parameters.
     if (_use_rtp) {
         // Use a system PRNG. This type of RNG does not need to be seeded.
@@ -268,7 +281,7 @@ bool ts::IPOutputPlugin::send(const TSPacket* pkt, const TSPacketMetadata* pkt_d
 
         // Send the output buffer when full.
         if (_out_count == _pkt_burst) {
-            if (!sendDatagram(_out_buffer.data(), _out_count)) {
+            if (!addDatagram(_out_buffer.data(), _out_count)) {
                 return false;
             }
             _out_count = 0;
@@ -278,13 +291,18 @@ bool ts::IPOutputPlugin::send(const TSPacket* pkt, const TSPacketMetadata* pkt_d
     // Send subsequent packets from the global buffer.
     while (packet_count > min_burst) {
         size_t count = std::min(packet_count, _pkt_burst);
-        if (!sendDatagram(pkt, count)) {
+        if (!addDatagram(pkt, count)) {
             return false;
         }
         pkt += count;
         packet_count -= count;
     }
 
+    // Send all datagrams which were built from the output buffer and the global buffer.
+    if (!sendDatagrams()) {
+        return false;
+    }
+
     // If remaining packets are present, save them in output buffer.
     if (packet_count > 0) {
         assert(_enforce_burst);
@@ -298,12 +316,29 @@ bool ts::IPOutputPlugin::send(const TSPacket* pkt, const TSPacketMetadata* pkt_d
 
 
 //----------------------------------------------------------------------------
-// Send contiguous packets in one single datagram.
+// Send the current batch of datagrams.
 //----------------------------------------------------------------------------
 
-bool ts::IPOutputPlugin::sendDatagram(const TSPacket* pkt, size_t packet_count)
+bool ts::IPOutputPlugin::sendDatagrams()
 {
-    bool status = true;
+    const size_t count = _msg_count;
+    _msg_count = 0;
+    return count == 0 || _sock.send(_messages.data(), count, *tsp);
+}
+
+
+//----------------------------------------------------------------------------
+// Add contiguous packets in one single datagram in the batch.
+//----------------------------------------------------------------------------
+
+bool ts::IPOutputPlugin::addDatagram(const TSPacket* pkt, size_t packet_count)
+{
+    // Send the current batch of datagrams when full.
+    if (_msg_count >= _messages.size() && !sendDatagrams()) {
+        return false;
+    }
+    assert(_msg_count < _messages.size());
+    UDPSocket::Message& msg(_messages[_msg_count++]);
 
     if (_use_rtp) {
         // RTP datagram are relatively trivial to build, except the time stamp.
@@ -315,8 +350,10 @@ bool ts::IPOutputPlugin::sendDatagram(const TSPacket* pkt, size_t packet_count)
         // Then keep this difference and resynchronize at each PCR.
         // But never jump back in RTP timestamps, only increase "more slowly" when adjusting.
 
-        // Build an RTP datagram. Use a simple RTP header without options nor extensions.
-        ByteBlock buffer(RTP_HEADER_SIZE + packet_count * PKT_SIZE);
+        // Build an RTP datagram in the slot of the message in the RTP buffer.
+        // Use a simple RTP header without options nor extensions.
+        assert(packet_count <= _pkt_burst);
+        uint8_t* const buffer = _rtp_buffer.data() + (_msg_count - 1) * (RTP_HEADER_SIZE + _pkt_burst * PKT_SIZE);
 
         // Build the RTP header, except the timestamp.
         buffer[0] = 0x80;             // Version = 2, P = 0, X = 0, CC = 0
@@ -391,17 +428,20 @@ bool ts::IPOutputPlugin::sendDatagram(const TSPacket* pkt, size_t packet_count)
         _last_rtp_pcr = rtp_pcr;
         _last_rtp_pcr_pkt = _pkt_count;
 
-        // Copy the TS packets after the RTP header and send the packets.
-        ::memcpy(buffer.data() + RTP_HEADER_SIZE, pkt, packet_count * PKT_SIZE);
-        status = _sock.send(buffer.data(), buffer.size(), *tsp);
+        // Copy the TS packets after the RTP header.
+        ::memcpy(buffer + RTP_HEADER_SIZE, pkt, packet_count * PKT_SIZE);
+        msg.data = buffer;
+        msg.size = RTP_HEADER_SIZE + packet_count * PKT_SIZE;
     }
     else {
-        // No RTP, send TS packets directly as datagram.
-        status = _sock.send(pkt, packet_count * PKT_SIZE, *tsp);
+        // No RTP, send TS packets directly as datagram, from the caller's buffer.
+        // The content of the message is not modified by the socket.
+        msg.data = const_cast<TSPacket*>(pkt);
+        msg.size = packet_count * PKT_SIZE;
     }
 
     // Count packets datagram per datagram.
     _pkt_count += packet_count;
 
-    return status;
+    return true;
 }
@@ -35,6 +35,7 @@
 #pragma once
 #include "tsPlugin.h"
 #include "tsUDPSocket.h"
+#include "tsByteBlock.h"
 
 namespace ts {
     //!
@@ -84,8 +85,14 @@ namespace ts {
         UDPSocket      _sock;               // Outgoing socket
         size_t         _out_count;          // Number of packets in _out_buffer
         TSPacketVector _out_buffer;         // Buffered packets for output with --enforce-burst
+        size_t         _msg_count;          // Number of datagrams in _messages
+        UDPSocket::MessageVector _messages; // Batch of datagrams to send
+        ByteBlock      _rtp_buffer;         // Buffer for the RTP datagrams in the batch
 
-        // Send contiguous packets in one single datagram.
-        bool sendDatagram(const TSPacket* pkt, size_t packet_count);
+        // Add contiguous packets in one single datagram in the batch of datagrams to send.
+        bool addDatagram(const TSPacket* pkt, size_t packet_count);
+
+        // Send the current batch of datagrams.
+        bool sendDatagrams();
     };
 }
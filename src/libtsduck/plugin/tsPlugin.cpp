@@ -110,6 +110,23 @@ ts::TSPacketMetadata::LabelSet ts::ProcessorPlugin::getOnlyLabelOption() const
 }
 
 
+//----------------------------------------------------------------------------
+// Default implementation of batch processing (packet processing plugins).
+//----------------------------------------------------------------------------
+
+size_t ts::ProcessorPlugin::processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, size_t count, Status* status)
+{
+    for (size_t i = 0; i < count; ++i) {
+        status[i] = processPacket(pkt[i], pkt_data[i]);
+        countPluginPackets(1);
+        if (status[i] == TSP_END) {
+            return i + 1;
+        }
+    }
+    return count;
+}
+
+
 //----------------------------------------------------------------------------
 // Default implementations of virtual methods.
 //----------------------------------------------------------------------------
@@ -40,6 +40,7 @@
 #include "tsTSPacketMetadata.h"
 #include "tsEnumeration.h"
 #include "tsDuckContext.h"
+#include <atomic>
 
 namespace ts {
 
@@ -106,7 +107,7 @@ namespace ts {
         //! @c int data named @c tspInterfaceVersion which contains the current
         //! interface version at the time the library is built.
         //!
-        static const int API_VERSION = 13;
+        static const int API_VERSION = 14;
 
         //!
         //! Get the current input bitrate in bits/seconds.
@@ -122,14 +123,14 @@ namespace ts {
         //! by the current plugin).
         //! @return The total number of packets in this plugin object.
         //!
-        PacketCounter pluginPackets() const { return _plugin_packets; }
+        PacketCounter pluginPackets() const { return _plugin_packets.load(std::memory_order_relaxed); }
 
         //!
         //! Get total number of packets in the execution of the plugin thread.
         //! This includes the number of extra stuffing or dropped packets.
         //! @return The total number of packets in this plugin thread.
         //!
-        PacketCounter totalPacketsInThread() const { return _total_packets; }
+        PacketCounter totalPacketsInThread() const { return _total_packets.load(std::memory_order_relaxed); }
 
         //!
         //! Check if the current plugin environment should use defaults for real-time.
@@ -206,17 +207,33 @@ namespace ts {
         //! Account for more processed packets in this plugin object.
         //! @param [in] incr Add this number of processed packets in the plugin object.
         //!
-        void addPluginPackets(size_t incr) {_plugin_packets += incr; _total_packets += incr;}
+        void addPluginPackets(size_t incr)
+        {
+            AddCounter(_plugin_packets, incr);
+            AddCounter(_total_packets, incr);
+        }
 
         //!
         //! Account for more processed packets in this plugin thread, but excluded from plugin object.
         //! @param [in] incr Add this number of processed packets in the plugin thread.
         //!
-        void addNonPluginPackets(size_t incr) {_total_packets += incr;}
+        void addNonPluginPackets(size_t incr) { AddCounter(_total_packets, incr); }
+
+        // Packet processing plugins report their processed packets in batch mode.
+        friend class ProcessorPlugin;
 
     private:
-        PacketCounter _total_packets;   // Total processed packets in the plugin thread.
-        PacketCounter _plugin_packets;  // Total processed packets in the plugin object.
+        // The packet counters are updated by the plugin thread only but can be read by
+        // other threads (statistics in the tsp control server). Since there is only one
+        // writer, the relaxed load and store are not slower than non-atomic operations.
+        std::atomic<PacketCounter> _total_packets;   // Total processed packets in the plugin thread.
+        std::atomic<PacketCounter> _plugin_packets;  // Total processed packets in the plugin object.
+
+        // Increment a counter from the plugin thread.
+        static void AddCounter(std::atomic<PacketCounter>& counter, size_t incr)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + incr, std::memory_order_relaxed);
+        }
     };
 
 
@@ -526,6 +543,31 @@ namespace ts {
         //!
         virtual Status processPacket(TSPacket& pkt, TSPacketMetadata& pkt_data) = 0;
 
+        //!
+        //! Packet processing interface for a batch of contiguous packets.
+        //!
+        //! The main application invokes processPacketBatch() with runs of contiguous
+        //! packets which must be submitted to the plugin. This is equivalent to invoking
+        //! processPacket() on each packet in sequence but avoids one virtual call per
+        //! packet for plugins which redefine it.
+        //!
+        //! The default implementation invokes processPacket() on each packet.
+        //! A subclass which redefines this method must keep the same semantics. Specifically,
+        //! the processing shall stop after the first packet which returns TSP_END and the
+        //! subclass shall call countPluginPackets() to declare its processed packets so that
+        //! tsp->pluginPackets() remains accurate, including inside the batch.
+        //!
+        //! @param [in,out] pkt Address of the first TS packet to process.
+        //! @param [in,out] pkt_data Address of the metadata of the first TS packet.
+        //! @param [in] count Number of packets to process.
+        //! @param [out] status Array of @a count processing status. On return, the first
+        //! entries receive the processing status of the corresponding packets.
+        //! @return The number of processed packets. This is @a count, unless a packet
+        //! returned TSP_END, in which case this is the number of packets up to (and
+        //! including) that packet.
+        //!
+        virtual size_t processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, size_t count, Status* status);
+
         //!
         //! Get the content of the --only-label options.
         //! The value of the option is fetched each time this method is called.
@@ -545,6 +587,13 @@ namespace ts {
         //! @param [in] syntax A short one-line syntax summary, eg. "[options] filename ...".
         //!
         ProcessorPlugin(TSP* tsp_, const UString& description = UString(), const UString& syntax = UString());
+
+        //!
+        //! Declare packets which were processed in processPacketBatch().
+        //! This updates the value of tsp->pluginPackets().
+        //! @param [in] count Number of processed packets.
+        //!
+        void countPluginPackets(size_t count) { tsp->addPluginPackets(count); }
     };
 
     //!
@@ -32,7 +32,8 @@ TSDUCK_SOURCE;
 
 ts::PluginOptions::PluginOptions(const ts::UString& name_, const UStringVector& args_) :
     name(name_),
-    args(args_)
+    args(args_),
+    cpus()
 {
 }
 
@@ -46,4 +47,5 @@ void ts::PluginOptions::clear()
 {
     name.clear();
     args.clear();
+    cpus.clear();
 }
@@ -34,6 +34,7 @@
 
 #pragma once
 #include "tsPlugin.h"
+#include "tsThreadAttributes.h"
 
 namespace ts {
     //!
@@ -64,6 +65,7 @@ namespace ts {
 
         UString       name;  //!< Plugin name.
         UStringVector args;  //!< Plugin options.
+        ThreadAttributes::CPUSet cpus;  //!< CPU affinity of the plugin thread, empty means any CPU.
     };
 
     //!
@@ -38,6 +38,8 @@ const ts::Enumeration ts::TSPControlCommand::ControlCommandEnum({
     {u"suspend", ts::TSPControlCommand::ControlCommand::CMD_SUSPEND},
     {u"resume",  ts::TSPControlCommand::ControlCommand::CMD_RESUME},
     {u"restart", ts::TSPControlCommand::ControlCommand::CMD_RESTART},
+    {u"stats",   ts::TSPControlCommand::ControlCommand::CMD_STATS},
+    {u"latency", ts::TSPControlCommand::ControlCommand::CMD_LATENCY},
 });
 
 
@@ -87,6 +89,29 @@ ts::TSPControlCommand::TSPControlCommand() :
     arg->help(u"same",
               u"Restart the plugin with the same options and parameters. "
               u"By default, when no plugin options are specified, restart with no option at all.");
+
+    arg = newCommand(CMD_STATS, u"Report statistics on all running plugins", u"[options]", Args::NO_VERBOSE);
+    arg->setIntro(u"Report statistics on all running plugins. For each plugin, the following values are reported: "
+                  u"the total number of packets which were processed in the plugin thread, the number of packets "
+                  u"which were actually passed to the plugin, the CPU time of the plugin thread, "
+                  u"the time during which the plugin thread waited for packets from the previous plugin "
+                  u"and the current number of packets in the area of the plugin in the global buffer. "
+                  u"For the input plugin, the wait time and the number of packets in the buffer are "
+                  u"related to the free space in the buffer. A plugin which uses most of its time in CPU "
+                  u"and rarely waits is the bottleneck of the processing chain.");
+
+    arg = newCommand(CMD_LATENCY, u"Control and report latency histograms on all plugins", u"[options]", Args::NO_VERBOSE);
+    arg->setIntro(u"Report the latency histograms of all running plugins. For each plugin, two histograms are "
+                  u"reported: the processing time of each batch of packets and the wait time of the plugin thread "
+                  u"before each batch. For the input and output plugins, the processing time is the duration of "
+                  u"the receive and send operations. The recording of the histograms is initially enabled using "
+                  u"the tsp option --latency-histograms.");
+    arg->option(u"reset");
+    arg->help(u"reset", u"Reset the latency histograms of all plugins after reporting them.");
+    arg->option(u"start");
+    arg->help(u"start", u"Start the recording of the latency histograms in all plugins.");
+    arg->option(u"stop");
+    arg->help(u"stop", u"Stop the recording of the latency histograms in all plugins.");
 }
 
 
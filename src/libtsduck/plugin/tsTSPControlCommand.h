@@ -63,6 +63,8 @@ namespace ts {
             CMD_SUSPEND,  //!< Suspend a plugin.
             CMD_RESUME,   //!< Resume a suspended plugin.
             CMD_RESTART,  //!< Restart a plugin with different parameters.
+            CMD_STATS,    //!< Report statistics on all plugins.
+            CMD_LATENCY,  //!< Control and report latency histograms on all plugins.
         };
 
         //!
@@ -40,6 +40,7 @@ const ts::TSPacketMetadata::LabelSet ts::TSPacketMetadata::AllLabels(~NoLabel);
 
 ts::TSPacketMetadata::TSPacketMetadata() :
     _labels(),
+    _input_time(0),
     _flush(false),
     _bitrate_changed(false),
     _input_stuffing(false),
@@ -55,6 +56,7 @@ ts::TSPacketMetadata::TSPacketMetadata() :
 void ts::TSPacketMetadata::reset()
 {
     _labels.reset();
+    _input_time = 0;
     _flush = false;
     _bitrate_changed = false;
     _input_stuffing = false;
@@ -194,12 +194,36 @@ namespace ts {
         //!
         void clearAllLabels() { _labels.reset(); }
 
+        //!
+        //! Set the input time stamp of the packet.
+        //! This is typically called by an input plugin when the reception time is known
+        //! with a better precision than the time of the plugin call (kernel time stamp for instance).
+        //! @param [in] time Input time stamp in nanoseconds, in the reference of Monotonic::CurrentNanoSeconds().
+        //! Zero means no time stamp.
+        //!
+        void setInputTimeStamp(NanoSecond time) { _input_time = time; }
+
+        //!
+        //! Get the input time stamp of the packet.
+        //! When the input plugin does not provide a time stamp, tsp sets the time of the input operation.
+        //! @return Input time stamp in nanoseconds, in the reference of Monotonic::CurrentNanoSeconds().
+        //! Zero means no time stamp.
+        //!
+        NanoSecond getInputTimeStamp() const { return _input_time; }
+
+        //!
+        //! Check if the packet has an input time stamp.
+        //! @return True if the packet has an input time stamp.
+        //!
+        bool hasInputTimeStamp() const { return _input_time != 0; }
+
     private:
-        LabelSet _labels;           // Bit mask of labels.
-        bool     _flush;            // Flush the packet buffer asap.
-        bool     _bitrate_changed;  // Call getBitrate() callback as soon as possible.
-        bool     _input_stuffing;   // Packet was artificially inserted as input stuffing.
-        bool     _nullified;        // Packet was explicitly turned into a null packet by a plugin.
+        LabelSet   _labels;           // Bit mask of labels.
+        NanoSecond _input_time;       // Input time stamp in nanoseconds, zero if unknown.
+        bool       _flush;            // Flush the packet buffer asap.
+        bool       _bitrate_changed;  // Call getBitrate() callback as soon as possible.
+        bool       _input_stuffing;   // Packet was artificially inserted as input stuffing.
+        bool       _nullified;        // Packet was explicitly turned into a null packet by a plugin.
     };
 
     //!
@@ -33,6 +33,7 @@
 #include "tstspProcessorExecutor.h"
 #include "tstspControlServer.h"
 #include "tsMonotonic.h"
+#include "tsSysInfo.h"
 #include "tsGuard.h"
 TSDUCK_SOURCE;
 
@@ -138,6 +139,11 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         // Clear errors on the report, used to check further initialisation errors.
         _report.resetErrors();
 
+        // Place plugin threads on adjacent cores when requested.
+        if (_args.auto_affinity) {
+            applyAutoAffinity();
+        }
+
         // Load all plugins and analyze their command line arguments.
         // The first plugin is always the input and the last one is the output.
         // The input thread has the highest priority to be always ready to load
@@ -145,10 +151,10 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         // plugin has a hight priority to make room in the buffer, but not as
         // high as the input which must remain the top-most priority?
 
-        _input = new tsp::InputExecutor(_args, _args.input, ThreadAttributes().setPriority(ts::ThreadAttributes::GetMaximumPriority()), _mutex, &_report);
+        _input = new tsp::InputExecutor(_args, _args.input, ThreadAttributes().setPriority(ts::ThreadAttributes::GetMaximumPriority()).setCPUAffinity(_args.input.cpus), _mutex, &_report);
         CheckNonNull(_input);
 
-        _output = new tsp::OutputExecutor(_args, _args.output, ThreadAttributes().setPriority(ts::ThreadAttributes::GetHighPriority()), _mutex, &_report);
+        _output = new tsp::OutputExecutor(_args, _args.output, ThreadAttributes().setPriority(ts::ThreadAttributes::GetHighPriority()).setCPUAffinity(_args.output.cpus), _mutex, &_report);
         CheckNonNull(_output);
 
         _output->ringInsertAfter(_input);
@@ -157,7 +163,7 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         bool realtime = _args.realtime == ts::TRUE || _input->isRealTime() || _output->isRealTime();
 
         for (auto it = _args.plugins.begin(); it != _args.plugins.end(); ++it) {
-            tsp::PluginExecutor* p = new tsp::ProcessorExecutor(_args, *it, ThreadAttributes(), _mutex, &_report);
+            tsp::PluginExecutor* p = new tsp::ProcessorExecutor(_args, *it, ThreadAttributes().setCPUAffinity(it->cpus), _mutex, &_report);
             CheckNonNull(p);
             p->ringInsertBefore(_output);
             realtime = realtime || p->isRealTime();
@@ -190,6 +196,12 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
             }
         } while ((proc = proc->ringNext<ts::tsp::PluginExecutor>()) != _input);
 
+        // When the input thread has a CPU affinity, temporarily run on the same CPUs to allocate the buffers.
+        // With the usual "first touch" memory policy, the memory pages are allocated on the NUMA node of
+        // the thread which first accesses them: here when locking or initializing them, or later the input thread.
+        ThreadAttributes::CPUSet previous_cpus;
+        const bool pinned = !_args.input.cpus.empty() && Thread::GetCPUAffinity(previous_cpus) && Thread::SetCPUAffinity(_args.input.cpus);
+
         // Allocate a memory-resident buffer of TS packets
         _packet_buffer = new PacketBuffer(_args.ts_buffer_size / ts::PKT_SIZE);
         CheckNonNull(_packet_buffer);
@@ -204,6 +216,11 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
         _metadata_buffer = new PacketMetadataBuffer(_packet_buffer->count());
         CheckNonNull(_metadata_buffer);
 
+        // Restore the CPU affinity of the current thread.
+        if (pinned) {
+            Thread::SetCPUAffinity(previous_cpus);
+        }
+
         // Start all processors, except output, in reverse order (input last).
         // Exit application in case of error.
         for (proc = _output->ringPrevious<tsp::PluginExecutor>(); proc != _output; proc = proc->ringPrevious<tsp::PluginExecutor>()) {
@@ -252,6 +269,53 @@ bool ts::TSProcessor::start(const TSProcessorArgs& args)
 }
 
 
+//----------------------------------------------------------------------------
+// Automatically set the CPU affinity of plugins without explicit affinity.
+//----------------------------------------------------------------------------
+
+void ts::TSProcessor::applyAutoAffinity()
+{
+    // Get the CPUs which are allowed for the process and their physical location.
+    ThreadAttributes::CPUSet allowed;
+    if (!Thread::GetCPUAffinity(allowed) || allowed.empty()) {
+        _report.warning(u"tsp: CPU affinity not supported on this system, --auto-affinity ignored");
+        return;
+    }
+    std::vector<SysInfo::CPULocation> locations;
+    SysInfo::Instance()->getCPULocations(locations, allowed);
+
+    // Build the list of CPUs in placement order: one hardware thread per physical core first,
+    // in order of package and core, so that adjacent plugins run on adjacent cores of the same
+    // package. The other hardware threads of each core are used only when there are more
+    // plugins than physical cores.
+    std::vector<size_t> order;
+    std::vector<size_t> others;
+    for (size_t i = 0; i < locations.size(); ++i) {
+        if (i > 0 && locations[i].package == locations[i-1].package && locations[i].core == locations[i-1].core) {
+            others.push_back(locations[i].cpu);
+        }
+        else {
+            order.push_back(locations[i].cpu);
+        }
+    }
+    order.insert(order.end(), others.begin(), others.end());
+
+    // Assign one CPU to each plugin without explicit affinity, in the order of the processing chain.
+    const size_t count = _args.plugins.size() + 2;
+    for (size_t index = 0; index < count; ++index) {
+        PluginOptions& opt(index == 0 ? _args.input : (index <= _args.plugins.size() ? _args.plugins[index - 1] : _args.output));
+        if (opt.cpus.empty()) {
+            opt.cpus.insert(order[index % order.size()]);
+        }
+        UStringList cpus;
+        for (auto it = opt.cpus.begin(); it != opt.cpus.end(); ++it) {
+            cpus.push_back(UString::Decimal(*it, 0, true, UString()));
+        }
+        _report.verbose(u"tsp: plugin %d (%s) on CPU %s", {index, opt.name, UString::Join(cpus, u",")});
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Check if the TS processing is started.
 //----------------------------------------------------------------------------
@@ -298,6 +362,12 @@ void ts::TSProcessor::waitForTermination()
         // Make sure the control server thread is terminated before deleting plugins.
         _control->close();
 
+        // Report the latency histograms of all plugins at the end of the processing.
+        if (_args.latency) {
+            ReportWithPrefix log(_report, u"latency: ");
+            _control->reportLatency(log);
+        }
+
         // Deallocate all plugins and plugin executor
         cleanupInternal();
     }
@@ -116,5 +116,8 @@ namespace ts {
 
         // Deallocate and cleanup internal resources.
         void cleanupInternal();
+
+        // Automatically set the CPU affinity of plugins without explicit affinity.
+        void applyAutoAffinity();
     };
 }
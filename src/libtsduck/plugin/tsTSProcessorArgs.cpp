@@ -35,6 +35,7 @@ TSDUCK_SOURCE;
 #if defined(TS_NEED_STATIC_CONST_DEFINITIONS)
 constexpr size_t ts::TSProcessorArgs::DEFAULT_BUFFER_SIZE;
 constexpr size_t ts::TSProcessorArgs::MIN_BUFFER_SIZE;
+constexpr size_t ts::TSProcessorArgs::MAX_CPU_INDEX;
 #endif
 
 #define DEF_BITRATE_INTERVAL               5  // seconds
@@ -54,6 +55,9 @@ ts::TSProcessorArgs::TSProcessorArgs() :
     app_name(),
     monitor(false),
     ignore_jt(false),
+    lock_free(false),
+    latency(false),
+    auto_affinity(false),
     ts_buffer_size(DEFAULT_BUFFER_SIZE),
     max_flush_pkt(0),
     max_input_pkt(0),
@@ -71,6 +75,7 @@ ts::TSProcessorArgs::TSProcessorArgs() :
     control_reuse(false),
     control_sources(),
     control_timeout(DEF_CONTROL_TIMEOUT),
+    stats_interval(0),
     input(),
     plugins(),
     output()
@@ -104,6 +109,26 @@ void ts::TSProcessorArgs::defineArgs(Args& args) const
               u"Specify that <count> null TS packets must be automatically inserted "
               u"at the end of the processing, after what comes from the input plugin.");
 
+    args.option(u"affinity", 0, Args::STRING, 0, Args::UNLIMITED_COUNT);
+    args.help(u"affinity", u"index:cpu-list",
+              u"Set the CPU affinity of the thread of a plugin. The plugin index is the same as "
+              u"in the control command \"list\": 0 for the input plugin, 1 for the first packet "
+              u"processing plugin, etc. The CPU list is a comma-separated list of logical CPU "
+              u"indexes or ranges, starting at zero. Example: --affinity 0:2 --affinity 1:3-4. "
+              u"When the input plugin has a CPU affinity, the global packet buffer is allocated "
+              u"on the same NUMA node as the input thread. "
+              u"Several --affinity options may be specified. The CPU affinity is supported on "
+              u"Linux and Windows only.");
+
+    args.option(u"auto-affinity");
+    args.help(u"auto-affinity",
+              u"Automatically set the CPU affinity of all plugin threads which have no explicit "
+              u"--affinity option. Adjacent plugins in the processing chain are placed on adjacent "
+              u"physical cores of the same processor package, so that the packets remain in the "
+              u"caches which are shared by these cores. Only the CPUs which are allowed for the "
+              u"tsp process are used. To run several tsp processes on the same system, allocate "
+              u"distinct CPU sets to each process, for instance using taskset on Linux.");
+
     args.option(u"bitrate", 'b', Args::POSITIVE);
     args.help(u"bitrate",
               u"Specify the input bitrate, in bits/seconds. By default, the input "
@@ -165,6 +190,23 @@ void ts::TSProcessorArgs::defineArgs(Args& args) const
               u"--ignore-joint-termination disables the termination of tsp when all "
               u"plugins have reached their joint termination condition.");
 
+    args.option(u"latency-histograms");
+    args.help(u"latency-histograms",
+              u"Record histograms of the processing time of each batch of packets and of the "
+              u"wait time between batches in all plugin threads. The histograms are reported "
+              u"in the log at the end of the processing. They can also be started, stopped "
+              u"and reported at any time using the control command \"latency\", "
+              u"see option --control-port. The recording overhead is a few nanoseconds per "
+              u"batch of packets and is compatible with high-bitrate streams.");
+
+    args.option(u"lock-free");
+    args.help(u"lock-free",
+              u"Pass packets between the plugin threads using lock-free atomic operations. "
+              u"A plugin thread without packets to process polls for a short time before "
+              u"sleeping. This reduces the latency between plugins and the contention on the "
+              u"global buffer lock when small values of --max-flushed-packets are used, at "
+              u"the expense of a slightly higher CPU usage.");
+
     args.option(u"receive-timeout", 0, Args::POSITIVE);
     args.help(u"receive-timeout", u"milliseconds",
               u"Specify a timeout in milliseconds for all input operations. "
@@ -201,6 +243,12 @@ void ts::TSProcessorArgs::defineArgs(Args& args) const
               u"are enforced. The explicit values 'no', 'false', 'off' are used to enforce "
               u"the offline defaults and the explicit values 'yes', 'true', 'on' are used "
               u"to enforce the real-time defaults.");
+
+    args.option(u"stats-interval", 0, Args::POSITIVE);
+    args.help(u"stats-interval", u"seconds",
+              u"Periodically report the statistics of all plugins in the log, "
+              u"every specified number of seconds. The reported values are the same "
+              u"as with the control command \"stats\", see option --control-port.");
 }
 
 
@@ -220,11 +268,15 @@ bool ts::TSProcessorArgs::loadArgs(DuckContext& duck, Args& args)
     instuff_start = args.intValue<size_t>(u"add-start-stuffing", 0);
     instuff_stop = args.intValue<size_t>(u"add-stop-stuffing", 0);
     ignore_jt = args.present(u"ignore-joint-termination");
+    lock_free = args.present(u"lock-free");
+    latency = args.present(u"latency-histograms");
+    auto_affinity = args.present(u"auto-affinity");
     realtime = args.tristateValue(u"realtime");
     receive_timeout = args.intValue<MilliSecond>(u"receive-timeout", 0);
     control_port = args.intValue<uint16_t>(u"control-port", 0);
     control_timeout = args.intValue<MilliSecond>(u"control-timeout", DEF_CONTROL_TIMEOUT);
     control_reuse = args.present(u"control-reuse-port");
+    stats_interval = MilliSecPerSec * args.intValue<MilliSecond>(u"stats-interval", 0);
 
     // Convert MB in MiB for buffer size for compatibility with original versions.
     ts_buffer_size = size_t((uint64_t(ts_buffer_size) * 1024 * 1024) / 1000000);
@@ -272,10 +324,68 @@ bool ts::TSProcessorArgs::loadArgs(DuckContext& duck, Args& args)
         plugins.clear();
     }
 
+    // Decode --affinity index:cpu-list, after loading the plugins.
+    input.cpus.clear();
+    output.cpus.clear();
+    for (size_t i = 0; i < args.count(u"affinity"); ++i) {
+        const UString value(args.value(u"affinity", u"", i));
+        const size_t colon = value.find(u':');
+        size_t index = 0;
+        ThreadAttributes::CPUSet cpus;
+        if (colon == NPOS || !value.substr(0, colon).toInteger(index) || !DecodeCPUList(cpus, value.substr(colon + 1))) {
+            args.error(u"invalid value for --affinity, use \"index:cpu-list\" format");
+        }
+        else if (index > plugins.size() + 1) {
+            args.error(u"invalid plugin index %d in --affinity, specify 0 to %d", {index, plugins.size() + 1});
+        }
+        else if (index == 0) {
+            input.cpus = cpus;
+        }
+        else if (index <= plugins.size()) {
+            plugins[index - 1].cpus = cpus;
+        }
+        else {
+            output.cpus = cpus;
+        }
+    }
+
     return args.valid();
 }
 
 
+//----------------------------------------------------------------------------
+// Decode a list of CPU indexes or ranges, "1,4-6".
+//----------------------------------------------------------------------------
+
+bool ts::TSProcessorArgs::DecodeCPUList(ThreadAttributes::CPUSet& cpus, const UString& list)
+{
+    cpus.clear();
+    UStringVector fields;
+    list.split(fields, u',', true, true);
+    for (auto it = fields.begin(); it != fields.end(); ++it) {
+        const size_t dash = it->find(u'-');
+        size_t first = 0;
+        size_t last = 0;
+        if (dash == NPOS) {
+            if (!it->toInteger(first)) {
+                return false;
+            }
+            last = first;
+        }
+        else if (!it->substr(0, dash).toInteger(first) || !it->substr(dash + 1).toInteger(last) || last < first) {
+            return false;
+        }
+        if (last > MAX_CPU_INDEX) {
+            return false;
+        }
+        for (size_t cpu = first; cpu <= last; ++cpu) {
+            cpus.insert(cpu);
+        }
+    }
+    return !cpus.empty();
+}
+
+
 //----------------------------------------------------------------------------
 // Apply default values to options which were not specified.
 //----------------------------------------------------------------------------
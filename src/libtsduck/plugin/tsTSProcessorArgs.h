@@ -48,6 +48,9 @@ namespace ts {
         UString         app_name;         //!< Application name, for help messages.
         bool            monitor;          //!< Run a resource monitoring thread.
         bool            ignore_jt;        //!< Ignore "joint termination" options in plugins.
+        bool            lock_free;        //!< Pass packets between plugin threads using lock-free operations.
+        bool            latency;          //!< Record latency histograms in all plugin threads.
+        bool            auto_affinity;    //!< Automatically set the CPU affinity of plugin threads without explicit affinity.
         size_t          ts_buffer_size;   //!< Size in bytes of the global TS packet buffer.
         size_t          max_flush_pkt;    //!< Max processed packets before flush.
         size_t          max_input_pkt;    //!< Max packets per input operation.
@@ -65,12 +68,14 @@ namespace ts {
         bool            control_reuse;    //!< Set the 'reuse port' socket option on the control TCP server port.
         IPAddressVector control_sources;  //!< Remote IP addresses which are allowed to send control commands.
         MilliSecond     control_timeout;  //!< Reception timeout in milliseconds for control commands.
+        MilliSecond     stats_interval;   //!< Interval between periodic statistics reports, zero if none.
         PluginOptions       input;        //!< Input plugin description.
         PluginOptionsVector plugins;      //!< Packet processor plugins descriptions.
         PluginOptions       output;       //!< Output plugin description.
 
         static constexpr size_t DEFAULT_BUFFER_SIZE = 16 * 1000000;  //!< Default size in bytes of global TS buffer.
         static constexpr size_t MIN_BUFFER_SIZE = 18800;             //!< Minimum size in bytes of global TS buffer.
+        static constexpr size_t MAX_CPU_INDEX = 4095;                //!< Maximum logical CPU index in option --affinity.
 
         //!
         //! Constructor.
@@ -86,5 +91,13 @@ namespace ts {
         //! @param [in] realtime If true, apply real-time defaults. If false, apply offline defaults.
         //!
         void applyDefaults(bool realtime);
+
+        //!
+        //! Decode a list of logical CPU indexes, as used in option --affinity.
+        //! @param [out] cpus Decoded set of CPU indexes.
+        //! @param [in] list Comma-separated list of CPU indexes or ranges, for instance "1,4-6".
+        //! @return True on success, false on invalid or empty list.
+        //!
+        static bool DecodeCPUList(ThreadAttributes::CPUSet& cpus, const UString& list);
     };
 }
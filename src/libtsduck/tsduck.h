@@ -282,6 +282,7 @@
 #include "tsjsonTrue.h"
 #include "tsjsonValue.h"
 #include "tsKeyTable.h"
+#include "tsLatencyHistogram.h"
 #include "tsLinkageDescriptor.h"
 #include "tsLNB.h"
 #include "tsLocalTimeOffsetDescriptor.h"
@@ -348,6 +349,7 @@
 #include "tsPESHandlerInterface.h"
 #include "tsPESPacket.h"
 #include "tsPIDOperator.h"
+#include "tsPIDTable.h"
 #include "tsPlatform.h"
 #include "tsPlugin.h"
 #include "tsPluginOptions.h"
@@ -391,6 +393,7 @@
 #include "tsSectionDemux.h"
 #include "tsSectionFile.h"
 #include "tsSectionHandlerInterface.h"
+#include "tsSectionPool.h"
 #include "tsSectionProviderInterface.h"
 #include "tsSelectionInformationTable.h"
 #include "tsService.h"
@@ -518,10 +521,12 @@
 #include "tsTSDT.h"
 #include "tsTSFile.h"
 #include "tsTSFileInputBuffered.h"
+#include "tsTSFileOutputAsync.h"
 #include "tsTSFileOutputResync.h"
 #include "tsTSPacket.h"
 #include "tsTSPacketMetadata.h"
 #include "tsTSPacketQueue.h"
+#include "tsTSPacketReader.h"
 #include "tsTSPControlCommand.h"
 #include "tsTSProcessor.h"
 #include "tsTSProcessorArgs.h"
@@ -36,16 +36,21 @@
 #include "tsPluginRepository.h"
 #include "tsTSAnalyzerReport.h"
 #include "tsTSSpeedMetrics.h"
+#include "tsMessageQueue.h"
+#include "tsThread.h"
 #include "tsSysUtils.h"
 TSDUCK_SOURCE;
 
+// Maximum number of pending snapshots, waiting to be reported.
+#define MAX_PENDING_REPORTS 4
+
 
 //----------------------------------------------------------------------------
 // Plugin definition
 //----------------------------------------------------------------------------
 
 namespace ts {
-    class AnalyzePlugin: public ProcessorPlugin
+    class AnalyzePlugin: public ProcessorPlugin, private Thread
     {
         TS_NOBUILD_NOCOPY(AnalyzePlugin);
     public:
@@ -57,22 +62,43 @@ namespace ts {
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
 
     private:
+        // Snapshots of the analysis are reported in a separate thread.
+        // A null pointer in the queue requests the termination of the thread.
+        typedef SafePtr<TSAnalyzerReport, Mutex> AnalyzerPtr;
+        typedef MessageQueue<TSAnalyzerReport, Mutex> SnapshotQueue;
+
         // Command line options:
         UString           _output_name;
+        UString           _cumulative_name;
         NanoSecond        _output_interval;
         bool              _multiple_output;
         TSAnalyzerOptions _analyzer_options;
 
         // Working data:
+        DuckContext       _report_duck;     // Execution context in the report thread.
         std::ofstream     _output_stream;
         std::ostream*     _output;
+        std::ofstream     _cumulative_stream;
         TSSpeedMetrics    _metrics;
         NanoSecond        _next_report;
         TSAnalyzerReport  _analyzer;
+        SnapshotQueue     _snapshots;       // Snapshots to report.
+        AnalyzerPtr       _previous;        // Previous cumulative snapshot (report thread only).
+        std::atomic<bool> _report_error;    // Set by the report thread on output error.
+
+        // Take a snapshot of the analysis.
+        TSAnalyzerReport* takeSnapshot();
 
-        bool openOutput();
-        void closeOutput();
-        bool produceReport();
+        // Produce the reports from a snapshot. Return true on success, false on error.
+        bool produceReports(const AnalyzerPtr& snapshot);
+        bool produceReport(TSAnalyzerReport& analyzer, const UString& name, std::ofstream& file, std::ostream& output);
+
+        // Create / close an output file. Return true on success, false on error.
+        bool openOutput(const UString& name, std::ofstream& file);
+        void closeOutput(const UString& name, std::ofstream& file);
+
+        // Implementation of Thread.
+        virtual void main() override;
     };
 }
 
@@ -86,27 +112,47 @@ TSPLUGIN_DECLARE_PROCESSOR(analyze, ts::AnalyzePlugin)
 
 ts::AnalyzePlugin::AnalyzePlugin(TSP* tsp_) :
     ProcessorPlugin(tsp_, u"Analyze the structure of a transport stream", u"[options]"),
+    Thread(),
     _output_name(),
+    _cumulative_name(),
     _output_interval(0),
     _multiple_output(false),
     _analyzer_options(),
+    _report_duck(tsp_),
     _output_stream(),
     _output(),
+    _cumulative_stream(),
     _metrics(),
     _next_report(0),
-    _analyzer(duck)
+    _analyzer(duck),
+    _snapshots(MAX_PENDING_REPORTS),
+    _previous(),
+    _report_error(false)
 {
     // Define all standard analysis options.
     duck.defineArgsForStandards(*this);
     duck.defineArgsForDVBCharset(*this);
     _analyzer_options.defineArgs(*this);
 
+    option(u"cumulative-file", 'c', STRING);
+    help(u"cumulative-file", u"filename",
+         u"With --interval, also produce a cumulative analysis since the beginning of the "
+         u"stream in the specified file, at the same time as each interval analysis. "
+         u"In that case, the analysis context is never reset. The interval reports "
+         u"contain the packet, error, section and bitrate statistics of the last interval "
+         u"but the structure of the stream (services, PID's, tables) is the one which is "
+         u"known since the beginning. "
+         u"With --multiple-files, the same naming rules apply to this file.");
+
     option(u"interval", 'i', POSITIVE);
     help(u"interval",
          u"Produce a new output file at regular intervals. "
          u"The interval value is in seconds. "
          u"After outputing a file, the analysis context is reset, "
-         u"ie. each output file contains a fully independent analysis.");
+         u"ie. each output file contains a fully independent analysis "
+         u"(unless --cumulative-file is specified). "
+         u"The reports are produced in a separate thread and do not slow down the "
+         u"processing of packets.");
 
     option(u"multiple-files", 'm');
     help(u"multiple-files",
@@ -129,10 +175,17 @@ ts::AnalyzePlugin::AnalyzePlugin(TSP* tsp_) :
 bool ts::AnalyzePlugin::getOptions()
 {
     duck.loadArgs(*this);
+    _report_duck.loadArgs(*this);
     _analyzer_options.loadArgs(duck, *this);
     _output_name = value(u"output-file");
+    _cumulative_name = value(u"cumulative-file");
     _output_interval = NanoSecPerSec * intValue<Second>(u"interval", 0);
     _multiple_output = present(u"multiple-files");
+
+    if (!_cumulative_name.empty() && _output_interval == 0) {
+        tsp->error(u"--cumulative-file requires --interval");
+        return false;
+    }
     return true;
 }
 
@@ -145,6 +198,9 @@ bool ts::AnalyzePlugin::start()
 {
     _output = _output_name.empty() ? &std::cout : &_output_stream;
     _analyzer.setAnalysisOptions(_analyzer_options);
+    _previous.clear();
+    _snapshots.clear();
+    _report_error.store(false, std::memory_order_relaxed);
 
     // For production of multiple reports at regular intervals.
     _metrics.start();
@@ -153,11 +209,12 @@ bool ts::AnalyzePlugin::start()
     // Create the output file. Note that this file is used only in the stop
     // method and could be created there. However, if the file cannot be
     // created, we do not want to wait all along the analysis and finally fail.
-    if (_output_interval == 0 && !openOutput()) {
-        return false;
+    if (_output_interval == 0) {
+        return openOutput(_output_name, _output_stream);
     }
 
-    return true;
+    // With --interval, the reports are produced in a separate thread.
+    return Thread::start();
 }
 
 
@@ -165,10 +222,10 @@ bool ts::AnalyzePlugin::start()
 // Create an output file. Return true on success, false on error.
 //----------------------------------------------------------------------------
 
-bool ts::AnalyzePlugin::openOutput()
+bool ts::AnalyzePlugin::openOutput(const UString& file_name, std::ofstream& file)
 {
     // Standard output is always open. Also do not reopen an open file.
-    if (_output_name.empty() || _output_stream.is_open()) {
+    if (file_name.empty() || file.is_open()) {
         return true;
     }
 
@@ -176,15 +233,15 @@ bool ts::AnalyzePlugin::openOutput()
     UString name;
     if (_multiple_output) {
         const Time::Fields now(Time::CurrentLocalTime());
-        name = UString::Format(u"%s_%04d%02d%02d_%02d%02d%02d%s", {PathPrefix(_output_name), now.year, now.month, now.day, now.hour, now.minute, now.second, PathSuffix(_output_name)});
+        name = UString::Format(u"%s_%04d%02d%02d_%02d%02d%02d%s", {PathPrefix(file_name), now.year, now.month, now.day, now.hour, now.minute, now.second, PathSuffix(file_name)});
     }
     else {
-        name = _output_name;
+        name = file_name;
     }
 
     // Create the file
-    _output_stream.open(name.toUTF8().c_str());
-    if (_output_stream) {
+    file.open(name.toUTF8().c_str());
+    if (file) {
         return true;
     }
     else {
@@ -198,42 +255,103 @@ bool ts::AnalyzePlugin::openOutput()
 // Close current output file.
 //----------------------------------------------------------------------------
 
-void ts::AnalyzePlugin::closeOutput()
+void ts::AnalyzePlugin::closeOutput(const UString& file_name, std::ofstream& file)
 {
-    if (!_output_name.empty() && _output_stream.is_open()) {
-        _output_stream.close();
+    if (!file_name.empty() && file.is_open()) {
+        file.close();
     }
 }
 
 
 //----------------------------------------------------------------------------
-// Produce a report. Return true on success, false on error.
+// Take a snapshot of the analysis.
 //----------------------------------------------------------------------------
 
-bool ts::AnalyzePlugin::produceReport()
+ts::TSAnalyzerReport* ts::AnalyzePlugin::takeSnapshot()
 {
-    if (!openOutput()) {
-        return false;
+    // Set last known input bitrate as hint
+    _analyzer.setBitrateHint(tsp->bitrate());
+
+    TSAnalyzerReport* snapshot = new TSAnalyzerReport(_report_duck);
+    snapshot->setAnalysisOptions(_analyzer_options);
+    _analyzer.getSnapshot(*snapshot);
+    return snapshot;
+}
+
+
+//----------------------------------------------------------------------------
+// Produce the reports from a snapshot. Return true on success, false on error.
+//----------------------------------------------------------------------------
+
+bool ts::AnalyzePlugin::produceReports(const AnalyzerPtr& snapshot)
+{
+    if (_cumulative_name.empty()) {
+        // Independent analysis for each report.
+        return produceReport(*snapshot, _output_name, _output_stream, *_output);
     }
     else {
-        // Set last known input bitrate as hint
-        _analyzer.setBitrateHint(tsp->bitrate());
+        // Cumulative analysis since the beginning.
+        bool ok = produceReport(*snapshot, _cumulative_name, _cumulative_stream, _cumulative_stream);
+
+        // Interval analysis: difference with the previous cumulative snapshot.
+        TSAnalyzerReport interval(_report_duck);
+        interval.setAnalysisOptions(_analyzer_options);
+        snapshot->getSnapshot(interval);
+        if (!_previous.isNull()) {
+            interval.subtractSnapshot(*_previous);
+        }
+        _previous = snapshot;
+        return produceReport(interval, _output_name, _output_stream, *_output) && ok;
+    }
+}
 
-        // Produce the report
-        _analyzer.report(*_output, _analyzer_options);
-        closeOutput();
+bool ts::AnalyzePlugin::produceReport(TSAnalyzerReport& analyzer, const UString& name, std::ofstream& file, std::ostream& output)
+{
+    if (!openOutput(name, file)) {
+        return false;
+    }
+    else {
+        analyzer.report(output, _analyzer_options);
+        closeOutput(name, file);
         return true;
     }
 }
 
 
+//----------------------------------------------------------------------------
+// Report thread: produce the reports from the snapshots of the analysis.
+//----------------------------------------------------------------------------
+
+void ts::AnalyzePlugin::main()
+{
+    tsp->debug(u"report thread started");
+
+    SnapshotQueue::MessagePtr snapshot;
+    while (_snapshots.dequeue(snapshot) && !snapshot.isNull()) {
+        if (!produceReports(snapshot)) {
+            _report_error.store(true, std::memory_order_release);
+        }
+    }
+
+    tsp->debug(u"report thread terminated");
+}
+
+
 //----------------------------------------------------------------------------
 // Stop method
 //----------------------------------------------------------------------------
 
 bool ts::AnalyzePlugin::stop()
 {
-    produceReport();
+    // Wait for the completion of all pending reports.
+    if (_output_interval > 0) {
+        _snapshots.forceEnqueue(static_cast<TSAnalyzerReport*>(nullptr));
+        Thread::waitForTermination();
+    }
+
+    // Final report.
+    produceReports(AnalyzerPtr(takeSnapshot()));
+    _previous.clear();
     return true;
 }
 
@@ -249,12 +367,20 @@ ts::ProcessorPlugin::Status ts::AnalyzePlugin::processPacket(TSPacket& pkt, TSPa
 
     // With --interval, check if it is time to produce a report
     if (_output_interval > 0 && _metrics.processedPacket() && _metrics.sessionNanoSeconds() >= _next_report) {
-        // Time to produce a report.
-        if (!produceReport()) {
+        // Stop on previous report error.
+        if (_report_error.load(std::memory_order_acquire)) {
             return TSP_END;
         }
-        // Reset analysis context.
-        _analyzer.reset();
+        // Time to produce a report. The snapshot is reported in the report thread.
+        // Never wait: if the report thread is late, drop this snapshot.
+        SnapshotQueue::MessagePtr snapshot(takeSnapshot());
+        if (!_snapshots.enqueue(snapshot, 0)) {
+            tsp->warning(u"analysis reports are late, dropping one report");
+        }
+        // Reset analysis context, unless cumulative reports are required.
+        if (_cumulative_name.empty()) {
+            _analyzer.reset();
+        }
         // Compute next report time.
         _next_report += _output_interval;
     }
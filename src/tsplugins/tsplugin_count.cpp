@@ -54,6 +54,7 @@ namespace ts {
         virtual bool start() override;
         virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t processPacketBatch(TSPacket*, TSPacketMetadata*, size_t, Status*) override;
 
     private:
         // This structure is used at each --interval.
@@ -324,3 +325,28 @@ ts::ProcessorPlugin::Status ts::CountPlugin::processPacket(TSPacket& pkt, TSPack
 
     return TSP_OK;
 }
+
+
+//----------------------------------------------------------------------------
+// Batch packet processing method
+//----------------------------------------------------------------------------
+
+size_t ts::CountPlugin::processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, size_t count, Status* status)
+{
+    if (_report_all || _report_interval > 0) {
+        // Per-packet reporting uses the packet index, use the generic packet by packet processing.
+        return ProcessorPlugin::processPacketBatch(pkt, pkt_data, count, status);
+    }
+    else {
+        // Fast path: only count the packets.
+        for (size_t i = 0; i < count; ++i) {
+            const PID pid = pkt[i].getPID();
+            if (_pids[pid] != _negate) {
+                _counters[pid]++;
+            }
+            status[i] = TSP_OK;
+        }
+        countPluginPackets(count);
+        return count;
+    }
+}
@@ -65,6 +65,14 @@ ts::DropOutput::DropOutput(TSP* tsp_) :
 {
 }
 
+
+//----------------------------------------------------------------------------
+// Output method.
+// This is an output plugin, it does not use processPacketBatch(): the
+// packets are already passed by blocks and the whole block is dropped at
+// once. Packets are dropped in the chain by processors such as "filter".
+//----------------------------------------------------------------------------
+
 bool ts::DropOutput::send(const TSPacket*, const TSPacketMetadata* pkt_data, size_t)
 {
     return true;
@@ -53,6 +53,7 @@ namespace ts {
         virtual bool start() override;
         virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t processPacketBatch(TSPacket*, TSPacketMetadata*, size_t, Status*) override;
 
     private:
         // Packet intervals and list of them.
@@ -488,3 +489,22 @@ ts::ProcessorPlugin::Status ts::FilterPlugin::processPacket(TSPacket& pkt, TSPac
 
     return ok ? TSP_OK : _drop_status;
 }
+
+
+//----------------------------------------------------------------------------
+// Batch packet processing method
+//----------------------------------------------------------------------------
+
+size_t ts::FilterPlugin::processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, size_t count, Status* status)
+{
+    // Same processing as processPacket() without one virtual call per packet.
+    // The packet index is used in processPacket(), count packets one by one.
+    for (size_t i = 0; i < count; ++i) {
+        status[i] = FilterPlugin::processPacket(pkt[i], pkt_data[i]);
+        countPluginPackets(1);
+        if (status[i] == TSP_END) {
+            return i + 1;
+        }
+    }
+    return count;
+}
@@ -52,6 +52,7 @@ namespace ts {
         virtual bool start() override;
         virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t processPacketBatch(TSPacket*, TSPacketMetadata*, size_t, Status*) override;
 
     private:
         // Description of one PID
@@ -279,3 +280,19 @@ ts::ProcessorPlugin::Status ts::PCRVerifyPlugin::processPacket(TSPacket& pkt, TS
 
     return TSP_OK;
 }
+
+
+//----------------------------------------------------------------------------
+// Batch packet processing method
+//----------------------------------------------------------------------------
+
+size_t ts::PCRVerifyPlugin::processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, size_t count, Status* status)
+{
+    // Same processing as processPacket() without one virtual call per packet.
+    // This plugin never returns TSP_END and never uses tsp->pluginPackets().
+    for (size_t i = 0; i < count; ++i) {
+        status[i] = PCRVerifyPlugin::processPacket(pkt[i], pkt_data[i]);
+    }
+    countPluginPackets(count);
+    return count;
+}
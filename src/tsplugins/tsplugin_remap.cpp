@@ -59,6 +59,7 @@ namespace ts {
         virtual bool getOptions() override;
         virtual bool start() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t processPacketBatch(TSPacket*, TSPacketMetadata*, size_t, Status*) override;
 
     private:
         typedef SafePtr<CyclingPacketizer, NullMutex> CyclingPacketizerPtr;
@@ -299,3 +300,23 @@ ts::ProcessorPlugin::Status ts::RemapPlugin::processPacket(TSPacket& pkt, TSPack
 
     return TSP_OK;
 }
+
+
+//----------------------------------------------------------------------------
+// Batch packet processing method
+//----------------------------------------------------------------------------
+
+size_t ts::RemapPlugin::processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, size_t count, Status* status)
+{
+    // Same processing as processPacket() without one virtual call per packet.
+    // This plugin never uses tsp->pluginPackets(), processed packets are counted at once.
+    size_t i = 0;
+    while (i < count) {
+        status[i] = RemapPlugin::processPacket(pkt[i], pkt_data[i]);
+        if (status[i++] == TSP_END) {
+            break;
+        }
+    }
+    countPluginPackets(i);
+    return i;
+}
@@ -105,6 +105,7 @@ namespace ts {
         virtual bool start() override;
         virtual bool stop() override;
         virtual Status processPacket(TSPacket&, TSPacketMetadata&) override;
+        virtual size_t processPacketBatch(TSPacket*, TSPacketMetadata*, size_t, Status*) override;
 
     private:
         // Description of a crypto-period.
@@ -196,6 +197,9 @@ namespace ts {
         size_t            _current_ecm;         // Index to current ECM (ECM being broadcast)
         TSScrambling      _scrambling;          // Scrambler
         CyclingPacketizer _pzer_pmt;            // Packetizer for modified PMT
+        bool              _in_batch;            // Currently processing a batch of packets
+        std::vector<TSPacket*> _batch_pkts;     // Packets to scramble at end of batch
+        TSPacket*         _batch_error;         // First packet which could not be scrambled in batch
 
         // Return current/next CryptoPeriod for CW or ECM
         CryptoPeriod& currentCW()  { return _cp[_current_cw]; }
@@ -210,6 +214,9 @@ namespace ts {
         // Check if we are in degraded mode or if we enter degraded mode
         bool inDegradedMode();
 
+        // Scramble all packets which were collected in the current batch.
+        bool scrambleBatch();
+
         // Try to exit from degraded mode
         bool tryExitDegradedMode();
 
@@ -266,7 +273,10 @@ ts::ScramblerPlugin::ScramblerPlugin(TSP* tsp_) :
     _current_cw(0),
     _current_ecm(0),
     _scrambling(*tsp),
-    _pzer_pmt()
+    _pzer_pmt(),
+    _in_batch(false),
+    _batch_pkts(),
+    _batch_error(nullptr)
 {
     option(u"", 0, STRING, 0, 1);
     help(u"",
@@ -681,6 +691,11 @@ bool ts::ScramblerPlugin::tryExitDegradedMode()
 
 bool ts::ScramblerPlugin::changeCW()
 {
+    // In batch mode, scramble pending packets with the previous CW first.
+    if (!scrambleBatch()) {
+        return false;
+    }
+
     if (_scrambling.hasFixedCW()) {
         // A list of fixed CW was loaded from a file.
 
@@ -846,8 +861,11 @@ ts::ProcessorPlugin::Status ts::ScramblerPlugin::processPacket(TSPacket& pkt, TS
         _partial_clear = _partial_scrambling - 1;
     }
 
-    // Scramble the packet payload.
-    if (!_scrambling.encrypt(pkt)) {
+    // Scramble the packet payload. In batch mode, packets are scrambled together later.
+    if (_in_batch) {
+        _batch_pkts.push_back(&pkt);
+    }
+    else if (!_scrambling.encrypt(pkt)) {
         return TSP_END;
     }
     _scrambled_count++;
@@ -856,6 +874,51 @@ ts::ProcessorPlugin::Status ts::ScramblerPlugin::processPacket(TSPacket& pkt, TS
 }
 
 
+//----------------------------------------------------------------------------
+// Batch packet processing method
+//----------------------------------------------------------------------------
+
+size_t ts::ScramblerPlugin::processPacketBatch(TSPacket* pkt, TSPacketMetadata* pkt_data, size_t count, Status* status)
+{
+    // Same processing as processPacket() but the packets to scramble are collected
+    // and scrambled together, at end of batch or before the next CW change.
+    _in_batch = true;
+    _batch_error = nullptr;
+    size_t processed = 0;
+    while (processed < count) {
+        status[processed] = ScramblerPlugin::processPacket(pkt[processed], pkt_data[processed]);
+        if (status[processed++] == TSP_END) {
+            break;
+        }
+    }
+    _in_batch = false;
+    scrambleBatch();
+
+    // In case of scrambling error, stop at the first packet which was not scrambled.
+    if (_batch_error != nullptr) {
+        processed = size_t(_batch_error - pkt) + 1;
+        status[processed - 1] = TSP_END;
+    }
+    countPluginPackets(processed);
+    return processed;
+}
+
+
+//----------------------------------------------------------------------------
+// Scramble all packets which were collected in the current batch.
+//----------------------------------------------------------------------------
+
+bool ts::ScramblerPlugin::scrambleBatch()
+{
+    const bool ok = _batch_pkts.empty() || _scrambling.encrypt(_batch_pkts.data(), _batch_pkts.size());
+    if (!ok && _batch_error == nullptr) {
+        _batch_error = _batch_pkts.front();
+    }
+    _batch_pkts.clear();
+    return ok;
+}
+
+
 //----------------------------------------------------------------------------
 // CryptoPeriod default constructor.
 //----------------------------------------------------------------------------
@@ -34,11 +34,24 @@
 #include "tsMain.h"
 #include "tsTSAnalyzerReport.h"
 #include "tsTSAnalyzerOptions.h"
-#include "tsInputRedirector.h"
+#include "tsTSFile.h"
 #include "tsPagerArgs.h"
+#include "tsThread.h"
+#include "tsSysUtils.h"
+#include "tsMutex.h"
+#include "tsGuard.h"
 TSDUCK_SOURCE;
 TS_MAIN(MainCode);
 
+// Number of packets to read at a time.
+#define READ_PACKETS 10000
+
+// Default number of warm-up packets before each chunk in parallel analysis.
+#define DEFAULT_WARMUP_PACKETS 200000
+
+// Minimum number of packets per chunk in parallel analysis.
+#define MIN_CHUNK_PACKETS 100000
+
 
 //----------------------------------------------------------------------------
 //  Command line options
@@ -53,6 +66,8 @@ public:
 
     ts::DuckContext       duck;      // TSDuck execution context.
     ts::BitRate           bitrate;   // Expected bitrate (188-byte packets)
+    size_t                threads;   // Number of analysis threads.
+    ts::PacketCounter     warmup;    // Number of warm-up packets before each chunk.
     ts::UString           infile;    // Input file name
     ts::TSAnalyzerOptions analysis;  // Analysis options.
     ts::PagerArgs         pager;     // Output paging options.
@@ -62,6 +77,8 @@ Options::Options(int argc, char *argv[]) :
     ts::Args(u"Analyze the structure of a transport stream", u"[options] [filename]"),
     duck(this),
     bitrate(0),
+    threads(1),
+    warmup(0),
     infile(),
     analysis(),
     pager(true, true)
@@ -81,6 +98,21 @@ Options::Options(int argc, char *argv[]) :
          u"(based on 188-byte packets). By default, the bitrate is "
          u"evaluated using the PCR in the transport stream.");
 
+    option(u"threads", 't', POSITIVE);
+    help(u"threads",
+         u"Analyze the input file in parallel using the specified number of threads. "
+         u"The file is split into contiguous chunks which are analyzed independently "
+         u"and the results are merged. The input must be a regular file. "
+         u"The default is 1, the file is sequentially analyzed.");
+
+    option(u"warm-up-packets", 0, UNSIGNED);
+    help(u"warm-up-packets",
+         u"With --threads, specify the number of packets which are analyzed before the "
+         u"start of each chunk, to collect the PSI structure and the state of continuity "
+         u"counters and PCR's. The merged analysis is identical to a sequential analysis "
+         u"when this sequence contains all PSI and at least one packet of each PID. "
+         u"The default is " TS_USTRINGIFY(DEFAULT_WARMUP_PACKETS) u" packets.");
+
     analyze(argc, argv);
 
     // Define all standard analysis options.
@@ -90,6 +122,12 @@ Options::Options(int argc, char *argv[]) :
 
     infile = value(u"");
     bitrate = intValue<ts::BitRate>(u"bitrate");
+    threads = intValue<size_t>(u"threads", 1);
+    warmup = intValue<ts::PacketCounter>(u"warm-up-packets", DEFAULT_WARMUP_PACKETS);
+
+    if (threads > 1 && infile.empty()) {
+        error(u"--threads cannot be used on standard input");
+    }
 
     exitOnError();
 }
@@ -99,6 +137,223 @@ Options::~Options()
 }
 
 
+//----------------------------------------------------------------------------
+//  A report which can be used by all analysis threads.
+//----------------------------------------------------------------------------
+
+class ThreadSafeReport: public ts::Report
+{
+    TS_NOBUILD_NOCOPY(ThreadSafeReport);
+public:
+    ThreadSafeReport(ts::Report& report) : ts::Report(report.maxSeverity()), _mutex(), _report(report) {}
+protected:
+    virtual void writeLog(int severity, const ts::UString& msg) override
+    {
+        ts::Guard lock(_mutex);
+        _report.log(severity, msg);
+    }
+private:
+    ts::Mutex   _mutex;
+    ts::Report& _report;
+};
+
+
+//----------------------------------------------------------------------------
+//  Analysis of one chunk of the file, in a separate thread.
+//----------------------------------------------------------------------------
+
+class AnalysisChunk: private ts::Thread
+{
+    TS_NOBUILD_NOCOPY(AnalysisChunk);
+public:
+    // Constructor: analyze packets from index start (included) to end (excluded).
+    AnalysisChunk(Options& opt, ts::Report& log, ts::PacketCounter start, ts::PacketCounter end);
+    virtual ~AnalysisChunk() override;
+
+    // Start and wait for the analysis.
+    using ts::Thread::start;
+    using ts::Thread::waitForTermination;
+
+    // Results, after termination.
+    bool success() const { return _success; }
+    bool syncLost() const { return _sync_lost != ts::INVALID_PACKET_COUNTER; }
+    const ts::TSAnalyzer& result() const { return _result; }
+
+private:
+    const Options&          _opt;
+    ts::Report&             _log;
+    ts::DuckContext         _duck;
+    ts::TSAnalyzerReport    _analyzer;
+    ts::TSAnalyzerReport    _warmup_end;
+    ts::TSAnalyzerReport    _result;
+    const ts::PacketCounter _warmup_start;
+    const ts::PacketCounter _start;
+    const ts::PacketCounter _end;
+    ts::PacketCounter       _sync_lost;
+    bool                    _success;
+
+    // Analyze packets until the specified index. Return false on error or synchronization loss.
+    bool feed(ts::TSFile& file, ts::PacketCounter& index, ts::PacketCounter end);
+
+    // Implementation of Thread.
+    virtual void main() override;
+};
+
+AnalysisChunk::AnalysisChunk(Options& opt, ts::Report& log, ts::PacketCounter start, ts::PacketCounter end) :
+    _opt(opt),
+    _log(log),
+    _duck(&log),
+    _analyzer(_duck, opt.bitrate),
+    _warmup_end(_duck),
+    _result(_duck),
+    _warmup_start(start > opt.warmup ? start - opt.warmup : 0),
+    _start(start),
+    _end(end),
+    _sync_lost(ts::INVALID_PACKET_COUNTER),
+    _success(false)
+{
+    // Each thread needs its own context, loaded from the command line, in the main thread.
+    _duck.loadArgs(opt);
+    _analyzer.setAnalysisOptions(opt.analysis);
+}
+
+AnalysisChunk::~AnalysisChunk()
+{
+    waitForTermination();
+}
+
+void AnalysisChunk::main()
+{
+    ts::TSFile file;
+    ts::PacketCounter index = _warmup_start;
+
+    file.setMemoryMapped(true);
+    if (!file.openRead(_opt.infile, 0, _log) || !file.seek(_warmup_start, _log)) {
+        return;
+    }
+
+    // Analyze the warm-up packets, before the chunk, to start the chunk in the same state as a
+    // sequential analysis. A synchronization loss here is reported by the previous chunk.
+    _analyzer.setPacketIndex(_warmup_start);
+    _success = feed(file, index, _start);
+    if (_success && _start > _warmup_start) {
+        _analyzer.getSnapshot(_warmup_end);
+    }
+
+    // Analyze the chunk. The result is the difference with the state at end of warm-up.
+    if (_success || syncLost()) {
+        _success = feed(file, index, _end) || syncLost();
+        _analyzer.getSnapshot(_result);
+        if (_start > _warmup_start) {
+            _result.subtractSnapshot(_warmup_end);
+        }
+    }
+    file.close(_log);
+}
+
+bool AnalysisChunk::feed(ts::TSFile& file, ts::PacketCounter& index, ts::PacketCounter end)
+{
+    const ts::TSPacket* pkt = nullptr;
+    size_t count = 0;
+    while (!syncLost() && index < end && (count = file.readInPlace(pkt, size_t(std::min<ts::PacketCounter>(READ_PACKETS, end - index)), _log)) > 0) {
+        for (size_t i = 0; i < count; ++i, ++index) {
+            if (pkt[i].hasValidSync()) {
+                _analyzer.feedPacket(pkt[i]);
+            }
+            else {
+                _sync_lost = index;
+                if (index >= _start) {
+                    _log.error(u"synchronization lost after %'d packets, got 0x%X instead of 0x%X at start of TS packet", {index, pkt[i].b[0], ts::SYNC_BYTE});
+                }
+                return false;
+            }
+        }
+    }
+    return index >= end;
+}
+
+
+//----------------------------------------------------------------------------
+//  Parallel analysis of a file.
+//----------------------------------------------------------------------------
+
+namespace {
+    bool SequentialAnalysis(Options& opt, ts::TSAnalyzer& analyzer)
+    {
+        // Open the input file. Regular files are memory mapped and analyzed without copy.
+        ts::TSFile file;
+        file.setMemoryMapped(true);
+        if (!file.openRead(opt.infile, 1, 0, opt)) {
+            return false;
+        }
+
+        // Read input file and perform analysis.
+        const ts::TSPacket* pkt = nullptr;
+        size_t count = 0;
+        bool sync = true;
+        while (sync && (count = file.readInPlace(pkt, READ_PACKETS, opt)) > 0) {
+            for (size_t i = 0; sync && i < count; ++i) {
+                if (pkt[i].hasValidSync()) {
+                    analyzer.feedPacket(pkt[i]);
+                }
+                else {
+                    opt.error(u"synchronization lost after %'d packets, got 0x%X instead of 0x%X at start of TS packet", {file.getReadCount() - count + i, pkt[i].b[0], ts::SYNC_BYTE});
+                    sync = false;
+                }
+            }
+        }
+        file.close(opt);
+        return true;
+    }
+
+    bool ParallelAnalysis(Options& opt, ts::TSAnalyzer& analyzer)
+    {
+        // Split the file into chunks of packets.
+        const int64_t file_size = ts::GetFileSize(opt.infile);
+        if (file_size < 0) {
+            opt.error(u"cannot get size of %s", {opt.infile});
+            return false;
+        }
+        const ts::PacketCounter total = ts::PacketCounter(file_size) / ts::PKT_SIZE;
+        const size_t count = size_t(std::max<ts::PacketCounter>(1, std::min<ts::PacketCounter>(opt.threads, total / MIN_CHUNK_PACKETS)));
+        opt.verbose(u"analyzing %'d packets in %d chunks", {total, count});
+
+        // Analyze all chunks in parallel.
+        ThreadSafeReport log(opt);
+        std::vector<ts::SafePtr<AnalysisChunk>> chunks(count);
+        for (size_t i = 0; i < count; ++i) {
+            chunks[i] = new AnalysisChunk(opt, log, (total * i) / count, (total * (i + 1)) / count);
+        }
+        bool started = true;
+        for (size_t i = 0; started && i < count; ++i) {
+            started = chunks[i]->start();
+        }
+        for (size_t i = 0; i < count; ++i) {
+            chunks[i]->waitForTermination();
+        }
+
+        // If a thread cannot be started, the analyzer was not modified yet, fall back to a sequential analysis.
+        if (!started) {
+            opt.error(u"cannot start analysis thread");
+            opt.verbose(u"analyzing %s sequentially", {opt.infile});
+            return SequentialAnalysis(opt, analyzer);
+        }
+
+        // Merge the results, in order, up to the first synchronization loss.
+        for (size_t i = 0; i < count; ++i) {
+            if (!chunks[i]->success()) {
+                return false;
+            }
+            analyzer.appendAnalysis(chunks[i]->result());
+            if (chunks[i]->syncLost()) {
+                break;
+            }
+        }
+        return true;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 //  Program entry point
 //----------------------------------------------------------------------------
@@ -107,14 +362,11 @@ int MainCode(int argc, char *argv[])
 {
     Options opt(argc, argv);
     ts::TSAnalyzerReport analyzer(opt.duck, opt.bitrate);
-    ts::InputRedirector input(opt.infile, opt);
-    ts::TSPacket pkt;
-
     analyzer.setAnalysisOptions(opt.analysis);
 
-    // Read input file and perform analysis.
-    while (pkt.read(std::cin, true, opt)) {
-        analyzer.feedPacket(pkt);
+    // Perform the analysis.
+    if (opt.threads > 1 ? !ParallelAnalysis(opt, analyzer) : !SequentialAnalysis(opt, analyzer)) {
+        return EXIT_FAILURE;
     }
 
     // Report analysis.
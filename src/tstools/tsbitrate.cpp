@@ -32,8 +32,8 @@
 //----------------------------------------------------------------------------
 
 #include "tsMain.h"
-#include "tsInputRedirector.h"
 #include "tsPCRAnalyzer.h"
+#include "tsTSPacketReader.h"
 TSDUCK_SOURCE;
 TS_MAIN(MainCode);
 
@@ -136,8 +136,7 @@ int MainCode(int argc, char *argv[])
 {
     Options opt(argc, argv);
     ts::PCRAnalyzer zer(opt.min_pid, opt.min_pcr);
-    ts::InputRedirector input(opt.infile, opt);
-    ts::TSPacket pkt;
+    ts::TSPacketReader input;
 
     // Configure the PCR analyzer.
     zer.setIgnoreErrors(opt.ignore_errors);
@@ -146,7 +145,11 @@ int MainCode(int argc, char *argv[])
     }
 
     // Read all packets in the file and pass them to the PCR analyzer.
-    while (pkt.read(std::cin, true, opt) && (!zer.feedPacket(pkt) || opt.all)) {}
+    if (!input.open(opt.infile, opt)) {
+        return EXIT_FAILURE;
+    }
+    const ts::TSPacket* pkt = nullptr;
+    while ((pkt = input.read(opt)) != nullptr && (!zer.feedPacket(*pkt) || opt.all)) {}
 
     // Display results.
     ts::PCRAnalyzer::Status status;
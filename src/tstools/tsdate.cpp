@@ -33,12 +33,12 @@
 
 #include "tsMain.h"
 #include "tsDuckContext.h"
-#include "tsInputRedirector.h"
 #include "tsTablesDisplay.h"
 #include "tsSectionDemux.h"
 #include "tsNames.h"
 #include "tsTDT.h"
 #include "tsTOT.h"
+#include "tsTSPacketReader.h"
 TSDUCK_SOURCE;
 TS_MAIN(MainCode);
 
@@ -205,13 +205,16 @@ int MainCode(int argc, char *argv[])
     Options opt(argc, argv);
     TableHandler handler(opt);
     ts::SectionDemux demux(opt.duck, &handler);
-    ts::InputRedirector input(opt.infile, opt);
-    ts::TSPacket pkt;
+    ts::TSPacketReader input;
+    const ts::TSPacket* pkt = nullptr;
 
     demux.addPID(ts::PID_TDT);  // also equal PID_TOT
 
-    while (!handler.completed() && pkt.read(std::cin, true, opt)) {
-        demux.feedPacket(pkt);
+    if (!input.open(opt.infile, opt)) {
+        return EXIT_FAILURE;
+    }
+    while (!handler.completed() && (pkt = input.read(opt)) != nullptr) {
+        demux.feedPacket(*pkt);
     }
 
     return EXIT_SUCCESS;
@@ -33,6 +33,8 @@
 
 #include "tsMain.h"
 #include "tsContinuityAnalyzer.h"
+#include "tsNullReport.h"
+#include "tsSysUtils.h"
 TSDUCK_SOURCE;
 TS_MAIN(MainCode);
 
@@ -48,10 +50,12 @@ public:
     Options(int argc, char *argv[]);
     virtual ~Options();
 
-    bool         test;      // Test mode
-    bool         circular;  // Add empty packets to enforce circular continuity
-    ts::UString  filename;  // File name
-    std::fstream file;      // File buffer
+    bool         test;        // Test mode
+    bool         circular;    // Add empty packets to enforce circular continuity
+    bool         memory_map;  // Update the file in place using memory mapping
+    bool         two_pass;    // Analyze the file first, then patch the modified packets only
+    ts::UString  filename;    // File name
+    std::fstream file;        // File buffer
 
     // Check if there was an I/O error on the file.
     // Print an error message if this is the case.
@@ -66,6 +70,8 @@ Options::Options(int argc, char *argv[]) :
     Args(u"Fix continuity counters in a transport stream", u"[options] filename"),
     test(false),
     circular(false),
+    memory_map(false),
+    two_pass(false),
     filename(),
     file()
 {
@@ -78,14 +84,30 @@ Options::Options(int argc, char *argv[]) :
          u"Add empty packets, if necessary, on each PID so that the "
          u"continuity is preserved between end and beginning of file.");
 
+    option(u"memory-map", 'm');
+    help(u"memory-map",
+         u"Map the file in memory and fix the packets in place, without reading and "
+         u"rewriting them. Only the memory pages containing modified packets are "
+         u"written back to the file. This is not supported on Windows or on non-regular "
+         u"files, where the file is read and rewritten packet by packet.");
+
     option(u"noaction", 'n');
     help(u"noaction", u"Display what should be performed but do not modify the file.");
 
+    option(u"two-pass");
+    help(u"two-pass",
+         u"Analyze the file first, without modifying it, and then patch only the bytes "
+         u"which must be modified. The file is not written at all when there is nothing "
+         u"to fix. The modifications are kept in memory between the two passes. "
+         u"This option implies --memory-map.");
+
     analyze(argc, argv);
 
     filename = value(u"");
     circular = present(u"circular");
     test = present(u"noaction");
+    two_pass = present(u"two-pass");
+    memory_map = two_pass || present(u"memory-map");
 
     exitOnError();
 }
@@ -103,6 +125,218 @@ bool Options::fileError(const ts::UChar* message)
 }
 
 
+//----------------------------------------------------------------------------
+//  Memory-mapped file.
+//----------------------------------------------------------------------------
+
+namespace {
+    class MappedFile
+    {
+        TS_NOCOPY(MappedFile);
+    public:
+        MappedFile() : _data(nullptr), _size(0), _writable(false) {}
+        ~MappedFile() { close(); }
+
+        // Map a regular file in memory. Return false if not possible.
+        // Set error to true if the file cannot be open.
+        bool open(const ts::UString& filename, bool writable, bool& error, ts::Report& report);
+
+        // Write modified pages to the file and unmap.
+        bool close(ts::Report& report);
+        void close() { close(NULLREP); }
+
+        uint8_t* data() const { return _data; }
+        uint64_t size() const { return _size; }
+
+    private:
+        uint8_t* _data;
+        uint64_t _size;
+        bool     _writable;
+    };
+
+    bool MappedFile::open(const ts::UString& filename, bool writable, bool& error, ts::Report& report)
+    {
+        close();
+        error = false;
+#if defined(TS_WINDOWS)
+        report.verbose(u"memory-mapped files are not supported on Windows");
+        return false;
+#else
+        const int fd = ::open(filename.toUTF8().c_str(), writable ? O_RDWR : O_RDONLY);
+        if (fd < 0) {
+            report.error(u"cannot open file %s", {filename});
+            error = true;
+            return false;
+        }
+        struct stat st;
+        if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+            report.verbose(u"%s is not a regular file, cannot map it in memory", {filename});
+            ::close(fd);
+            return false;
+        }
+        void* addr = nullptr;
+        if (st.st_size > 0) {
+            addr = ::mmap(nullptr, size_t(st.st_size), PROT_READ | (writable ? PROT_WRITE : 0), MAP_SHARED, fd, 0);
+            if (addr == MAP_FAILED) {
+                report.verbose(u"cannot map %s in memory: %s", {filename, ts::ErrorCodeMessage()});
+                ::close(fd);
+                return false;
+            }
+        }
+        ::close(fd);
+        _data = reinterpret_cast<uint8_t*>(addr);
+        _size = uint64_t(st.st_size);
+        _writable = writable;
+        return true;
+#endif
+    }
+
+    bool MappedFile::close(ts::Report& report)
+    {
+        bool ok = true;
+#if !defined(TS_WINDOWS)
+        if (_data != nullptr) {
+            if (_writable && ::msync(_data, size_t(_size), MS_SYNC) != 0) {
+                report.error(u"error writing file: %s", {ts::ErrorCodeMessage()});
+                ok = false;
+            }
+            ::munmap(_data, size_t(_size));
+        }
+#endif
+        _data = nullptr;
+        _size = 0;
+        _writable = false;
+        return ok;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+//  Fix the file using memory mapping.
+//  Return false if not possible, in which case nothing was done.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Same message suffix as ts::TSPacket::read().
+    ts::UString AfterPackets(ts::PacketCounter count)
+    {
+        return count > 0 ? ts::UString::Format(u" after %'d TS packets", {count}) : ts::UString();
+    }
+
+    bool MappedFix(Options& opt, ts::ContinuityAnalyzer& fixer)
+    {
+        // The file is read-only in test mode and in the first pass of the two-pass mode.
+        MappedFile file;
+        bool error = false;
+        if (!file.open(opt.filename, !opt.test && !opt.two_pass, error, opt)) {
+            return error;
+        }
+
+        // With two passes, list of bytes to modify in the second pass: offset in file, new value.
+        std::vector<std::pair<uint64_t, uint8_t>> patches;
+
+        // Process all packets in the file, directly in the mapped memory.
+        ts::TSPacket* const packets = reinterpret_cast<ts::TSPacket*>(file.data());
+        const ts::PacketCounter count = file.size() / ts::PKT_SIZE;
+        ts::PacketCounter index = 0;
+
+        for (; index < count; ++index) {
+            ts::TSPacket& pkt(packets[index]);
+            if (pkt.b[0] != ts::SYNC_BYTE) {
+                opt.error(u"synchronization lost%s, got 0x%X instead of 0x%X at start of TS packet", {AfterPackets(index), pkt.b[0], ts::SYNC_BYTE});
+                break;
+            }
+            if (opt.test) {
+                // Read-only mapping, never modify the packet.
+                fixer.feedPacket(static_cast<const ts::TSPacket&>(pkt));
+            }
+            else if (!opt.two_pass) {
+                // The analyzer writes only modified bytes, only the corresponding pages become dirty.
+                fixer.feedPacket(pkt);
+            }
+            else {
+                // Work on a copy of the packet and remember the modified bytes.
+                ts::TSPacket copy(pkt);
+                if (!fixer.feedPacket(copy)) {
+                    for (size_t i = 0; i < ts::PKT_SIZE; ++i) {
+                        if (copy.b[i] != pkt.b[i]) {
+                            patches.push_back(std::make_pair(index * ts::PKT_SIZE + i, copy.b[i]));
+                        }
+                    }
+                }
+            }
+        }
+        if (index == count && file.size() % ts::PKT_SIZE != 0) {
+            opt.error(u"truncated TS packet (%d bytes)%s", {file.size() % ts::PKT_SIZE, AfterPackets(count)});
+        }
+
+        // Second pass: map the file in read/write mode and patch the modified bytes only.
+        if (!patches.empty()) {
+            opt.debug(u"patching %'d bytes in %s", {patches.size(), opt.filename});
+            if (!file.open(opt.filename, true, error, opt)) {
+                if (!error) {
+                    opt.error(u"cannot map %s in memory", {opt.filename});
+                }
+                return true;
+            }
+            for (auto it = patches.begin(); it != patches.end(); ++it) {
+                file.data()[it->first] = it->second;
+            }
+        }
+
+        file.close(opt);
+        return true;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+//  Fix the file using stream I/O.
+//----------------------------------------------------------------------------
+
+namespace {
+    void StreamFix(Options& opt, ts::ContinuityAnalyzer& fixer)
+    {
+        // Process all packets in the file
+        ts::TSPacket pkt;
+
+        for (;;) {
+
+            // Save position of current packet
+            const std::ios::pos_type pos = opt.file.tellg();
+            if (opt.fileError(u"error getting file position")) {
+                break;
+            }
+
+            // Read a TS packet
+            if (!pkt.read(opt.file, true, opt)) {
+                break; // end of file
+            }
+
+            // Process packet
+            if (!fixer.feedPacket(pkt) && !opt.test) {
+                // Packet was modified, need to rewrite it.
+                // Rewind to beginning of current packet
+                opt.file.seekp(pos);
+                if (opt.fileError(u"error setting file position")) {
+                    break;
+                }
+                // Rewrite the packet
+                pkt.write(opt.file, opt);
+                if (opt.fileError(u"error rewriting packet")) {
+                    break;
+                }
+                // Make sure the get position is ok
+                opt.file.seekg(opt.file.tellp());
+                if (opt.fileError(u"error setting file position")) {
+                    break;
+                }
+            }
+        }
+    }
+}
+
+
 //----------------------------------------------------------------------------
 //  Program entry point
 //----------------------------------------------------------------------------
@@ -123,48 +357,17 @@ int MainCode(int argc, char *argv[])
         mode |= std::ios::out;
     }
 
-    opt.file.open(opt.filename.toUTF8().c_str(), mode);
-
-    if (!opt.file) {
-        opt.error(u"cannot open file %s", {opt.filename});
-        return EXIT_FAILURE;
-    }
-
-    // Process all packets in the file
-    ts::TSPacket pkt;
-
-    for (;;) {
+    // Fix the file using memory mapping when requested and possible.
+    if (!opt.memory_map || !MappedFix(opt, fixer)) {
 
-        // Save position of current packet
-        const std::ios::pos_type pos = opt.file.tellg();
-        if (opt.fileError(u"error getting file position")) {
-            break;
-        }
+        opt.file.open(opt.filename.toUTF8().c_str(), mode);
 
-        // Read a TS packet
-        if (!pkt.read(opt.file, true, opt)) {
-            break; // end of file
+        if (!opt.file) {
+            opt.error(u"cannot open file %s", {opt.filename});
+            return EXIT_FAILURE;
         }
 
-        // Process packet
-        if (!fixer.feedPacket(pkt) && !opt.test) {
-            // Packet was modified, need to rewrite it.
-            // Rewind to beginning of current packet
-            opt.file.seekp(pos);
-            if (opt.fileError(u"error setting file position")) {
-                break;
-            }
-            // Rewrite the packet
-            pkt.write(opt.file, opt);
-            if (opt.fileError(u"error rewriting packet")) {
-                break;
-            }
-            // Make sure the get position is ok
-            opt.file.seekg(opt.file.tellp());
-            if (opt.fileError(u"error setting file position")) {
-                break;
-            }
-        }
+        StreamFix(opt, fixer);
     }
 
     opt.verbose(u"%'d packets read, %'d discontinuities, %'d packets updated", {fixer.totalPackets(), fixer.errorCount(), fixer.fixCount()});
@@ -173,17 +376,23 @@ int MainCode(int argc, char *argv[])
     if (opt.circular && opt.valid()) {
 
         // Create an empty packet (no payload, 184-byte adaptation field)
-        pkt = ts::NullPacket;
+        ts::TSPacket pkt(ts::NullPacket);
         pkt.b[3] = 0x20;    // adaptation field, no payload
         pkt.b[4] = 183;     // adaptation field length
         pkt.b[5] = 0x00;    // nothing in adaptation field
 
         // Ensure write position is at end of file
         if (!opt.test) {
-            // First, need to clear the eof bit
-            opt.file.clear();
-            // Set write position at eof
-            opt.file.seekp(0, std::ios::end);
+            if (opt.file.is_open()) {
+                // First, need to clear the eof bit
+                opt.file.clear();
+                // Set write position at eof
+                opt.file.seekp(0, std::ios::end);
+            }
+            else {
+                // The file was memory-mapped, open it now to append packets.
+                opt.file.open(opt.filename.toUTF8().c_str(), mode | std::ios::ate);
+            }
             // Returned value ignored on purpose, just report error when needed.
             // coverity[CHECKED_RETURN]
             opt.fileError(u"error setting file position");
@@ -0,0 +1,111 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  Names files compiler
+//
+//----------------------------------------------------------------------------
+
+#include "tsMain.h"
+#include "tsNames.h"
+TSDUCK_SOURCE;
+TS_MAIN(MainCode);
+
+
+//----------------------------------------------------------------------------
+//  Command line options
+//----------------------------------------------------------------------------
+
+class Options: public ts::Args
+{
+    TS_NOBUILD_NOCOPY(Options);
+public:
+    Options(int argc, char *argv[]);
+    virtual ~Options();
+
+    ts::UStringVector infiles;  // Input names files.
+    ts::UString       outfile;  // Output image file.
+};
+
+// Destructor.
+Options::~Options() {}
+
+// Constructor.
+Options::Options(int argc, char *argv[]) :
+    Args(u"Compile TSDuck names files into binary images", u"[options] filename ..."),
+    infiles(),
+    outfile()
+{
+    option(u"", 0, STRING, 1, UNLIMITED_COUNT);
+    help(u"",
+         u"Names files to compile (tsduck*.names). "
+         u"The compiled image of each file is loaded by TSDuck instead of the text file "
+         u"when it is found in the same search path, with an additional suffix '.bin'.");
+
+    option(u"output", 'o', STRING);
+    help(u"output", u"filename",
+         u"Output image file. Allowed only with one input file. "
+         u"By default, the output file is the input file name with an additional suffix '.bin'.");
+
+    analyze(argc, argv);
+
+    getValues(infiles);
+    getValue(outfile, u"output");
+
+    if (!outfile.empty() && infiles.size() > 1) {
+        error(u"--output cannot be used with more than one input file");
+    }
+
+    exitOnError();
+}
+
+
+//----------------------------------------------------------------------------
+//  Program entry point
+//----------------------------------------------------------------------------
+
+int MainCode(int argc, char *argv[])
+{
+    Options opt(argc, argv);
+    bool success = true;
+
+    for (auto it = opt.infiles.begin(); it != opt.infiles.end(); ++it) {
+        // Always parse the text file, ignore existing images.
+        const ts::Names names(*it, false, false);
+        if (names.configurationFile().empty() || names.errorCount() > 0) {
+            opt.error(u"error loading %s", {*it});
+            success = false;
+        }
+        else {
+            const ts::UString outfile(opt.outfile.empty() ? *it + ts::Names::IMAGE_SUFFIX : opt.outfile);
+            opt.verbose(u"compiling %s into %s", {names.configurationFile(), outfile});
+            success = names.saveImage(outfile, opt) && success;
+        }
+    }
+    return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
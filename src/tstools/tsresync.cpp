@@ -27,6 +27,7 @@
 //
 //----------------------------------------------------------------------------
 //
+//
 //  Resynchronize a transport stream at beginning of a packet.
 //
 //----------------------------------------------------------------------------
@@ -35,6 +36,8 @@
 #include "tsInputRedirector.h"
 #include "tsOutputRedirector.h"
 #include "tsByteBlock.h"
+#include "tsThread.h"
+#include "tsSysUtils.h"
 #include "tsFatal.h"
 #include "tsMPEG.h"
 TSDUCK_SOURCE;
@@ -48,6 +51,9 @@ TS_MAIN(MainCode);
 #define MAX_CONTIG_SIZE     (8 * 1024 * 1024)   // 8 MB
 #define DEFAULT_CONTIG_SIZE (512 * 1024)        // 512 kB
 
+#define IO_BLOCK_SIZE       (4 * 1024 * 1024)   // 4 MB, size of input and output blocks
+#define MIN_CHUNK_SIZE      (32 * 1024 * 1024)  // 32 MB, minimum chunk size in parallel resynchronization
+
 
 //----------------------------------------------------------------------------
 //  Command line options
@@ -64,6 +70,7 @@ public:
     size_t      contig_size; // required size of contiguous packets to accept a stream slice
     size_t      packet_size; // specific non-standard input packet size (zero means use standard sizes)
     size_t      header_size; // header size (when packet_size > 0)
+    size_t      threads;     // number of threads for parallel resynchronization
     bool        cont_sync;   // continuous synchronization (default: stop on error)
     bool        keep;        // keep packet size (default: reduce to 188 bytes)
     ts::UString infile;      // Input file name
@@ -80,6 +87,7 @@ Options::Options(int argc, char *argv[]) :
     contig_size(0),
     packet_size(0),
     header_size(0),
+    threads(1),
     cont_sync(false),
     keep(false),
     infile(),
@@ -125,6 +133,15 @@ Options::Options(int argc, char *argv[]) :
          u"Number of initial bytes to analyze to find start of packet "
          u"synchronization (default: 1 MB).");
 
+    option(u"threads", 't', POSITIVE);
+    help(u"threads",
+         u"Resynchronize the input file in parallel using the specified number of threads. "
+         u"The file is split into contiguous chunks which are searched independently and "
+         u"the results are stitched in order. The output is identical to a sequential "
+         u"processing. The input must be a regular file. It is memory-mapped, which is "
+         u"currently not supported on Windows, where the file is sequentially processed. "
+         u"The default is 1, the file is sequentially processed.");
+
     analyze(argc, argv);
 
     infile = value(u"");
@@ -133,17 +150,106 @@ Options::Options(int argc, char *argv[]) :
     contig_size = intValue<size_t>(u"min-contiguous", DEFAULT_CONTIG_SIZE);
     header_size = intValue<size_t>(u"header-size", 0);
     packet_size = intValue<size_t>(u"packet-size", 0);
+    threads = intValue<size_t>(u"threads", 1);
     keep = present(u"keep");
     cont_sync = present(u"continue");
 
     if (packet_size > 0 && header_size + ts::PKT_SIZE > packet_size) {
         error(u"specified --header-size too large for specified --packet-size");
     }
+    if (threads > 1 && infile.empty()) {
+        error(u"--threads cannot be used on standard input");
+    }
 
     exitOnError();
 }
 
 
+//----------------------------------------------------------------------------
+// Packet formats and search for synchronization.
+//----------------------------------------------------------------------------
+
+namespace {
+
+    // Encapsulation of TS packets in the input file.
+    struct PacketFormat
+    {
+        size_t pkt_size;     // TS packet size in input stream (188, 204, 192)
+        size_t header_size;  // Header size before TS packet in input stream (0, 4)
+    };
+
+    // List of packet formats to try, in order of preference.
+    typedef std::vector<PacketFormat> PacketFormatList;
+
+    PacketFormatList GetPacketFormats(const Options& opt)
+    {
+        if (opt.packet_size > 0) {
+            // User-specified encapsulation of TS packets
+            return PacketFormatList({{opt.packet_size, opt.header_size}});
+        }
+        else {
+            // Standard TS packets, TS packets with trailing Reed-Solomon outer FEC,
+            // TS packets with leading 4-byte timestamp (M2TS format, blu-ray discs).
+            return PacketFormatList({{ts::PKT_SIZE, 0}, {ts::PKT_RS_SIZE, 0}, {ts::PKT_M2TS_SIZE, ts::M2TS_HEADER_SIZE}});
+        }
+    }
+
+    // Check if a buffer of search_size bytes contains packets of the specified format.
+    bool CheckSync(const uint8_t* buf, size_t search_size, const PacketFormat& format)
+    {
+        assert(format.pkt_size >= format.header_size + ts::PKT_SIZE);
+        for (size_t off = 0; off + format.pkt_size <= search_size; off += format.pkt_size) {
+            if (buf[off + format.header_size] != ts::SYNC_BYTE) {
+                return false; // not found
+            }
+        }
+        // Packets found all along the buffer
+        return true;
+    }
+
+    // Search the first range of search_size bytes containing packets in a buffer of buf_size bytes.
+    // Return the offset of the first packet and set the index of its packet format. Return NPOS if not found.
+    size_t FindSync(const uint8_t* buf, size_t buf_size, size_t search_size, const PacketFormatList& formats, size_t& index)
+    {
+        assert(search_size <= buf_size);
+        const size_t end_search = buf_size - search_size + 1;
+
+        // When at least one packet is checked for each format, a start position is a candidate only when
+        // a sync byte follows the header of one format. Then, we skip non-candidate positions using memchr(),
+        // which is usually vectorized by the C library. Otherwise, we need to check each position.
+        bool skip = true;
+        for (size_t i = 0; i < formats.size(); ++i) {
+            skip = skip && search_size >= formats[i].pkt_size;
+        }
+
+        for (size_t start = 0; start < end_search; ++start) {
+            if (skip) {
+                size_t next = end_search;
+                for (size_t i = 0; i < formats.size(); ++i) {
+                    const size_t hsize = formats[i].header_size;
+                    if (i == 0 || hsize != formats[i-1].header_size) {
+                        const void* sync = ::memchr(buf + start + hsize, ts::SYNC_BYTE, next - start);
+                        if (sync != nullptr) {
+                            next = size_t(reinterpret_cast<const uint8_t*>(sync) - buf) - hsize;
+                        }
+                    }
+                }
+                if (next >= end_search) {
+                    break;
+                }
+                start = next;
+            }
+            for (index = 0; index < formats.size(); ++index) {
+                if (CheckSync(buf + start, search_size, formats[index])) {
+                    return start;
+                }
+            }
+        }
+        return ts::NPOS;
+    }
+}
+
+
 //----------------------------------------------------------------------------
 // Resynchronization class
 //----------------------------------------------------------------------------
@@ -152,6 +258,7 @@ enum Status {RS_OK, RS_SYNC_LOST, RS_EOF, RS_ERROR};
 
 class Resynchronizer
 {
+    TS_NOBUILD_NOCOPY(Resynchronizer);
 public:
 
     // Reset the analysis of input data.
@@ -162,12 +269,10 @@ public:
         _in_header_size = 0;
     }
 
-    // Look for MPEG packets in a buffer, according to an assumed packet size.
-    // If the complete buffer matches the packet size, set input and output packet
-    // sizes and return true. Return false otherwise.
-    bool checkSync(const uint8_t* buf, size_t buf_size, size_t pkt_size, size_t header_size);
+    // Set input and output packet sizes from the format which was found in input data.
+    void setPacketFormat(const PacketFormat& format);
 
-    // Get packet sizes, as determined by checkSync(). Size is zero if no valid packet size found.
+    // Get packet sizes, as determined by setPacketFormat(). Size is zero if no valid packet size found.
     size_t inputPacketSize() const {return _in_pkt_size;}
     size_t inputHeaderSize() const {return _in_header_size;}
     size_t outputPacketSize() const {return _out_pkt_size;}
@@ -187,6 +292,12 @@ public:
     // Write one output packet from input packet.
     bool writePacket(const uint8_t* input_packet);
 
+    // Write contiguous output packets from contiguous input packets.
+    bool writePackets(const uint8_t* input_packets, uint64_t count);
+
+    // Flush buffered output data.
+    bool flush();
+
     // Constructor
     Resynchronizer(bool keep_packet_size) :
         _status(RS_OK),
@@ -195,215 +306,696 @@ public:
         _in_pkt_size(0),
         _in_header_size(0),
         _out_pkt_size(0),
-        _out_header_size(0)
+        _out_header_size(0),
+        _in_buf(IO_BLOCK_SIZE),
+        _in_start(0),
+        _in_end(0),
+        _in_eof(false),
+        _out_buf(IO_BLOCK_SIZE),
+        _out_end(0)
     {
     }
 
 private:
-    Status   _status;            // Processing status
-    bool     _keep_packet_size;  // Same packet size on output file
-    uint64_t _out_size;          // Size of output file
-    size_t   _in_pkt_size;       // TS packet size in input stream (188, 204, 192)
-    size_t   _in_header_size;    // Header size before TS packet in input stream (0, 4)
-    size_t   _out_pkt_size;      // TS packet size in output stream
-    size_t   _out_header_size;   // Header size before TS packet in output stream
+    Status        _status;            // Processing status
+    bool          _keep_packet_size;  // Same packet size on output file
+    uint64_t      _out_size;          // Size of output file
+    size_t        _in_pkt_size;       // TS packet size in input stream (188, 204, 192)
+    size_t        _in_header_size;    // Header size before TS packet in input stream (0, 4)
+    size_t        _out_pkt_size;      // TS packet size in output stream
+    size_t        _out_header_size;   // Header size before TS packet in output stream
+    ts::ByteBlock _in_buf;            // Input buffer
+    size_t        _in_start;          // Start of unread data in input buffer
+    size_t        _in_end;            // End of data in input buffer
+    bool          _in_eof;            // End of input file reached
+    ts::ByteBlock _out_buf;           // Output buffer
+    size_t        _out_end;           // End of data in output buffer
+
+    // Write output data.
+    bool writeData(const uint8_t* data, size_t size);
 };
 
 
+//----------------------------------------------------------------------------
+// Set input and output packet sizes.
+//----------------------------------------------------------------------------
+
+void Resynchronizer::setPacketFormat(const PacketFormat& format)
+{
+    _in_pkt_size = format.pkt_size;
+    _in_header_size = format.header_size;
+    _out_pkt_size = _keep_packet_size ? format.pkt_size : ts::PKT_SIZE;
+    _out_header_size = _keep_packet_size ? format.header_size : 0;
+}
+
+
 //----------------------------------------------------------------------------
 // Read input data, return read size (zero on end of file or error)
 //----------------------------------------------------------------------------
 
 size_t Resynchronizer::readData(uint8_t* buf, size_t size)
 {
-    std::streamsize got = 0;
-    std::streamsize remain = std::streamsize(size);
-    while (remain > 0) {
-        if (std::cin.read(reinterpret_cast <char*> (buf + got), remain)) {
-            const std::streamsize count = std::cin.gcount();
-            got += count;
-            remain -= count;
-        }
-        else {
-            if (got == 0) {
-                _status = RS_EOF;
-            }
-            break;
+    // Read large blocks from the input file until the requested size is available.
+    while (_in_end - _in_start < size && !_in_eof) {
+        _in_end -= _in_start;
+        ::memmove(_in_buf.data(), _in_buf.data() + _in_start, _in_end);
+        _in_start = 0;
+        if (_in_buf.size() < size) {
+            _in_buf.resize(size);
         }
+        std::cin.read(reinterpret_cast<char*>(_in_buf.data() + _in_end), std::streamsize(_in_buf.size() - _in_end));
+        _in_end += size_t(std::cin.gcount());
+        _in_eof = !std::cin;
+    }
+
+    // Incomplete data at end of file are dropped: either the requested size is returned or nothing.
+    if (_in_end - _in_start < size) {
+        _in_start = _in_end = 0;
+        _status = RS_EOF;
+        return 0;
+    }
+    else {
+        ::memcpy(buf, _in_buf.data() + _in_start, size);
+        _in_start += size;
+        return size;
     }
-    return size_t(got);
 }
 
 
 //----------------------------------------------------------------------------
-// Write one output packet from input packet.
+// Write output packets.
 //----------------------------------------------------------------------------
 
 bool Resynchronizer::writePacket(const uint8_t* input_packet)
 {
-    const char* out_pkt = reinterpret_cast<const char*>(input_packet + _in_header_size - _out_header_size);
-    if (std::cout.write(out_pkt, std::streamsize(_out_pkt_size))) {
-        _out_size += _out_pkt_size;
-        return true;
+    return writeData(input_packet + _in_header_size - _out_header_size, _out_pkt_size);
+}
+
+bool Resynchronizer::writePackets(const uint8_t* input_packets, uint64_t count)
+{
+    if (_in_pkt_size == _out_pkt_size) {
+        // Same packet format on input and output, write all packets at once.
+        return writeData(input_packets, size_t(count * _in_pkt_size));
     }
     else {
+        for (; count > 0; --count, input_packets += _in_pkt_size) {
+            if (!writePacket(input_packets)) {
+                return false;
+            }
+        }
+        return true;
+    }
+}
+
+bool Resynchronizer::writeData(const uint8_t* data, size_t size)
+{
+    if (_out_end + size > _out_buf.size() && !flush()) {
+        return false;
+    }
+    if (size < _out_buf.size()) {
+        ::memcpy(_out_buf.data() + _out_end, data, size);
+        _out_end += size;
+    }
+    else if (!std::cout.write(reinterpret_cast<const char*>(data), std::streamsize(size))) {
         std::cerr << "* Error writing output file" << std::endl;
         _status = RS_ERROR;
         return false;
     }
+    _out_size += size;
+    return true;
 }
 
-
-//----------------------------------------------------------------------------
-//  Look for MPEG packets in a buffer, according to an assumed packet size.
-//----------------------------------------------------------------------------
-
-bool Resynchronizer::checkSync(const uint8_t* buf, size_t buf_size, size_t pkt_size, size_t header_size)
+bool Resynchronizer::flush()
 {
-    assert(pkt_size >= header_size + ts::PKT_SIZE);
-    const uint8_t* end = buf + buf_size - pkt_size + 1;
-
-    // Check if the buffer contains packets with the appropriate size
-    while (buf < end) {
-        if (buf[header_size] != ts::SYNC_BYTE) {
-            return false; // not found
-        }
-        buf += pkt_size;
+    if (_out_end > 0 && !std::cout.write(reinterpret_cast<const char*>(_out_buf.data()), std::streamsize(_out_end))) {
+        std::cerr << "* Error writing output file" << std::endl;
+        _status = RS_ERROR;
+        _out_end = 0;
+        return false;
     }
-
-    // Packets found all along the buffer
-    _in_pkt_size = pkt_size;
-    _in_header_size = header_size;
-    _out_pkt_size = _keep_packet_size ? pkt_size : ts::PKT_SIZE;
-    _out_header_size = _keep_packet_size ? header_size : 0;
+    _out_end = 0;
     return true;
 }
 
 
 //----------------------------------------------------------------------------
-//  Program entry point
+// Messages, common to sequential and parallel resynchronization.
 //----------------------------------------------------------------------------
 
-int MainCode(int argc, char *argv[])
-{
-    Options opt(argc, argv);
-    ts::InputRedirector input(opt.infile, opt);
-    ts::OutputRedirector output(opt.outfile, opt);
-    Resynchronizer resync(opt.keep);
+namespace {
+    void ReportAnalyzing(const Options& opt, const char*& prefix, size_t size)
+    {
+        if (opt.verbose()) {
+            std::cerr << "* Analyzing " << prefix << " " << ts::UString::Decimal(size) << " bytes" << std::endl;
+            prefix = "next";
+        }
+    }
 
-    // Synchronization buffer
-    ts::ByteBlock sync_buf_bb(opt.sync_size + opt.contig_size);
-    uint8_t* const sync_buf = sync_buf_bb.data();
-    size_t const sync_buf_size = sync_buf_bb.size();
+    void ReportNotFound(size_t search_size)
+    {
+        std::cerr << "* Cannot find MPEG TS packets after " << ts::UString::Decimal(search_size) << " bytes" << std::endl;
+    }
 
-    size_t sync_pre_size = 0; // Pre-loaded in synchronization buffer
-    const char* prefix_fn = "first";
+    void ReportFound(const Options& opt, const Resynchronizer& resync, size_t offset)
+    {
+        if (opt.verbose()) {
+            std::cerr << "* Found synchronization after " << ts::UString::Decimal(offset) << " bytes" << std::endl
+                      << "* Packet size is " << resync.inputPacketSize() << " bytes";
+            if (resync.inputHeaderSize() > 0) {
+                std::cerr << " (" << resync.inputHeaderSize() << "-byte header)";
+            }
+            std::cerr << std::endl;
+        }
+    }
 
-    // Loop on synchronization start. This occurs once at the
-    // beginning of the file. Then, if option --continue is specified,
-    // it occurs again each time the synchronization is lost.
-    do {
-        resync.reset();
+    void ReportLost(const Resynchronizer& resync, uint8_t sync)
+    {
+        std::cerr << ts::UString::Format(u"*** Synchronization lost after %'d TS packets", {resync.outputFilePackets()}) << std::endl
+                  << ts::UString::Format(u"*** Got 0x%X instead of 0x%X at start of TS packet", {sync, ts::SYNC_BYTE}) << std::endl;
+    }
+}
 
-        // Read the initial buffer. We use these data to look for packet sync.
-        size_t const read_size = resync.readData(sync_buf + sync_pre_size, sync_buf_size - sync_pre_size);
-        size_t const sync_size = sync_pre_size + read_size;
-        uint8_t* const sync_end = sync_buf + sync_size;
 
-        if (opt.verbose()) {
-            std::cerr << "* Analyzing " << prefix_fn << " " << ts::UString::Decimal(sync_size) << " bytes" << std::endl;
-            prefix_fn = "next";
-        }
+//----------------------------------------------------------------------------
+// Sequential resynchronization from the input stream.
+//----------------------------------------------------------------------------
 
-        // Look for a range of packets for at least --min-contiguous bytes
-        size_t const search_size = std::min(opt.contig_size, sync_size);
-        uint8_t* const end_search = sync_end - search_size + 1;
+namespace {
+    void SequentialResync(const Options& opt, Resynchronizer& resync)
+    {
+        const PacketFormatList formats(GetPacketFormats(opt));
+
+        // Synchronization buffer
+        ts::ByteBlock sync_buf_bb(opt.sync_size + opt.contig_size);
+        uint8_t* const sync_buf = sync_buf_bb.data();
+        size_t const sync_buf_size = sync_buf_bb.size();
+
+        size_t sync_pre_size = 0; // Pre-loaded in synchronization buffer
+        const char* prefix_fn = "first";
+
+        // Loop on synchronization start. This occurs once at the
+        // beginning of the file. Then, if option --continue is specified,
+        // it occurs again each time the synchronization is lost.
+        do {
+            resync.reset();
+
+            // Read the initial buffer. We use these data to look for packet sync.
+            size_t const read_size = resync.readData(sync_buf + sync_pre_size, sync_buf_size - sync_pre_size);
+            size_t const sync_size = sync_pre_size + read_size;
+            uint8_t* const sync_end = sync_buf + sync_size;
+            ReportAnalyzing(opt, prefix_fn, sync_size);
+
+            // Look for a range of packets for at least --min-contiguous bytes.
+            // Search a range of valid packets. Try all expected packet sizes.
+            size_t const search_size = std::min(opt.contig_size, sync_size);
+            size_t format = 0;
+            size_t const offset = FindSync(sync_buf, sync_size, search_size, formats, format);
+            if (offset == ts::NPOS) {
+                ReportNotFound(search_size);
+                resync.setStatus(RS_ERROR);
+                break;
+            }
+            resync.setPacketFormat(formats[format]);
+            ReportFound(opt, resync, offset);
 
-        // Search a range of valid packets. Try all expected packet sizes.
-        const uint8_t* start;
-        for (start = sync_buf; start < end_search; start++) {
-            if (opt.packet_size > 0) {
-                if (resync.checkSync(start, search_size, opt.packet_size, opt.header_size)) {
-                    // Found user-specified encapsulation of TS packets
+            // Output initial sync buffer, starting at first valid packet, writing all valid packets
+            const uint8_t* start = sync_buf + offset;
+            while (start <= sync_end - resync.inputPacketSize() && start[resync.inputHeaderSize()] == ts::SYNC_BYTE) {
+                if (!resync.writePacket(start)) {
                     break;
                 }
+                start += resync.inputPacketSize();
+            }
+            if (resync.status() != RS_OK) {
+                break;
+            }
+
+            // Compact sync buffer
+            if (start >= sync_end) {
+                sync_pre_size = 0;
             }
             else {
-                if (resync.checkSync(start, search_size, ts::PKT_SIZE, 0)) {
-                    // Found standard TS packets
-                    break;
+                sync_pre_size = sync_end - start;
+                ::memmove(sync_buf, start, sync_pre_size);
+            }
+
+            // If more than one packet left, out of sync
+            if (sync_pre_size >= resync.inputPacketSize()) {
+                resync.setStatus(RS_SYNC_LOST);
+            }
+
+            // Read the rest of the input file
+            while (resync.status() == RS_OK) {
+                assert(sync_pre_size < resync.inputPacketSize());
+                // Read the next packet
+                const size_t remain_size = resync.inputPacketSize() - sync_pre_size;
+                if (resync.readData(sync_buf + sync_pre_size, remain_size) != remain_size) {
+                    resync.setStatus(RS_EOF);
                 }
-                if (resync.checkSync(start, search_size, ts::PKT_RS_SIZE, 0)) {
-                    // Found TS packets with trailing Reed-Solomon outer FEC
-                    break;
+                else if (sync_buf[resync.inputHeaderSize()] != ts::SYNC_BYTE) {
+                    ReportLost(resync, sync_buf[resync.inputHeaderSize()]);
+                    resync.setStatus(RS_SYNC_LOST);
+                    // Will resynchronize with sync buffer pre-loaded
+                    sync_pre_size = resync.inputPacketSize();
                 }
-                if (resync.checkSync(start, search_size, ts::PKT_M2TS_SIZE, ts::M2TS_HEADER_SIZE)) {
-                    // Found TS packets with leading 4-byte timestamp (M2TS format, blu-ray discs)
-                    break;
+                else {
+                    resync.writePacket(sync_buf);
+                    sync_pre_size = 0;
                 }
             }
+
+        } while (resync.status() == RS_OK || (resync.status() == RS_SYNC_LOST && opt.cont_sync));
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Memory-mapped input file.
+//----------------------------------------------------------------------------
+
+namespace {
+    class MappedFile
+    {
+        TS_NOCOPY(MappedFile);
+    public:
+        MappedFile() : _data(nullptr), _size(0) {}
+        ~MappedFile() { close(); }
+
+        // Map a regular file in memory. Return false if not possible.
+        bool open(const ts::UString& filename, ts::Report& report);
+        void close();
+
+        const uint8_t* data() const { return _data; }
+        uint64_t size() const { return _size; }
+
+    private:
+        const uint8_t* _data;
+        uint64_t       _size;
+    };
+
+    bool MappedFile::open(const ts::UString& filename, ts::Report& report)
+    {
+        close();
+#if defined(TS_WINDOWS)
+        report.verbose(u"memory-mapped files are not supported on Windows, using sequential processing");
+        return false;
+#else
+        const int fd = ::open(filename.toUTF8().c_str(), O_RDONLY);
+        if (fd < 0) {
+            report.error(u"error opening %s: %s", {filename, ts::ErrorCodeMessage()});
+            return false;
         }
-        if (resync.inputPacketSize() == 0) {
-            std::cerr << "* Cannot find MPEG TS packets after " << ts::UString::Decimal(search_size) << " bytes" << std::endl;
-            resync.setStatus (RS_ERROR);
-            break;
+        struct stat st;
+        void* addr = MAP_FAILED;
+        if (::fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+            addr = ::mmap(nullptr, size_t(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
         }
-        if (opt.verbose()) {
-            std::cerr << "* Found synchronization after " << ts::UString::Decimal(start - sync_buf) << " bytes" << std::endl
-                      << "* Packet size is " << resync.inputPacketSize() << " bytes";
-            if (resync.inputHeaderSize() > 0) {
-                std::cerr << " (" << resync.inputHeaderSize() << "-byte header)";
+        ::close(fd);
+        if (addr == MAP_FAILED) {
+            report.verbose(u"cannot map %s in memory, using sequential processing", {filename});
+            return false;
+        }
+        _data = reinterpret_cast<const uint8_t*>(addr);
+        _size = uint64_t(st.st_size);
+        return true;
+#endif
+    }
+
+    void MappedFile::close()
+    {
+#if !defined(TS_WINDOWS)
+        if (_data != nullptr) {
+            ::munmap(const_cast<uint8_t*>(_data), size_t(_size));
+        }
+#endif
+        _data = nullptr;
+        _size = 0;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Search functions in a memory-mapped file.
+//----------------------------------------------------------------------------
+//
+// The sequential processing is a chain of synchronization searches. Each one
+// starts at the position where the synchronization was lost and uses a full
+// synchronization buffer, except at end of file. Its result, as well as the
+// following run of valid packets, depends only on the file content and this
+// position. Therefore, the results which are computed by different threads
+// from arbitrary positions can be reused when they match the actual chain.
+//
+//----------------------------------------------------------------------------
+
+namespace {
+
+    // How a run of packets ends.
+    enum RunEnd {
+        RUN_LOST,   // Packet without sync byte.
+        RUN_EOF,    // End of file in the middle of a packet.
+        RUN_LIMIT,  // Valid packet at the specified limit, the run continues.
+    };
+
+    // Result of a synchronization search with a full synchronization buffer.
+    struct SyncPoint
+    {
+        uint64_t resync;  // Position of the synchronization buffer.
+        uint64_t start;   // Position of the first packet.
+        size_t   format;  // Index of the packet format, NPOS if not found.
+    };
+
+    // A run of contiguous packets with a sync byte.
+    struct PacketRun
+    {
+        uint64_t start;   // Position of the first packet.
+        uint64_t end;     // Position after the last valid packet.
+        size_t   format;  // Index of the packet format.
+        RunEnd   reason;  // How the run ends.
+    };
+
+    class Scanner
+    {
+        TS_NOBUILD_NOCOPY(Scanner);
+    public:
+        Scanner(const Options& opt, const PacketFormatList& formats, const MappedFile& file) :
+            _formats(formats),
+            _data(file.data()),
+            _size(file.size()),
+            _sync_buf_size(opt.sync_size + opt.contig_size),
+            _search_size(opt.contig_size)
+        {
+        }
+
+        // Check if a synchronization search at the specified position uses a full synchronization buffer.
+        bool fullSync(uint64_t pos) const { return pos + _sync_buf_size <= _size; }
+
+        // Search synchronization from the specified position, with a full synchronization buffer.
+        SyncPoint findSync(uint64_t pos) const;
+
+        // Follow a run of packets from the specified position until the limit or a non-valid packet.
+        PacketRun followRun(uint64_t start, size_t format, uint64_t limit) const;
+
+    private:
+        const PacketFormatList& _formats;
+        const uint8_t* const    _data;
+        const uint64_t          _size;
+        const size_t            _sync_buf_size;
+        const size_t            _search_size;
+    };
+
+    SyncPoint Scanner::findSync(uint64_t pos) const
+    {
+        assert(fullSync(pos));
+        SyncPoint sp = {pos, pos, 0};
+        const size_t offset = FindSync(_data + pos, _sync_buf_size, _search_size, _formats, sp.format);
+        if (offset == ts::NPOS) {
+            sp.format = ts::NPOS;
+        }
+        else {
+            sp.start = pos + offset;
+        }
+        return sp;
+    }
+
+    PacketRun Scanner::followRun(uint64_t start, size_t format, uint64_t limit) const
+    {
+        const PacketFormat& fmt(_formats[format]);
+        PacketRun run = {start, start, format, RUN_LIMIT};
+        for (;;) {
+            if (run.end + fmt.pkt_size > _size) {
+                run.reason = RUN_EOF;
+                break;
             }
-            std::cerr << std::endl;
+            else if (_data[run.end + fmt.header_size] != ts::SYNC_BYTE) {
+                run.reason = RUN_LOST;
+                break;
+            }
+            else if (run.end >= limit) {
+                run.reason = RUN_LIMIT;
+                break;
+            }
+            run.end += fmt.pkt_size;
         }
+        return run;
+    }
+}
+
 
-        // Output initial sync buffer, starting at first valid packet, writing all valid packets
-        while (start <= sync_end - resync.inputPacketSize() && start[resync.inputHeaderSize()] == ts::SYNC_BYTE) {
-            if (!resync.writePacket(start)) {
+//----------------------------------------------------------------------------
+// Chain of synchronization searches in one chunk of the file, in a separate thread.
+//----------------------------------------------------------------------------
+
+namespace {
+    class ResyncChunk: private ts::Thread
+    {
+        TS_NOBUILD_NOCOPY(ResyncChunk);
+    public:
+        // Constructor: follow synchronization from start (included) to end (excluded).
+        ResyncChunk(const Scanner& scanner, uint64_t start, uint64_t end);
+        virtual ~ResyncChunk() override;
+
+        // Start, abort and wait for the processing.
+        using ts::Thread::start;
+        using ts::Thread::waitForTermination;
+        void abort() { _abort = true; }
+
+        // Results, after termination. Return a null pointer if not found.
+        const SyncPoint* findSync(uint64_t pos) const;
+        const PacketRun* findRun(uint64_t pos, size_t format, size_t pkt_size) const;
+
+    private:
+        const Scanner&         _scanner;
+        const uint64_t         _start;
+        const uint64_t         _end;
+        volatile bool          _abort;
+        std::vector<SyncPoint> _syncs;  // In increasing positions.
+        std::vector<PacketRun> _runs;   // In increasing positions, not overlapping.
+
+        // Implementation of Thread.
+        virtual void main() override;
+    };
+
+    ResyncChunk::ResyncChunk(const Scanner& scanner, uint64_t start, uint64_t end) :
+        _scanner(scanner),
+        _start(start),
+        _end(end),
+        _abort(false),
+        _syncs(),
+        _runs()
+    {
+    }
+
+    ResyncChunk::~ResyncChunk()
+    {
+        abort();
+        waitForTermination();
+    }
+
+    void ResyncChunk::main()
+    {
+        // The first search in the chunk starts at an arbitrary position. The following ones
+        // start where the synchronization is lost, just like in the sequential processing.
+        uint64_t pos = _start;
+        while (!_abort && pos < _end && _scanner.fullSync(pos)) {
+            const SyncPoint sp(_scanner.findSync(pos));
+            _syncs.push_back(sp);
+            if (sp.format == ts::NPOS) {
+                break;
+            }
+            const PacketRun run(_scanner.followRun(sp.start, sp.format, _end));
+            _runs.push_back(run);
+            if (run.reason != RUN_LOST || run.end <= pos) {
                 break;
             }
-            start += resync.inputPacketSize();
+            pos = run.end;
+        }
+    }
+
+    const SyncPoint* ResyncChunk::findSync(uint64_t pos) const
+    {
+        const auto it = std::lower_bound(_syncs.begin(), _syncs.end(), pos, [](const SyncPoint& sp, uint64_t p) { return sp.resync < p; });
+        return it != _syncs.end() && it->resync == pos ? &*it : nullptr;
+    }
+
+    const PacketRun* ResyncChunk::findRun(uint64_t pos, size_t format, size_t pkt_size) const
+    {
+        // Only the last run starting before pos may contain it.
+        auto it = std::upper_bound(_runs.begin(), _runs.end(), pos, [](uint64_t p, const PacketRun& run) { return p < run.start; });
+        if (it == _runs.begin()) {
+            return nullptr;
         }
-        if (resync.status() != RS_OK) {
-            break;
+        --it;
+        // The run must contain the position, with the same packet format and the same packet alignment.
+        // A run which continues after the position gives the same end, whatever the start of the run.
+        const bool match = it->format == format && pos <= it->end && (pos - it->start) % pkt_size == 0 && (pos < it->end || it->reason != RUN_LIMIT);
+        return match ? &*it : nullptr;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+// Parallel resynchronization of a memory-mapped file.
+// Return false if not possible, in which case nothing was done.
+//----------------------------------------------------------------------------
+
+namespace {
+    bool ParallelResync(Options& opt, Resynchronizer& resync)
+    {
+        MappedFile file;
+        if (!file.open(opt.infile, opt)) {
+            return false;
         }
 
-        // Compact sync buffer
-        if (start >= sync_end) {
-            sync_pre_size = 0;
+        // Split the file into chunks.
+        const size_t count = size_t(std::min<uint64_t>(opt.threads, file.size() / MIN_CHUNK_SIZE));
+        if (count < 2) {
+            opt.debug(u"file too small for parallel processing, using sequential processing");
+            return false;
         }
-        else {
-            sync_pre_size = sync_end - start;
-            ::memmove(sync_buf, start, sync_pre_size);
+        opt.debug(u"resynchronizing %'d bytes in %d chunks", {file.size(), count});
+
+        const PacketFormatList formats(GetPacketFormats(opt));
+        const Scanner scanner(opt, formats, file);
+        const uint8_t* const data = file.data();
+        const size_t sync_buf_size = opt.sync_size + opt.contig_size;
+
+        std::vector<uint64_t> bounds(count + 1);
+        for (size_t i = 0; i <= count; ++i) {
+            bounds[i] = (file.size() * i) / count;
         }
 
-        // If more than one packet left, out of sync
-        if (sync_pre_size >= resync.inputPacketSize()) {
-            resync.setStatus(RS_SYNC_LOST);
+        // The first chunk is processed by the main thread, the other ones are prepared by threads.
+        std::vector<ts::SafePtr<ResyncChunk>> chunks(count);
+        for (size_t i = 1; i < count; ++i) {
+            chunks[i] = new ResyncChunk(scanner, bounds[i], bounds[i + 1]);
+            chunks[i]->start();
         }
 
-        // Read the rest of the input file
-        while (resync.status() == RS_OK) {
-            assert(sync_pre_size < resync.inputPacketSize());
-            // Read the next packet
-            const size_t remain_size = resync.inputPacketSize() - sync_pre_size;
-            if (resync.readData(sync_buf + sync_pre_size, remain_size) != remain_size) {
+        // Get the index of the chunk containing a position.
+        const auto chunkIndex = [&bounds, count](uint64_t pos) -> size_t {
+            return std::min<size_t>(count, size_t(std::upper_bound(bounds.begin(), bounds.end(), pos) - bounds.begin())) - 1;
+        };
+
+        size_t sync_pre_size = 0; // Pre-loaded in synchronization buffer in the sequential processing
+        uint64_t pos = 0;         // Position of the synchronization buffer
+        const char* prefix_fn = "first";
+
+        // Follow the same chain of synchronization searches as the sequential processing.
+        do {
+            resync.reset();
+
+            size_t search_size = 0;
+            size_t format = ts::NPOS;
+            uint64_t start = pos;
+
+            if (scanner.fullSync(pos)) {
+                ReportAnalyzing(opt, prefix_fn, sync_buf_size);
+                search_size = opt.contig_size;
+                const size_t index = chunkIndex(pos);
+                const SyncPoint* sp = nullptr;
+                if (index > 0) {
+                    chunks[index]->waitForTermination();
+                    sp = chunks[index]->findSync(pos);
+                }
+                const SyncPoint found(sp != nullptr ? *sp : scanner.findSync(pos));
+                format = found.format;
+                start = found.start;
+            }
+            else {
+                // The sequential processing cannot read a full synchronization buffer, the incomplete
+                // data at end of file are dropped and the search is done in the pre-loaded data only.
+                resync.setStatus(RS_EOF);
+                ReportAnalyzing(opt, prefix_fn, sync_pre_size);
+                search_size = std::min(opt.contig_size, sync_pre_size);
+                const size_t offset = FindSync(data + pos, sync_pre_size, search_size, formats, format);
+                if (offset == ts::NPOS) {
+                    format = ts::NPOS;
+                }
+                else {
+                    start = pos + offset;
+                }
+            }
+
+            if (format == ts::NPOS) {
+                ReportNotFound(search_size);
+                resync.setStatus(RS_ERROR);
+                break;
+            }
+            resync.setPacketFormat(formats[format]);
+            ReportFound(opt, resync, size_t(start - pos));
+
+            const size_t pkt_size = resync.inputPacketSize();
+            const size_t header_size = resync.inputHeaderSize();
+            uint64_t end = start;
+
+            if (resync.status() == RS_EOF) {
+                // Output the valid packets in the pre-loaded data.
+                while (end + pkt_size <= pos + sync_pre_size && data[end + header_size] == ts::SYNC_BYTE && resync.writePacket(data + end)) {
+                    end += pkt_size;
+                }
+                break;
+            }
+
+            // Output all valid packets, reusing the runs of packets from the threads when possible.
+            RunEnd reason = RUN_LIMIT;
+            while (reason == RUN_LIMIT && resync.status() == RS_OK) {
+                const size_t index = chunkIndex(end);
+                const PacketRun* rp = nullptr;
+                if (index > 0) {
+                    chunks[index]->waitForTermination();
+                    rp = chunks[index]->findRun(end, format, pkt_size);
+                }
+                const PacketRun run(rp != nullptr ? *rp : scanner.followRun(end, format, bounds[index + 1]));
+                resync.writePackets(data + end, (run.end - end) / pkt_size);
+                end = run.end;
+                reason = run.reason;
+            }
+            if (resync.status() != RS_OK) {
+                break;
+            }
+
+            if (reason == RUN_EOF) {
                 resync.setStatus(RS_EOF);
             }
-            else if (sync_buf[resync.inputHeaderSize()] != ts::SYNC_BYTE) {
-                std::cerr << ts::UString::Format(u"*** Synchronization lost after %'d TS packets", {resync.outputFilePackets()}) << std::endl
-                          << ts::UString::Format(u"*** Got 0x%X instead of 0x%X at start of TS packet", {sync_buf[resync.inputHeaderSize()], ts::SYNC_BYTE}) << std::endl;
+            else if (end + pkt_size <= pos + sync_buf_size) {
+                // Synchronization lost inside the synchronization buffer, which is pre-loaded for the next search.
                 resync.setStatus(RS_SYNC_LOST);
-                // Will resynchronize with sync buffer pre-loaded
-                sync_pre_size = resync.inputPacketSize();
+                sync_pre_size = size_t(pos + sync_buf_size - end);
             }
             else {
-                resync.writePacket(sync_buf);
-                sync_pre_size = 0;
+                // Synchronization lost after the synchronization buffer, on one packet.
+                ReportLost(resync, data[end + header_size]);
+                resync.setStatus(RS_SYNC_LOST);
+                sync_pre_size = pkt_size;
             }
+            pos = end;
+
+        } while (resync.status() == RS_SYNC_LOST && opt.cont_sync);
+
+        // Stop the threads which are still running.
+        for (size_t i = 1; i < count; ++i) {
+            chunks[i]->abort();
         }
+        return true;
+    }
+}
+
+
+//----------------------------------------------------------------------------
+//  Program entry point
+//----------------------------------------------------------------------------
 
-    } while (resync.status() == RS_OK || (resync.status() == RS_SYNC_LOST && opt.cont_sync));
+int MainCode(int argc, char *argv[])
+{
+    Options opt(argc, argv);
+    ts::InputRedirector input(opt.infile, opt);
+    ts::OutputRedirector output(opt.outfile, opt);
+    Resynchronizer resync(opt.keep);
+
+    if (opt.threads <= 1 || !ParallelResync(opt, resync)) {
+        SequentialResync(opt, resync);
+    }
+    resync.flush();
 
     if (opt.verbose()) {
         std::cerr << ts::UString::Format(u"* Output %'d bytes, %'d %d-byte packets", {resync.outputFileBytes(), resync.outputFilePackets(), resync.outputPacketSize()})
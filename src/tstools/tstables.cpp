@@ -33,9 +33,9 @@
 
 #include "tsMain.h"
 #include "tsDuckContext.h"
-#include "tsInputRedirector.h"
 #include "tsTablesLogger.h"
 #include "tsPagerArgs.h"
+#include "tsTSPacketReader.h"
 TSDUCK_SOURCE;
 TS_MAIN(MainCode);
 
@@ -107,8 +107,12 @@ Options::Options(int argc, char *argv[]) :
 int MainCode(int argc, char *argv[])
 {
     Options opt(argc, argv);
-    ts::InputRedirector input(opt.infile, opt);
-    ts::TSPacket pkt;
+    ts::TSPacketReader input;
+    const ts::TSPacket* pkt = nullptr;
+
+    if (!input.open(opt.infile, opt)) {
+        return EXIT_FAILURE;
+    }
 
     // Redirect display on pager process or stdout only.
     opt.duck.setOutput(&opt.pager.output(opt), false);
@@ -117,8 +121,8 @@ int MainCode(int argc, char *argv[])
     if (!opt.logger.open()) {
         return EXIT_FAILURE;
     }
-    while (!opt.logger.completed() && pkt.read(std::cin, true, opt)) {
-        opt.logger.feedPacket(pkt);
+    while (!opt.logger.completed() && (pkt = input.read(opt)) != nullptr) {
+        opt.logger.feedPacket(*pkt);
     }
     opt.logger.close();
 
@@ -0,0 +1,200 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for CRC32 computation.
+//
+//----------------------------------------------------------------------------
+
+#include "tsCRC32.h"
+#include "tsByteBlock.h"
+#include "tsSystemRandomGenerator.h"
+#include "tsunit.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class CRC32Test: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testReference();
+    void testImplementations();
+    void testIncremental();
+    void testUpdate();
+
+    TSUNIT_TEST_BEGIN(CRC32Test);
+    TSUNIT_TEST(testReference);
+    TSUNIT_TEST(testImplementations);
+    TSUNIT_TEST(testIncremental);
+    TSUNIT_TEST(testUpdate);
+    TSUNIT_TEST_END();
+
+private:
+    static const ts::CRC32::Implementation _impls[];
+    static const size_t _impls_count;
+};
+
+TSUNIT_REGISTER(CRC32Test);
+
+const ts::CRC32::Implementation CRC32Test::_impls[] = {
+    ts::CRC32::BYTEWISE,
+    ts::CRC32::SLICING8,
+    ts::CRC32::CLMUL,
+    ts::CRC32::FASTEST,
+};
+
+const size_t CRC32Test::_impls_count = sizeof(_impls) / sizeof(_impls[0]);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void CRC32Test::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void CRC32Test::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+// Larger than the maximum section size.
+#define ZEROS_TEST_SIZE 9000
+
+void CRC32Test::testReference()
+{
+    // Standard check value of CRC-32/MPEG-2.
+    static const char check[] = "123456789";
+
+    // Check value, repeated to be large enough for all implementations.
+    ts::ByteBlock data;
+    for (size_t i = 0; i < 20; ++i) {
+        data.append(check, 9);
+    }
+
+    for (size_t i = 0; i < _impls_count; ++i) {
+        ts::CRC32 crc;
+        crc.add(check, 9, _impls[i]);
+        TSUNIT_EQUAL(0x0376E6E7, crc.value());
+
+        ts::CRC32 crc0;
+        crc0.add(data.data(), data.size(), ts::CRC32::BYTEWISE);
+        ts::CRC32 crc1;
+        crc1.add(data.data(), data.size(), _impls[i]);
+        TSUNIT_EQUAL(crc0.value(), crc1.value());
+    }
+
+    TSUNIT_ASSERT(ts::CRC32::IsSupported(ts::CRC32::BYTEWISE));
+    TSUNIT_ASSERT(ts::CRC32::IsSupported(ts::CRC32::SLICING8));
+    TSUNIT_ASSERT(ts::CRC32::IsSupported(ts::CRC32::FASTEST));
+    debug() << "CRC32Test: carry-less multiplication: " << ts::UString::YesNo(ts::CRC32::IsSupported(ts::CRC32::CLMUL)) << std::endl;
+}
+
+void CRC32Test::testImplementations()
+{
+    ts::SystemRandomGenerator prng;
+    ts::ByteBlock data(5000);
+    TSUNIT_ASSERT(prng.read(data.data(), data.size()));
+
+    // All sizes around the block sizes of the fast implementations, all alignments.
+    for (size_t start = 0; start < 8; ++start) {
+        for (size_t size = 0; size < 300 && start + size <= data.size(); ++size) {
+            const ts::CRC32 ref(&data[start], size);
+            for (size_t i = 0; i < _impls_count; ++i) {
+                ts::CRC32 crc;
+                crc.add(&data[start], size, _impls[i]);
+                TSUNIT_EQUAL(ref.value(), crc.value());
+            }
+        }
+    }
+
+    // Largest section size and beyond.
+    for (size_t size = 4090; size <= data.size(); size += 91) {
+        ts::CRC32 ref;
+        ref.add(data.data(), size, ts::CRC32::BYTEWISE);
+        for (size_t i = 0; i < _impls_count; ++i) {
+            ts::CRC32 crc;
+            crc.add(data.data(), size, _impls[i]);
+            TSUNIT_EQUAL(ref.value(), crc.value());
+        }
+    }
+}
+
+void CRC32Test::testIncremental()
+{
+    ts::SystemRandomGenerator prng;
+    ts::ByteBlock data(1024);
+    TSUNIT_ASSERT(prng.read(data.data(), data.size()));
+
+    const ts::CRC32 ref(data.data(), data.size());
+
+    // Compute the CRC in two parts, possibly using different implementations.
+    for (size_t split = 0; split <= data.size(); split += 13) {
+        for (size_t i1 = 0; i1 < _impls_count; ++i1) {
+            for (size_t i2 = 0; i2 < _impls_count; ++i2) {
+                ts::CRC32 crc;
+                crc.add(data.data(), split, _impls[i1]);
+                crc.add(&data[split], data.size() - split, _impls[i2]);
+                TSUNIT_EQUAL(ref.value(), crc.value());
+            }
+        }
+    }
+}
+
+void CRC32Test::testUpdate()
+{
+    ts::SystemRandomGenerator prng;
+    ts::ByteBlock data(ZEROS_TEST_SIZE);
+    ts::ByteBlock patch(16);
+    TSUNIT_ASSERT(prng.read(data.data(), data.size()));
+
+    // Patch a few bytes at various places, including beyond the maximum section size.
+    for (size_t offset = 0; offset < data.size(); offset += 97) {
+        for (size_t size = 0; size <= patch.size() && offset + size <= data.size(); size += 5) {
+            TSUNIT_ASSERT(prng.read(patch.data(), patch.size()));
+            const uint32_t before = ts::CRC32(data.data(), data.size()).value();
+            ts::ByteBlock modified(data);
+            ::memcpy(&modified[offset], patch.data(), size);
+            const uint32_t after = ts::CRC32(modified.data(), modified.size()).value();
+            TSUNIT_EQUAL(after, ts::CRC32::Update(before, &data[offset], &modified[offset], size, data.size() - offset - size));
+        }
+    }
+}
@@ -80,9 +80,12 @@ public:
     virtual void afterTest() override;
 
     void testAES();
+    void testAES_Portable();
+    void testAES_Blocks();
     void testAES_ECB();
     void testAES_CBC();
     void testAES_CTR();
+    void testAES_CTR_Blocks();
     void testAES_CTS1();
     void testAES_CTS2();
     void testAES_CTS3();
@@ -103,9 +106,12 @@ public:
 
     TSUNIT_TEST_BEGIN(CryptoTest);
     TSUNIT_TEST(testAES);
+    TSUNIT_TEST(testAES_Portable);
+    TSUNIT_TEST(testAES_Blocks);
     TSUNIT_TEST(testAES_ECB);
     TSUNIT_TEST(testAES_CBC);
     TSUNIT_TEST(testAES_CTR);
+    TSUNIT_TEST(testAES_CTR_Blocks);
     TSUNIT_TEST(testAES_CTS1);
     TSUNIT_TEST(testAES_CTS2);
     TSUNIT_TEST(testAES_CTS3);
@@ -353,6 +359,60 @@ void CryptoTest::testAES()
     }
 }
 
+void CryptoTest::testAES_Portable()
+{
+    ts::AES aes;
+    aes.useAESInstructions(false);
+    TSUNIT_ASSERT(!aes.usesAESInstructions());
+
+    const size_t tv_count = sizeof(tv_aes) / sizeof(TV_AES);
+    for (size_t tvi = 0; tvi < tv_count; ++tvi) {
+        const TV_AES* tv = tv_aes + tvi;
+        testCipher(aes, tvi, tv_count, tv->key, tv->key_size, tv->plain, sizeof(tv->plain), tv->cipher, sizeof(tv->cipher));
+    }
+}
+
+void CryptoTest::testAES_Blocks()
+{
+    // Compare multi-blocks operations using the AES instructions (when supported) and the portable implementation.
+    ts::SystemRandomGenerator prng;
+    ts::AES fast;
+    ts::AES portable;
+    portable.useAESInstructions(false);
+
+    debug() << "CryptoTest: AES instructions: " << ts::UString::YesNo(fast.usesAESInstructions()) << std::endl;
+
+    // Not a multiple of the number of blocks which are processed in parallel.
+    const size_t count = 37;
+    ts::ByteBlock plain(count * ts::AES::BLOCK_SIZE);
+    ts::ByteBlock cipher1(plain.size());
+    ts::ByteBlock cipher2(plain.size());
+    ts::ByteBlock decipher(plain.size());
+
+    for (size_t key_size = ts::AES::MIN_KEY_SIZE; key_size <= ts::AES::MAX_KEY_SIZE; key_size += 8) {
+        ts::ByteBlock key(key_size);
+        TSUNIT_ASSERT(prng.read(key.data(), key.size()));
+        TSUNIT_ASSERT(prng.read(plain.data(), plain.size()));
+        TSUNIT_ASSERT(fast.setKey(key.data(), key.size()));
+        TSUNIT_ASSERT(portable.setKey(key.data(), key.size()));
+
+        TSUNIT_ASSERT(fast.encryptBlocks(plain.data(), cipher1.data(), count));
+        TSUNIT_ASSERT(portable.encryptBlocks(plain.data(), cipher2.data(), count));
+        TSUNIT_ASSERT(cipher1 == cipher2);
+
+        for (size_t i = 0; i < count; ++i) {
+            uint8_t block[ts::AES::BLOCK_SIZE];
+            TSUNIT_ASSERT(portable.encrypt(&plain[i * ts::AES::BLOCK_SIZE], ts::AES::BLOCK_SIZE, block, sizeof(block)));
+            TSUNIT_ASSERT(::memcmp(block, &cipher1[i * ts::AES::BLOCK_SIZE], ts::AES::BLOCK_SIZE) == 0);
+        }
+
+        TSUNIT_ASSERT(fast.decryptBlocks(cipher1.data(), decipher.data(), count));
+        TSUNIT_ASSERT(decipher == plain);
+        TSUNIT_ASSERT(portable.decryptBlocks(cipher1.data(), decipher.data(), count));
+        TSUNIT_ASSERT(decipher == plain);
+    }
+}
+
 void CryptoTest::testAES_ECB()
 {
     ts::ECB<ts::AES> ecb_aes;
@@ -383,6 +443,43 @@ void CryptoTest::testAES_CTR()
     }
 }
 
+void CryptoTest::testAES_CTR_Blocks()
+{
+    // Compare CTR mode on many blocks with a manual implementation, block per block.
+    ts::SystemRandomGenerator prng;
+    ts::CTR<ts::AES> ctr_aes;
+    ts::AES aes;
+    ts::ByteBlock key(16);
+    ts::ByteBlock iv(16);
+    ts::ByteBlock plain(1000);
+    ts::ByteBlock cipher(plain.size());
+    ts::ByteBlock expected(plain.size());
+
+    TSUNIT_ASSERT(prng.read(key.data(), key.size()));
+    TSUNIT_ASSERT(prng.read(iv.data(), iv.size()));
+    TSUNIT_ASSERT(prng.read(plain.data(), plain.size()));
+
+    // Force carries in the 64-bit counter.
+    iv[14] = iv[15] = 0xFE;
+
+    TSUNIT_ASSERT(ctr_aes.setKey(key.data(), key.size()));
+    TSUNIT_ASSERT(ctr_aes.setIV(iv.data(), iv.size()));
+    TSUNIT_ASSERT(ctr_aes.encrypt(plain.data(), plain.size(), cipher.data(), cipher.size()));
+
+    TSUNIT_ASSERT(aes.setKey(key.data(), key.size()));
+    ts::ByteBlock counter(iv);
+    for (size_t start = 0; start < plain.size(); start += 16) {
+        uint8_t mask[16];
+        TSUNIT_ASSERT(aes.encrypt(counter.data(), counter.size(), mask, sizeof(mask)));
+        for (size_t i = start; i < std::min(start + 16, plain.size()); ++i) {
+            expected[i] = plain[i] ^ mask[i - start];
+        }
+        for (size_t i = 15; i >= 8 && ++counter[i] == 0; --i) {
+        }
+    }
+    TSUNIT_ASSERT(cipher == expected);
+}
+
 void CryptoTest::testAES_CTS1()
 {
     ts::CTS1<ts::AES> cts1_aes;
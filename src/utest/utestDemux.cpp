@@ -43,6 +43,7 @@
 #include "tsTOT.h"
 #include "tsTDT.h"
 #include "tsNames.h"
+#include "tsPIDTable.h"
 #include "tsunit.h"
 TSDUCK_SOURCE;
 
@@ -91,6 +92,9 @@ public:
     void testTDT();
     void testTOT();
     void testHEVC();
+    void testPIDTable();
+    void testManyPIDs();
+    void testNewVersion();
 
     TSUNIT_TEST_BEGIN(DemuxTest);
     TSUNIT_TEST(testPAT);
@@ -104,6 +108,9 @@ public:
     TSUNIT_TEST(testTDT);
     TSUNIT_TEST(testTOT);
     TSUNIT_TEST(testHEVC);
+    TSUNIT_TEST(testPIDTable);
+    TSUNIT_TEST(testManyPIDs);
+    TSUNIT_TEST(testNewVersion);
     TSUNIT_TEST_END();
 
 private:
@@ -488,3 +495,237 @@ void DemuxTest::testHEVC()
 {
     TEST_TABLE("PMT with HEVC descriptor", pmt_hevc);
 }
+
+void DemuxTest::testPIDTable()
+{
+    ts::PIDTable<int> table;
+    TSUNIT_ASSERT(table.empty());
+    TSUNIT_EQUAL(0, table.size());
+    TSUNIT_EQUAL(ts::PID_MAX, table.first());
+    TSUNIT_ASSERT(table.get(100) == nullptr);
+    TSUNIT_ASSERT(table.get(ts::PID_MAX) == nullptr);
+
+    table[ts::PID_NULL] = 3;
+    table[100] = 2;
+    table[0] = 1;
+    int* p = table.get(100);
+    TSUNIT_ASSERT(p != nullptr);
+    TSUNIT_EQUAL(2, *p);
+    TSUNIT_EQUAL(3, table.size());
+    TSUNIT_ASSERT(table.contains(0));
+    TSUNIT_ASSERT(!table.contains(1));
+
+    // Iteration in increasing PID order, contexts do not move.
+    std::vector<ts::PID> pids;
+    for (ts::PID pid = table.first(); pid != ts::PID_MAX; pid = table.next(pid)) {
+        pids.push_back(pid);
+    }
+    TSUNIT_EQUAL(3, pids.size());
+    TSUNIT_EQUAL(0, pids[0]);
+    TSUNIT_EQUAL(100, pids[1]);
+    TSUNIT_EQUAL(ts::PID_NULL, pids[2]);
+    TSUNIT_ASSERT(&table[100] == p);
+
+    table.erase(100);
+    table.erase(200);
+    TSUNIT_EQUAL(2, table.size());
+    TSUNIT_EQUAL(ts::PID_NULL, table.next(0));
+    TSUNIT_EQUAL(0, table[100]);
+
+    // Explicitly allocated contexts.
+    table.assign(200, new int(5));
+    TSUNIT_EQUAL(4, table.size());
+    TSUNIT_EQUAL(5, table[200]);
+    table.assign(200, new int(6));
+    TSUNIT_EQUAL(4, table.size());
+    TSUNIT_EQUAL(6, table[200]);
+    table.assign(100, nullptr);
+    TSUNIT_EQUAL(3, table.size());
+    TSUNIT_ASSERT(!table.contains(100));
+
+    // Iterators, like a std::map<PID,int*>.
+    pids.clear();
+    int sum = 0;
+    for (auto it = table.begin(); it != table.end(); ++it) {
+        TSUNIT_ASSERT(it->second == table.get(it->first));
+        pids.push_back(it->first);
+        sum += *it->second;
+    }
+    TSUNIT_EQUAL(3, pids.size());
+    TSUNIT_EQUAL(0, pids[0]);
+    TSUNIT_EQUAL(200, pids[1]);
+    TSUNIT_EQUAL(ts::PID_NULL, pids[2]);
+    TSUNIT_EQUAL(10, sum);
+
+    table.clear();
+    TSUNIT_ASSERT(table.empty());
+    TSUNIT_EQUAL(ts::PID_MAX, table.first());
+    TSUNIT_ASSERT(table.begin() == table.end());
+}
+
+namespace {
+    // Count tables and sections from a demux.
+    class DemuxCounter: public ts::TableHandlerInterface, public ts::SectionHandlerInterface
+    {
+    public:
+        DemuxCounter() : tables(0), sections(0) {}
+        size_t tables;
+        size_t sections;
+        virtual void handleTable(ts::SectionDemux&, const ts::BinaryTable&) override { tables++; }
+        virtual void handleSection(ts::SectionDemux&, const ts::Section&) override { sections++; }
+    };
+}
+
+void DemuxTest::testManyPIDs()
+{
+    // Build a multiplex of many PID's, each of them carrying one of the reference tables,
+    // repeated several times.
+    struct RefPackets {
+        const uint8_t* data;
+        size_t size;
+    };
+    static const RefPackets refs[] = {
+        {psi_bat_cplus_packets, sizeof(psi_bat_cplus_packets)},
+        {psi_bat_tvnum_packets, sizeof(psi_bat_tvnum_packets)},
+        {psi_cat_r3_packets, sizeof(psi_cat_r3_packets)},
+        {psi_cat_r6_packets, sizeof(psi_cat_r6_packets)},
+        {psi_nit_tntv23_packets, sizeof(psi_nit_tntv23_packets)},
+        {psi_pat_r4_packets, sizeof(psi_pat_r4_packets)},
+        {psi_pmt_planete_packets, sizeof(psi_pmt_planete_packets)},
+        {psi_sdt_r3_packets, sizeof(psi_sdt_r3_packets)},
+        {psi_tdt_tnt_packets, sizeof(psi_tdt_tnt_packets)},
+        {psi_tot_tnt_packets, sizeof(psi_tot_tnt_packets)},
+        {psi_pmt_hevc_packets, sizeof(psi_pmt_hevc_packets)},
+    };
+    static const size_t refs_count = sizeof(refs) / sizeof(refs[0]);
+    static const size_t groups = 40;
+    static const size_t repeat = 50;
+
+    // Each stream is one reference table on its own PID, repeated with a continuous CC.
+    std::vector<ts::TSPacketVector> streams;
+    for (size_t g = 0; g < groups; ++g) {
+        for (size_t r = 0; r < refs_count; ++r) {
+            const ts::TSPacket* ref = reinterpret_cast<const ts::TSPacket*>(refs[r].data);
+            const size_t count = refs[r].size / ts::PKT_SIZE;
+            streams.resize(streams.size() + 1);
+            ts::TSPacketVector& st(streams.back());
+            for (size_t i = 0; i < repeat * count; ++i) {
+                st.push_back(ref[i % count]);
+                st.back().setPID(ts::PID(0x0100 + g * refs_count + r));
+                st.back().setCC(uint8_t(i & ts::CC_MASK));
+            }
+        }
+    }
+
+    // Interleave all streams.
+    ts::TSPacketVector mux;
+    size_t sections_per_round = 0;
+    for (size_t i = 0; ; ++i) {
+        const size_t prev = mux.size();
+        for (size_t si = 0; si < streams.size(); ++si) {
+            if (i < streams[si].size()) {
+                mux.push_back(streams[si][i]);
+            }
+        }
+        if (mux.size() == prev) {
+            break;
+        }
+    }
+
+    // Reference: number of sections in one repetition of the multiplex.
+    for (size_t r = 0; r < refs_count; ++r) {
+        ts::DuckContext duck;
+        DemuxCounter counter;
+        ts::SectionDemux demux(duck, nullptr, &counter, ts::AllPIDs);
+        const ts::TSPacket* ref = reinterpret_cast<const ts::TSPacket*>(refs[r].data);
+        for (size_t i = 0; i < refs[r].size / ts::PKT_SIZE; ++i) {
+            demux.feedPacket(ref[i]);
+        }
+        sections_per_round += groups * counter.sections;
+    }
+
+    // Without section handler, repeated sections are only checked, not rebuilt.
+    {
+        ts::DuckContext duck;
+        DemuxCounter counter;
+        ts::SectionDemux demux(duck, &counter, nullptr, ts::AllPIDs);
+        for (size_t i = 0; i < mux.size(); ++i) {
+            demux.feedPacket(mux[i]);
+        }
+        TSUNIT_ASSERT(!demux.hasErrors());
+        TSUNIT_ASSERT(counter.tables >= groups * refs_count);
+    }
+
+    // With section handler, all sections are rebuilt.
+    ts::DuckContext duck;
+    DemuxCounter counter;
+    ts::SectionDemux demux(duck, &counter, &counter, ts::AllPIDs);
+    for (size_t i = 0; i < mux.size(); ++i) {
+        demux.feedPacket(mux[i]);
+    }
+    TSUNIT_ASSERT(!demux.hasErrors());
+    TSUNIT_EQUAL(repeat * sections_per_round, counter.sections);
+    TSUNIT_ASSERT(counter.tables >= groups * refs_count);
+
+    // Reset of individual PID's and of the complete demux.
+    demux.resetPID(0x0100);
+    demux.reset();
+    counter.sections = 0;
+    for (size_t i = 0; i < mux.size() && i < 1000; ++i) {
+        demux.feedPacket(mux[i]);
+    }
+    TSUNIT_ASSERT(counter.sections > 0);
+}
+
+namespace {
+    // Keep all tables from a demux.
+    class DemuxKeeper: public ts::TableHandlerInterface
+    {
+    public:
+        DemuxKeeper() : tables() {}
+        ts::BinaryTablePtrVector tables;
+        virtual void handleTable(ts::SectionDemux&, const ts::BinaryTable& table) override { tables.push_back(new ts::BinaryTable(table, ts::SHARE)); }
+    };
+}
+
+void DemuxTest::testNewVersion()
+{
+    // Successive versions of a PAT with two sections. The sections of the previous
+    // versions are still referenced by the application when a new version starts.
+    ts::DuckContext duck;
+    ts::TSPacketVector packets;
+    for (uint8_t version = 0; version < 3; ++version) {
+        ts::PAT pat(version, true, 1);
+        for (uint16_t srv = 1; srv <= 400; ++srv) {
+            pat.pmts[srv] = ts::PID(0x1000 + srv + version);
+        }
+        ts::OneShotPacketizer pzer(ts::PID_PAT);
+        ts::TSPacketVector pkts;
+        pzer.addTable(duck, pat);
+        pzer.getPackets(pkts);
+        packets.insert(packets.end(), pkts.begin(), pkts.end());
+    }
+    for (size_t i = 0; i < packets.size(); ++i) {
+        packets[i].setCC(uint8_t(i & ts::CC_MASK));
+    }
+
+    DemuxKeeper keeper;
+    ts::SectionDemux demux(duck, &keeper);
+    demux.addPID(ts::PID_PAT);
+    for (size_t i = 0; i < packets.size(); ++i) {
+        demux.feedPacket(packets[i]);
+    }
+    TSUNIT_ASSERT(!demux.hasErrors());
+    TSUNIT_EQUAL(3, keeper.tables.size());
+
+    for (uint8_t version = 0; version < 3; ++version) {
+        const ts::BinaryTable& table(*keeper.tables[version]);
+        TSUNIT_ASSERT(table.isValid());
+        TSUNIT_EQUAL(2, table.sectionCount());
+        TSUNIT_EQUAL(version, table.version());
+        ts::PAT pat(duck, table);
+        TSUNIT_ASSERT(pat.isValid());
+        TSUNIT_EQUAL(400, pat.pmts.size());
+        TSUNIT_EQUAL(ts::PID(0x1001 + version), pat.pmts[1]);
+    }
+}
@@ -0,0 +1,260 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::EITProcessor
+//
+//----------------------------------------------------------------------------
+
+#include "tsEITProcessor.h"
+#include "tsEIT.h"
+#include "tsOneShotPacketizer.h"
+#include "tsSectionDemux.h"
+#include "tsBinaryTable.h"
+#include "tsDuckContext.h"
+#include "tsCRC32.h"
+#include "tsunit.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class EITProcessorTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testPassThrough();
+    void testRename();
+    void testRenameTwice();
+    void testStartTime();
+
+    TSUNIT_TEST_BEGIN(EITProcessorTest);
+    TSUNIT_TEST(testPassThrough);
+    TSUNIT_TEST(testRename);
+    TSUNIT_TEST(testRenameTwice);
+    TSUNIT_TEST(testStartTime);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(EITProcessorTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void EITProcessorTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void EITProcessorTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Reference start time of the first event.
+    const ts::Time FirstStart(2020, 3, 15, 12, 30, 0);
+
+    // Build a packetized EIT p/f with two events.
+    void BuildEIT(ts::DuckContext& duck, ts::TSPacketVector& packets)
+    {
+        ts::EIT eit(true, true, 0, 7, true, 0x1234, 0x0010, 0x0020);
+        for (uint16_t id = 0; id < 2; ++id) {
+            ts::EIT::Event& ev(eit.events[id]);
+            ev.event_id = 100 + id;
+            ev.start_time = FirstStart + id * ts::MilliSecPerHour;
+            ev.duration = 3600;
+            ev.running_status = id == 0 ? 4 : 1;
+        }
+        ts::BinaryTable table;
+        eit.serialize(duck, table);
+        TSUNIT_ASSERT(table.isValid());
+
+        ts::OneShotPacketizer pzer(ts::PID_EIT);
+        pzer.addTable(table);
+        pzer.getPackets(packets);
+        TSUNIT_ASSERT(!packets.empty());
+    }
+
+    // Collect sections with a valid CRC32.
+    class SectionCollector: public ts::SectionHandlerInterface
+    {
+    public:
+        ts::SectionPtrVector sections;
+        SectionCollector() : sections() {}
+        virtual void handleSection(ts::SectionDemux& demux, const ts::Section& section) override
+        {
+            sections.push_back(ts::SectionPtr(new ts::Section(section, ts::COPY)));
+        }
+    };
+
+    // Process a packetized EIT and return the output sections.
+    void Process(ts::DuckContext& duck, ts::EITProcessor& proc, const ts::TSPacketVector& input, ts::SectionPtrVector& output)
+    {
+        SectionCollector collector;
+        ts::SectionDemux demux(duck, nullptr, &collector);
+        demux.addPID(ts::PID_EIT);
+
+        // Feed the input twice, the output is delayed by one packet at most.
+        for (size_t repeat = 0; repeat < 2; ++repeat) {
+            for (size_t i = 0; i < input.size(); ++i) {
+                ts::TSPacket pkt(input[i]);
+                proc.processPacket(pkt);
+                demux.feedPacket(pkt);
+            }
+        }
+        output = collector.sections;
+        TSUNIT_ASSERT(!output.empty());
+    }
+}
+
+void EITProcessorTest::testPassThrough()
+{
+    ts::DuckContext duck;
+    ts::TSPacketVector input;
+    BuildEIT(duck, input);
+
+    ts::SectionPtrVector ref;
+    ts::SectionPtrVector output;
+    ts::EITProcessor proc_ref(duck);
+    proc_ref.keepService(0x1234);
+    Process(duck, proc_ref, input, ref);
+
+    // Renaming another service does not modify the section.
+    ts::EITProcessor proc(duck);
+    ts::Service other(0x4321);
+    ts::Service renamed(0x5678);
+    proc.renameService(other, renamed);
+    Process(duck, proc, input, output);
+
+    TSUNIT_EQUAL(ref.size(), output.size());
+    TSUNIT_ASSERT(*ref[0] == *output[0]);
+    TSUNIT_EQUAL(0x1234, output[0]->tableIdExtension());
+}
+
+void EITProcessorTest::testRename()
+{
+    ts::DuckContext duck;
+    ts::TSPacketVector input;
+    BuildEIT(duck, input);
+
+    ts::EITProcessor proc(duck);
+    ts::Service old_srv(0x1234);
+    ts::Service new_srv(0x0ABC);
+    new_srv.setTSId(0x0011);
+    new_srv.setONId(0x0022);
+    proc.renameService(old_srv, new_srv);
+
+    ts::SectionPtrVector output;
+    Process(duck, proc, input, output);
+
+    // The demux has checked the updated CRC32.
+    const ts::Section& sec(*output[0]);
+    TSUNIT_ASSERT(sec.isValid());
+    TSUNIT_EQUAL(0x0ABC, sec.tableIdExtension());
+    TSUNIT_EQUAL(0x0011, ts::GetUInt16(sec.payload()));
+    TSUNIT_EQUAL(0x0022, ts::GetUInt16(sec.payload() + 2));
+    TSUNIT_EQUAL(ts::CRC32(sec.content(), sec.size() - 4).value(), ts::GetUInt32(sec.content() + sec.size() - 4));
+}
+
+void EITProcessorTest::testRenameTwice()
+{
+    ts::DuckContext duck;
+    ts::TSPacketVector input;
+    BuildEIT(duck, input);
+
+    // Same rename twice (as done by tsrename on each PAT version) and an overlapping rename.
+    ts::EITProcessor proc(duck);
+    ts::Service old_srv(0x1234);
+    ts::Service new_srv(0x0ABC);
+    new_srv.setTSId(0x0011);
+    ts::Service new_onid;
+    new_onid.setTSId(0x0033);
+    new_onid.setONId(0x0022);
+    proc.renameService(old_srv, new_srv);
+    proc.renameService(old_srv, new_srv);
+    proc.renameService(old_srv, new_onid);
+
+    ts::SectionPtrVector output;
+    Process(duck, proc, input, output);
+
+    const ts::Section& sec(*output[0]);
+    TSUNIT_ASSERT(sec.isValid());
+    TSUNIT_EQUAL(0x0ABC, sec.tableIdExtension());
+    TSUNIT_EQUAL(0x0033, ts::GetUInt16(sec.payload()));
+    TSUNIT_EQUAL(0x0022, ts::GetUInt16(sec.payload() + 2));
+    TSUNIT_EQUAL(ts::CRC32(sec.content(), sec.size() - 4).value(), ts::GetUInt32(sec.content() + sec.size() - 4));
+}
+
+void EITProcessorTest::testStartTime()
+{
+    ts::DuckContext duck;
+    ts::TSPacketVector input;
+    BuildEIT(duck, input);
+
+    ts::EITProcessor proc(duck);
+    proc.addStartTimeOffet(2 * ts::MilliSecPerDay + 5 * ts::MilliSecPerMin);
+
+    ts::SectionPtrVector output;
+    Process(duck, proc, input, output);
+
+    // An EIT p/f always has two sections.
+    TSUNIT_ASSERT(output.size() >= 2);
+    ts::BinaryTable table;
+    table.addSection(output[0]);
+    table.addSection(output[1]);
+    TSUNIT_ASSERT(table.isValid());
+    ts::EIT eit(duck, table);
+    TSUNIT_ASSERT(eit.isValid());
+    TSUNIT_EQUAL(0x1234, eit.service_id);
+    TSUNIT_EQUAL(2, eit.events.size());
+    TSUNIT_ASSERT(eit.events[0].start_time == FirstStart + 2 * ts::MilliSecPerDay + 5 * ts::MilliSecPerMin);
+    TSUNIT_ASSERT(eit.events[1].start_time == FirstStart + 2 * ts::MilliSecPerDay + 65 * ts::MilliSecPerMin);
+
+    // Date only: the hours and minutes are unchanged.
+    ts::EITProcessor proc_date(duck);
+    proc_date.addStartTimeOffet(-3 * ts::MilliSecPerDay, true);
+    Process(duck, proc_date, input, output);
+    table.clear();
+    table.addSection(output[0]);
+    table.addSection(output[1]);
+    ts::EIT eit_date(duck, table);
+    TSUNIT_ASSERT(eit_date.isValid());
+    TSUNIT_ASSERT(eit_date.events[0].start_time == FirstStart - 3 * ts::MilliSecPerDay);
+}
@@ -0,0 +1,217 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::LatencyHistogram
+//
+//----------------------------------------------------------------------------
+
+#include "tsLatencyHistogram.h"
+#include "tsThread.h"
+#include "tsunit.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class LatencyHistogramTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testEmpty();
+    void testSmallValues();
+    void testPrecision();
+    void testPercentile();
+    void testReset();
+    void testConcurrent();
+
+    TSUNIT_TEST_BEGIN(LatencyHistogramTest);
+    TSUNIT_TEST(testEmpty);
+    TSUNIT_TEST(testSmallValues);
+    TSUNIT_TEST(testPrecision);
+    TSUNIT_TEST(testPercentile);
+    TSUNIT_TEST(testReset);
+    TSUNIT_TEST(testConcurrent);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(LatencyHistogramTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void LatencyHistogramTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void LatencyHistogramTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void LatencyHistogramTest::testEmpty()
+{
+    ts::LatencyHistogram h;
+    TSUNIT_EQUAL(0, h.count());
+    TSUNIT_EQUAL(0, h.minimum());
+    TSUNIT_EQUAL(0, h.maximum());
+    TSUNIT_EQUAL(0, h.mean());
+    TSUNIT_EQUAL(0, h.percentile(50.0));
+    TSUNIT_EQUAL(u"no data", h.toString());
+}
+
+void LatencyHistogramTest::testSmallValues()
+{
+    // Values below the number of sub-buckets are exact.
+    ts::LatencyHistogram h;
+    for (ts::NanoSecond i = 0; i < 8; ++i) {
+        h.add(i);
+    }
+    h.add(-5);  // recorded as zero
+    TSUNIT_EQUAL(9, h.count());
+    TSUNIT_EQUAL(0, h.minimum());
+    TSUNIT_EQUAL(7, h.maximum());
+    TSUNIT_EQUAL(0, h.percentile(0.0));
+    TSUNIT_EQUAL(0, h.percentile(20.0));
+    TSUNIT_EQUAL(3, h.percentile(50.0));
+    TSUNIT_EQUAL(7, h.percentile(100.0));
+}
+
+void LatencyHistogramTest::testPrecision()
+{
+    // A single value is reported with a relative error of at most 1/8 on all ranges.
+    for (ts::NanoSecond value = 1; value < ts::NanoSecond(1) << 62; value = value * 3 + 1) {
+        ts::LatencyHistogram h;
+        h.add(value);
+        h.add(ts::NanoSecond(1) << 62);
+        const ts::NanoSecond p = h.percentile(50.0);
+        TSUNIT_ASSERT(p >= value);
+        TSUNIT_ASSERT(p - value <= value / 8);
+        TSUNIT_EQUAL(value, h.minimum());
+    }
+}
+
+void LatencyHistogramTest::testPercentile()
+{
+    ts::LatencyHistogram h;
+    for (ts::NanoSecond i = 1; i <= 10000; ++i) {
+        h.add(i * ts::NanoSecPerMicroSec);
+    }
+    TSUNIT_EQUAL(10000, h.count());
+    TSUNIT_EQUAL(ts::NanoSecPerMicroSec, h.minimum());
+    TSUNIT_EQUAL(10000 * ts::NanoSecPerMicroSec, h.maximum());
+    TSUNIT_EQUAL(5000500, h.mean());
+    TSUNIT_EQUAL(10000 * ts::NanoSecPerMicroSec, h.percentile(100.0));
+
+    const double percents[] = {10.0, 50.0, 90.0, 99.0, 99.9};
+    for (size_t i = 0; i < sizeof(percents) / sizeof(percents[0]); ++i) {
+        const ts::NanoSecond expected = ts::NanoSecond(percents[i] * 100.0) * ts::NanoSecPerMicroSec;
+        const ts::NanoSecond p = h.percentile(percents[i]);
+        debug() << "LatencyHistogramTest::testPercentile: p" << percents[i] << " = " << p << ", expected " << expected << std::endl;
+        TSUNIT_ASSERT(p >= expected);
+        TSUNIT_ASSERT(p - expected <= expected / 8);
+    }
+
+    debug() << "LatencyHistogramTest::testPercentile: " << h.toString() << std::endl;
+    TSUNIT_ASSERT(h.toString().startWith(u"count: 10,000, min: 1,000 ns, mean: 5,000 us, "));
+    TSUNIT_ASSERT(h.toString().endWith(u", max: 10 ms"));
+}
+
+void LatencyHistogramTest::testReset()
+{
+    ts::LatencyHistogram h;
+    h.add(1000);
+    h.add(2000);
+    TSUNIT_EQUAL(2, h.count());
+
+    // The histogram is immediately seen as empty but actually cleared on next value.
+    h.reset();
+    TSUNIT_EQUAL(0, h.count());
+    TSUNIT_EQUAL(0, h.maximum());
+    TSUNIT_EQUAL(0, h.percentile(99.0));
+
+    h.add(500);
+    TSUNIT_EQUAL(1, h.count());
+    TSUNIT_EQUAL(500, h.minimum());
+    TSUNIT_EQUAL(500, h.maximum());
+    TSUNIT_EQUAL(500, h.mean());
+}
+
+namespace {
+    // A thread which writes into a histogram.
+    class Writer: public ts::Thread
+    {
+        TS_NOBUILD_NOCOPY(Writer);
+    public:
+        Writer(ts::LatencyHistogram& histo, size_t count) : ts::Thread(), _histo(histo), _count(count) {}
+        virtual ~Writer() override { waitForTermination(); }
+    private:
+        ts::LatencyHistogram& _histo;
+        size_t _count;
+        virtual void main() override
+        {
+            for (size_t i = 0; i < _count; ++i) {
+                _histo.add(ts::NanoSecond(i % 1000));
+            }
+        }
+    };
+}
+
+void LatencyHistogramTest::testConcurrent()
+{
+    const size_t count = 1000000;
+    ts::LatencyHistogram h;
+    Writer writer(h, count);
+    TSUNIT_ASSERT(writer.start());
+
+    // Read the histogram while being written.
+    uint64_t previous = 0;
+    while (previous < count) {
+        const uint64_t current = h.count();
+        TSUNIT_ASSERT(current >= previous);
+        TSUNIT_ASSERT(h.maximum() < 1000);
+        TSUNIT_ASSERT(h.percentile(99.0) < 1000);
+        previous = current;
+    }
+    writer.waitForTermination();
+    TSUNIT_EQUAL(count, h.count());
+    TSUNIT_EQUAL(0, h.minimum());
+    TSUNIT_EQUAL(999, h.maximum());
+}
@@ -53,11 +53,13 @@ public:
     void testArithmetic();
     void testSysWait();
     void testWait();
+    void testCurrentNanoSeconds();
 
     TSUNIT_TEST_BEGIN(MonotonicTest);
     TSUNIT_TEST(testArithmetic);
     TSUNIT_TEST(testSysWait);
     TSUNIT_TEST(testWait);
+    TSUNIT_TEST(testCurrentNanoSeconds);
     TSUNIT_TEST_END();
 private:
     ts::NanoSecond  _nsPrecision;
@@ -153,3 +155,14 @@ void MonotonicTest::testWait()
     TSUNIT_ASSERT(end >= start + 100 - _msPrecision);
     TSUNIT_ASSUME(end < start + 150);
 }
+
+void MonotonicTest::testCurrentNanoSeconds()
+{
+    const ts::NanoSecond start = ts::Monotonic::CurrentNanoSeconds();
+    ts::SleepThread(100); // milliseconds
+    const ts::NanoSecond end = ts::Monotonic::CurrentNanoSeconds();
+
+    debug() << "MonotonicTest: CurrentNanoSeconds() elapsed = " << ts::UString::Decimal(end - start) << " ns" << std::endl;
+    TSUNIT_ASSERT(end >= start + 100 * ts::NanoSecPerMilliSec - _nsPrecision);
+    TSUNIT_ASSUME(end < start + 150 * ts::NanoSecPerMilliSec);
+}
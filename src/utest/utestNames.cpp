@@ -45,6 +45,8 @@ TSDUCK_SOURCE;
 class NamesTest: public tsunit::Test
 {
 public:
+    NamesTest();
+
     virtual void beforeTest() override;
     virtual void afterTest() override;
 
@@ -83,6 +85,9 @@ public:
     void testAudioType();
     void testT2MIPacketType();
     void testPlatformId();
+    void testSectionHandle();
+    void testImage();
+    void testImageOUI();
 
     TSUNIT_TEST_BEGIN(NamesTest);
     TSUNIT_TEST(testConfigFile);
@@ -120,7 +125,14 @@ public:
     TSUNIT_TEST(testAudioType);
     TSUNIT_TEST(testT2MIPacketType);
     TSUNIT_TEST(testPlatformId);
+    TSUNIT_TEST(testSectionHandle);
+    TSUNIT_TEST(testImage);
+    TSUNIT_TEST(testImageOUI);
     TSUNIT_TEST_END();
+
+private:
+    ts::UString _tempFileName;
+    ts::UString _tempImageName;
 };
 
 TSUNIT_REGISTER(NamesTest);
@@ -130,14 +142,25 @@ TSUNIT_REGISTER(NamesTest);
 // Initialization.
 //----------------------------------------------------------------------------
 
+// Constructor.
+NamesTest::NamesTest() :
+    _tempFileName(ts::TempFile(u".names")),
+    _tempImageName(_tempFileName + ts::Names::IMAGE_SUFFIX)
+{
+}
+
 // Test suite initialization method.
 void NamesTest::beforeTest()
 {
+    ts::DeleteFile(_tempFileName);
+    ts::DeleteFile(_tempImageName);
 }
 
 // Test suite cleanup method.
 void NamesTest::afterTest()
 {
+    ts::DeleteFile(_tempFileName);
+    ts::DeleteFile(_tempImageName);
 }
 
 
@@ -375,3 +398,118 @@ void NamesTest::testPlatformId()
     TSUNIT_EQUAL(u"0x000004 (TV digitale mobile, Telecom Italia)", ts::names::PlatformId(4, ts::names::FIRST));
     TSUNIT_EQUAL(u"VTC Mobile TV (0x704001)", ts::names::PlatformId(0x704001, ts::names::VALUE));
 }
+
+void NamesTest::testSectionHandle()
+{
+    const ts::Names::SectionHandle section(ts::NamesMain::Instance()->sectionHandle(u"StreamType"));
+    TSUNIT_ASSERT(section != nullptr);
+    TSUNIT_ASSERT(section == ts::NamesMain::Instance()->sectionHandle(u" streamtype  "));
+    TSUNIT_ASSERT(section == ts::NamesMain::Instance()->sectionHandle(u"STREAMTYPE"));
+    TSUNIT_ASSERT(ts::NamesMain::Instance()->sectionHandle(u"StreamTypes") == nullptr);
+    TSUNIT_ASSERT(ts::NamesMain::Instance()->sectionHandle(u"") == nullptr);
+
+    TSUNIT_EQUAL(u"MPEG-4 Video", ts::NamesMain::Instance()->nameFromSection(section, ts::ST_MPEG4_VIDEO));
+    TSUNIT_EQUAL(u"MPEG-4 Video (0x10)", ts::NameFromSection(section, uint8_t(ts::ST_MPEG4_VIDEO), ts::names::VALUE));
+    TSUNIT_EQUAL(ts::NameFromSection(u"StreamType", 0x1B), ts::NameFromSection(section, 0x1B));
+    TSUNIT_ASSERT(ts::NamesMain::Instance()->nameExists(section, ts::ST_MPEG4_VIDEO));
+    TSUNIT_EQUAL(u"unknown (0x10)", ts::NamesMain::Instance()->nameFromSection(nullptr, ts::ST_MPEG4_VIDEO, ts::names::NAME, 8));
+    TSUNIT_ASSERT(!ts::NamesMain::Instance()->nameExists(nullptr, ts::ST_MPEG4_VIDEO));
+}
+
+void NamesTest::testImage()
+{
+    TSUNIT_ASSERT(ts::UString::Save(ts::UStringList({
+        u"[Single]",
+        u"Bits = 16",
+        u"0x0001 = One",
+        u"0x0002 = Two",
+        u"0x1000 = Big",
+        u"[Ranges]",
+        u"0x10-0x1F = Ten to fifteen",
+        u"0x20 = Twenty",
+        u"0x30-0x3F = Thirty",
+        u"[Empty]",
+    }), _tempFileName));
+
+    // Without image file, the text file is parsed. The image is built when saved.
+    ts::Names text(_tempFileName);
+    TSUNIT_EQUAL(_tempFileName, text.configurationFile());
+    TSUNIT_ASSERT(text.imageFile().empty());
+    TSUNIT_EQUAL(0, text.errorCount());
+    TSUNIT_ASSERT(text.saveImage(_tempImageName, CERR));
+    const int64_t text_size = ts::GetFileSize(_tempFileName);
+
+    // Now the image file is used.
+    ts::Names image(_tempFileName);
+    TSUNIT_EQUAL(_tempImageName, image.imageFile());
+    TSUNIT_EQUAL(0, image.errorCount());
+
+    const ts::Names* const all[] = {&text, &image};
+    for (size_t i = 0; i < 2; ++i) {
+        const ts::Names& names(*all[i]);
+        TSUNIT_EQUAL(u"One", names.nameFromSection(u"Single", 1));
+        TSUNIT_EQUAL(u"Big (0x1000)", names.nameFromSection(u"single", 0x1000, ts::names::VALUE));
+        TSUNIT_EQUAL(u"unknown (0x0003)", names.nameFromSection(u"Single", 3));
+        TSUNIT_EQUAL(u"Ten to fifteen", names.nameFromSection(u"Ranges", 0x10));
+        TSUNIT_EQUAL(u"Ten to fifteen", names.nameFromSection(u"Ranges", 0x17));
+        TSUNIT_EQUAL(u"Ten to fifteen", names.nameFromSection(u"Ranges", 0x1F));
+        TSUNIT_EQUAL(u"Twenty", names.nameFromSection(u"Ranges", 0x20));
+        TSUNIT_EQUAL(u"Thirty", names.nameFromSection(u"Ranges", 0x3F));
+        TSUNIT_ASSERT(!names.nameExists(u"Ranges", 0x0F));
+        TSUNIT_ASSERT(!names.nameExists(u"Ranges", 0x21));
+        TSUNIT_ASSERT(!names.nameExists(u"Ranges", 0x40));
+        TSUNIT_ASSERT(names.sectionHandle(u"Empty") != nullptr);
+        TSUNIT_ASSERT(!names.nameExists(u"Empty", 0));
+        TSUNIT_ASSERT(names.sectionHandle(u"Other") == nullptr);
+    }
+
+    // A text file which was modified without changing its size does not use the image.
+    TSUNIT_ASSERT(ts::UString::Save(ts::UStringList({
+        u"[Single]",
+        u"Bits = 16",
+        u"0x0001 = Uno",
+        u"0x0002 = Two",
+        u"0x1000 = Big",
+        u"[Ranges]",
+        u"0x10-0x1F = Ten to fifteen",
+        u"0x20 = Twenty",
+        u"0x30-0x3F = Thirty",
+        u"[Empty]",
+    }), _tempFileName));
+    TSUNIT_EQUAL(text_size, ts::GetFileSize(_tempFileName));
+    ts::Names same_size(_tempFileName);
+    TSUNIT_ASSERT(same_size.imageFile().empty());
+    TSUNIT_EQUAL(u"Uno", same_size.nameFromSection(u"Single", 1));
+    TSUNIT_EQUAL(u"Twenty", same_size.nameFromSection(u"Ranges", 0x20));
+
+    // An image which does not match the text file is ignored.
+    TSUNIT_ASSERT(ts::UString::Save(ts::UStringList({u"[Single]", u"0x0001 = Uno"}), _tempFileName));
+    ts::Names modified(_tempFileName);
+    TSUNIT_ASSERT(modified.imageFile().empty());
+    TSUNIT_EQUAL(u"Uno", modified.nameFromSection(u"Single", 1));
+    TSUNIT_ASSERT(modified.sectionHandle(u"Ranges") == nullptr);
+}
+
+void NamesTest::testImageOUI()
+{
+    // Use a copy of the OUI file, the largest one.
+    ts::UStringList lines;
+    TSUNIT_ASSERT(ts::UString::Load(lines, ts::NamesOUI::Instance()->configurationFile()));
+    TSUNIT_ASSERT(ts::UString::Save(lines, _tempFileName));
+
+    ts::Names text(_tempFileName, false, false);
+    TSUNIT_ASSERT(text.imageFile().empty());
+    TSUNIT_ASSERT(text.saveImage(_tempImageName, CERR));
+    ts::Names image(_tempFileName);
+    TSUNIT_EQUAL(_tempImageName, image.imageFile());
+
+    // Same names from the text file and the image.
+    const ts::Names::SectionHandle text_section(text.sectionHandle(u"OUI"));
+    const ts::Names::SectionHandle image_section(image.sectionHandle(u"OUI"));
+    TSUNIT_ASSERT(text_section != nullptr);
+    TSUNIT_ASSERT(image_section != nullptr);
+    for (uint32_t oui = 0; oui < 100000; oui += 97) {
+        TSUNIT_EQUAL(text.nameFromSection(text_section, oui * 167), image.nameFromSection(image_section, oui * 167));
+    }
+    TSUNIT_EQUAL(ts::MICRO_SIGN + ts::UString(u"Tech Tecnologia"), image.nameFromSection(image_section, 0xF8E7B5));
+}
@@ -43,6 +43,7 @@
 #include "tsSysUtils.h"
 #include "tsIPUtils.h"
 #include "tsCerrReport.h"
+#include "tsMonotonic.h"
 #include "utestTSUnitThread.h"
 #include "tsunit.h"
 TSDUCK_SOURCE;
@@ -69,6 +70,7 @@ public:
     void testSocketAddress();
     void testTCPSocket();
     void testUDPSocket();
+    void testUDPSocketBatch();
     void testIPHeader();
 
     TSUNIT_TEST_BEGIN(NetworkingTest);
@@ -81,6 +83,7 @@ public:
     TSUNIT_TEST(testSocketAddress);
     TSUNIT_TEST(testTCPSocket);
     TSUNIT_TEST(testUDPSocket);
+    TSUNIT_TEST(testUDPSocketBatch);
     TSUNIT_TEST(testIPHeader);
     TSUNIT_TEST_END();
 
@@ -680,6 +683,63 @@ void NetworkingTest::testUDPSocket()
     CERR.debug(u"UDPSocketTest: main thread: reply sent");
 }
 
+// Test batch send and receive of UDP messages.
+void NetworkingTest::testUDPSocketBatch()
+{
+    TSUNIT_ASSERT(ts::IPInitialize());
+
+    const uint16_t portNumber = 12346;
+
+    // Create receiver socket
+    ts::UDPSocket rsock(true);
+    TSUNIT_ASSERT(rsock.isOpen());
+    TSUNIT_ASSERT(rsock.reusePort(true, CERR));
+#if defined(TS_LINUX)
+    TSUNIT_ASSERT(rsock.setReceiveTimestamps(true, CERR));
+#endif
+    TSUNIT_ASSERT(rsock.bind(ts::SocketAddress(ts::IPAddress::LocalHost, portNumber), CERR));
+
+    // Create sender socket
+    ts::UDPSocket ssock(true);
+    TSUNIT_ASSERT(ssock.isOpen());
+    TSUNIT_ASSERT(ssock.bind(ts::SocketAddress(ts::IPAddress::LocalHost, ts::SocketAddress::AnyPort), CERR));
+    TSUNIT_ASSERT(ssock.setDefaultDestination(ts::SocketAddress(ts::IPAddress::LocalHost, portNumber), CERR));
+
+    // Send three messages in one call.
+    char out[3][16] = {"first", "second message", "third"};
+    ts::UDPSocket::MessageVector omsg;
+    for (size_t i = 0; i < 3; ++i) {
+        omsg.push_back(ts::UDPSocket::Message(out[i], ::strlen(out[i]) + 1));
+    }
+    TSUNIT_ASSERT(ssock.send(omsg.data(), omsg.size(), CERR));
+
+    // Receive them, possibly in several calls.
+    char in[3][64];
+    ts::UDPSocket::MessageVector imsg;
+    for (size_t i = 0; i < 3; ++i) {
+        imsg.push_back(ts::UDPSocket::Message(in[i], sizeof(in[i])));
+    }
+    size_t received = 0;
+    while (received < 3) {
+        size_t count = 0;
+        TSUNIT_ASSERT(rsock.receive(imsg.data() + received, imsg.size() - received, count, nullptr, CERR));
+        TSUNIT_ASSERT(count > 0);
+        received += count;
+    }
+    TSUNIT_EQUAL(3, received);
+    for (size_t i = 0; i < 3; ++i) {
+        CERR.debug(u"UDPSocketBatchTest: received %d bytes, sender: %s, destination: %s", {imsg[i].size, imsg[i].sender, imsg[i].destination});
+        TSUNIT_EQUAL(::strlen(out[i]) + 1, imsg[i].size);
+        TSUNIT_ASSERT(::memcmp(out[i], in[i], imsg[i].size) == 0);
+        TSUNIT_ASSERT(ts::IPAddress(imsg[i].sender) == ts::IPAddress::LocalHost);
+#if defined(TS_LINUX)
+        // Kernel reception time stamps are in the past of the monotonic clock.
+        TSUNIT_ASSERT(imsg[i].timestamp > 0);
+        TSUNIT_ASSERT(imsg[i].timestamp <= ts::Monotonic::CurrentNanoSeconds());
+#endif
+    }
+}
+
 // Test IP header
 void NetworkingTest::testIPHeader()
 {
@@ -57,14 +57,19 @@ public:
     virtual void afterTest() override;
 
     void testPacketizer();
+    void testRemoveSections();
 
     TSUNIT_TEST_BEGIN(PacketizerTest);
     TSUNIT_TEST(testPacketizer);
+    TSUNIT_TEST(testRemoveSections);
     TSUNIT_TEST_END();
 
 private:
     // Demux one table from a list of packets
     static void DemuxTable(ts::BinaryTablePtr& binTable, const char* name, const uint8_t* packets, size_t packets_size);
+
+    // Build a long section with one TS packet.
+    static ts::SectionPtr MakeSection(ts::TID tid, uint16_t tid_ext, uint8_t section_number);
 };
 
 TSUNIT_REGISTER(PacketizerTest);
@@ -176,3 +181,60 @@ void PacketizerTest::testPacketizer()
     TSUNIT_ASSERT(pmt_count == 4);
     TSUNIT_ASSERT(sdt_count >= 15 && sdt_count <= 18);
 }
+
+// Build a long section with one TS packet.
+ts::SectionPtr PacketizerTest::MakeSection(ts::TID tid, uint16_t tid_ext, uint8_t section_number)
+{
+    const ts::ByteBlock payload(100, uint8_t(tid_ext));
+    return ts::SectionPtr(new ts::Section(tid, true, tid_ext, 1, true, section_number, section_number, payload.data(), payload.size()));
+}
+
+void PacketizerTest::testRemoveSections()
+{
+    // Mix of scheduled and unscheduled sections.
+    ts::CyclingPacketizer pzer(0x0100, ts::CyclingPacketizer::ALWAYS, 1000000);
+    for (uint16_t ext = 0; ext < 10; ++ext) {
+        pzer.addSection(MakeSection(0x50, ext, 0), 500);
+        pzer.addSection(MakeSection(0x51, ext, 0), 0);
+        pzer.addSection(MakeSection(0x52, ext, 0), 1000);
+    }
+    TSUNIT_EQUAL(30, pzer.storedSectionCount());
+
+    std::set<uint32_t> found;
+    ts::TSPacket pkt;
+    for (size_t i = 0; i < 300; ++i) {
+        pzer.getNextPacket(pkt);
+        if (pkt.getPUSI()) {
+            found.insert((uint32_t(pkt.b[5]) << 16) | ts::GetUInt16(pkt.b + 8));
+        }
+    }
+    TSUNIT_EQUAL(30, found.size());
+
+    pzer.removeSections(0x52, 3);
+    TSUNIT_EQUAL(29, pzer.storedSectionCount());
+    pzer.removeSections(0x51);
+    TSUNIT_EQUAL(19, pzer.storedSectionCount());
+    pzer.removeSections(0x53);
+    TSUNIT_EQUAL(19, pzer.storedSectionCount());
+
+    // Change the bitrate to move sections between schedule and unscheduled list.
+    pzer.setBitRate(0);
+    pzer.setBitRate(2000000);
+    pzer.removeSections(0x50, 7);
+    TSUNIT_EQUAL(18, pzer.storedSectionCount());
+
+    found.clear();
+    for (size_t i = 0; i < 3000; ++i) {
+        pzer.getNextPacket(pkt);
+        if (pkt.getPUSI()) {
+            found.insert((uint32_t(pkt.b[5]) << 16) | ts::GetUInt16(pkt.b + 8));
+        }
+    }
+    TSUNIT_EQUAL(18, found.size());
+    TSUNIT_ASSERT(found.find(0x00520003) == found.end());
+    TSUNIT_ASSERT(found.find(0x00500007) == found.end());
+    TSUNIT_ASSERT(found.find(0x00510000) == found.end());
+
+    pzer.removeAll();
+    TSUNIT_EQUAL(0, pzer.storedSectionCount());
+}
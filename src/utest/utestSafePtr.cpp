@@ -33,6 +33,7 @@
 
 #include "tsSafePtr.h"
 #include "tsMutex.h"
+#include "tsThread.h"
 #include "tsunit.h"
 TSDUCK_SOURCE;
 
@@ -51,12 +52,14 @@ public:
     void testDowncast();
     void testUpcast();
     void testChangeMutex();
+    void testConcurrent();
 
     TSUNIT_TEST_BEGIN(SafePtrTest);
     TSUNIT_TEST(testSafePtr);
     TSUNIT_TEST(testDowncast);
     TSUNIT_TEST(testUpcast);
     TSUNIT_TEST(testChangeMutex);
+    TSUNIT_TEST(testConcurrent);
     TSUNIT_TEST_END();
 };
 
@@ -387,3 +390,47 @@ void SafePtrTest::testChangeMutex()
     pt.clear();
     TSUNIT_ASSERT(TestData::InstanceCount() == 0);
 }
+
+// Test case: concurrent copies of a thread-safe pointer from several threads.
+namespace {
+    class CopyThread: public ts::Thread
+    {
+        TS_NOBUILD_NOCOPY(CopyThread);
+    public:
+        CopyThread(const ts::SafePtr<TestData,ts::Mutex>& ptr, size_t count) : ts::Thread(), _ptr(ptr), _count(count) {}
+        virtual ~CopyThread() override { waitForTermination(); }
+    private:
+        ts::SafePtr<TestData,ts::Mutex> _ptr;
+        size_t _count;
+        virtual void main() override
+        {
+            for (size_t i = 0; i < _count; ++i) {
+                ts::SafePtr<TestData,ts::Mutex> p1(_ptr);
+                ts::SafePtr<TestData,ts::Mutex> p2;
+                p2 = p1;
+            }
+            _ptr.clear();
+        }
+    };
+}
+
+void SafePtrTest::testConcurrent()
+{
+    TSUNIT_ASSERT(TestData::InstanceCount() == 0);
+    {
+        ts::SafePtr<TestData,ts::Mutex> ptr(new TestData(12));
+        CopyThread t1(ptr, 100000);
+        CopyThread t2(ptr, 100000);
+        CopyThread t3(ptr, 100000);
+        TSUNIT_ASSERT(t1.start());
+        TSUNIT_ASSERT(t2.start());
+        TSUNIT_ASSERT(t3.start());
+        TSUNIT_ASSERT(t1.waitForTermination());
+        TSUNIT_ASSERT(t2.waitForTermination());
+        TSUNIT_ASSERT(t3.waitForTermination());
+        TSUNIT_EQUAL(1, ptr.count());
+        TSUNIT_EQUAL(12, ptr->value());
+        TSUNIT_ASSERT(TestData::InstanceCount() == 1);
+    }
+    TSUNIT_ASSERT(TestData::InstanceCount() == 0);
+}
@@ -49,9 +49,13 @@ public:
     virtual void afterTest() override;
 
     void testScrambling();
+    void testBatch();
+    void testBatchSizes();
 
     TSUNIT_TEST_BEGIN(ScramblingTest);
     TSUNIT_TEST(testScrambling);
+    TSUNIT_TEST(testBatch);
+    TSUNIT_TEST(testBatchSizes);
     TSUNIT_TEST_END();
 };
 
@@ -211,3 +215,85 @@ void ScramblingTest::testScrambling()
         TSUNIT_ASSERT(::memcmp(pkt.b + header_size, vec->cipher.b + header_size, payload_size) == 0);
     }
 }
+
+void ScramblingTest::testBatch()
+{
+    const ScramblingTestVector* vec = scrambling_test_vectors;
+    size_t count = sizeof(scrambling_test_vectors) / sizeof(ScramblingTestVector);
+    ts::DVBCSA2 scrambler;
+
+    // More than one group of packets in batch mode.
+    const size_t batch_count = ts::DVBCSA2::BATCH_SIZE + 13;
+    ts::TSPacketVector pkt(batch_count);
+    std::vector<void*> data(batch_count);
+    std::vector<size_t> size(batch_count);
+
+    for (size_t ti = 0; ti < count; ++ti, ++vec) {
+
+        const size_t header_size = vec->plain.getHeaderSize();
+        const size_t payload_size = vec->plain.getPayloadSize();
+        const uint8_t scv = vec->cipher.getScrambling();
+
+        TSUNIT_ASSERT(scrambler.setKey(scv == ts::SC_EVEN_KEY ? vec->cw_even : vec->cw_odd, sizeof(vec->cw_even)));
+
+        for (size_t i = 0; i < batch_count; ++i) {
+            data[i] = pkt[i].b + header_size;
+            size[i] = payload_size;
+        }
+
+        // Descrambling test
+        for (size_t i = 0; i < batch_count; ++i) {
+            pkt[i] = vec->cipher;
+        }
+        TSUNIT_ASSERT(scrambler.decryptInPlaceBatch(data.data(), size.data(), batch_count));
+        for (size_t i = 0; i < batch_count; ++i) {
+            TSUNIT_ASSERT(::memcmp(pkt[i].b + header_size, vec->plain.b + header_size, payload_size) == 0);
+        }
+
+        // Scrambling test
+        for (size_t i = 0; i < batch_count; ++i) {
+            pkt[i] = vec->plain;
+        }
+        TSUNIT_ASSERT(scrambler.encryptInPlaceBatch(data.data(), size.data(), batch_count));
+        for (size_t i = 0; i < batch_count; ++i) {
+            TSUNIT_ASSERT(::memcmp(pkt[i].b + header_size, vec->cipher.b + header_size, payload_size) == 0);
+        }
+    }
+}
+
+void ScramblingTest::testBatchSizes()
+{
+    static const uint8_t cw[ts::DVBCSA2::KEY_SIZE] = {0x10, 0x21, 0x32, 0x63, 0x44, 0x55, 0x66, 0xFF};
+    ts::DVBCSA2 scrambler;
+    TSUNIT_ASSERT(scrambler.setKey(cw, sizeof(cw)));
+
+    // All possible payload sizes (0 to 184), compared with one-by-one processing.
+    const size_t batch_count = 185;
+    ts::ByteBlock ref(batch_count * ts::PKT_SIZE);
+    for (size_t i = 0; i < ref.size(); ++i) {
+        ref[i] = uint8_t(i * 7 + i / 13);
+    }
+    ts::ByteBlock batch(ref);
+    ts::ByteBlock single(ref);
+    std::vector<void*> data(batch_count);
+    std::vector<size_t> size(batch_count);
+    for (size_t i = 0; i < batch_count; ++i) {
+        data[i] = &batch[i * ts::PKT_SIZE];
+        size[i] = i;
+    }
+
+    TSUNIT_ASSERT(scrambler.encryptInPlaceBatch(data.data(), size.data(), batch_count));
+    for (size_t i = 0; i < batch_count; ++i) {
+        TSUNIT_ASSERT(scrambler.encryptInPlace(&single[i * ts::PKT_SIZE], i));
+    }
+    TSUNIT_ASSERT(batch == single);
+    TSUNIT_ASSERT(batch != ref);
+
+    TSUNIT_ASSERT(scrambler.decryptInPlaceBatch(data.data(), size.data(), batch_count));
+    TSUNIT_ASSERT(batch == ref);
+
+    // Invalid sizes are rejected without modifying data.
+    size[3] = 200;
+    TSUNIT_ASSERT(!scrambler.encryptInPlaceBatch(data.data(), size.data(), batch_count));
+    TSUNIT_ASSERT(batch == ref);
+}
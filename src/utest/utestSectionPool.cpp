@@ -0,0 +1,194 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::SectionPool
+//
+//----------------------------------------------------------------------------
+
+#include "tsSectionPool.h"
+#include "tsunit.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class SectionPoolTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testRecycle();
+    void testShared();
+    void testInvalid();
+    void testNoPool();
+
+    TSUNIT_TEST_BEGIN(SectionPoolTest);
+    TSUNIT_TEST(testRecycle);
+    TSUNIT_TEST(testShared);
+    TSUNIT_TEST(testInvalid);
+    TSUNIT_TEST(testNoPool);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(SectionPoolTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void SectionPoolTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void SectionPoolTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+namespace {
+    // Build the binary content of a long section.
+    ts::ByteBlock MakeSection(uint16_t tid_ext, size_t payload_size)
+    {
+        ts::ByteBlock payload(payload_size, uint8_t(tid_ext));
+        ts::Section sect(0x80, true, tid_ext, 1, true, 0, 0, payload.data(), payload.size());
+        return ts::ByteBlock(sect.content(), sect.size());
+    }
+}
+
+void SectionPoolTest::testRecycle()
+{
+    ts::SectionPool pool;
+    const ts::ByteBlock sect1(MakeSection(1, 100));
+    const ts::ByteBlock sect2(MakeSection(2, 120));
+    const ts::ByteBlock sect3(MakeSection(3, 2000));
+
+    ts::SectionPtr sp(pool.allocate(sect1.data(), sect1.size(), 100, ts::CRC32::CHECK));
+    TSUNIT_ASSERT(sp->isValid());
+    TSUNIT_EQUAL(1, sp->tableIdExtension());
+    TSUNIT_EQUAL(100, sp->sourcePID());
+    const ts::Section* const addr = sp.pointer();
+    const uint8_t* const data = sp->content();
+
+    // Not referenced, same section and same data block with the new content.
+    sp.clear();
+    sp = pool.allocate(sect2.data(), sect2.size(), 200, ts::CRC32::CHECK);
+    TSUNIT_ASSERT(sp->isValid());
+    TSUNIT_ASSERT(sp.pointer() == addr);
+    TSUNIT_ASSERT(sp->content() == data);
+    TSUNIT_EQUAL(2, sp->tableIdExtension());
+    TSUNIT_EQUAL(200, sp->sourcePID());
+    TSUNIT_EQUAL(sect2.size(), sp->size());
+    TSUNIT_EQUAL(1, pool.allocatedCount());
+    TSUNIT_EQUAL(1, pool.recycledCount());
+
+    // Still referenced, another size class: new section.
+    ts::SectionPtr sp3(pool.allocate(sect3.data(), sect3.size(), 300, ts::CRC32::CHECK));
+    TSUNIT_ASSERT(sp3->isValid());
+    TSUNIT_ASSERT(sp3.pointer() != addr);
+    TSUNIT_EQUAL(3, sp3->tableIdExtension());
+    TSUNIT_EQUAL(2, pool.allocatedCount());
+    TSUNIT_EQUAL(1, pool.recycledCount());
+}
+
+void SectionPoolTest::testShared()
+{
+    ts::SectionPool pool;
+    const ts::ByteBlock sect1(MakeSection(1, 100));
+    const ts::ByteBlock sect2(MakeSection(2, 100));
+
+    // The section is still referenced, it is not modified.
+    ts::SectionPtr sp1(pool.allocate(sect1.data(), sect1.size(), 100, ts::CRC32::CHECK));
+    ts::SectionPtr sp2(pool.allocate(sect2.data(), sect2.size(), 100, ts::CRC32::CHECK));
+    TSUNIT_ASSERT(sp1 != sp2);
+    TSUNIT_EQUAL(1, sp1->tableIdExtension());
+    TSUNIT_EQUAL(2, sp2->tableIdExtension());
+
+    // The data of the section are shared by another section, they are not modified.
+    const ts::Section shared(*sp1, ts::SHARE);
+    const ts::Section* const addr1 = sp1.pointer();
+    sp1.clear();
+    sp2.clear();
+    sp1 = pool.allocate(sect2.data(), sect2.size(), 100, ts::CRC32::CHECK);
+    TSUNIT_ASSERT(sp1.pointer() != addr1);
+    TSUNIT_EQUAL(2, sp1->tableIdExtension());
+    TSUNIT_ASSERT(shared.isValid());
+    TSUNIT_EQUAL(1, shared.tableIdExtension());
+    TSUNIT_ASSERT(shared.content() != sp1->content());
+    TSUNIT_EQUAL(2, pool.allocatedCount());
+    TSUNIT_EQUAL(1, pool.recycledCount());
+}
+
+void SectionPoolTest::testInvalid()
+{
+    ts::SectionPool pool;
+    const ts::ByteBlock sect1(MakeSection(1, 100));
+    ts::ByteBlock corrupted(sect1);
+    corrupted[20] ^= 0xFF;
+
+    ts::SectionPtr sp(pool.allocate(corrupted.data(), corrupted.size(), 100, ts::CRC32::CHECK));
+    TSUNIT_ASSERT(!sp->isValid());
+
+    // The invalid section is recycled.
+    sp.clear();
+    sp = pool.allocate(sect1.data(), sect1.size(), 100, ts::CRC32::CHECK);
+    TSUNIT_ASSERT(sp->isValid());
+    TSUNIT_EQUAL(1, sp->tableIdExtension());
+    TSUNIT_EQUAL(1, pool.allocatedCount());
+    TSUNIT_EQUAL(1, pool.recycledCount());
+
+    sp.clear();
+    sp = pool.allocate(corrupted.data(), corrupted.size(), 100, ts::CRC32::CHECK);
+    TSUNIT_ASSERT(!sp->isValid());
+    TSUNIT_EQUAL(2, pool.recycledCount());
+}
+
+void SectionPoolTest::testNoPool()
+{
+    ts::SectionPool pool(0);
+    const ts::ByteBlock sect1(MakeSection(1, 100));
+
+    ts::SectionPtr sp(pool.allocate(sect1.data(), sect1.size(), 100, ts::CRC32::CHECK));
+    TSUNIT_ASSERT(sp->isValid());
+    TSUNIT_EQUAL(1, sp.count());
+    sp.clear();
+    sp = pool.allocate(sect1.data(), sect1.size(), 100, ts::CRC32::CHECK);
+    TSUNIT_ASSERT(sp->isValid());
+    TSUNIT_EQUAL(2, pool.allocatedCount());
+    TSUNIT_EQUAL(0, pool.recycledCount());
+}
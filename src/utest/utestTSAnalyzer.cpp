@@ -0,0 +1,274 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::TSAnalyzer
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSAnalyzerReport.h"
+#include "tsunit.h"
+TSDUCK_SOURCE;
+
+#include "tables/psi_pat_r4_packets.h"
+#include "tables/psi_pmt_planete_packets.h"
+#include "tables/psi_sdt_r3_packets.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TSAnalyzerTest: public tsunit::Test
+{
+public:
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testSnapshot();
+    void testInterval();
+    void testAppend();
+
+    TSUNIT_TEST_BEGIN(TSAnalyzerTest);
+    TSUNIT_TEST(testSnapshot);
+    TSUNIT_TEST(testInterval);
+    TSUNIT_TEST(testAppend);
+    TSUNIT_TEST_END();
+};
+
+TSUNIT_REGISTER(TSAnalyzerTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Test suite initialization method.
+void TSAnalyzerTest::beforeTest()
+{
+}
+
+// Test suite cleanup method.
+void TSAnalyzerTest::afterTest()
+{
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+namespace {
+    // An analyzer which gives access to its analysis data.
+    class Analyzer: public ts::TSAnalyzerReport
+    {
+    public:
+        Analyzer(ts::DuckContext& duck) : ts::TSAnalyzerReport(duck), _cc() {}
+
+        uint64_t packets() const { return _ts_pkt_cnt; }
+        size_t serviceCount() const { return _services.size(); }
+
+        uint64_t pidPackets(ts::PID pid) const
+        {
+            const PIDContext* const pc = _pids.get(pid);
+            return pc == nullptr ? 0 : pc->ts_pkt_cnt;
+        }
+
+        uint64_t pidErrors(ts::PID pid) const
+        {
+            const PIDContext* const pc = _pids.get(pid);
+            return pc == nullptr ? 0 : pc->unexp_discont;
+        }
+
+        uint64_t tableCount(ts::PID pid, ts::TID tid) const
+        {
+            const PIDContext* const pc = _pids.get(pid);
+            if (pc != nullptr) {
+                for (auto its = pc->details->sections.begin(); its != pc->details->sections.end(); ++its) {
+                    if (its->first.tid() == tid) {
+                        return its->second->table_count;
+                    }
+                }
+            }
+            return 0;
+        }
+
+        // Feed all packets from a reference buffer, with a continuous CC.
+        void feed(const uint8_t* data, size_t size, size_t repeat = 1)
+        {
+            const ts::TSPacket* pkt = reinterpret_cast<const ts::TSPacket*>(data);
+            const size_t count = size / ts::PKT_SIZE;
+            for (size_t r = 0; r < repeat; ++r) {
+                for (size_t i = 0; i < count; ++i) {
+                    ts::TSPacket p(pkt[i]);
+                    const ts::PID pid = p.getPID();
+                    p.setCC(_cc[pid]++ & ts::CC_MASK);
+                    feedPacket(p);
+                }
+            }
+        }
+
+        // Feed a range of packets from a stream.
+        void feed(const ts::TSPacketVector& stream, size_t first, size_t last)
+        {
+            for (size_t i = first; i < last; ++i) {
+                feedPacket(stream[i]);
+            }
+        }
+
+    private:
+        std::map<ts::PID, uint8_t> _cc;
+    };
+
+    // Build a stream from reference buffers, with a continuous CC.
+    void AppendStream(ts::TSPacketVector& stream, std::map<ts::PID, uint8_t>& cc, const uint8_t* data, size_t size)
+    {
+        const ts::TSPacket* pkt = reinterpret_cast<const ts::TSPacket*>(data);
+        for (size_t i = 0; i < size / ts::PKT_SIZE; ++i) {
+            stream.push_back(pkt[i]);
+            stream.back().setCC(cc[pkt[i].getPID()]++ & ts::CC_MASK);
+        }
+    }
+}
+
+void TSAnalyzerTest::testSnapshot()
+{
+    ts::DuckContext duck;
+    Analyzer live(duck);
+    live.feed(psi_pat_r4_packets, sizeof(psi_pat_r4_packets), 10);
+    live.feed(psi_sdt_r3_packets, sizeof(psi_sdt_r3_packets), 10);
+    live.feed(psi_pmt_planete_packets, sizeof(psi_pmt_planete_packets), 10);
+    const uint64_t count = live.packets();
+    TSUNIT_ASSERT(count > 0);
+
+    Analyzer snapshot(duck);
+    live.getSnapshot(snapshot);
+    TSUNIT_EQUAL(count, snapshot.packets());
+    TSUNIT_EQUAL(live.serviceCount(), snapshot.serviceCount());
+    TSUNIT_EQUAL(live.pidPackets(ts::PID_PAT), snapshot.pidPackets(ts::PID_PAT));
+    TSUNIT_EQUAL(10, snapshot.tableCount(ts::PID_PAT, ts::TID_PAT));
+
+    // The snapshot is independent from the live analysis.
+    live.feed(psi_pat_r4_packets, sizeof(psi_pat_r4_packets), 5);
+    TSUNIT_EQUAL(count, snapshot.packets());
+    TSUNIT_EQUAL(10, snapshot.tableCount(ts::PID_PAT, ts::TID_PAT));
+    TSUNIT_EQUAL(15, live.tableCount(ts::PID_PAT, ts::TID_PAT));
+
+    // Same report, except system times.
+    ts::TSAnalyzerOptions opt;
+    opt.service_analysis = true;
+    opt.pid_analysis = true;
+    opt.table_analysis = true;
+    Analyzer snapshot2(duck);
+    live.getSnapshot(snapshot2);
+    TSUNIT_EQUAL(live.reportToString(opt), snapshot2.reportToString(opt));
+}
+
+void TSAnalyzerTest::testInterval()
+{
+    ts::DuckContext duck;
+    Analyzer live(duck);
+    Analyzer first(duck);
+    Analyzer second(duck);
+
+    live.feed(psi_pat_r4_packets, sizeof(psi_pat_r4_packets), 10);
+    live.feed(psi_sdt_r3_packets, sizeof(psi_sdt_r3_packets), 4);
+    live.getSnapshot(first);
+
+    live.feed(psi_pat_r4_packets, sizeof(psi_pat_r4_packets), 3);
+    live.getSnapshot(second);
+
+    // Cumulative statistics.
+    TSUNIT_EQUAL(13, second.tableCount(ts::PID_PAT, ts::TID_PAT));
+    TSUNIT_EQUAL(4, second.tableCount(ts::PID_SDT, ts::TID_SDT_ACT));
+
+    // Interval statistics.
+    second.subtractSnapshot(first);
+    TSUNIT_EQUAL(live.packets() - first.packets(), second.packets());
+    TSUNIT_EQUAL(3 * sizeof(psi_pat_r4_packets) / ts::PKT_SIZE, second.pidPackets(ts::PID_PAT));
+    TSUNIT_EQUAL(0, second.pidPackets(ts::PID_SDT));
+    TSUNIT_EQUAL(3, second.tableCount(ts::PID_PAT, ts::TID_PAT));
+    TSUNIT_EQUAL(0, second.tableCount(ts::PID_SDT, ts::TID_SDT_ACT));
+
+    // The live analysis is unchanged.
+    TSUNIT_EQUAL(13, live.tableCount(ts::PID_PAT, ts::TID_PAT));
+}
+
+void TSAnalyzerTest::testAppend()
+{
+    // Build a stream with a continuity error at the boundary of the two parts.
+    ts::TSPacketVector stream;
+    std::map<ts::PID, uint8_t> cc;
+    for (size_t i = 0; i < 20; ++i) {
+        AppendStream(stream, cc, psi_pat_r4_packets, sizeof(psi_pat_r4_packets));
+        AppendStream(stream, cc, psi_pmt_planete_packets, sizeof(psi_pmt_planete_packets));
+        AppendStream(stream, cc, psi_sdt_r3_packets, sizeof(psi_sdt_r3_packets));
+    }
+    const size_t split = stream.size() / 2;
+    const size_t warmup = stream.size() / 4;
+    const ts::PID err_pid = stream[split].getPID();
+    stream[split].setCC((stream[split].getCC() + 5) & ts::CC_MASK);
+
+    ts::DuckContext duck;
+    Analyzer sequential(duck);
+    sequential.feed(stream, 0, stream.size());
+    TSUNIT_EQUAL(2, sequential.pidErrors(err_pid));
+
+    // First part, from the beginning of the stream.
+    Analyzer part1(duck);
+    Analyzer result1(duck);
+    part1.feed(stream, 0, split);
+    part1.getSnapshot(result1);
+
+    // Second part, with warm-up packets.
+    Analyzer part2(duck);
+    Analyzer warm2(duck);
+    Analyzer result2(duck);
+    part2.setPacketIndex(split - warmup);
+    part2.feed(stream, split - warmup, split);
+    part2.getSnapshot(warm2);
+    part2.feed(stream, split, stream.size());
+    part2.getSnapshot(result2);
+    result2.subtractSnapshot(warm2);
+
+    Analyzer merged(duck);
+    merged.appendAnalysis(result1);
+    merged.appendAnalysis(result2);
+
+    TSUNIT_EQUAL(sequential.packets(), merged.packets());
+    TSUNIT_EQUAL(2, merged.pidErrors(err_pid));
+    TSUNIT_EQUAL(20, merged.tableCount(ts::PID_PAT, ts::TID_PAT));
+    TSUNIT_EQUAL(sequential.pidPackets(ts::PID_SDT), merged.pidPackets(ts::PID_SDT));
+
+    ts::TSAnalyzerOptions opt;
+    opt.service_analysis = true;
+    opt.pid_analysis = true;
+    opt.table_analysis = true;
+    opt.error_analysis = true;
+    TSUNIT_EQUAL(sequential.reportToString(opt), merged.reportToString(opt));
+}
@@ -0,0 +1,287 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for TSFile.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSFile.h"
+#include "tsTSFileOutputAsync.h"
+#include "tsSysUtils.h"
+#include "tsMemory.h"
+#include "tsCerrReport.h"
+#include "tsNullReport.h"
+#include "tsunit.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TSFileTest: public tsunit::Test
+{
+public:
+    TSFileTest();
+
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testReadWrite();
+    void testRepeat();
+    void testSeek();
+    void testTruncated();
+    void testAsyncWrite();
+
+    TSUNIT_TEST_BEGIN(TSFileTest);
+    TSUNIT_TEST(testReadWrite);
+    TSUNIT_TEST(testRepeat);
+    TSUNIT_TEST(testSeek);
+    TSUNIT_TEST(testTruncated);
+    TSUNIT_TEST(testAsyncWrite);
+    TSUNIT_TEST_END();
+
+private:
+    ts::UString _tempFileName;
+    ts::Report& report();
+    void createFile();
+    static uint32_t packetIndex(const ts::TSPacket& pkt) { return ts::GetUInt32(pkt.b + 4); }
+};
+
+TSUNIT_REGISTER(TSFileTest);
+
+// Number of packets in the test file.
+namespace {
+    const size_t FILE_PACKETS = 1000;
+}
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Constructor.
+TSFileTest::TSFileTest() :
+    _tempFileName()
+{
+}
+
+// Test suite initialization method.
+void TSFileTest::beforeTest()
+{
+    if (_tempFileName.empty()) {
+        _tempFileName = ts::TempFile(u".ts");
+    }
+    ts::DeleteFile(_tempFileName);
+}
+
+// Test suite cleanup method.
+void TSFileTest::afterTest()
+{
+    ts::DeleteFile(_tempFileName);
+}
+
+ts::Report& TSFileTest::report()
+{
+    if (tsunit::Test::debugMode()) {
+        return CERR;
+    }
+    else {
+        return NULLREP;
+    }
+}
+
+// Create a test file. Each packet contains its index after the header.
+void TSFileTest::createFile()
+{
+    ts::TSPacketVector packets(FILE_PACKETS);
+    for (size_t i = 0; i < packets.size(); ++i) {
+        packets[i] = ts::NullPacket;
+        ts::PutUInt32(packets[i].b + 4, uint32_t(i));
+    }
+
+    ts::TSFile file;
+    TSUNIT_ASSERT(file.open(_tempFileName, ts::TSFile::WRITE, report()));
+    TSUNIT_ASSERT(file.write(packets.data(), packets.size(), report()));
+    TSUNIT_EQUAL(FILE_PACKETS, file.getWriteCount());
+    TSUNIT_ASSERT(file.close(report()));
+}
+
+
+//----------------------------------------------------------------------------
+// Test cases
+//----------------------------------------------------------------------------
+
+void TSFileTest::testReadWrite()
+{
+    createFile();
+
+    // Read the file with and without memory mapping.
+    for (int mapped = 0; mapped < 2; ++mapped) {
+        ts::TSFile file;
+        file.setMemoryMapped(mapped != 0);
+        TSUNIT_ASSERT(file.openRead(_tempFileName, 1, 0, report()));
+#if !defined(TS_WINDOWS)
+        TSUNIT_EQUAL(mapped != 0, file.isMemoryMapped());
+#endif
+        ts::TSPacket buffer[300];
+        size_t index = 0;
+        size_t count = 0;
+        while ((count = file.read(buffer, 300, report())) > 0) {
+            for (size_t i = 0; i < count; ++i) {
+                TSUNIT_EQUAL(index++, packetIndex(buffer[i]));
+            }
+        }
+        TSUNIT_EQUAL(FILE_PACKETS, index);
+        TSUNIT_EQUAL(FILE_PACKETS, file.getReadCount());
+        TSUNIT_ASSERT(file.close(report()));
+    }
+}
+
+void TSFileTest::testRepeat()
+{
+    createFile();
+
+    // Read the file three times, starting at packet 10, without copy.
+    for (int mapped = 0; mapped < 2; ++mapped) {
+        ts::TSFile file;
+        file.setMemoryMapped(mapped != 0);
+        TSUNIT_ASSERT(file.openRead(_tempFileName, 3, 10 * ts::PKT_SIZE, report()));
+        const ts::TSPacket* pkt = nullptr;
+        size_t index = 10;
+        size_t total = 0;
+        size_t count = 0;
+        while ((count = file.readInPlace(pkt, 128, report())) > 0) {
+            TSUNIT_ASSERT(pkt != nullptr);
+            for (size_t i = 0; i < count; ++i) {
+                TSUNIT_EQUAL(index, packetIndex(pkt[i]));
+                index = index + 1 < FILE_PACKETS ? index + 1 : 10;
+            }
+            total += count;
+        }
+        TSUNIT_EQUAL(3 * (FILE_PACKETS - 10), total);
+        TSUNIT_EQUAL(3 * (FILE_PACKETS - 10), file.getReadCount());
+        TSUNIT_ASSERT(file.close(report()));
+    }
+}
+
+void TSFileTest::testSeek()
+{
+    createFile();
+
+    for (int mapped = 0; mapped < 2; ++mapped) {
+        ts::TSFile file;
+        file.setMemoryMapped(mapped != 0);
+        TSUNIT_ASSERT(file.openRead(_tempFileName, 0, report()));
+
+        const ts::TSPacket* pkt = nullptr;
+        TSUNIT_EQUAL(1, file.readInPlace(pkt, 1, report()));
+        TSUNIT_EQUAL(0, packetIndex(*pkt));
+
+        TSUNIT_ASSERT(file.seek(500, report()));
+        TSUNIT_EQUAL(10, file.readInPlace(pkt, 10, report()));
+        TSUNIT_EQUAL(500, packetIndex(pkt[0]));
+        TSUNIT_EQUAL(509, packetIndex(pkt[9]));
+
+        TSUNIT_ASSERT(file.seek(FILE_PACKETS - 2, report()));
+        TSUNIT_EQUAL(2, file.readInPlace(pkt, 10, report()));
+        TSUNIT_EQUAL(0, file.readInPlace(pkt, 10, report()));
+
+        TSUNIT_ASSERT(file.rewind(report()));
+        TSUNIT_EQUAL(1, file.readInPlace(pkt, 1, report()));
+        TSUNIT_EQUAL(0, packetIndex(*pkt));
+        TSUNIT_ASSERT(file.close(report()));
+    }
+}
+
+void TSFileTest::testTruncated()
+{
+    createFile();
+
+    // Add a partial packet at end of file.
+    ts::TSFile out;
+    TSUNIT_ASSERT(out.open(_tempFileName, ts::TSFile::WRITE | ts::TSFile::APPEND, report()));
+    ts::TSPacket pkt(ts::NullPacket);
+    TSUNIT_ASSERT(out.write(&pkt, 1, report()));
+    TSUNIT_ASSERT(out.close(report()));
+    TSUNIT_EQUAL(ts::SYS_SUCCESS, ts::TruncateFile(_tempFileName, FILE_PACKETS * ts::PKT_SIZE + 100));
+
+    // The partial packet is dropped, with and without memory mapping.
+    for (int mapped = 0; mapped < 2; ++mapped) {
+        ts::TSFile file;
+        file.setMemoryMapped(mapped != 0);
+        TSUNIT_ASSERT(file.openRead(_tempFileName, 1, 0, report()));
+        TSUNIT_EQUAL(0, file.getTruncatedSize());
+        ts::TSPacket buffer[300];
+        while (file.read(buffer, 300, report()) > 0) {
+        }
+        TSUNIT_EQUAL(FILE_PACKETS, file.getReadCount());
+        TSUNIT_EQUAL(100, file.getTruncatedSize());
+        TSUNIT_ASSERT(file.close(report()));
+    }
+}
+
+void TSFileTest::testAsyncWrite()
+{
+    // Write more packets than the ring size, not a multiple of the buffer size.
+    const size_t total = 5 * ts::TSFileOutputAsync::BUFFER_PACKETS + 100;
+    ts::TSPacketVector packets(total);
+    for (size_t i = 0; i < packets.size(); ++i) {
+        packets[i] = ts::NullPacket;
+        ts::PutUInt32(packets[i].b + 4, uint32_t(i));
+    }
+
+    ts::TSFileOutputAsync out;
+    TSUNIT_ASSERT(out.open(_tempFileName, ts::TSFile::WRITE, 2, report()));
+    TSUNIT_ASSERT(out.isOpen());
+    for (size_t i = 0; i < total; i += 300) {
+        TSUNIT_ASSERT(out.write(&packets[i], std::min<size_t>(300, total - i), report()));
+    }
+    TSUNIT_ASSERT(out.close(report()));
+    TSUNIT_ASSERT(!out.isOpen());
+
+    const ts::TSFileOutputAsync::Statistics stats(out.getStatistics());
+    TSUNIT_EQUAL(total, stats.packets);
+    TSUNIT_EQUAL(6, stats.buffers);
+    TSUNIT_ASSERT(stats.max_busy <= 2);
+
+    // Read the file back.
+    ts::TSFile file;
+    TSUNIT_ASSERT(file.openRead(_tempFileName, 1, 0, report()));
+    const ts::TSPacket* pkt = nullptr;
+    size_t index = 0;
+    size_t count = 0;
+    while ((count = file.readInPlace(pkt, 1000, report())) > 0) {
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_EQUAL(index++, packetIndex(pkt[i]));
+        }
+    }
+    TSUNIT_EQUAL(total, index);
+    TSUNIT_ASSERT(file.close(report()));
+}
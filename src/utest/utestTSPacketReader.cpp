@@ -0,0 +1,220 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for TSPacketReader.
+//
+//----------------------------------------------------------------------------
+
+#include "tsTSPacketReader.h"
+#include "tsReportBuffer.h"
+#include "tsSysUtils.h"
+#include "tsMemory.h"
+#include "tsunit.h"
+TSDUCK_SOURCE;
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TSPacketReaderTest: public tsunit::Test
+{
+public:
+    TSPacketReaderTest();
+
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testRead();
+    void testBlocks();
+    void testTruncated();
+    void testSyncLoss();
+
+    TSUNIT_TEST_BEGIN(TSPacketReaderTest);
+    TSUNIT_TEST(testRead);
+    TSUNIT_TEST(testBlocks);
+    TSUNIT_TEST(testTruncated);
+    TSUNIT_TEST(testSyncLoss);
+    TSUNIT_TEST_END();
+
+private:
+    ts::UString _tempFileName;
+
+    // Create a test file. Each packet contains its index after the header.
+    void createFile(size_t packet_count, size_t extra_bytes = 0, size_t bad_sync_index = ts::NPOS);
+    static uint32_t packetIndex(const ts::TSPacket& pkt) { return ts::GetUInt32(pkt.b + 4); }
+};
+
+TSUNIT_REGISTER(TSPacketReaderTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Constructor.
+TSPacketReaderTest::TSPacketReaderTest() :
+    _tempFileName()
+{
+}
+
+// Test suite initialization method.
+void TSPacketReaderTest::beforeTest()
+{
+    if (_tempFileName.empty()) {
+        _tempFileName = ts::TempFile(u".ts");
+    }
+    ts::DeleteFile(_tempFileName);
+}
+
+// Test suite cleanup method.
+void TSPacketReaderTest::afterTest()
+{
+    ts::DeleteFile(_tempFileName);
+}
+
+// Create a test file.
+void TSPacketReaderTest::createFile(size_t packet_count, size_t extra_bytes, size_t bad_sync_index)
+{
+    ts::TSPacketVector packets(packet_count);
+    for (size_t i = 0; i < packets.size(); ++i) {
+        packets[i] = ts::NullPacket;
+        ts::PutUInt32(packets[i].b + 4, uint32_t(i));
+    }
+    if (bad_sync_index < packets.size()) {
+        packets[bad_sync_index].b[0] = 0x48;
+    }
+
+    std::ofstream file(_tempFileName.toUTF8().c_str(), std::ios::binary);
+    file.write(reinterpret_cast<const char*>(packets.data()), std::streamsize(packets.size() * ts::PKT_SIZE));
+    file.write(reinterpret_cast<const char*>(ts::NullPacket.b), std::streamsize(extra_bytes));
+    TSUNIT_ASSERT(bool(file));
+}
+
+
+//----------------------------------------------------------------------------
+// Test cases
+//----------------------------------------------------------------------------
+
+void TSPacketReaderTest::testRead()
+{
+    createFile(1000);
+
+    ts::ReportBuffer<> rep;
+    ts::TSPacketReader reader(300);
+    TSUNIT_ASSERT(!reader.isOpen());
+    TSUNIT_ASSERT(reader.open(_tempFileName, rep));
+    TSUNIT_ASSERT(reader.isOpen());
+    TSUNIT_ASSERT(!reader.endOfFile());
+
+    // Alternate reading packets in place and by copy.
+    ts::TSPacket pkt;
+    size_t index = 0;
+    for (;;) {
+        const ts::TSPacket* p = reader.read(rep);
+        if (p == nullptr) {
+            break;
+        }
+        TSUNIT_EQUAL(index++, packetIndex(*p));
+        if (!reader.read(pkt, rep)) {
+            break;
+        }
+        TSUNIT_EQUAL(index++, packetIndex(pkt));
+    }
+    TSUNIT_EQUAL(1000, index);
+    TSUNIT_EQUAL(1000, reader.getReadCount());
+    TSUNIT_ASSERT(reader.endOfFile());
+    TSUNIT_ASSERT(reader.read(rep) == nullptr);
+    TSUNIT_ASSERT(reader.close(rep));
+    TSUNIT_ASSERT(!reader.isOpen());
+    TSUNIT_ASSERT(rep.emptyMessages());
+}
+
+void TSPacketReaderTest::testBlocks()
+{
+    createFile(1000);
+
+    ts::ReportBuffer<> rep;
+    ts::TSPacketReader reader(300);
+    TSUNIT_ASSERT(reader.open(_tempFileName, rep));
+
+    const ts::TSPacket* packets = nullptr;
+    size_t index = 0;
+    size_t count = 0;
+    while ((count = reader.read(packets, 70, rep)) > 0) {
+        TSUNIT_ASSERT(packets != nullptr);
+        TSUNIT_ASSERT(count <= 70);
+        for (size_t i = 0; i < count; ++i) {
+            TSUNIT_EQUAL(index++, packetIndex(packets[i]));
+        }
+    }
+    TSUNIT_EQUAL(1000, index);
+    TSUNIT_EQUAL(1000, reader.getReadCount());
+    TSUNIT_ASSERT(reader.close(rep));
+    TSUNIT_ASSERT(rep.emptyMessages());
+}
+
+void TSPacketReaderTest::testTruncated()
+{
+    createFile(1000, 100);
+
+    ts::ReportBuffer<> rep;
+    ts::TSPacketReader reader;
+    TSUNIT_ASSERT(reader.open(_tempFileName, rep));
+    size_t index = 0;
+    while (reader.read(rep) != nullptr) {
+        index++;
+    }
+    TSUNIT_EQUAL(1000, index);
+    TSUNIT_ASSERT(reader.close(rep));
+    TSUNIT_EQUAL(u"Error: truncated TS packet (100 bytes) after 1,000 TS packets", rep.getMessages());
+}
+
+void TSPacketReaderTest::testSyncLoss()
+{
+    createFile(1000, 0, 500);
+
+    ts::ReportBuffer<> rep;
+    ts::TSPacketReader reader(300);
+    TSUNIT_ASSERT(reader.open(_tempFileName, rep));
+
+    // The block before the corrupted packet stops on it.
+    const ts::TSPacket* packets = nullptr;
+    size_t index = 0;
+    size_t count = 0;
+    while ((count = reader.read(packets, 1000, rep)) > 0) {
+        index += count;
+    }
+    TSUNIT_EQUAL(500, index);
+    TSUNIT_EQUAL(500, reader.getReadCount());
+    TSUNIT_ASSERT(reader.endOfFile());
+    TSUNIT_ASSERT(reader.read(rep) == nullptr);
+    TSUNIT_ASSERT(reader.close(rep));
+    TSUNIT_EQUAL(u"Error: synchronization lost after 500 TS packets, got 0x48 instead of 0x47 at start of TS packet", rep.getMessages());
+}
@@ -0,0 +1,178 @@
+//----------------------------------------------------------------------------
+//
+// TSDuck - The MPEG Transport Stream Toolkit
+// Copyright (c) 2005-2020, Thierry Lelegard
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice,
+//    this list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+// THE POSSIBILITY OF SUCH DAMAGE.
+//
+//----------------------------------------------------------------------------
+//
+//  TSUnit test suite for class ts::TablesLogger
+//
+//----------------------------------------------------------------------------
+
+#include "tsTablesLogger.h"
+#include "tsSysUtils.h"
+#include "tsunit.h"
+TSDUCK_SOURCE;
+
+#include "tables/psi_pat_r4_packets.h"
+#include "tables/psi_pmt_planete_packets.h"
+#include "tables/psi_sdt_r3_packets.h"
+
+
+//----------------------------------------------------------------------------
+// The test fixture
+//----------------------------------------------------------------------------
+
+class TablesLoggerTest: public tsunit::Test
+{
+public:
+    TablesLoggerTest();
+
+    virtual void beforeTest() override;
+    virtual void afterTest() override;
+
+    void testPipelineText();
+    void testPipelineSections();
+    void testPipelineXML();
+
+    TSUNIT_TEST_BEGIN(TablesLoggerTest);
+    TSUNIT_TEST(testPipelineText);
+    TSUNIT_TEST(testPipelineSections);
+    TSUNIT_TEST(testPipelineXML);
+    TSUNIT_TEST_END();
+
+private:
+    ts::UString _tempFileName;
+
+    // Log all tables from a test stream using the specified options.
+    static ts::UString Log(const ts::UStringVector& options);
+};
+
+TSUNIT_REGISTER(TablesLoggerTest);
+
+
+//----------------------------------------------------------------------------
+// Initialization.
+//----------------------------------------------------------------------------
+
+// Constructor.
+TablesLoggerTest::TablesLoggerTest() :
+    _tempFileName(ts::TempFile(u".tmp.xml"))
+{
+}
+
+// Test suite initialization method.
+void TablesLoggerTest::beforeTest()
+{
+    ts::DeleteFile(_tempFileName);
+}
+
+// Test suite cleanup method.
+void TablesLoggerTest::afterTest()
+{
+    ts::DeleteFile(_tempFileName);
+}
+
+
+//----------------------------------------------------------------------------
+// Log all tables from a test stream using the specified options.
+//----------------------------------------------------------------------------
+
+ts::UString TablesLoggerTest::Log(const ts::UStringVector& options)
+{
+    std::ostringstream out;
+    ts::DuckContext duck(&NULLREP, &out);
+    ts::TablesDisplay display(duck);
+    ts::TablesLogger logger(display);
+
+    ts::Args args;
+    logger.defineArgs(args);
+    display.defineArgs(args);
+    TSUNIT_ASSERT(args.analyze(u"test", options));
+    TSUNIT_ASSERT(logger.loadArgs(duck, args));
+    TSUNIT_ASSERT(display.loadArgs(duck, args));
+    TSUNIT_ASSERT(logger.open());
+
+    // Make sure that each table is repeated with a continuous CC.
+    std::map<ts::PID, uint8_t> cc;
+    const struct {
+        const uint8_t* data;
+        size_t size;
+    } streams[] = {
+        {psi_pat_r4_packets, sizeof(psi_pat_r4_packets)},
+        {psi_pmt_planete_packets, sizeof(psi_pmt_planete_packets)},
+        {psi_sdt_r3_packets, sizeof(psi_sdt_r3_packets)},
+    };
+    for (size_t repeat = 0; repeat < 50; ++repeat) {
+        for (size_t s = 0; s < sizeof(streams) / sizeof(streams[0]); ++s) {
+            const ts::TSPacket* pkt = reinterpret_cast<const ts::TSPacket*>(streams[s].data);
+            for (size_t i = 0; i < streams[s].size / ts::PKT_SIZE; ++i) {
+                ts::TSPacket p(pkt[i]);
+                p.setCC(cc[p.getPID()]++ & ts::CC_MASK);
+                logger.feedPacket(p);
+            }
+        }
+    }
+    logger.close();
+    TSUNIT_ASSERT(!logger.hasErrors());
+    return ts::UString::FromUTF8(out.str());
+}
+
+
+//----------------------------------------------------------------------------
+// Unitary tests.
+//----------------------------------------------------------------------------
+
+void TablesLoggerTest::testPipelineText()
+{
+    const ts::UString ref(Log({u"--packet-index"}));
+    TSUNIT_ASSERT(!ref.empty());
+    debug() << "TablesLoggerTest::testPipelineText: " << ref << std::endl;
+    TSUNIT_EQUAL(ref, Log({u"--packet-index", u"--threads", u"4"}));
+    TSUNIT_EQUAL(Log({u"--log"}), Log({u"--log", u"--threads", u"3"}));
+}
+
+void TablesLoggerTest::testPipelineSections()
+{
+    const ts::UString ref(Log({u"--all-sections", u"--packet-index"}));
+    TSUNIT_ASSERT(!ref.empty());
+    TSUNIT_EQUAL(ref, Log({u"--all-sections", u"--packet-index", u"--threads", u"4"}));
+}
+
+void TablesLoggerTest::testPipelineXML()
+{
+    ts::UStringList ref;
+    ts::UStringList lines;
+
+    Log({u"--xml-output", _tempFileName, u"--packet-index"});
+    TSUNIT_ASSERT(ts::UString::Load(ref, _tempFileName));
+    TSUNIT_ASSERT(ref.size() > 10);
+    TSUNIT_EQUAL(u"<?xml version=\"1.0\" encoding=\"UTF-8\"?>", ref.front());
+    TSUNIT_EQUAL(u"</tsduck>", ref.back());
+
+    Log({u"--xml-output", _tempFileName, u"--packet-index", u"--threads", u"4"});
+    TSUNIT_ASSERT(ts::UString::Load(lines, _tempFileName));
+    TSUNIT_ASSERT(ref == lines);
+}
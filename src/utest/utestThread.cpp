@@ -42,6 +42,7 @@
 #include "tsTime.h"
 #include "tsMonotonic.h"
 #include "tsSysUtils.h"
+#include "tsSysInfo.h"
 #include "utestTSUnitThread.h"
 #include "tsunit.h"
 TSDUCK_SOURCE;
@@ -65,6 +66,8 @@ public:
     void testMutexRecursion();
     void testMutexTimeout();
     void testCondition();
+    void testCpuTime();
+    void testCPUAffinity();
 
     TSUNIT_TEST_BEGIN(ThreadTest);
     TSUNIT_TEST(testAttributes);
@@ -73,6 +76,8 @@ public:
     TSUNIT_TEST(testMutexRecursion);
     TSUNIT_TEST(testMutexTimeout);
     TSUNIT_TEST(testCondition);
+    TSUNIT_TEST(testCpuTime);
+    TSUNIT_TEST(testCPUAffinity);
     TSUNIT_TEST_END();
 private:
     ts::NanoSecond  _nsPrecision;
@@ -413,3 +418,116 @@ void ThreadTest::testCondition()
         }
     }
 }
+
+//
+// Test case: CPU time of a thread.
+//
+namespace {
+    class ThreadCpuTime: public utest::TSUnitThread
+    {
+    private:
+        volatile bool& _busy_done;
+        volatile bool& _stop;
+    public:
+        ThreadCpuTime(volatile bool& busy_done, volatile bool& stop) :
+            utest::TSUnitThread(),
+            _busy_done(busy_done),
+            _stop(stop)
+        {
+        }
+        virtual ~ThreadCpuTime()
+        {
+            waitForTermination();
+        }
+        virtual void test() override
+        {
+            // Use at least 20 ms of CPU, with a safeguard of 10 seconds.
+            const ts::NanoSecond start = ts::Monotonic::CurrentNanoSeconds();
+            volatile uint64_t value = 0;
+            while (cpuTime() < 20 * ts::NanoSecPerMilliSec && ts::Monotonic::CurrentNanoSeconds() - start < 10 * ts::NanoSecPerSec) {
+                for (int i = 0; i < 100000; ++i) {
+                    value = value + uint64_t(i);
+                }
+            }
+            _busy_done = true;
+            while (!_stop) {
+                ts::SleepThread(10);
+            }
+        }
+    };
+}
+
+void ThreadTest::testCpuTime()
+{
+    volatile bool busy_done = false;
+    volatile bool stop = false;
+    ThreadCpuTime thread(busy_done, stop);
+    TSUNIT_EQUAL(0, thread.cpuTime());
+    TSUNIT_ASSERT(thread.start());
+    while (!busy_done) {
+        ts::SleepThread(10);
+    }
+    const ts::NanoSecond cpu = thread.cpuTime();
+    debug() << "ThreadTest::testCpuTime: " << cpu << " ns" << std::endl;
+    TSUNIT_ASSERT(cpu >= 20 * ts::NanoSecPerMilliSec);
+    TSUNIT_ASSERT(cpu < 10 * ts::NanoSecPerSec);
+    stop = true;
+    TSUNIT_ASSERT(thread.waitForTermination());
+    TSUNIT_EQUAL(0, thread.cpuTime());
+}
+
+//
+// Test case: CPU affinity of a thread.
+//
+namespace {
+    class ThreadCPUAffinity: public utest::TSUnitThread
+    {
+    private:
+        ts::ThreadAttributes::CPUSet& _cpus;
+    public:
+        ThreadCPUAffinity(const ts::ThreadAttributes& attributes, ts::ThreadAttributes::CPUSet& cpus) :
+            utest::TSUnitThread(attributes),
+            _cpus(cpus)
+        {
+        }
+        virtual ~ThreadCPUAffinity()
+        {
+            waitForTermination();
+        }
+        virtual void test() override
+        {
+            ts::Thread::GetCPUAffinity(_cpus);
+        }
+    };
+}
+
+void ThreadTest::testCPUAffinity()
+{
+    ts::ThreadAttributes::CPUSet allowed;
+    if (!ts::Thread::GetCPUAffinity(allowed)) {
+        debug() << "ThreadTest::testCPUAffinity: CPU affinity not supported" << std::endl;
+        return;
+    }
+    TSUNIT_ASSERT(!allowed.empty());
+
+    // Run a thread on the last allowed CPU.
+    const ts::ThreadAttributes::CPUSet last({*allowed.rbegin()});
+    ts::ThreadAttributes::CPUSet cpus;
+    ThreadCPUAffinity thread(ts::ThreadAttributes().setCPUAffinity(last), cpus);
+    TSUNIT_ASSERT(thread.start());
+    TSUNIT_ASSERT(thread.waitForTermination());
+    debug() << "ThreadTest::testCPUAffinity: " << allowed.size() << " allowed CPUs, thread on CPU " << *last.begin() << std::endl;
+#if !defined(TS_WINDOWS)
+    // On Windows, GetCPUAffinity() returns the process affinity.
+    TSUNIT_ASSERT(cpus == last);
+#endif
+
+    // Locations of the allowed CPUs.
+    std::vector<ts::SysInfo::CPULocation> locations;
+    ts::SysInfo::Instance()->getCPULocations(locations, allowed);
+    TSUNIT_EQUAL(allowed.size(), locations.size());
+    for (size_t i = 0; i < locations.size(); ++i) {
+        debug() << "ThreadTest::testCPUAffinity: CPU " << locations[i].cpu << ", core " << locations[i].core << ", package " << locations[i].package << std::endl;
+        TSUNIT_ASSERT(allowed.find(locations[i].cpu) != allowed.end());
+    }
+}
@@ -61,11 +61,13 @@ public:
     void testStackSize();
     void testDeleteWhenTerminated();
     void testPriority();
+    void testCPUAffinity();
 
     TSUNIT_TEST_BEGIN(ThreadAttributesTest);
     TSUNIT_TEST(testStackSize);
     TSUNIT_TEST(testDeleteWhenTerminated);
     TSUNIT_TEST(testPriority);
+    TSUNIT_TEST(testCPUAffinity);
     TSUNIT_TEST_END();
 };
 
@@ -134,3 +136,11 @@ void ThreadAttributesTest::testPriority()
     attr.setPriority (ts::ThreadAttributes::GetNormalPriority());
     TSUNIT_ASSERT(attr.getPriority() == ts::ThreadAttributes::GetNormalPriority());
 }
+
+void ThreadAttributesTest::testCPUAffinity()
+{
+    ts::ThreadAttributes attr;
+    TSUNIT_ASSERT(attr.getCPUAffinity().empty()); // default value
+    TSUNIT_ASSERT(attr.setCPUAffinity({1, 3}).getCPUAffinity() == ts::ThreadAttributes::CPUSet({1, 3}));
+    TSUNIT_ASSERT(attr.setCPUAffinity(ts::ThreadAttributes::CPUSet()).getCPUAffinity().empty());
+}